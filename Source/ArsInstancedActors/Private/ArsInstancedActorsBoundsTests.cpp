@@ -0,0 +1,293 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#include "ArsInstancedActorsBoundsTests.h"
+#include "MassCommonFragments.h"
+#include "Math/VectorRegister.h"
+
+
+namespace UE::ArsInstancedActors::BoundsTests
+{
+	namespace
+	{
+		constexpr int32 NumLanes = 4;
+
+		// Appends BaseIndex + Lane for each Lane bit set in LaneMask
+		FORCEINLINE void AppendLanes(uint32 LaneMask, const int32 BaseIndex, TArray<int32>& OutIndices)
+		{
+			while (LaneMask != 0)
+			{
+				OutIndices.Add(BaseIndex + int32(FMath::CountTrailingZeros(LaneMask)));
+				LaneMask &= LaneMask - 1;
+			}
+		}
+
+		// Runs TTest over Locations NumLanes at a time, with a scalar loop for the remainder
+		template <typename TTest>
+		int32 GatherPassing(const FLocationsSoA& Locations, const TTest& Test, TArray<int32>& OutIndices)
+		{
+			const int32 NumIndicesBefore = OutIndices.Num();
+			const int32 NumLocations = Locations.Num();
+			const double* RESTRICT X = Locations.X.GetData();
+			const double* RESTRICT Y = Locations.Y.GetData();
+			const double* RESTRICT Z = Locations.Z.GetData();
+
+			int32 Index = 0;
+			for (; Index + NumLanes <= NumLocations; Index += NumLanes)
+			{
+				const VectorRegister4Double PassMask = Test.Test(VectorLoad(X + Index), VectorLoad(Y + Index), VectorLoad(Z + Index));
+				AppendLanes(uint32(VectorMaskBits(PassMask)), Index, OutIndices);
+			}
+			for (; Index < NumLocations; ++Index)
+			{
+				if (Test.Test(X[Index], Y[Index], Z[Index]))
+				{
+					OutIndices.Add(Index);
+				}
+			}
+
+			return OutIndices.Num() - NumIndicesBefore;
+		}
+
+		struct FBoxTest
+		{
+			FBoxTest(const FBox& Box, const double Padding)
+				: Min(Box.Min - FVector(Padding))
+				, Max(Box.Max + FVector(Padding))
+				, MinX(VectorSetFloat1(Min.X)), MinY(VectorSetFloat1(Min.Y)), MinZ(VectorSetFloat1(Min.Z))
+				, MaxX(VectorSetFloat1(Max.X)), MaxY(VectorSetFloat1(Max.Y)), MaxZ(VectorSetFloat1(Max.Z))
+			{
+			}
+
+			FORCEINLINE VectorRegister4Double Test(const VectorRegister4Double& X, const VectorRegister4Double& Y, const VectorRegister4Double& Z) const
+			{
+				const VectorRegister4Double InsideX = VectorBitwiseAnd(VectorCompareGE(X, MinX), VectorCompareLE(X, MaxX));
+				const VectorRegister4Double InsideY = VectorBitwiseAnd(VectorCompareGE(Y, MinY), VectorCompareLE(Y, MaxY));
+				const VectorRegister4Double InsideZ = VectorBitwiseAnd(VectorCompareGE(Z, MinZ), VectorCompareLE(Z, MaxZ));
+				return VectorBitwiseAnd(InsideX, VectorBitwiseAnd(InsideY, InsideZ));
+			}
+
+			FORCEINLINE bool Test(const double X, const double Y, const double Z) const
+			{
+				return X >= Min.X && X <= Max.X && Y >= Min.Y && Y <= Max.Y && Z >= Min.Z && Z <= Max.Z;
+			}
+
+			FVector Min;
+			FVector Max;
+			VectorRegister4Double MinX, MinY, MinZ;
+			VectorRegister4Double MaxX, MaxY, MaxZ;
+		};
+
+		struct FSphereTest
+		{
+			FSphereTest(const FSphere& Sphere, const double Padding)
+				: Center(Sphere.Center)
+				, RadiusSquared(FMath::Square(FMath::Max(Sphere.W + Padding, 0.0)))
+				, CenterX(VectorSetFloat1(Center.X)), CenterY(VectorSetFloat1(Center.Y)), CenterZ(VectorSetFloat1(Center.Z))
+				, RadiusSquaredV(VectorSetFloat1(RadiusSquared))
+			{
+			}
+
+			FORCEINLINE VectorRegister4Double Test(const VectorRegister4Double& X, const VectorRegister4Double& Y, const VectorRegister4Double& Z) const
+			{
+				const VectorRegister4Double DeltaX = VectorSubtract(X, CenterX);
+				const VectorRegister4Double DeltaY = VectorSubtract(Y, CenterY);
+				const VectorRegister4Double DeltaZ = VectorSubtract(Z, CenterZ);
+				const VectorRegister4Double DistanceSquared = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaZ, DeltaZ)));
+				return VectorCompareLE(DistanceSquared, RadiusSquaredV);
+			}
+
+			FORCEINLINE bool Test(const double X, const double Y, const double Z) const
+			{
+				return FMath::Square(X - Center.X) + FMath::Square(Y - Center.Y) + FMath::Square(Z - Center.Z) <= RadiusSquared;
+			}
+
+			FVector Center;
+			double RadiusSquared;
+			VectorRegister4Double CenterX, CenterY, CenterZ;
+			VectorRegister4Double RadiusSquaredV;
+		};
+
+		struct FOrientedBoxTest
+		{
+			FOrientedBoxTest(const FOrientedBox& OrientedBox, const double Padding)
+				: Box(OrientedBox)
+			{
+				Box.ExtentX = FMath::Max(Box.ExtentX + Padding, 0.0);
+				Box.ExtentY = FMath::Max(Box.ExtentY + Padding, 0.0);
+				Box.ExtentZ = FMath::Max(Box.ExtentZ + Padding, 0.0);
+
+				CenterV[0] = VectorSetFloat1(Box.Center.X);
+				CenterV[1] = VectorSetFloat1(Box.Center.Y);
+				CenterV[2] = VectorSetFloat1(Box.Center.Z);
+
+				const FVector* Axes[3] = { &Box.AxisX, &Box.AxisY, &Box.AxisZ };
+				const double Extents[3] = { Box.ExtentX, Box.ExtentY, Box.ExtentZ };
+				for (int32 AxisIndex = 0; AxisIndex < 3; ++AxisIndex)
+				{
+					AxisV[AxisIndex][0] = VectorSetFloat1(Axes[AxisIndex]->X);
+					AxisV[AxisIndex][1] = VectorSetFloat1(Axes[AxisIndex]->Y);
+					AxisV[AxisIndex][2] = VectorSetFloat1(Axes[AxisIndex]->Z);
+					ExtentV[AxisIndex] = VectorSetFloat1(Extents[AxisIndex]);
+				}
+			}
+
+			FORCEINLINE VectorRegister4Double Test(const VectorRegister4Double& X, const VectorRegister4Double& Y, const VectorRegister4Double& Z) const
+			{
+				const VectorRegister4Double DeltaX = VectorSubtract(X, CenterV[0]);
+				const VectorRegister4Double DeltaY = VectorSubtract(Y, CenterV[1]);
+				const VectorRegister4Double DeltaZ = VectorSubtract(Z, CenterV[2]);
+
+				VectorRegister4Double PassMask = VectorCompareGE(ExtentV[0], ExtentV[0]);
+				for (int32 AxisIndex = 0; AxisIndex < 3; ++AxisIndex)
+				{
+					// Project onto the box axis, compared against the box extent along it
+					const VectorRegister4Double Projection = VectorMultiplyAdd(DeltaX, AxisV[AxisIndex][0]
+						, VectorMultiplyAdd(DeltaY, AxisV[AxisIndex][1], VectorMultiply(DeltaZ, AxisV[AxisIndex][2])));
+					PassMask = VectorBitwiseAnd(PassMask, VectorCompareLE(VectorAbs(Projection), ExtentV[AxisIndex]));
+				}
+				return PassMask;
+			}
+
+			FORCEINLINE bool Test(const double X, const double Y, const double Z) const
+			{
+				return IsInside(Box, FVector(X, Y, Z));
+			}
+
+			FOrientedBox Box;
+			VectorRegister4Double CenterV[3];
+			VectorRegister4Double AxisV[3][3];
+			VectorRegister4Double ExtentV[3];
+		};
+	} // anonymous
+
+	//-----------------------------------------------------------------------------
+	// FLocationsSoA
+	//-----------------------------------------------------------------------------
+	void FLocationsSoA::Reset()
+	{
+		X.Reset();
+		Y.Reset();
+		Z.Reset();
+		MaxAbsScale = 0.0;
+	}
+
+	void FLocationsSoA::Reserve(const int32 Num)
+	{
+		X.Reserve(Num);
+		Y.Reserve(Num);
+		Z.Reserve(Num);
+	}
+
+	void FLocationsSoA::Add(const FVector& Location)
+	{
+		X.Add(Location.X);
+		Y.Add(Location.Y);
+		Z.Add(Location.Z);
+	}
+
+	void FLocationsSoA::AddTransforms(TConstArrayView<FTransformFragment> Transforms)
+	{
+		Reserve(Num() + Transforms.Num());
+		for (const FTransformFragment& TransformFragment : Transforms)
+		{
+			const FTransform& Transform = TransformFragment.GetTransform();
+			Add(Transform.GetLocation());
+			MaxAbsScale = FMath::Max(MaxAbsScale, Transform.GetScale3D().GetAbsMax());
+		}
+	}
+
+	void FLocationsSoA::AddTransforms(TConstArrayView<FTransform> Transforms)
+	{
+		Reserve(Num() + Transforms.Num());
+		for (const FTransform& Transform : Transforms)
+		{
+			Add(Transform.GetLocation());
+			MaxAbsScale = FMath::Max(MaxAbsScale, Transform.GetScale3D().GetAbsMax());
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	// Batch tests
+	//-----------------------------------------------------------------------------
+	int32 GatherInside(const FLocationsSoA& Locations, const FBox& Box, const double Padding, TArray<int32>& OutIndices)
+	{
+		return GatherPassing(Locations, FBoxTest(Box, Padding), OutIndices);
+	}
+
+	int32 GatherInside(const FLocationsSoA& Locations, const FSphere& Sphere, const double Padding, TArray<int32>& OutIndices)
+	{
+		return GatherPassing(Locations, FSphereTest(Sphere, Padding), OutIndices);
+	}
+
+	int32 GatherInside(const FLocationsSoA& Locations, const FOrientedBox& OrientedBox, const double Padding, TArray<int32>& OutIndices)
+	{
+		return GatherPassing(Locations, FOrientedBoxTest(OrientedBox, Padding), OutIndices);
+	}
+
+	//-----------------------------------------------------------------------------
+	// Scalar helpers
+	//-----------------------------------------------------------------------------
+	bool IsInside(const FOrientedBox& OrientedBox, const FVector& Location)
+	{
+		const FVector Delta = Location - OrientedBox.Center;
+		return FMath::Abs(Delta | OrientedBox.AxisX) <= OrientedBox.ExtentX
+			&& FMath::Abs(Delta | OrientedBox.AxisY) <= OrientedBox.ExtentY
+			&& FMath::Abs(Delta | OrientedBox.AxisZ) <= OrientedBox.ExtentZ;
+	}
+
+	bool IsInside(const FOrientedBox& OrientedBox, const FBox& Box)
+	{
+		FVector Vertices[8];
+		Box.GetVertices(Vertices);
+		for (const FVector& Vertex : Vertices)
+		{
+			if (!IsInside(OrientedBox, Vertex))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Intersect(const FOrientedBox& OrientedBox, const FBox& Box)
+	{
+		// Separating axis test along the world axes, i.e: Box's face normals
+		if (!GetBoundingBox(OrientedBox).Intersect(Box))
+		{
+			return false;
+		}
+
+		// Separating axis test along OrientedBox's face normals
+		FVector BoxCenter;
+		FVector BoxExtent;
+		Box.GetCenterAndExtents(BoxCenter, BoxExtent);
+		const FVector Delta = BoxCenter - OrientedBox.Center;
+
+		const FVector* Axes[3] = { &OrientedBox.AxisX, &OrientedBox.AxisY, &OrientedBox.AxisZ };
+		const double Extents[3] = { OrientedBox.ExtentX, OrientedBox.ExtentY, OrientedBox.ExtentZ };
+		for (int32 AxisIndex = 0; AxisIndex < 3; ++AxisIndex)
+		{
+			const FVector& Axis = *Axes[AxisIndex];
+			const double ProjectedBoxExtent = BoxExtent.X * FMath::Abs(Axis.X) + BoxExtent.Y * FMath::Abs(Axis.Y) + BoxExtent.Z * FMath::Abs(Axis.Z);
+			if (FMath::Abs(Delta | Axis) > Extents[AxisIndex] + ProjectedBoxExtent)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	FBox GetBoundingBox(const FOrientedBox& OrientedBox)
+	{
+		const FVector HalfSize = OrientedBox.AxisX.GetAbs() * OrientedBox.ExtentX
+			+ OrientedBox.AxisY.GetAbs() * OrientedBox.ExtentY
+			+ OrientedBox.AxisZ.GetAbs() * OrientedBox.ExtentZ;
+		return FBox(OrientedBox.Center - HalfSize, OrientedBox.Center + HalfSize);
+	}
+
+	double GetBoundsRadius(const FBox& LocalBounds)
+	{
+		return LocalBounds.IsValid ? FVector::Max(LocalBounds.Min.GetAbs(), LocalBounds.Max.GetAbs()).Size() : 0.0;
+	}
+} // namespace UE::ArsInstancedActors::BoundsTests
@@ -24,6 +24,11 @@ void UArsInstancedActorsComponent::InitializeComponentForInstance(FArsInstancedA
 	InstanceHandle = InInstanceHandle;
 }
 
+void UArsInstancedActorsComponent::OnReleasedToPool()
+{
+	InstanceHandle.Reset();
+}
+
 void UArsInstancedActorsComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -0,0 +1,402 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#include "ArsInstancedActorsCompressedTransforms.h"
+#include "Serialization/Archive.h"
+
+
+namespace UE::ArsInstancedActors
+{
+	namespace
+	{
+		// Smallest-three quaternion components all lie within [-1/sqrt(2), 1/sqrt(2)]
+		constexpr double SmallestThreeRange = UE_INV_SQRT_2;
+
+		constexpr int32 MinRotationBits = 4;
+		constexpr int32 MaxRotationBits = 16;
+
+		// Upper limit on distinct scales. Instance sets exceeding this after clustering are left uncompressed.
+		constexpr int32 MaxScalePaletteSize = 256;
+
+		// Slack applied when verifying tolerances, to absorb float rounding in otherwise exact quantization
+		constexpr double VerificationSlack = UE_KINDA_SMALL_NUMBER;
+
+		FORCEINLINE uint64 BitMask(const int32 NumBits)
+		{
+			return (uint64(1) << NumBits) - 1;
+		}
+
+		FORCEINLINE uint32 Quantize(const double Value, const double Min, const double Step, const int32 NumBits)
+		{
+			if (NumBits == 0 || Step <= 0.0)
+			{
+				return 0;
+			}
+			return (uint32)FMath::Clamp<int64>(FMath::RoundToInt64((Value - Min) / Step), 0, (int64)BitMask(NumBits));
+		}
+
+		FORCEINLINE double Dequantize(const uint32 Quantized, const double Min, const double Step)
+		{
+			return Min + double(Quantized) * Step;
+		}
+
+		FORCEINLINE double GetSmallestThreeStep(const int32 NumBits)
+		{
+			return (2.0 * SmallestThreeRange) / double(BitMask(NumBits));
+		}
+
+		/** Appends fixed width bit fields to a packed uint32 array */
+		struct FBitPacker
+		{
+			explicit FBitPacker(TArray<uint32>& InWords)
+				: Words(InWords)
+			{
+			}
+
+			void Write(const uint32 Value, const int32 NumBits)
+			{
+				check(NumBits >= 0 && NumBits <= 32);
+				if (NumBits == 0)
+				{
+					return;
+				}
+
+				const int32 LastWordIndex = (BitOffset + NumBits - 1) >> 5;
+				if (Words.Num() <= LastWordIndex)
+				{
+					Words.AddZeroed(LastWordIndex + 1 - Words.Num());
+				}
+
+				const int32 WordIndex = BitOffset >> 5;
+				const int32 BitInWord = BitOffset & 31;
+				const uint64 ShiftedValue = (uint64(Value) & BitMask(NumBits)) << BitInWord;
+				Words[WordIndex] |= uint32(ShiftedValue);
+				if (LastWordIndex != WordIndex)
+				{
+					Words[LastWordIndex] |= uint32(ShiftedValue >> 32);
+				}
+
+				BitOffset += NumBits;
+			}
+
+			TArray<uint32>& Words;
+			int32 BitOffset = 0;
+		};
+
+		FORCEINLINE uint32 ReadBits(TConstArrayView<uint32> Words, int32& InOutBitOffset, const int32 NumBits)
+		{
+			if (NumBits == 0)
+			{
+				return 0;
+			}
+
+			const int32 WordIndex = InOutBitOffset >> 5;
+			const int32 BitInWord = InOutBitOffset & 31;
+			uint64 Bits = Words[WordIndex];
+			if (BitInWord + NumBits > 32)
+			{
+				Bits |= uint64(Words[WordIndex + 1]) << 32;
+			}
+
+			InOutBitOffset += NumBits;
+			return uint32((Bits >> BitInWord) & BitMask(NumBits));
+		}
+
+		/** 'Smallest three' quaternion encoding: index of the largest component and the remaining three, quantized */
+		struct FSmallestThreeQuat
+		{
+			uint32 LargestIndex = 0;
+			uint32 Components[3] = { 0, 0, 0 };
+
+			static FSmallestThreeQuat Encode(const FQuat& Rotation, const int32 NumBits)
+			{
+				const double Values[4] = { Rotation.X, Rotation.Y, Rotation.Z, Rotation.W };
+
+				FSmallestThreeQuat Encoded;
+				for (uint32 ComponentIndex = 1; ComponentIndex < 4; ++ComponentIndex)
+				{
+					if (FMath::Abs(Values[ComponentIndex]) > FMath::Abs(Values[Encoded.LargestIndex]))
+					{
+						Encoded.LargestIndex = ComponentIndex;
+					}
+				}
+
+				// Q and -Q represent the same rotation, so flip to keep the dropped component positive
+				const double Sign = Values[Encoded.LargestIndex] < 0.0 ? -1.0 : 1.0;
+				const double Step = GetSmallestThreeStep(NumBits);
+				for (uint32 ComponentIndex = 0, EncodedIndex = 0; ComponentIndex < 4; ++ComponentIndex)
+				{
+					if (ComponentIndex != Encoded.LargestIndex)
+					{
+						Encoded.Components[EncodedIndex++] = Quantize(Values[ComponentIndex] * Sign, -SmallestThreeRange, Step, NumBits);
+					}
+				}
+
+				return Encoded;
+			}
+
+			FQuat Decode(const int32 NumBits) const
+			{
+				const double Step = GetSmallestThreeStep(NumBits);
+
+				double Values[4];
+				double SumSquared = 0.0;
+				for (uint32 ComponentIndex = 0, EncodedIndex = 0; ComponentIndex < 4; ++ComponentIndex)
+				{
+					if (ComponentIndex != LargestIndex)
+					{
+						Values[ComponentIndex] = Dequantize(Components[EncodedIndex++], -SmallestThreeRange, Step);
+						SumSquared += FMath::Square(Values[ComponentIndex]);
+					}
+				}
+				Values[LargestIndex] = FMath::Sqrt(FMath::Max(0.0, 1.0 - SumSquared));
+
+				FQuat Rotation(Values[0], Values[1], Values[2], Values[3]);
+				Rotation.Normalize();
+				return Rotation;
+			}
+		};
+	} // anonymous
+
+	//-----------------------------------------------------------------------------
+	// FCompressedInstanceTransforms
+	//-----------------------------------------------------------------------------
+	bool FCompressedInstanceTransforms::Compress(TConstArrayView<FTransform> InstanceTransforms, const FTransformCompressionTolerances& Tolerances, FString& OutFailureReason)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCompressedInstanceTransforms Compress);
+
+		Reset();
+
+		const int32 InNumInstances = InstanceTransforms.Num();
+		if (InNumInstances == 0)
+		{
+			OutFailureReason = TEXT("No instances to compress");
+			return false;
+		}
+
+		// Gather valid instances, location bounds & normalized rotations
+		TBitArray<> InValidInstances(false, InNumInstances);
+		TArray<FQuat> NormalizedRotations;
+		NormalizedRotations.SetNumUninitialized(InNumInstances);
+		FBox LocationBounds(ForceInit);
+		for (int32 InstanceIndex = 0; InstanceIndex < InNumInstances; ++InstanceIndex)
+		{
+			const FTransform& InstanceTransform = InstanceTransforms[InstanceIndex];
+			if (!InstanceTransform.GetScale3D().IsZero())
+			{
+				InValidInstances[InstanceIndex] = true;
+				LocationBounds += InstanceTransform.GetLocation();
+				NormalizedRotations[InstanceIndex] = InstanceTransform.GetRotation().GetNormalized();
+			}
+		}
+
+		if (!LocationBounds.IsValid)
+		{
+			OutFailureReason = TEXT("No valid instances to compress");
+			return false;
+		}
+
+		// Location: choose the per-axis bit depth whose half-step meets MaxLocationError
+		const double MaxLocationError = FMath::Max(Tolerances.MaxLocationError, UE_DOUBLE_KINDA_SMALL_NUMBER);
+		LocationMin = LocationBounds.Min;
+		const FVector LocationRange = LocationBounds.GetSize();
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (LocationRange[Axis] <= MaxLocationError)
+			{
+				LocationBits[Axis] = 0;
+				LocationStep[Axis] = 0.0;
+				continue;
+			}
+
+			const int32 AxisBits = FMath::Max(1, FMath::CeilToInt32(FMath::Log2(LocationRange[Axis] / (2.0 * MaxLocationError) + 1.0)));
+			if (AxisBits > 32)
+			{
+				OutFailureReason = FString::Printf(TEXT("Location range %f can't meet %f error within 32 bits"), LocationRange[Axis], MaxLocationError);
+				Reset();
+				return false;
+			}
+			LocationBits[Axis] = (uint8)AxisBits;
+			LocationStep[Axis] = LocationRange[Axis] / double(BitMask(AxisBits));
+		}
+
+		// Rotation: choose the smallest bit depth meeting MaxRotationErrorDegrees for all instances
+		const double MaxRotationError = FMath::DegreesToRadians(Tolerances.MaxRotationErrorDegrees);
+		RotationBits = 0;
+		for (int32 CandidateBits = MinRotationBits; CandidateBits <= MaxRotationBits && RotationBits == 0; ++CandidateBits)
+		{
+			bool bMeetsTolerance = true;
+			for (TConstSetBitIterator<> It(InValidInstances); It && bMeetsTolerance; ++It)
+			{
+				const FQuat& Rotation = NormalizedRotations[It.GetIndex()];
+				const FQuat Decoded = FSmallestThreeQuat::Encode(Rotation, CandidateBits).Decode(CandidateBits);
+				bMeetsTolerance = Rotation.AngularDistance(Decoded) <= MaxRotationError;
+			}
+
+			if (bMeetsTolerance)
+			{
+				RotationBits = (uint8)CandidateBits;
+			}
+		}
+
+		if (RotationBits == 0)
+		{
+			OutFailureReason = FString::Printf(TEXT("Rotations can't meet %f degree error within %d bits per component"), Tolerances.MaxRotationErrorDegrees, MaxRotationBits);
+			Reset();
+			return false;
+		}
+
+		// Scale: greedily cluster scales into a palette, within MaxScaleError of their palette entry
+		TArray<uint32> ScaleIndices;
+		ScaleIndices.SetNumZeroed(InNumInstances);
+		for (TConstSetBitIterator<> It(InValidInstances); It; ++It)
+		{
+			const FVector3f Scale(InstanceTransforms[It.GetIndex()].GetScale3D());
+			int32 PaletteIndex = ScalePalette.IndexOfByPredicate([&Scale, &Tolerances](const FVector3f& PaletteScale)
+				{
+					return (PaletteScale - Scale).GetAbsMax() <= Tolerances.MaxScaleError;
+				});
+
+			if (PaletteIndex == INDEX_NONE)
+			{
+				if (ScalePalette.Num() >= MaxScalePaletteSize)
+				{
+					OutFailureReason = FString::Printf(TEXT("More than %d distinct scales within %f error"), MaxScalePaletteSize, Tolerances.MaxScaleError);
+					Reset();
+					return false;
+				}
+				PaletteIndex = ScalePalette.Add(Scale);
+			}
+			ScaleIndices[It.GetIndex()] = (uint32)PaletteIndex;
+		}
+		ScaleIndexBits = (uint8)FMath::CeilLogTwo((uint32)ScalePalette.Num());
+
+		// Pack valid instances
+		FBitPacker Packer(PackedInstances);
+		for (TConstSetBitIterator<> It(InValidInstances); It; ++It)
+		{
+			const FVector Location = InstanceTransforms[It.GetIndex()].GetLocation();
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Packer.Write(Quantize(Location[Axis], LocationMin[Axis], LocationStep[Axis], LocationBits[Axis]), LocationBits[Axis]);
+			}
+
+			const FSmallestThreeQuat Rotation = FSmallestThreeQuat::Encode(NormalizedRotations[It.GetIndex()], RotationBits);
+			Packer.Write(Rotation.LargestIndex, 2);
+			for (const uint32 Component : Rotation.Components)
+			{
+				Packer.Write(Component, RotationBits);
+			}
+
+			Packer.Write(ScaleIndices[It.GetIndex()], ScaleIndexBits);
+		}
+		PackedInstances.Shrink();
+
+		NumInstances = InNumInstances;
+		ValidInstances = MoveTemp(InValidInstances);
+
+		// Verify actual error against tolerances, to guard against any quantization edge cases
+		TArray<FTransform> Decompressed;
+		Decompress(Decompressed);
+		for (int32 InstanceIndex = 0; InstanceIndex < InNumInstances; ++InstanceIndex)
+		{
+			const FTransform& Original = InstanceTransforms[InstanceIndex];
+			const FTransform& Result = Decompressed[InstanceIndex];
+			if (!ValidInstances[InstanceIndex])
+			{
+				continue;
+			}
+
+			const double LocationError = (Original.GetLocation() - Result.GetLocation()).GetAbsMax();
+			const double RotationError = NormalizedRotations[InstanceIndex].AngularDistance(Result.GetRotation());
+			const double ScaleError = (Original.GetScale3D() - Result.GetScale3D()).GetAbsMax();
+			if (LocationError > MaxLocationError + VerificationSlack
+				|| RotationError > MaxRotationError + VerificationSlack
+				|| ScaleError > Tolerances.MaxScaleError + VerificationSlack)
+			{
+				OutFailureReason = FString::Printf(TEXT("Instance %d exceeds tolerances after compression (location %f, rotation %f deg, scale %f)")
+					, InstanceIndex, LocationError, FMath::RadiansToDegrees(RotationError), ScaleError);
+				Reset();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void FCompressedInstanceTransforms::Decompress(TArray<FTransform>& OutInstanceTransforms) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCompressedInstanceTransforms Decompress);
+
+		OutInstanceTransforms.Reset(NumInstances);
+		OutInstanceTransforms.SetNumUninitialized(NumInstances);
+
+		int32 BitOffset = 0;
+		for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+		{
+			if (ValidInstances[InstanceIndex])
+			{
+				OutInstanceTransforms[InstanceIndex] = DecompressInstance(BitOffset);
+			}
+			else
+			{
+				OutInstanceTransforms[InstanceIndex].SetIdentityZeroScale();
+			}
+		}
+	}
+
+	FTransform FCompressedInstanceTransforms::DecompressInstance(int32& InOutBitOffset) const
+	{
+		FVector Location;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Location[Axis] = Dequantize(ReadBits(PackedInstances, InOutBitOffset, LocationBits[Axis]), LocationMin[Axis], LocationStep[Axis]);
+		}
+
+		FSmallestThreeQuat Rotation;
+		Rotation.LargestIndex = ReadBits(PackedInstances, InOutBitOffset, 2);
+		for (uint32& Component : Rotation.Components)
+		{
+			Component = ReadBits(PackedInstances, InOutBitOffset, RotationBits);
+		}
+
+		const uint32 ScaleIndex = ReadBits(PackedInstances, InOutBitOffset, ScaleIndexBits);
+
+		return FTransform(Rotation.Decode(RotationBits), Location, FVector(ScalePalette[ScaleIndex]));
+	}
+
+	void FCompressedInstanceTransforms::Reset()
+	{
+		NumInstances = 0;
+		ValidInstances.Empty();
+		LocationMin = FVector::ZeroVector;
+		LocationStep = FVector::ZeroVector;
+		LocationBits[0] = LocationBits[1] = LocationBits[2] = 0;
+		RotationBits = 0;
+		ScaleIndexBits = 0;
+		ScalePalette.Empty();
+		PackedInstances.Empty();
+	}
+
+	SIZE_T FCompressedInstanceTransforms::GetAllocatedSize() const
+	{
+		return ValidInstances.GetAllocatedSize() + ScalePalette.GetAllocatedSize() + PackedInstances.GetAllocatedSize();
+	}
+
+	FArchive& operator<<(FArchive& Ar, FCompressedInstanceTransforms& CompressedTransforms)
+	{
+		Ar << CompressedTransforms.NumInstances;
+		Ar << CompressedTransforms.ValidInstances;
+		Ar << CompressedTransforms.LocationMin;
+		Ar << CompressedTransforms.LocationStep;
+		for (uint8& AxisBits : CompressedTransforms.LocationBits)
+		{
+			Ar << AxisBits;
+		}
+		Ar << CompressedTransforms.RotationBits;
+		Ar << CompressedTransforms.ScaleIndexBits;
+		Ar << CompressedTransforms.ScalePalette;
+		CompressedTransforms.PackedInstances.BulkSerialize(Ar);
+
+		return Ar;
+	}
+} // namespace UE::ArsInstancedActors
@@ -16,7 +16,6 @@
 #include "Algo/Count.h"
 #include "Algo/NoneOf.h"
 #include "Components/InstancedStaticMeshComponent.h"
-#include "Engine/AssetManager.h"
 #include "Engine/StaticMesh.h"
 #if UE_WITH_IRIS
 #include "Iris/ReplicationSystem/ReplicationFragmentUtil.h"
@@ -35,6 +34,7 @@
 #include "MassRepresentationTypes.h"
 #include "Net/UnrealNetwork.h"
 #include "Misc/Crc.h"
+#include "Serialization/ArchiveCrc32.h"
 
 
 #define DO_COLLISION_INDEX_DEBUG (1 && WITH_ARSINSTANCEDACTORS_DEBUG)
@@ -65,11 +65,19 @@ namespace UE::ArsInstancedActors
 			TEXT("Enables instances transform compression on cook for all AArsInstancedActorsManager's"),
 			ECVF_Cheat);
 
-		float CompressedLocationError = 0.0f;
+		bool bCookBakedSettings = false;
+		FAutoConsoleVariableRef CVarCookBakedSettings(
+			TEXT("IA.CookBakedSettings"),
+			bCookBakedSettings,
+			TEXT("Enables cooking compiled class settings into all UArsInstancedActorsData, skipping runtime settings compilation & Data Registry ")
+			TEXT("lookups for cooked classes. Requires the settings Data Registries to be preloaded in editor, otherwise settings are compiled at runtime."),
+			ECVF_Default);
+
+		float CompressedLocationError = 0.1f;
 		FAutoConsoleVariableRef CVarCompressedLocationError(
 			TEXT("IA.CompressedLocationError"),
 			CompressedLocationError,
-			TEXT("The maximum acceptable error for compressed locations"),
+			TEXT("The maximum acceptable per-axis error for compressed locations, in world units"),
 			ECVF_Cheat);
 
 		float CompressedRotationError = 1.0f;
@@ -83,7 +91,7 @@ namespace UE::ArsInstancedActors
 		FAutoConsoleVariableRef CVarCompressedScaleError(
 			TEXT("IA.CompressedScaleError"),
 			CompressedScaleError,
-			TEXT("The maximum acceptable error for compressed locations"),
+			TEXT("The maximum acceptable per-axis error for compressed scales"),
 			ECVF_Cheat);
 
 		bool bEnableFarDistanceRendering = true;
@@ -147,6 +155,23 @@ namespace UE::ArsInstancedActors
 			TEXT("initialize the visualization, instead of requesting async loads and deferring initialization."),
 			ECVF_Default);
 
+		bool bBatchVisualizationSwitches = true;
+		FAutoConsoleVariableRef CVarBatchVisualizationSwitches(
+			TEXT("IA.Visualizations.BatchSwitches"),
+			bBatchVisualizationSwitches,
+			TEXT("If enabled (default) UArsInstancedActorsData::SwitchInstanceVisualization queues switches to be applied in bulk by ")
+			TEXT("UArsInstancedActorsVisualizationSwitcherProcessor, coalescing repeated switches. Otherwise each switch adds and removes a ")
+			TEXT("FArsInstancedActorsMeshSwitchFragment, changing the entity's archetype twice."),
+			ECVF_Default);
+
+		float VisualizationPoolReleaseDelay = 10.0f;
+		FAutoConsoleVariableRef CVarVisualizationPoolReleaseDelay(
+			TEXT("IA.Visualizations.PoolReleaseDelay"),
+			VisualizationPoolReleaseDelay,
+			TEXT("Seconds visualizations removed via UArsInstancedActorsData::RemoveVisualization are pooled for, to be revived by a matching ")
+			TEXT("AddVisualization, before their ISMCs are destroyed. 0 disables pooling."),
+			ECVF_Default);
+
 		bool bUpdateNextTickTimeFragments = true;
 		FAutoConsoleVariableRef CVarUpdateNextTickTimeFragments(
 			TEXT("IA.UpdateNextTickTimeFragments"),
@@ -161,12 +186,63 @@ namespace UE::ArsInstancedActors
 			TEXT("If enabled (default) instanced actors will release created entity templates and exemplar actors from central systems. Allows resources that are no longer in use to be garbage collected."),
 			ECVF_Default);
 
+		bool bUseClassDefaultsForExemplars = false;
+		FAutoConsoleVariableRef CVarUseClassDefaultsForExemplars(
+			TEXT("IA.ExemplarActors.UseClassDefaults"),
+			bUseClassDefaultsForExemplars,
+			TEXT("If enabled, instance datas deduce their default visualization from their actor class's default object and component templates ")
+			TEXT("rather than spawning an exemplar actor. Exemplars are then only spawned when building a new entity template, or for classes ")
+			TEXT("without visible static meshes in their defaults. Note: Construction scripts are not run, so only enable this if instanced ")
+			TEXT("actor classes don't set up their static meshes in them."),
+			ECVF_Default);
+
+		bool bShareEntityTemplates = true;
+		FAutoConsoleVariableRef CVarShareEntityTemplates(
+			TEXT("IA.ShareEntityTemplates"),
+			bShareEntityTemplates,
+			TEXT("If enabled (default) instance datas of the same class, actor class, compiled settings and default visualization share a single ")
+			TEXT("entity template, rather than building one each. Only affects templates created after changing this."),
+			ECVF_Default);
+
 		bool bCanHydrateLogicEnabled = true;
 		FAutoConsoleVariableRef CVarCanHydrateLogicEnabled(
 			TEXT("IA.EnableCanHydrateLogic"),
 			bCanHydrateLogicEnabled,
 			TEXT("Toggles special handling of instanced marked as non-hydrating via settings (MaxActorDistance ==0)"),
 			ECVF_Default);
+
+		bool bEnableSpatialIndex = true;
+		FAutoConsoleVariableRef CVarEnableSpatialIndex(
+			TEXT("IA.SpatialIndex.Enable"),
+			bEnableSpatialIndex,
+			TEXT("If enabled (default) instance datas build a uniform grid of their instances, used to limit bounded instance queries ")
+			TEXT("(e.g: AArsInstancedActorsManager::ForEachInstance with an FBox or FSphere, modifier volumes) to candidate instances only. ")
+			TEXT("Affects only instance datas that haven't yet built their index."),
+			ECVF_Default);
+
+		int32 SpatialIndexMinInstances = 64;
+		FAutoConsoleVariableRef CVarSpatialIndexMinInstances(
+			TEXT("IA.SpatialIndex.MinInstances"),
+			SpatialIndexMinInstances,
+			TEXT("Instance datas with fewer instances than this will not build a spatial index, falling back to linear iteration for bounded queries."),
+			ECVF_Default);
+
+		int32 SpatialIndexTargetInstancesPerCell = 16;
+		FAutoConsoleVariableRef CVarSpatialIndexTargetInstancesPerCell(
+			TEXT("IA.SpatialIndex.TargetInstancesPerCell"),
+			SpatialIndexTargetInstancesPerCell,
+			TEXT("The average number of instances per cell used to determine spatial index cell size."),
+			ECVF_Default);
+
+		bool bRetainInstanceTransforms = true;
+		FAutoConsoleVariableRef CVarRetainInstanceTransforms(
+			TEXT("IA.RetainInstanceTransforms"),
+			bRetainInstanceTransforms,
+			TEXT("If enabled SpawnEntities retains InstanceTransforms rather than freeing them, allowing DespawnEntities to restore ")
+			TEXT("them by only applying runtime changes (removed instances and those marked via MarkInstanceTransformDirty), instead of reading ")
+			TEXT("back every entity's transform. Trades memory for cheaper streaming churn.\n")
+			TEXT("Instance datas with FArsInstancedActorsSettings::bMovableInstances never retain, always reading back every entity's transform."),
+			ECVF_Default);
 	} // CVars
 
 	namespace Helpers
@@ -179,6 +255,104 @@ namespace UE::ArsInstancedActors
 		{
 			InstanceTransform.SetIdentityZeroScale();
 		}
+
+		// Game thread gathered inputs for PrepareSpawnEntities, safe to hand off to a task
+		struct FSpawnEntitiesPreparationInputs
+		{
+			// View of UArsInstancedActorsData::InstanceTransforms, which must remain unmodified until preparation completes
+			TConstArrayView<FTransform> InstanceTransforms;
+			FTransform ManagerTransform;
+			bool bApplyManagerTranslationOnly = false;
+			int32 NumValidInstances = 0;
+
+			// Instances with persisted destroyed deltas
+			TBitArray<> DestroyedInstances;
+		};
+
+		FSpawnEntitiesPreparationInputs MakeSpawnEntitiesPreparationInputs(const UArsInstancedActorsData& InstanceData, TConstArrayView<FArsInstancedActorsDelta> InstanceDeltas)
+		{
+			const AArsInstancedActorsManager& Manager = InstanceData.GetManagerChecked();
+
+			FSpawnEntitiesPreparationInputs Inputs;
+			Inputs.InstanceTransforms = InstanceData.InstanceTransforms;
+			Inputs.ManagerTransform = Manager.GetActorTransform();
+			Inputs.bApplyManagerTranslationOnly = (Manager.GetActorQuat().IsIdentity() && Manager.GetActorScale().Equals(FVector::OneVector));
+			Inputs.NumValidInstances = InstanceData.NumValidInstances;
+			Inputs.DestroyedInstances.Init(false, InstanceData.InstanceTransforms.Num());
+			for (const FArsInstancedActorsDelta& InstanceDelta : InstanceDeltas)
+			{
+				const int32 InstanceIndex = InstanceDelta.GetInstanceIndex().GetIndex();
+				if (InstanceDelta.IsDestroyed() && Inputs.DestroyedInstances.IsValidIndex(InstanceIndex))
+				{
+					Inputs.DestroyedInstances[InstanceIndex] = true;
+				}
+			}
+			return Inputs;
+		}
+
+		// Filters valid, non-destroyed instances and computes their world space transforms. Doesn't touch any UObjects
+		// so is safe to run off the game thread.
+		void PrepareSpawnEntities(const FSpawnEntitiesPreparationInputs& Inputs, FSpawnEntitiesPreparation& OutPreparation)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsData PrepareSpawnEntities);
+
+			OutPreparation.Reset();
+			OutPreparation.WorldTransforms.Reserve(Inputs.NumValidInstances);
+			OutPreparation.InstanceIndices.Reserve(Inputs.NumValidInstances);
+
+			// Note: NumValidInstances may have been scaled down by FArsInstancedActorsSettings::ScaleEntityCount, in which case we
+			//       only take the first NumValidInstances valid instances
+			const FVector ManagerLocation = Inputs.ManagerTransform.GetLocation();
+			for (int32 InstanceIndex = 0; InstanceIndex < Inputs.InstanceTransforms.Num(); ++InstanceIndex)
+			{
+				if (OutPreparation.InstanceIndices.Num() + OutPreparation.DestroyedInstances.Num() >= Inputs.NumValidInstances)
+				{
+					break;
+				}
+
+				const FTransform& InstanceTransform = Inputs.InstanceTransforms[InstanceIndex];
+				if (!IsValidInstanceTransform(InstanceTransform))
+				{
+					continue;
+				}
+
+				if (Inputs.DestroyedInstances[InstanceIndex])
+				{
+					OutPreparation.DestroyedInstances.Add(FArsInstancedActorsInstanceIndex(InstanceIndex));
+					continue;
+				}
+
+				// Convert to world space
+				FTransform& WorldTransform = OutPreparation.WorldTransforms.Add_GetRef(InstanceTransform);
+				if (Inputs.bApplyManagerTranslationOnly)
+				{
+					WorldTransform.AddToTranslation(ManagerLocation);
+				}
+				else
+				{
+					WorldTransform *= Inputs.ManagerTransform;
+				}
+				OutPreparation.InstanceIndices.Add(FArsInstancedActorsInstanceIndex(InstanceIndex));
+			}
+		}
+
+		// Copies Fragment's value into EntityHandle's matching fragment, if it has one
+		void ApplyInstanceFragment(FMassEntityManager& EntityManager, const FMassEntityHandle EntityHandle, FConstStructView Fragment)
+		{
+			if (!EntityManager.IsEntityValid(EntityHandle))
+			{
+				return;
+			}
+
+			const UScriptStruct* FragmentType = Fragment.GetScriptStruct();
+			check(FragmentType);
+
+			FStructView EntityFragment = FMassEntityView(EntityManager, EntityHandle).GetFragmentDataStruct(FragmentType);
+			if (EntityFragment.IsValid())
+			{
+				FragmentType->CopyScriptStruct(EntityFragment.GetMemory(), Fragment.GetMemory());
+			}
+		}
 	} // Helpers
 
 	//-----------------------------------------------------------------------------
@@ -190,10 +364,42 @@ namespace UE::ArsInstancedActors
 		{
 			AActor* ExemplarActor = Actor.Get();
 			check(ExemplarActor);
-	
-			ArsInstancedActorsSubsystem->UnregisterExemplarActorClass(ExemplarActor->GetClass());
 
-			ExemplarActor->Destroy();
+			ArsInstancedActorsSubsystem->ReleaseExemplarActor(*ExemplarActor);
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	// FSharedEntityTemplate
+	//-----------------------------------------------------------------------------
+	FSharedEntityTemplate::FSharedEntityTemplate(const FSharedEntityTemplateKey& InKey, UArsInstancedActorsSubsystem* InInstancedActorSubsystem)
+		: Key(InKey)
+		, ArsInstancedActorsSubsystem(InInstancedActorSubsystem)
+	{
+	}
+
+	FSharedEntityTemplate::~FSharedEntityTemplate()
+	{
+		UArsInstancedActorsSubsystem* InstancedActorSubsystem = ArsInstancedActorsSubsystem.Get();
+		if (InstancedActorSubsystem == nullptr)
+		{
+			return;
+		}
+
+		InstancedActorSubsystem->UnregisterSharedEntityTemplate(Key);
+
+		// The template registry and traits go with the world, so there's nothing to destroy once it's tearing down
+		UWorld* World = InstancedActorSubsystem->GetWorld();
+		if (World == nullptr || World->bIsTearingDown)
+		{
+			return;
+		}
+
+		EntityConfig.DestroyEntityTemplate(*World);
+
+		if (UMassSpawnerSubsystem* MassSpawnerSubsystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(World))
+		{
+			MassSpawnerSubsystem->GetMutableTemplateRegistryInstance().DestroyTemplate(TemplateID);
 		}
 	}
 } // namespace ArsInstancedActors
@@ -205,9 +411,15 @@ void UArsInstancedActorsData::Initialize()
 {
 	AArsInstancedActorsManager& Manager = GetManagerChecked();
 
-	// Get the settings setup nice and early.
+	// Restore full InstanceTransforms before anything (modifiers, spatial index, entity spawning) reads them
+	DecompressInstanceTransforms();
+
+	// Get the settings setup nice and early, using cooked settings if we have them.
 	UArsInstancedActorsSubsystem& InstancedActorSubsystem = Manager.GetInstancedActorSubsystemChecked();
-	SharedSettings = InstancedActorSubsystem.GetOrCompileSettingsForActorClass(ActorClass);
+	SharedSettings = CookedSettings.IsValid()
+		? InstancedActorSubsystem.GetOrAddCookedSettingsForActorClass(ActorClass, CookedSettings)
+		: InstancedActorSubsystem.GetOrCompileSettingsForActorClass(ActorClass);
+	CookedSettings.Reset();
 	const FArsInstancedActorsSettings* Settings = GetSettingsPtr<const FArsInstancedActorsSettings>();
 
 	// Allow settings to override the actor class.
@@ -241,7 +453,7 @@ void UArsInstancedActorsData::Initialize()
 			const int32 NamedSeed = FCrc::StrCrc32(*ActorClass->GetName());
 			const int32 RandomSeed = FCrc::TypeCrc32(IntLocation, NamedSeed);
 			FRandomStream RandomStream(RandomSeed);
-			if (MissingChance > RandomStream.GetFraction() && NumValidInstances < MAX_uint16)
+			if (MissingChance > RandomStream.GetFraction() && NumValidInstances < GetMaxNumInstances())
 			{
 				++NumValidInstances;
 			}
@@ -260,28 +472,42 @@ void UArsInstancedActorsData::Initialize()
 		CombinedTags.AppendTags(Settings->GameplayTags);
 	}
 
-	// Get or create exemplar actor to derive entities from
+	// Deduce default visualization from ActorClass's defaults if possible, otherwise get or create exemplar actor to derive entities from
 	check(!ExemplarActorData.IsValid());
-	ExemplarActorData = InstancedActorSubsystem.GetOrCreateExemplarActor(ActorClass);
-	const AActor* const ExemplarActor = ExemplarActorData->Actor.Get();
-	check(ExemplarActor);
+	const FArsInstancedActorsVisualizationDesc* ClassDefaultVisualization = UE::ArsInstancedActors::CVars::bUseClassDefaultsForExemplars 
+		? InstancedActorSubsystem.GetOrCreateClassDefaultVisualization(ActorClass) : nullptr;
+	if (ClassDefaultVisualization == nullptr)
+	{
+		ExemplarActorData = InstancedActorSubsystem.GetOrCreateExemplarActor(ActorClass);
+		check(ExemplarActorData->Actor);
+	}
 
 	// Add default visualization at index 0
 	//FArsInstancedActorsVisualizationDesc DefaultVisualiation = FArsInstancedActorsVisualizationDesc::FromActor(ExemplarActor, &UE::ArsInstancedActors::VisualizationDescrFromActorAdditionalSteps);
-	FArsInstancedActorsVisualizationDesc DefaultVisualiation = InstancedActorSubsystem.CreateVisualDescriptionFromActor(*ExemplarActor);
+	FArsInstancedActorsVisualizationDesc DefaultVisualiation = ClassDefaultVisualization 
+		? *ClassDefaultVisualization : InstancedActorSubsystem.CreateVisualDescriptionFromActor(*ExemplarActorData->Actor);
 	const uint8 VisualizationIndex = AddVisualization(DefaultVisualiation);
 	check(VisualizationIndex == 0);
 
 	bCanHydrate = (UE::ArsInstancedActors::CVars::bCanHydrateLogicEnabled == false) || (Settings == nullptr) || Settings->MaxActorDistance > 0;
 
 	// Create entity template
-	CreateEntityTemplate(*ExemplarActor);
+	CreateEntityTemplate();
 
 	bHasEverInitialized = true;
 }
 
 void UArsInstancedActorsData::Deinitialize()
 {
+	CancelSpawnEntitiesPreparation();
+
+	// The shared fragment outlives this instance data in the entity manager, so stop it being bulk LOD ticked until re-initialized
+	if (FArsInstancedActorsDataSharedFragment* AsShared = SharedInstancedActorDataStruct.GetPtr<FArsInstancedActorsDataSharedFragment>())
+	{
+		GetManagerChecked().GetInstancedActorSubsystemChecked().UnregisterSharedFragment(SharedInstancedActorDataStruct);
+		AsShared->InstanceData.Reset();
+	}
+
 	if (bHasEverInitialized && UE::ArsInstancedActors::CVars::bEnableReleasingEntityTemplatesAndExemplarActors)
 	{
 		ReleaseEntityTemplate();
@@ -292,33 +518,60 @@ void UArsInstancedActorsData::Deinitialize()
 	CachedSetReplicatedActorRequests.Empty();
 }
 
-void UArsInstancedActorsData::CreateEntityTemplate(const AActor& ExemplarActor)
+void UArsInstancedActorsData::CreateEntityTemplate()
+{
+	UArsInstancedActorsSubsystem& InstancedActorSubsystem = GetManagerChecked().GetInstancedActorSubsystemChecked();
+
+	// Note: SharedEntityTemplate is retained across re-initialization if IA.EnableReleasingEntityTemplatesAndExemplarActors is disabled
+	if (!SharedEntityTemplate.IsValid())
+	{
+		SharedEntityTemplate = InstancedActorSubsystem.FindSharedEntityTemplate(*this);
+	}
+	if (!SharedEntityTemplate.IsValid())
+	{
+		// Building a new template requires a fully constructed exemplar, which Initialize may have skipped with IA.ExemplarActors.UseClassDefaults.
+		// In which case it's only held while building, leaving it to the exemplar actor cache thereafter.
+		TSharedPtr<UE::ArsInstancedActors::FExemplarActorData> TemplateExemplarActorData = ExemplarActorData.IsValid() 
+			? ExemplarActorData : TSharedPtr<UE::ArsInstancedActors::FExemplarActorData>(InstancedActorSubsystem.GetOrCreateExemplarActor(ActorClass));
+		const AActor* const ExemplarActor = TemplateExemplarActorData->Actor.Get();
+		check(ExemplarActor);
+
+		SharedEntityTemplate = InstancedActorSubsystem.GetOrCreateSharedEntityTemplate(*this, *ExemplarActor);
+	}
+	EntityTemplateID = SharedEntityTemplate->TemplateID;
+
+	// The shared fragment pointing back to this IAD isn't part of the (shared) template, so needs creating separately
+	CreateSharedInstancedActorDataStruct();
+}
+
+FMassEntityTemplateID UArsInstancedActorsData::BuildEntityTemplate(const AActor& ExemplarActor, FMassEntityConfig& InOutEntityConfig)
 {
 	UWorld* World = GetWorld();
 	check(World);
 
 	FMassEntityManager& MassEntityManager = GetMassEntityManagerChecked();
 
-	EntityConfig = FMassEntityConfig(*this);
+	// Note: Traits are outered to the subsystem rather than this IAD, as the shared template may outlive us
+	UObject* ConfigOwner = &GetManagerChecked().GetInstancedActorSubsystemChecked();
 
-	UMassDistanceLODCollectorTrait* LODCollectorTrait = NewObject<UMassDistanceLODCollectorTrait>(this);
-	EntityConfig.AddTrait(*LODCollectorTrait);
+	UMassDistanceLODCollectorTrait* LODCollectorTrait = NewObject<UMassDistanceLODCollectorTrait>(ConfigOwner);
+	InOutEntityConfig.AddTrait(*LODCollectorTrait);
 
-	UMassStationaryDistanceVisualizationTrait* VisTrait = NewObject<UMassStationaryDistanceVisualizationTrait>(this, GET_ARSINSTANCEDACTORS_CONFIG_VALUE(GetStationaryVisualizationTraitClass()));
+	UMassStationaryDistanceVisualizationTrait* VisTrait = NewObject<UMassStationaryDistanceVisualizationTrait>(ConfigOwner, GET_ARSINSTANCEDACTORS_CONFIG_VALUE(GetStationaryVisualizationTraitClass()));
 	if (UArsInstancedActorsVisualizationTrait* ArsInstancedActorsVisTrait = Cast<UArsInstancedActorsVisualizationTrait>(VisTrait))
 	{
 		ArsInstancedActorsVisTrait->InitializeFromInstanceData(*this);
 	}
-	EntityConfig.AddTrait(*VisTrait);
+	InOutEntityConfig.AddTrait(*VisTrait);
 
 	// Allow UArsInstancedActorsComponent's to extend entity config
 	ExemplarActor.ForEachComponent<UArsInstancedActorsComponent>(/*bIncludeFromChildActors*/ false
-		, [this, &MassEntityManager](const UArsInstancedActorsComponent* InstancedActorComponent)
+		, [this, &MassEntityManager, &InOutEntityConfig](const UArsInstancedActorsComponent* InstancedActorComponent)
 		{
-			InstancedActorComponent->ModifyMassEntityConfig(MassEntityManager, this, EntityConfig);
+			InstancedActorComponent->ModifyMassEntityConfig(MassEntityManager, this, InOutEntityConfig);
 		});
 
-	const FMassEntityTemplate& BaseEntityTemplate = EntityConfig.GetOrCreateEntityTemplate(*World);
+	const FMassEntityTemplate& BaseEntityTemplate = InOutEntityConfig.GetOrCreateEntityTemplate(*World);
 
 	FMassEntityTemplateData ModifiedTemplate(BaseEntityTemplate);
 	ModifyEntityTemplate(ModifiedTemplate, ExemplarActor);
@@ -331,11 +584,10 @@ void UArsInstancedActorsData::CreateEntityTemplate(const AActor& ExemplarActor)
 			return true;
 		});
 
-	UMassSpawnerSubsystem* MassSpawnerSubsystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(GetWorld());
+	UMassSpawnerSubsystem* MassSpawnerSubsystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(World);
 	FMassEntityTemplateRegistry& TemplateRegistry = MassSpawnerSubsystem->GetMutableTemplateRegistryInstance();
-	// @todo we should have GUID per IAD and use it here.
 	const TSharedRef<FMassEntityTemplate>& FinalizedTemplate = TemplateRegistry.FindOrAddTemplate(FMassEntityTemplateIDFactory::Make(FGuid::NewGuid()), MoveTemp(ModifiedTemplate));
-	EntityTemplateID = FinalizedTemplate->GetTemplateID();
+	return FinalizedTemplate->GetTemplateID();
 }
 
 void UArsInstancedActorsData::ModifyEntityTemplate(FMassEntityTemplateData& ModifiedTemplate, const AActor&)
@@ -345,16 +597,103 @@ void UArsInstancedActorsData::ModifyEntityTemplate(FMassEntityTemplateData& Modi
 	ModifiedTemplate.GetMutableTags().Remove(UE::ArsInstancedActors::GetDetailedLODTags());
 }
 
+UE::ArsInstancedActors::FSharedEntityTemplateKey UArsInstancedActorsData::MakeSharedEntityTemplateKey() const
+{
+	auto HashStruct = [](const UScriptStruct* Struct, const void* StructMemory) -> uint32
+		{
+			if (Struct == nullptr || StructMemory == nullptr)
+			{
+				return 0;
+			}
+			FArchiveCrc32 CrcArchive;
+			Struct->SerializeBin(CrcArchive, const_cast<void*>(StructMemory));
+			return CrcArchive.GetCrc();
+		};
+
+	const FArsInstancedActorsVisualizationDesc& DefaultVisualizationDesc = GetDefaultVisualizationChecked().VisualizationDesc;
+	const bool bShareEntityTemplate = UE::ArsInstancedActors::CVars::bShareEntityTemplates
+		&& GetManagerChecked().GetInstancedActorSubsystemChecked().CanShareEntityTemplates(ActorClass);
+
+	UE::ArsInstancedActors::FSharedEntityTemplateKey Key;
+	Key.InstanceDataClass = GetClass();
+	Key.ActorClass = ActorClass.Get();
+	Key.CombinedTags = CombinedTags;
+	Key.Settings = SharedSettings;
+	Key.VisualizationDesc = DefaultVisualizationDesc;
+	Key.SettingsHash = HashStruct(SharedSettings.GetScriptStruct(), SharedSettings.GetMemory());
+	Key.VisualizationHash = HashStruct(FArsInstancedActorsVisualizationDesc::StaticStruct(), &DefaultVisualizationDesc);
+	Key.UnsharedID = bShareEntityTemplate ? 0 : GetUniqueID();
+	return Key;
+}
+
+void UArsInstancedActorsData::CreateSharedInstancedActorDataStruct()
+{
+	FMassEntityManager& EntityManager = GetMassEntityManagerChecked();
+
+	FArsInstancedActorsDataSharedFragment ManagerSharedFragment;
+	ManagerSharedFragment.InstanceData = this;
+	FSharedStruct SubsystemFragment = EntityManager.GetOrCreateSharedFragment(ManagerSharedFragment);
+
+	FArsInstancedActorsDataSharedFragment* AsShared = SubsystemFragment.GetPtr<FArsInstancedActorsDataSharedFragment>();
+	if (ensure(AsShared))
+	{
+		// this can happen when we unload data and then stream it back again - we end up with the same path object, but different pointer.
+		// The old instance should be garbage now
+		if (AsShared->InstanceData != this)
+		{
+			ensure(AsShared->InstanceData.IsValid() == false);
+			AsShared->InstanceData = this;
+		}
+		
+		// we also need to make sure the bulk LOD is reset since the shared fragment can survive the death of the original 
+		// InstanceData while preserving the "runtime" value, which will mess up newly spawned entities.
+		AsShared->BulkLOD = EArsInstancedActorsBulkLOD::MAX;
+
+		SetSharedInstancedActorDataStruct(SubsystemFragment);
+
+		// Schedule for immediate bulk LOD evaluation, re-adding the shared fragment if Deinitialize previously unregistered it
+		GetManagerChecked().GetInstancedActorSubsystemChecked().RegisterSharedFragment(SubsystemFragment);
+	}
+}
+
 void UArsInstancedActorsData::ReleaseEntityTemplate()
 {
-	UWorld* World = GetWorld();
-	check(World);
+	// Note: The shared template is destroyed once the last IAD referencing it releases it @see FSharedEntityTemplate::~FSharedEntityTemplate
+	SharedEntityTemplate.Reset();
+	EntityTemplateID = FMassEntityTemplateID();
+}
 
-	EntityConfig.DestroyEntityTemplate(*World);
+void UArsInstancedActorsData::BeginPrepareSpawnEntities()
+{
+	check(!HasSpawnedEntities());
 
-	UMassSpawnerSubsystem* MassSpawnerSubsystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(World);
-	FMassEntityTemplateRegistry& TemplateRegistry = MassSpawnerSubsystem->GetMutableTemplateRegistryInstance();
-	TemplateRegistry.DestroyTemplate(EntityTemplateID);
+	CancelSpawnEntitiesPreparation();
+
+	if (NumValidInstances <= 0)
+	{
+		return;
+	}
+
+	SpawnPreparationTask = UE::Tasks::Launch(UE_SOURCE_LOCATION
+		, [Inputs = UE::ArsInstancedActors::Helpers::MakeSpawnEntitiesPreparationInputs(*this, InstanceDeltas.GetInstanceDeltas()), Preparation = &SpawnPreparation]()
+		{
+			UE::ArsInstancedActors::Helpers::PrepareSpawnEntities(Inputs, *Preparation);
+		});
+}
+
+bool UArsInstancedActorsData::IsSpawnEntitiesPreparationComplete() const
+{
+	return !SpawnPreparationTask.IsValid() || SpawnPreparationTask.IsCompleted();
+}
+
+void UArsInstancedActorsData::CancelSpawnEntitiesPreparation()
+{
+	if (SpawnPreparationTask.IsValid())
+	{
+		SpawnPreparationTask.Wait();
+		SpawnPreparationTask = UE::Tasks::FTask();
+	}
+	SpawnPreparation.Reset();
 }
 
 void UArsInstancedActorsData::SpawnEntities()
@@ -363,6 +702,7 @@ void UArsInstancedActorsData::SpawnEntities()
 	{
 		// Removal modifiers or offline instance removal may have simply invalidated all InstanceTransforms
 		// entries. Free up now-superfluous invalid instance transforms memory (and satisfy IsEmpty check in EndPlay)
+		CancelSpawnEntitiesPreparation();
 		InstanceTransforms.Empty();
 
 		return;
@@ -370,6 +710,7 @@ void UArsInstancedActorsData::SpawnEntities()
 
 	if (!ensureMsgf(EntityTemplateID.IsValid(), TEXT("No entity template generated for %s, skipping entity creation for these entities"), *ActorClass->GetPathName()))
 	{
+		CancelSpawnEntitiesPreparation();
 		return;
 	}
 
@@ -379,19 +720,52 @@ void UArsInstancedActorsData::SpawnEntities()
 	UMassSpawnerSubsystem* MassSpawnerSubsystem = World->GetSubsystem<UMassSpawnerSubsystem>();
 	check(MassSpawnerSubsystem);
 
+	// Complete spawn preparation, preparing inline if BeginPrepareSpawnEntities wasn't called or has since been cancelled
+	if (SpawnPreparationTask.IsValid())
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsData WaitForSpawnPreparation);
+		SpawnPreparationTask.Wait();
+		SpawnPreparationTask = UE::Tasks::FTask();
+	}
+	else
+	{
+		UE::ArsInstancedActors::Helpers::PrepareSpawnEntities(UE::ArsInstancedActors::Helpers::MakeSpawnEntitiesPreparationInputs(*this, InstanceDeltas.GetInstanceDeltas()), SpawnPreparation);
+	}
+
+	// Persisted destroyed instances are simply invalidated rather than spawned and then removed in ApplyInstanceDeltas
+	for (const FArsInstancedActorsInstanceIndex DestroyedInstance : SpawnPreparation.DestroyedInstances)
+	{
+		UE::ArsInstancedActors::Helpers::InvalidateInstanceTransform(InstanceTransforms[DestroyedInstance.GetIndex()]);
+		SpatialIndex.RemoveInstance(DestroyedInstance);
+	}
+	check(SpawnPreparation.InstanceIndices.Num() + SpawnPreparation.DestroyedInstances.Num() == NumValidInstances);
+	NumValidInstances = SpawnPreparation.InstanceIndices.Num();
+
+	// Build the spatial index and collision-only ISMC instances while we still have InstanceTransforms to build them from
+	GetOrBuildSpatialIndex();
+	SeedCollisionOnlyInstances(InstanceTransforms);
+
+	if (NumValidInstances <= 0)
+	{
+		SpawnPreparation.Reset();
+		InstanceTransforms.Empty();
+		return;
+	}
+
 	// Prepare slots for UArsInstancedActorsInitializerProcessor to place corresponding entity handles in.
 	// Note: We can't simply use SpawnEntities returned array directly, as we only spawn entities
 	//       to for `valid` InstanceTransforms. By letting UArsInstancedActorsInitializerProcessor store handles for
-	//       spawned entities into Entities as it uses valid transforms from InstanceTransforms, we end up with an
-	//       identically indexed Entities array, for things like DestroyedInstances to look up matching entities.
+	//       spawned entities into Entities using SpawnPreparation.InstanceIndices, we end up with an identically
+	//       indexed Entities array, for things like DestroyedInstances to look up matching entities.
 	Entities.Reset();
 	Entities.AddDefaulted(InstanceTransforms.Num());
 
 	FArsInstancedActorsMassSpawnData SpawnData;
 	SpawnData.InstanceData = this;
+	SpawnData.Preparation = &SpawnPreparation;
 
 	// Spawn entities
-	UE_LOG(LogArsInstancedActors, Verbose, TEXT("\t%s spawning %u entities"), *GetDebugName(/*bCompact*/ true), NumValidInstances);
+	UE_LOG(LogArsInstancedActors, Verbose, TEXT("\t%s spawning %d entities"), *GetDebugName(/*bCompact*/ true), NumValidInstances);
 	FConstStructView SpawnDataView = FConstStructView::Make(SpawnData);
 	TArray<FMassEntityHandle> SpawnedEntities;
 	MassSpawnerSubsystem->SpawnEntities(EntityTemplateID, NumValidInstances, SpawnDataView, UArsInstancedActorsInitializerProcessor::StaticClass(), SpawnedEntities);
@@ -400,7 +774,14 @@ void UArsInstancedActorsData::SpawnEntities()
 	checkSlow(Algo::CountIf(Entities, [](const auto& EntityHandle)
 		{ return EntityHandle.IsValid(); }) == NumValidInstances);
 
-	// Now we've seeded Mass entity locations, we can free up now-superfluous InstanceTransforms
+	// Now we've seeded Mass entity locations, we can free up now-superfluous InstanceTransforms and prepared data, 
+	// optionally retaining InstanceTransforms for DespawnEntities to restore from
+	SpawnPreparation.Reset();
+	DirtyInstanceTransforms.Reset();
+	if (UE::ArsInstancedActors::CVars::bRetainInstanceTransforms && !AreInstancesMovable())
+	{
+		RetainedInstanceTransforms = MoveTemp(InstanceTransforms);
+	}
 	InstanceTransforms.Empty();
 
 	if (UE::ArsInstancedActors::CVars::bUpdateNextTickTimeFragments)
@@ -443,7 +824,7 @@ void UArsInstancedActorsData::DespawnEntities()
 	const FTransform ManagerTransform = Manager.GetActorTransform();
 	const bool bApplyManagerTranslationOnly = (Manager.GetActorQuat().IsIdentity() && Manager.GetActorScale().Equals(FVector::OneVector));
 
-	// Reconstruct InstanceTransforms from Mass entity locations, just in case BeginPlay gets
+	// Reconstruct InstanceTransforms from Mass entity locations (or RetainedInstanceTransforms), just in case BeginPlay gets
 	// called again for this manager, which can happen with actor streaming.
 	//
 	// Note: Destroyed instances will not restore their transforms here but the initial array size and indexing will
@@ -451,64 +832,149 @@ void UArsInstancedActorsData::DespawnEntities()
 	//       If RemoveDestroyedInstanceEntities is called again, it will see the entities have already been removed
 	//       and simply skip them.
 	checkf(InstanceTransforms.IsEmpty(), TEXT("Expected %s InstanceTransforms to have been cleared after having seeding ISMCs in BeginPlay"), *GetDebugName());
-	checkf(NumInstances >= Entities.Num(), TEXT("%s has somehow gained more entities that it's source InstanceTransforms"), *GetDebugName());
-	InstanceTransforms.SetNumZeroed(NumInstances);
+	checkf(FMath::Max(NumInstances, NumAddedInstanceSlots) >= Entities.Num(), TEXT("%s has somehow gained more entities that it's source InstanceTransforms and runtime added instances"), *GetDebugName());
 	NumValidInstances = 0;
 
-	FMassEntityQuery InstancedActorLocationQuery(MassEntityManager.AsShared());
-	InstancedActorLocationQuery.AddRequirement<FArsInstancedActorsFragment>(EMassFragmentAccess::ReadOnly);
-	InstancedActorLocationQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
-
-	TArray<FMassArchetypeEntityCollection> EntityCollectionsToDestroy;
-	UE::Mass::Utils::CreateEntityCollections(MassEntityManager, Entities, FMassArchetypeEntityCollection::NoDuplicates, EntityCollectionsToDestroy);
+	// Runtime added instances are truncated here, restoring the cooked instance layout. They're re-added from InstanceDeltas
+	// in ApplyInstanceDeltas, be it via replication or persistence restoration.
+	NumAddedInstanceSlots = 0;
 
-	FMassExecutionContext ExecutionContext(MassEntityManager);
-	for (FMassArchetypeEntityCollection& Collection : EntityCollectionsToDestroy)
+	// Restore from transforms retained in SpawnEntities, only applying runtime changes
+	if (!RetainedInstanceTransforms.IsEmpty())
 	{
-		InstancedActorLocationQuery.ForEachEntityChunk(Collection, ExecutionContext, [this, &WorldToLocalTranslation, &ManagerTransform](FMassExecutionContext& Context)
+		TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsData RestoreRetainedInstanceTransforms);
+
+		check(RetainedInstanceTransforms.Num() >= NumInstances);
+		InstanceTransforms = MoveTemp(RetainedInstanceTransforms);
+		InstanceTransforms.SetNum(NumInstances);
+		RetainedInstanceTransforms.Empty();
+
+		// Invalidate instances whose entities have since been removed
+		for (int32 InstanceIndex = 0; InstanceIndex < InstanceTransforms.Num(); ++InstanceIndex)
+		{
+			if (Entities.IsValidIndex(InstanceIndex) && MassEntityManager.IsEntityValid(Entities[InstanceIndex]))
+			{
+				checkSlow(UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransforms[InstanceIndex]));
+				++NumValidInstances;
+			}
+			else
 			{
-				TConstArrayView<FArsInstancedActorsFragment> InstancedActorFragments = Context.GetFragmentView<FArsInstancedActorsFragment>();
-				TConstArrayView<FTransformFragment> TransformsList = Context.GetFragmentView<FTransformFragment>();
-				check(TransformsList.GetTypeSize() == sizeof(FTransform));
+				UE::ArsInstancedActors::Helpers::InvalidateInstanceTransform(InstanceTransforms[InstanceIndex]);
+			}
+		}
 
-				// Re-build InstanceTransforms, being careful to put transforms back into the right index it was created from
-				for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
-				{
-					FArsInstancedActorsInstanceIndex InstanceIndex = InstancedActorFragments[EntityIt].InstanceIndex;
-					InstanceTransforms[InstanceIndex.GetIndex()] = TransformsList[EntityIt].GetTransform();
+#if WITH_ARSINSTANCEDACTORS_DEBUG
+		// Catch moves that weren't reported via MarkInstanceTransformDirty, which would otherwise silently revert to their spawn 
+		// transforms here, having been missed by spatial queries whilst spawned
+		for (int32 InstanceIndex = 0; InstanceIndex < InstanceTransforms.Num(); ++InstanceIndex)
+		{
+			if (DirtyInstanceTransforms.Contains(InstanceIndex) || !Entities.IsValidIndex(InstanceIndex) || !MassEntityManager.IsEntityValid(Entities[InstanceIndex]))
+			{
+				continue;
+			}
 
-					checkf(UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransforms[InstanceIndex.GetIndex()]), TEXT("Found Mass entity with unexpected Scale 0 'invalid' transform"));
+			const FVector EntityLocation = FMassEntityView(MassEntityManager, Entities[InstanceIndex]).GetFragmentData<FTransformFragment>().GetTransform().GetLocation();
+			const FVector RetainedLocation = ManagerTransform.TransformPosition(InstanceTransforms[InstanceIndex].GetLocation());
+			if (!ensureMsgf(EntityLocation.Equals(RetainedLocation, /*Tolerance*/0.1)
+				, TEXT("%s instance %d was moved without MarkInstanceTransformDirty. Report moves, or set bMovableInstances in its settings if routinely moved.")
+				, *GetDebugName(), InstanceIndex))
+			{
+				DirtyInstanceTransforms.Add(InstanceIndex);
+			}
+		}
+#endif
 
-					++NumValidInstances;
+		// Read back transforms for remaining instances that have been moved at runtime
+		for (const int32 InstanceIndex : DirtyInstanceTransforms)
+		{
+			const FMassEntityHandle EntityHandle = (InstanceTransforms.IsValidIndex(InstanceIndex) && Entities.IsValidIndex(InstanceIndex)) ? Entities[InstanceIndex] : FMassEntityHandle();
+			if (MassEntityManager.IsEntityValid(EntityHandle))
+			{
+				FTransform& InstanceTransform = InstanceTransforms[InstanceIndex];
+				InstanceTransform = FMassEntityView(MassEntityManager, EntityHandle).GetFragmentData<FTransformFragment>().GetTransform();
+				checkf(UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransform), TEXT("Found Mass entity with unexpected Scale 0 'invalid' transform"));
+
+				if (bApplyManagerTranslationOnly)
+				{
+					InstanceTransform.AddToTranslation(WorldToLocalTranslation);
 				}
-			});
+				else
+				{
+					InstanceTransform.SetToRelativeTransform(ManagerTransform);
+				}
+			}
+		}
+		DirtyInstanceTransforms.Reset();
 
-		// Destroy all entities while we're going
-		MassEntityManager.BatchDestroyEntityChunks(Collection);
+		TArray<FMassArchetypeEntityCollection> EntityCollectionsToDestroy;
+		UE::Mass::Utils::CreateEntityCollections(MassEntityManager, Entities, FMassArchetypeEntityCollection::NoDuplicates, EntityCollectionsToDestroy);
+		MassEntityManager.BatchDestroyEntityChunks(EntityCollectionsToDestroy);
+		Entities.Reset();
 	}
-	Entities.Reset();
+	else
+	{
+		InstanceTransforms.SetNumZeroed(NumInstances);
 
-	checkSlow(NumValidInstances == Algo::CountIf(InstanceTransforms, [](const FTransform& InstanceTransform)
-		{ return UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransform); }));
+		FMassEntityQuery InstancedActorLocationQuery(MassEntityManager.AsShared());
+		InstancedActorLocationQuery.AddRequirement<FArsInstancedActorsFragment>(EMassFragmentAccess::ReadOnly);
+		InstancedActorLocationQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
 
-	// Convert gathered transforms back to local space
-	if (bApplyManagerTranslationOnly)
-	{
-		for (FTransform& InstanceTransform : InstanceTransforms)
+		TArray<FMassArchetypeEntityCollection> EntityCollectionsToDestroy;
+		UE::Mass::Utils::CreateEntityCollections(MassEntityManager, Entities, FMassArchetypeEntityCollection::NoDuplicates, EntityCollectionsToDestroy);
+
+		FMassExecutionContext ExecutionContext(MassEntityManager);
+		for (FMassArchetypeEntityCollection& Collection : EntityCollectionsToDestroy)
 		{
-			if (UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransform))
+			InstancedActorLocationQuery.ForEachEntityChunk(Collection, ExecutionContext, [this, &WorldToLocalTranslation, &ManagerTransform](FMassExecutionContext& Context)
+				{
+					TConstArrayView<FArsInstancedActorsFragment> InstancedActorFragments = Context.GetFragmentView<FArsInstancedActorsFragment>();
+					TConstArrayView<FTransformFragment> TransformsList = Context.GetFragmentView<FTransformFragment>();
+					check(TransformsList.GetTypeSize() == sizeof(FTransform));
+
+					// Re-build InstanceTransforms, being careful to put transforms back into the right index it was created from
+					for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
+					{
+						FArsInstancedActorsInstanceIndex InstanceIndex = InstancedActorFragments[EntityIt].InstanceIndex;
+						if (!InstanceTransforms.IsValidIndex(InstanceIndex.GetIndex()))
+						{
+							// Runtime added instance, truncated
+							continue;
+						}
+						InstanceTransforms[InstanceIndex.GetIndex()] = TransformsList[EntityIt].GetTransform();
+
+						checkf(UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransforms[InstanceIndex.GetIndex()]), TEXT("Found Mass entity with unexpected Scale 0 'invalid' transform"));
+
+						++NumValidInstances;
+					}
+				});
+
+			// Destroy all entities while we're going
+			MassEntityManager.BatchDestroyEntityChunks(Collection);
+		}
+		Entities.Reset();
+
+		checkSlow(NumValidInstances == Algo::CountIf(InstanceTransforms, [](const FTransform& InstanceTransform)
+			{ return UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransform); }));
+
+		// Convert gathered transforms back to local space
+		if (bApplyManagerTranslationOnly)
+		{
+			for (FTransform& InstanceTransform : InstanceTransforms)
 			{
-				InstanceTransform.AddToTranslation(WorldToLocalTranslation);
+				if (UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransform))
+				{
+					InstanceTransform.AddToTranslation(WorldToLocalTranslation);
+				}
 			}
 		}
-	}
-	else
-	{
-		for (FTransform& InstanceTransform : InstanceTransforms)
+		else
 		{
-			if (UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransform))
+			for (FTransform& InstanceTransform : InstanceTransforms)
 			{
-				InstanceTransform.SetToRelativeTransform(ManagerTransform);
+				if (UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransform))
+				{
+					InstanceTransform.SetToRelativeTransform(ManagerTransform);
+				}
 			}
 		}
 	}
@@ -535,6 +1001,11 @@ void UArsInstancedActorsData::DespawnEntities()
 	// Reregister & destroy runtime ISMCs
 	RemoveAllVisualizations();
 
+	// Instances may have been removed since the index was built. Rather than carry over removal flags, the index will
+	// simply be rebuilt from the restored InstanceTransforms on next use.
+	SpatialIndex.Reset();
+	bHasMovedInstances = false;
+
 	// Reset delta list, if this actor gets recycled on the server we'll get another persistence update restoring the deltas,
 	// if its recycled on the client, the network shadow state is the CDO state so we'll get this replicated again from fresh.
 	InstanceDeltas.Reset(/*bMarkDirty*/ false);
@@ -588,6 +1059,16 @@ int32 UArsInstancedActorsData::GetNumFreeInstances() const
 	return GetNumInstances() - NumValidInstances;
 }
 
+int32 UArsInstancedActorsData::GetMaxNumInstances() const
+{
+	return bWideInstanceIndices ? FArsInstancedActorsInstanceIndex::MaxWideIndex + 1 : FArsInstancedActorsInstanceIndex::MaxNarrowIndex + 1;
+}
+
+bool UArsInstancedActorsData::CanAddInstance() const
+{
+	return GetNumFreeInstances() > 0 || GetNumInstances() < GetMaxNumInstances();
+}
+
 bool UArsInstancedActorsData::IsValidInstance(const FArsInstancedActorsInstanceHandle& InstanceHandle) const
 {
 	if (HasSpawnedEntities())
@@ -600,6 +1081,59 @@ bool UArsInstancedActorsData::IsValidInstance(const FArsInstancedActorsInstanceH
 	}
 }
 
+bool UArsInstancedActorsData::GetInstanceLocation(const FArsInstancedActorsInstanceIndex InstanceIndex, FVector& OutLocation) const
+{
+	const int32 Index = InstanceIndex.GetIndex();
+
+	if (HasSpawnedEntities())
+	{
+		if (Entities.IsValidIndex(Index))
+		{
+			const FMassEntityManager& MassEntityManager = GetMassEntityManagerChecked();
+			if (MassEntityManager.IsEntityValid(Entities[Index]))
+			{
+				OutLocation = FMassEntityView(MassEntityManager, Entities[Index]).GetFragmentData<FTransformFragment>().GetTransform().GetLocation();
+				return true;
+			}
+		}
+
+		// Entity may have already been removed, fall back to the retained transform if we have one
+		if (RetainedInstanceTransforms.IsValidIndex(Index) && UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(RetainedInstanceTransforms[Index]))
+		{
+			OutLocation = GetManagerChecked().GetActorTransform().TransformPosition(RetainedInstanceTransforms[Index].GetLocation());
+			return true;
+		}
+	}
+	else if (InstanceTransforms.IsValidIndex(Index) && UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransforms[Index]))
+	{
+		OutLocation = GetManagerChecked().GetActorTransform().TransformPosition(InstanceTransforms[Index].GetLocation());
+		return true;
+	}
+
+	return false;
+}
+
+bool UArsInstancedActorsData::AreInstancesMovable() const
+{
+	const FArsInstancedActorsSettings* Settings = GetSettingsPtr<const FArsInstancedActorsSettings>();
+	return Settings && Settings->bMovableInstances;
+}
+
+void UArsInstancedActorsData::MarkInstanceTransformDirty(const FArsInstancedActorsInstanceIndex InstanceIndex)
+{
+	if (ensureMsgf(HasSpawnedEntities() && Entities.IsValidIndex(InstanceIndex.GetIndex()), TEXT("Attempting to mark invalid instance index %d dirty in %s"), InstanceIndex.GetIndex(), *GetDebugName()))
+	{
+		// The spatial index holds instance locations as of SpawnEntities, which no longer hold for this instance
+		bHasMovedInstances = true;
+
+		// Only needed when restoring from RetainedInstanceTransforms, otherwise all entity transforms are read back anyway
+		if (!RetainedInstanceTransforms.IsEmpty())
+		{
+			DirtyInstanceTransforms.Add(InstanceIndex.GetIndex());
+		}
+	}
+}
+
 #if WITH_EDITOR
 FArsInstancedActorsInstanceHandle UArsInstancedActorsData::AddInstance(const FTransform& Transform, const bool bWorldSpace)
 {
@@ -611,6 +1145,11 @@ FArsInstancedActorsInstanceHandle UArsInstancedActorsData::AddInstance(const FTr
 		return FArsInstancedActorsInstanceHandle();
 	}
 
+	if (!ensureMsgf(CanAddInstance(), TEXT("%s has reached it's maximum instance count (%d). Consider enabling bWideInstanceIndices"), *GetDebugName(), GetMaxNumInstances()))
+	{
+		return FArsInstancedActorsInstanceHandle();
+	}
+
 	// Do we have a free / invalid index to reuse?
 	int32 NewInstanceIndex = UE::ArsInstancedActors::CVars::bRecycleInvalidInstances ? InstanceTransforms.IndexOfByPredicate([](const FTransform& InstanceTransform)
 		{ return !UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransform); })
@@ -647,6 +1186,9 @@ FArsInstancedActorsInstanceHandle UArsInstancedActorsData::AddInstance(const FTr
 	ensure(CachedLocalBounds.IsValid);
 	Bounds += CachedLocalBounds.TransformBy(InstanceTransforms[NewInstanceIndex]);
 
+	// Instance layout changed, rebuild on next use
+	SpatialIndex.Reset();
+
 	return FArsInstancedActorsInstanceHandle(*this, FArsInstancedActorsInstanceIndex(NewInstanceIndex));
 }
 
@@ -656,6 +1198,7 @@ bool UArsInstancedActorsData::RemoveInstance(const FArsInstancedActorsInstanceHa
 	{
 		// Invalidate instance data by setting scale 0
 		UE::ArsInstancedActors::Helpers::InvalidateInstanceTransform(InstanceTransforms[InstanceToRemove.GetIndex()]);
+		SpatialIndex.RemoveInstance(InstanceToRemove.GetInstanceIndex());
 		--NumValidInstances;
 		check(NumValidInstances >= 0);
 
@@ -705,6 +1248,9 @@ bool UArsInstancedActorsData::SetInstanceTransform(const FArsInstancedActorsInst
 		InstanceTransforms[InstanceHandle.GetIndex()].SetToRelativeTransform(ManagerTransform);
 	}
 
+	// Instance layout changed, rebuild on next use
+	SpatialIndex.Reset();
+
 	// Update bounds
 	ensure(CachedLocalBounds.IsValid);
 	Bounds.Init();
@@ -760,6 +1306,34 @@ FMassEntityHandle UArsInstancedActorsData::GetEntity(FArsInstancedActorsInstance
 	return FMassEntityHandle();
 }
 
+const UE::ArsInstancedActors::FInstanceSpatialIndex* UArsInstancedActorsData::GetOrBuildSpatialIndex() const
+{
+	// Indexed locations are stale for moved instances, which could be missed by candidate gathering or wrongly reported present
+	// by FInstanceSpatialIndex::TestOccupancy, so fall back to testing every instance's current transform. Entity transform writes
+	// aren't tracked, so instances are only known to be where they were indexed if their settings declare them stationary.
+	if (bHasMovedInstances || AreInstancesMovable())
+	{
+		return nullptr;
+	}
+
+	if (SpatialIndex.IsBuilt())
+	{
+		return &SpatialIndex;
+	}
+
+	// Once entities have spawned we no longer have InstanceTransforms to build from
+	if (!UE::ArsInstancedActors::CVars::bEnableSpatialIndex || HasSpawnedEntities()
+		|| NumValidInstances < UE::ArsInstancedActors::CVars::SpatialIndexMinInstances)
+	{
+		return nullptr;
+	}
+
+	const AArsInstancedActorsManager& Manager = GetManagerChecked();
+	SpatialIndex.Build(InstanceTransforms, Manager.GetActorTransform(), CachedLocalBounds, UE::ArsInstancedActors::CVars::SpatialIndexTargetInstancesPerCell);
+
+	return SpatialIndex.IsBuilt() ? &SpatialIndex : nullptr;
+}
+
 void UArsInstancedActorsData::SetSharedInstancedActorDataStruct(FSharedStruct InSharedStruct)
 {
 	checkf(InSharedStruct.GetPtr<FArsInstancedActorsDataSharedFragment>(), TEXT("We expect only FArsInstancedActorsDataSharedFragment-base types here"));
@@ -809,6 +1383,119 @@ void UArsInstancedActorsData::PostLoad()
 	SetupLoadedInstances();
 }
 
+void UArsInstancedActorsData::Serialize(FArchive& Ar)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsData::Serialize);
+
+	Ar.UsingCustomVersion(FArsInstancedActorsCustomVersion::GUID);
+
+	// When cooking with IA.CookCompressedInstances, swap full precision InstanceTransforms out for the duration of
+	// property serialization so only CompressedInstanceTransforms make it into the cooked package.
+	bool bHasCompressedInstanceTransforms = !CompressedInstanceTransforms.IsEmpty();
+#if WITH_EDITOR
+	TArray<FTransform> FullPrecisionInstanceTransforms;
+	bool bCompressedForCook = false;
+	if (Ar.IsSaving() && Ar.IsCooking() && UE::ArsInstancedActors::CVars::bCookCompressedInstances && CompressInstanceTransformsForCook())
+	{
+		FullPrecisionInstanceTransforms = MoveTemp(InstanceTransforms);
+		InstanceTransforms.Reset();
+		bHasCompressedInstanceTransforms = true;
+		bCompressedForCook = true;
+	}
+#endif
+
+	Super::Serialize(Ar);
+
+	if (Ar.CustomVer(FArsInstancedActorsCustomVersion::GUID) >= FArsInstancedActorsCustomVersion::CompressedInstanceTransforms)
+	{
+		Ar << bHasCompressedInstanceTransforms;
+		if (bHasCompressedInstanceTransforms)
+		{
+			Ar << CompressedInstanceTransforms;
+		}
+	}
+
+	if (Ar.CustomVer(FArsInstancedActorsCustomVersion::GUID) >= FArsInstancedActorsCustomVersion::CookedSettings)
+	{
+#if WITH_EDITOR
+		if (Ar.IsSaving())
+		{
+			CookedSettings.Reset();
+			if (Ar.IsCooking() && UE::ArsInstancedActors::CVars::bCookBakedSettings)
+			{
+				if (const UWorld* World = GetWorld())
+				{
+					if (UArsInstancedActorsSubsystem* InstancedActorSubsystem = UE::ArsInstancedActors::Utils::GetArsInstancedActorsSubsystem(*World))
+					{
+						CookedSettings = InstancedActorSubsystem->CompileSettingsForCook(ActorClass);
+					}
+				}
+				UE_CLOG(!CookedSettings.IsValid(), LogArsInstancedActors, Verbose, TEXT("%s couldn't compile settings for cook, they'll be compiled at runtime"), *GetDebugName());
+			}
+		}
+#endif
+		bool bHasCookedSettings = CookedSettings.IsValid();
+		Ar << bHasCookedSettings;
+		if (bHasCookedSettings)
+		{
+			CookedSettings.Serialize(Ar);
+		}
+#if WITH_EDITOR
+		if (Ar.IsSaving())
+		{
+			CookedSettings.Reset();
+		}
+#endif
+	}
+
+#if WITH_EDITOR
+	if (bCompressedForCook)
+	{
+		InstanceTransforms = MoveTemp(FullPrecisionInstanceTransforms);
+		CompressedInstanceTransforms.Reset();
+	}
+#endif
+}
+
+void UArsInstancedActorsData::DecompressInstanceTransforms()
+{
+	if (CompressedInstanceTransforms.IsEmpty())
+	{
+		return;
+	}
+
+	checkf(InstanceTransforms.IsEmpty(), TEXT("%s has both compressed and uncompressed InstanceTransforms"), *GetDebugName());
+	CompressedInstanceTransforms.Decompress(InstanceTransforms);
+	check(InstanceTransforms.Num() == NumInstances);
+	CompressedInstanceTransforms.Reset();
+}
+
+#if WITH_EDITOR
+bool UArsInstancedActorsData::CompressInstanceTransformsForCook()
+{
+	if (NumValidInstances == 0 || !Bounds.IsValid)
+	{
+		return false;
+	}
+
+	UE::ArsInstancedActors::FTransformCompressionTolerances Tolerances;
+	Tolerances.MaxLocationError = UE::ArsInstancedActors::CVars::CompressedLocationError;
+	Tolerances.MaxRotationErrorDegrees = UE::ArsInstancedActors::CVars::CompressedRotationError;
+	Tolerances.MaxScaleError = UE::ArsInstancedActors::CVars::CompressedScaleError;
+
+	FString FailureReason;
+	if (!CompressedInstanceTransforms.Compress(InstanceTransforms, Tolerances, FailureReason))
+	{
+		UE_LOG(LogArsInstancedActors, Warning, TEXT("%s cooking uncompressed InstanceTransforms: %s"), *GetDebugName(), *FailureReason);
+		return false;
+	}
+
+	UE_LOG(LogArsInstancedActors, Verbose, TEXT("%s compressed %d InstanceTransforms from %llu to %llu bytes"), *GetDebugName(/*bCompact*/ true)
+		, InstanceTransforms.Num(), (uint64)InstanceTransforms.GetAllocatedSize(), (uint64)CompressedInstanceTransforms.GetAllocatedSize());
+	return true;
+}
+#endif // WITH_EDITOR
+
 void UArsInstancedActorsData::SetupLoadedInstances()
 {
 	if (bHasSetupLoadedInstances)
@@ -818,7 +1505,7 @@ void UArsInstancedActorsData::SetupLoadedInstances()
 	
 	bHasSetupLoadedInstances = true;
 	
-	NumInstances = InstanceTransforms.Num();
+	NumInstances = CompressedInstanceTransforms.IsEmpty() ? InstanceTransforms.Num() : CompressedInstanceTransforms.Num();
 
 	// Cache asset bounds
 	if (!CachedLocalBounds.IsValid)
@@ -829,6 +1516,9 @@ void UArsInstancedActorsData::SetupLoadedInstances()
 	
 	if (!Bounds.IsValid)
 	{
+		// Compressed instances are only ever cooked with valid Bounds
+		ensure(CompressedInstanceTransforms.IsEmpty());
+
 		// Update bounds for InstanceData saved prior to addition of Bounds property
 		if (NumValidInstances > 0)
 		{
@@ -866,8 +1556,6 @@ void UArsInstancedActorsData::SetupLoadedInstances()
 	}
 #endif
 
-	//check(CompressedInstanceTransforms.IsEmpty());
-
 	// Prepare instance delta list for replication and persistence
 	InstanceDeltas.Initialize(*this);
 
@@ -1000,11 +1688,15 @@ void UArsInstancedActorsData::GetLifetimeReplicatedProps(TArray<FLifetimePropert
 	RepParams.bIsPushBased = true;
 
 	DOREPLIFETIME_WITH_PARAMS_FAST(UArsInstancedActorsData, InstanceDeltas, RepParams);
+	DOREPLIFETIME_CONDITION(UArsInstancedActorsData, RuntimeCreationDesc, COND_InitialOnly);
 }
 
 #if UE_WITH_IRIS
 void UArsInstancedActorsData::RegisterReplicationFragments(UE::Net::FFragmentRegistrationContext& Context, UE::Net::EFragmentRegistrationFlags RegistrationFlags)
 {
+	// FArsInstancedActorsInstanceIndex has no Iris NetSerializer, only replicating via Iris' last resort serializer
+	ensureMsgf(!bWideInstanceIndices, TEXT("%s: Wide instance indices are unsupported with Iris replication"), *GetDebugName());
+
 	UE::Net::FReplicationFragmentUtil::CreateAndRegisterFragmentsForObject(this, Context, RegistrationFlags);
 }
 #endif
@@ -1037,6 +1729,50 @@ void UArsInstancedActorsData::RemoveInstanceLifecyclePhaseDelta(FArsInstancedAct
 	InstanceDeltas.RemoveLifecyclePhaseDelta(InstanceIndex);
 }
 
+void UArsInstancedActorsData::SetInstanceFragment(FArsInstancedActorsInstanceIndex InstanceIndex, FConstStructView Fragment)
+{
+	AArsInstancedActorsManager& Manager = GetManagerChecked();
+	check(Manager.HasAuthority());
+
+	const EArsInstancedActorsFragmentFlags FragmentFlags = UE::ArsInstancedActors::GetInstanceFragmentTypeFlags(Fragment.GetScriptStruct());
+	if (EnumHasAnyFlags(FragmentFlags, EArsInstancedActorsFragmentFlags::Replicated))
+	{
+		Manager.FlushNetDormancy();
+	}
+
+	InstanceDeltas.SetInstanceFragment(InstanceIndex, Fragment);
+
+	// Apply locally on authority. If entities haven't spawned yet, this will be applied in ApplyInstanceDeltas
+	if (HasSpawnedEntities() && Entities.IsValidIndex(InstanceIndex.GetIndex()))
+	{
+		UE::ArsInstancedActors::Helpers::ApplyInstanceFragment(GetMassEntityManagerChecked(), Entities[InstanceIndex.GetIndex()], Fragment);
+	}
+
+	if (EnumHasAnyFlags(FragmentFlags, EArsInstancedActorsFragmentFlags::Persisted))
+	{
+		Manager.RequestInstancePersistentDataSave(*this, InstanceIndex);
+	}
+}
+
+void UArsInstancedActorsData::RemoveInstanceFragment(FArsInstancedActorsInstanceIndex InstanceIndex, const UScriptStruct& FragmentType)
+{
+	AArsInstancedActorsManager& Manager = GetManagerChecked();
+	check(Manager.HasAuthority());
+
+	const EArsInstancedActorsFragmentFlags FragmentFlags = UE::ArsInstancedActors::GetInstanceFragmentTypeFlags(&FragmentType);
+	if (EnumHasAnyFlags(FragmentFlags, EArsInstancedActorsFragmentFlags::Replicated))
+	{
+		Manager.FlushNetDormancy();
+	}
+
+	InstanceDeltas.RemoveInstanceFragment(InstanceIndex, FragmentType);
+
+	if (EnumHasAnyFlags(FragmentFlags, EArsInstancedActorsFragmentFlags::Persisted))
+	{
+		Manager.RequestInstancePersistentDataSave(*this, InstanceIndex);
+	}
+}
+
 void UArsInstancedActorsData::RemoveInstanceLifecyclePhaseTimeElapsedDelta(FArsInstancedActorsInstanceIndex InstanceIndex)
 {
 	AArsInstancedActorsManager& Manager = GetManagerChecked();
@@ -1055,9 +1791,12 @@ void UArsInstancedActorsData::ApplyInstanceDeltas()
 	const TArray<FArsInstancedActorsDelta>& Deltas = InstanceDeltas.GetInstanceDeltas();
 
 #if WITH_ARSINSTANCEDACTORS_DEBUG
-	UE_LOG(LogArsInstancedActors, Verbose, TEXT("Applying %d instance deltas (D: %u, L: %u, LT: %u) to %s"), Deltas.Num(), InstanceDeltas.GetNumDestroyedInstanceDeltas(), InstanceDeltas.GetNumLifecyclePhaseDeltas(), InstanceDeltas.GetNumLifecyclePhaseTimeElapsedDeltas(), *GetDebugName());
+	UE_LOG(LogArsInstancedActors, Verbose, TEXT("Applying %d instance deltas (D: %d, L: %d, LT: %d) to %s"), Deltas.Num(), InstanceDeltas.GetNumDestroyedInstanceDeltas(), InstanceDeltas.GetNumLifecyclePhaseDeltas(), InstanceDeltas.GetNumLifecyclePhaseTimeElapsedDeltas(), *GetDebugName());
 #endif
 
+	// Instantiate runtime added instances first, so the remaining deltas can apply to them
+	InstantiateAddedInstanceDeltas(Deltas);
+
 	if (!HasSpawnedEntities())
 	{
 		// We may have received persistence deltas before deferred entity spawning has executed. In this case, we'll early out here and
@@ -1083,6 +1822,22 @@ void UArsInstancedActorsData::ApplyInstanceDeltas(TConstArrayView<int32> Instanc
 	UE_LOG(LogArsInstancedActors, Verbose, TEXT("Applying %d instance deltas to %s"), InstanceDeltaIndices.Num(), *GetDebugName());
 #endif
 
+	// Instantiate runtime added instances first, so the remaining deltas can apply to them
+	{
+		const TArray<FArsInstancedActorsDelta>& Deltas = InstanceDeltas.GetInstanceDeltas();
+		TArray<FArsInstancedActorsInstanceIndex> AddedInstanceIndices;
+		TArray<FTransform> AddedInstanceTransforms;
+		for (const int32 InstanceDeltaIndex : InstanceDeltaIndices)
+		{
+			if (Deltas.IsValidIndex(InstanceDeltaIndex) && Deltas[InstanceDeltaIndex].IsAdded())
+			{
+				AddedInstanceIndices.Add(Deltas[InstanceDeltaIndex].GetInstanceIndex());
+				AddedInstanceTransforms.Add(Deltas[InstanceDeltaIndex].GetAddedTransform());
+			}
+		}
+		InstantiateAddedInstances(AddedInstanceIndices, AddedInstanceTransforms);
+	}
+
 	if (!HasSpawnedEntities())
 	{
 		// Make sure this is only because we'll *never* spawn entities (otherwise we should have by now)
@@ -1104,6 +1859,23 @@ void UArsInstancedActorsData::ApplyInstanceDeltas(TConstArrayView<int32> Instanc
 	RuntimeRemoveInstances(MakeArrayView(EntitiesToRemove));
 }
 
+void UArsInstancedActorsData::InstantiateAddedInstanceDeltas(TConstArrayView<FArsInstancedActorsDelta> Deltas)
+{
+	TArray<FArsInstancedActorsInstanceIndex> AddedInstanceIndices;
+	TArray<FTransform> AddedInstanceTransforms;
+	for (const FArsInstancedActorsDelta& Delta : Deltas)
+	{
+		if (Delta.IsAdded())
+		{
+			AddedInstanceIndices.Add(Delta.GetInstanceIndex());
+			AddedInstanceTransforms.Add(Delta.GetAddedTransform());
+		}
+	}
+
+	// Already instantiated instances are skipped in InstantiateAddedInstances, so this is safe to call for repeat deltas
+	InstantiateAddedInstances(AddedInstanceIndices, AddedInstanceTransforms);
+}
+
 void UArsInstancedActorsData::RollbackInstanceDeltas(TConstArrayView<int32> InstanceDeltaIndices)
 {
 #if WITH_ARSINSTANCEDACTORS_DEBUG
@@ -1145,6 +1917,13 @@ void UArsInstancedActorsData::ApplyInstanceDelta(FMassEntityManager& EntityManag
 		{
 			OutEntitiesToRemove.Add(FArsInstancedActorsInstanceIndex(InstanceIndex));
 		}
+		else if (InstanceDelta.HasFragments())
+		{
+			InstanceDelta.ForEachFragment([&EntityManager, Entity](FConstStructView Fragment)
+				{
+					UE::ArsInstancedActors::Helpers::ApplyInstanceFragment(EntityManager, Entity, Fragment);
+				});
+		}
 	}
 }
 
@@ -1166,6 +1945,236 @@ void UArsInstancedActorsData::RollbackInstanceDelta(FMassEntityManager& EntityMa
 	}
 }
 
+TArray<FArsInstancedActorsInstanceHandle> UArsInstancedActorsData::AddRuntimeInstances(TConstArrayView<FTransform> Transforms, const bool bWorldSpace)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsData::AddRuntimeInstances);
+
+	TArray<FArsInstancedActorsInstanceHandle> AddedInstanceHandles;
+
+	AArsInstancedActorsManager& Manager = GetManagerChecked();
+	if (!ensureMsgf(Manager.HasAuthority(), TEXT("Runtime instance addition is authority only. Clients receive added instances via InstanceDeltas")))
+	{
+		return AddedInstanceHandles;
+	}
+
+	const int32 NumAddableInstances = FMath::Min(GetNumAddableRuntimeInstances(), Transforms.Num());
+	if (NumAddableInstances < Transforms.Num())
+	{
+		UE_LOG(LogArsInstancedActors, Warning, TEXT("%s can't address any more instances, skipping %d of %d runtime added instances")
+			, *GetDebugName(), Transforms.Num() - NumAddableInstances, Transforms.Num());
+	}
+
+	// New instances are always appended after cooked instances and prior additions, rather than recycling invalid instances,
+	// as those indices may still have persisted deltas
+	const int32 FirstInstanceIndex = GetNextRuntimeInstanceIndex();
+	const FTransform& ManagerTransform = Manager.GetActorTransform();
+
+	TArray<FArsInstancedActorsInstanceIndex> InstanceIndices;
+	TArray<FTransform> LocalTransforms;
+	InstanceIndices.Reserve(NumAddableInstances);
+	LocalTransforms.Reserve(NumAddableInstances);
+	for (int32 TransformIndex = 0; TransformIndex < NumAddableInstances; ++TransformIndex)
+	{
+		const FTransform& Transform = Transforms[TransformIndex];
+		if (!ensureMsgf(UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(Transform), TEXT("Transform must have a non-zero scale. Instanced Actors use Scale = 0 to denote invalid instances")))
+		{
+			continue;
+		}
+
+		InstanceIndices.Emplace(FirstInstanceIndex + InstanceIndices.Num());
+		FTransform& LocalTransform = LocalTransforms.Add_GetRef(Transform);
+		if (bWorldSpace)
+		{
+			LocalTransform.SetToRelativeTransform(ManagerTransform);
+		}
+	}
+
+	if (InstanceIndices.IsEmpty())
+	{
+		return AddedInstanceHandles;
+	}
+
+	InstantiateAddedInstances(InstanceIndices, LocalTransforms);
+
+	Manager.FlushNetDormancy();
+
+	AddedInstanceHandles.Reserve(InstanceIndices.Num());
+	for (int32 AddedIndex = 0; AddedIndex < InstanceIndices.Num(); ++AddedIndex)
+	{
+		// Replicate the addition to clients via InstanceDeltas
+		// Note: This is done after instantiation so the delta can cache the instance's location for relevancy
+		InstanceDeltas.SetInstanceAdded(InstanceIndices[AddedIndex], LocalTransforms[AddedIndex]);
+
+		Manager.RequestInstancePersistentDataSave(*this, InstanceIndices[AddedIndex]);
+
+		AddedInstanceHandles.Emplace(*this, InstanceIndices[AddedIndex]);
+	}
+
+	return AddedInstanceHandles;
+}
+
+int32 UArsInstancedActorsData::GetNumAddableRuntimeInstances() const
+{
+	int32 MaxNumInstances = GetMaxNumInstances();
+
+	const AArsInstancedActorsManager& Manager = GetManagerChecked();
+	if (Manager.IsCompositeInstanceIndexBitsFrozen())
+	{
+		// Spawned entities' actor instance handles encode composite indices, so the index width is fixed from first spawn on
+		MaxNumInstances = FMath::Min(MaxNumInstances, 1 << Manager.GetCompositeInstanceIndexBits());
+	}
+
+	return FMath::Max(MaxNumInstances - GetNextRuntimeInstanceIndex(), 0);
+}
+
+int32 UArsInstancedActorsData::GetNextRuntimeInstanceIndex() const
+{
+	return FMath::Max3(NumInstances, GetNumInstances(), NumAddedInstanceSlots);
+}
+
+void UArsInstancedActorsData::InstantiateAddedInstances(TConstArrayView<FArsInstancedActorsInstanceIndex> InstanceIndices, TConstArrayView<FTransform> LocalTransforms)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsData::InstantiateAddedInstances);
+
+	check(InstanceIndices.Num() == LocalTransforms.Num());
+	if (InstanceIndices.IsEmpty())
+	{
+		return;
+	}
+
+	AArsInstancedActorsManager& Manager = GetManagerChecked();
+	const FTransform& ManagerTransform = Manager.GetActorTransform();
+
+	int32 MaxInstanceIndex = INDEX_NONE;
+	for (const FArsInstancedActorsInstanceIndex InstanceIndex : InstanceIndices)
+	{
+		MaxInstanceIndex = FMath::Max(MaxInstanceIndex, InstanceIndex.GetIndex());
+	}
+
+	if (!ensureMsgf(Manager.FitCompositeInstanceIndexBits(MaxInstanceIndex)
+		, TEXT("%s: Added instance index %d can't be addressed by %s's %d bit composite instance indices, skipping instance addition")
+		, *GetDebugName(), MaxInstanceIndex, *Manager.GetName(), Manager.GetCompositeInstanceIndexBits()))
+	{
+		return;
+	}
+
+	NumAddedInstanceSlots = FMath::Max(NumAddedInstanceSlots, MaxInstanceIndex + 1);
+
+	// Added instances destroyed since are never instantiated, rather than instantiated and then removed by ApplyInstanceDeltas
+	auto IsDestroyedInstance = [this](const FArsInstancedActorsInstanceIndex InstanceIndex)
+		{
+			const FArsInstancedActorsDelta* InstanceDelta = InstanceDeltas.FindInstanceDelta(InstanceIndex);
+			return InstanceDelta && InstanceDelta->IsDestroyed();
+		};
+
+	FBox AddedInstanceBounds(ForceInit);
+
+	if (HasSpawnedEntities())
+	{
+		if (MaxInstanceIndex >= Entities.Num())
+		{
+			Entities.SetNum(MaxInstanceIndex + 1);
+		}
+
+		UE::ArsInstancedActors::FSpawnEntitiesPreparation AddedInstancesPreparation;
+		AddedInstancesPreparation.WorldTransforms.Reserve(InstanceIndices.Num());
+		AddedInstancesPreparation.InstanceIndices.Reserve(InstanceIndices.Num());
+		for (int32 AddedIndex = 0; AddedIndex < InstanceIndices.Num(); ++AddedIndex)
+		{
+			if (Entities[InstanceIndices[AddedIndex].GetIndex()].IsValid() || IsDestroyedInstance(InstanceIndices[AddedIndex]))
+			{
+				continue;
+			}
+
+			const FTransform& WorldTransform = AddedInstancesPreparation.WorldTransforms.Add_GetRef(LocalTransforms[AddedIndex] * ManagerTransform);
+			AddedInstancesPreparation.InstanceIndices.Add(InstanceIndices[AddedIndex]);
+			AddedInstanceBounds += CachedLocalBounds.TransformBy(WorldTransform);
+		}
+
+		const int32 NumAddedInstances = AddedInstancesPreparation.InstanceIndices.Num();
+		if (NumAddedInstances == 0)
+		{
+			return;
+		}
+
+		// The index can't be rebuilt without InstanceTransforms, so added instances are appended to it instead
+		if (SpatialIndex.IsBuilt())
+		{
+			SpatialIndex.AddInstances(AddedInstancesPreparation.InstanceIndices, AddedInstancesPreparation.WorldTransforms, CachedLocalBounds);
+		}
+
+		if (HasCollisionOnlyISMComponents())
+		{
+			TArray<FTransform> AddedLocalTransforms;
+			AddedLocalTransforms.Reserve(NumAddedInstances);
+			for (const FTransform& WorldTransform : AddedInstancesPreparation.WorldTransforms)
+			{
+				AddedLocalTransforms.Add(WorldTransform.GetRelativeTransform(ManagerTransform));
+			}
+			UpdateCollisionOnlyInstances(AddedInstancesPreparation.InstanceIndices, AddedLocalTransforms);
+		}
+
+		UMassSpawnerSubsystem* MassSpawnerSubsystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(GetWorld());
+		check(MassSpawnerSubsystem);
+
+		FArsInstancedActorsMassSpawnData SpawnData;
+		SpawnData.InstanceData = this;
+		SpawnData.Preparation = &AddedInstancesPreparation;
+
+		UE_LOG(LogArsInstancedActors, Verbose, TEXT("\t%s spawning %d runtime added entities"), *GetDebugName(/*bCompact*/ true), NumAddedInstances);
+		TArray<FMassEntityHandle> SpawnedEntities;
+		MassSpawnerSubsystem->SpawnEntities(EntityTemplateID, NumAddedInstances, FConstStructView::Make(SpawnData), UArsInstancedActorsInitializerProcessor::StaticClass(), SpawnedEntities);
+		check(SpawnedEntities.Num() == NumAddedInstances);
+
+		NumValidInstances += NumAddedInstances;
+	}
+	else
+	{
+		// Spawn preparation holds a view of InstanceTransforms, which we're about to modify
+		CancelSpawnEntitiesPreparation();
+
+		// Persistence may be restored before Initialize, make sure cooked instances are in place before appending to them
+		DecompressInstanceTransforms();
+
+		if (MaxInstanceIndex >= InstanceTransforms.Num())
+		{
+			const int32 FirstNewIndex = InstanceTransforms.Num();
+			InstanceTransforms.SetNumUninitialized(MaxInstanceIndex + 1);
+			for (int32 NewIndex = FirstNewIndex; NewIndex < InstanceTransforms.Num(); ++NewIndex)
+			{
+				UE::ArsInstancedActors::Helpers::InvalidateInstanceTransform(InstanceTransforms[NewIndex]);
+			}
+		}
+
+		for (int32 AddedIndex = 0; AddedIndex < InstanceIndices.Num(); ++AddedIndex)
+		{
+			FTransform& InstanceTransform = InstanceTransforms[InstanceIndices[AddedIndex].GetIndex()];
+			if (UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(InstanceTransform) || IsDestroyedInstance(InstanceIndices[AddedIndex]))
+			{
+				continue;
+			}
+
+			InstanceTransform = LocalTransforms[AddedIndex];
+			AddedInstanceBounds += CachedLocalBounds.TransformBy(InstanceTransform * ManagerTransform);
+			++NumValidInstances;
+		}
+
+		// Instance layout changed, rebuild on next use
+		SpatialIndex.Reset();
+
+		// This IAD had nothing to spawn when the manager spawned entities, so spawn now
+		if (Manager.HasSpawnedEntities())
+		{
+			SpawnEntities();
+		}
+	}
+
+	if (AddedInstanceBounds.IsValid)
+	{
+		Manager.OnRuntimeInstancesAdded(AddedInstanceBounds);
+	}
+}
+
 void UArsInstancedActorsData::RuntimeRemoveInstances(TConstArrayView<FArsInstancedActorsInstanceIndex> InstancesToRemove)
 {
 	if (InstancesToRemove.IsEmpty())
@@ -1196,8 +2205,11 @@ void UArsInstancedActorsData::RuntimeRemoveInstances(TConstArrayView<FArsInstanc
 					EntitiesToDestroy.Add(EntityToRemove);
 					EntityToRemove.Reset();
 				}
+				SpatialIndex.RemoveInstance(InstanceToRemove);
 			}
 		}
+		RemoveCollisionOnlyInstances(InstancesToRemove);
+
 		TArray<FMassArchetypeEntityCollection> EntityCollectionsToDestroy;
 		UE::Mass::Utils::CreateEntityCollections(MassEntityManager, EntitiesToDestroy, FMassArchetypeEntityCollection::NoDuplicates, EntityCollectionsToDestroy);
 
@@ -1208,17 +2220,21 @@ void UArsInstancedActorsData::RuntimeRemoveInstances(TConstArrayView<FArsInstanc
 	// Pre-empt entity spawning and simply invalidate InstanceTransform entries, preventing them from spawning later
 	else
 	{
-		uint16 InstancedRemoved = 0;
+		// Any prepared spawn data is now stale
+		CancelSpawnEntitiesPreparation();
+
+		int32 InstancedRemoved = 0;
 		for (FArsInstancedActorsInstanceIndex InstanceToRemove : InstancesToRemove)
 		{
 			if (ensure(InstanceTransforms.IsValidIndex(InstanceToRemove.GetIndex())))
 			{
 				UE::ArsInstancedActors::Helpers::InvalidateInstanceTransform(InstanceTransforms[InstanceToRemove.GetIndex()]);
+				SpatialIndex.RemoveInstance(InstanceToRemove);
 				++InstancedRemoved;
 			}
 		}
 		
-		NumValidInstances = FMath::Clamp(NumValidInstances - InstancedRemoved, 0u, NumValidInstances);
+		NumValidInstances = FMath::Clamp(NumValidInstances - InstancedRemoved, 0, NumValidInstances);
 	}
 
 	bRemovingInstances = false;
@@ -1245,10 +2261,15 @@ void UArsInstancedActorsData::RuntimeRemoveAllInstances()
 
 		// Zero out all entity handles to 'reset' them
 		FMemory::Memzero(Entities.GetData(), Entities.GetTypeSize() * Entities.Num());
+
+		ClearCollisionOnlyInstances();
 	}
 	// Pre-empt entity spawning and simply invalidate InstanceTransform entries, preventing them from spawning later
 	else
 	{
+		// Any prepared spawn data is now stale
+		CancelSpawnEntitiesPreparation();
+
 		for (FTransform& InstanceTransform : InstanceTransforms)
 		{
 			UE::ArsInstancedActors::Helpers::InvalidateInstanceTransform(InstanceTransform);
@@ -1256,6 +2277,8 @@ void UArsInstancedActorsData::RuntimeRemoveAllInstances()
 		NumValidInstances = 0;
 	}
 
+	SpatialIndex.RemoveAllInstances();
+
 	bRemovingInstances = false;
 }
 
@@ -1446,11 +2469,31 @@ AActor* UArsInstancedActorsData::UnlinkActor(FArsInstancedActorsInstanceIndex In
 
 uint8 UArsInstancedActorsData::AllocateVisualization()
 {
-	// Reuse free or create new InstanceVisualizations entry
-	int32 AllocatedVisualizationIndex = InstanceVisualizationAllocationFlags.FindAndSetFirstZeroBit();
-	if (AllocatedVisualizationIndex == INDEX_NONE)
+	// Reuse free or create new InstanceVisualizations entry, skipping pooled entries
+	int32 AllocatedVisualizationIndex = INDEX_NONE;
+	for (int32 VisualizationIndex = 0; VisualizationIndex < InstanceVisualizationAllocationFlags.Num(); ++VisualizationIndex)
 	{
-		AllocatedVisualizationIndex = InstanceVisualizations.AddDefaulted();
+		if (!InstanceVisualizationAllocationFlags[VisualizationIndex]
+			&& !PooledVisualizations.ContainsByPredicate([VisualizationIndex](const TPair<uint8, double>& PooledVisualization) { return PooledVisualization.Key == VisualizationIndex; }))
+		{
+			AllocatedVisualizationIndex = VisualizationIndex;
+			InstanceVisualizationAllocationFlags[VisualizationIndex] = true;
+			break;
+		}
+	}
+
+	// Out of indices, release the longest pooled entry for reuse
+	if (AllocatedVisualizationIndex == INDEX_NONE && InstanceVisualizations.Num() >= TNumericLimits<uint8>::Max() && !PooledVisualizations.IsEmpty())
+	{
+		AllocatedVisualizationIndex = PooledVisualizations[0].Key;
+		PooledVisualizations.RemoveAt(0);
+		ReleaseVisualization(static_cast<uint8>(AllocatedVisualizationIndex));
+		InstanceVisualizationAllocationFlags[AllocatedVisualizationIndex] = true;
+	}
+
+	if (AllocatedVisualizationIndex == INDEX_NONE)
+	{
+		AllocatedVisualizationIndex = InstanceVisualizations.AddDefaulted();
 		InstanceVisualizationAllocationFlags.Add(true);
 
 		checkf(AllocatedVisualizationIndex < TNumericLimits<uint8>::Max(), TEXT("No more than UINT8_MAX - 1 InstanceVisualizations can be defined for a single UArsInstancedActorsData as uint8 is used to index InstanceVisualizations and UINT8_MAX is reserved for invalid index"));
@@ -1474,11 +2517,27 @@ void UArsInstancedActorsData::InitializeVisualization(uint8 AllocatedVisualizati
 	// Copy descriptor
 	NewVisualization.VisualizationDesc = VisualizationDesc;
 
-	// Create ISMC's for descriptor
 	AArsInstancedActorsManager& Manager = GetManagerChecked();
+
+	// Headless servers only need collision, which instances keep from the default visualization's ISMCs regardless of
+	// visualization switches, so they don't create any for additional visualizations
+	if (Manager.IsHeadlessServer() && AllocatedVisualizationIndex != 0)
+	{
+		return;
+	}
+
+	// Create ISMC's for descriptor
 	Manager.CreateISMComponents(NewVisualization.VisualizationDesc, SharedSettings, NewVisualization.ISMComponents);
 	Manager.RegisterInstanceDatasComponents(*this, NewVisualization.ISMComponents);
 
+	// Headless server ISMCs are collision-only, so aren't registered with Mass representation which would otherwise manage
+	// their instances and render state. Their instances are instead added in SpawnEntities, @see SeedCollisionOnlyInstances
+	if (Manager.IsHeadlessServer())
+	{
+		INC_DWORD_STAT_BY(STAT_RegisteredISMs, NewVisualization.ISMComponents.Num());
+		return;
+	}
+
 	// Register ISMC's with Mass & update their culling settings
 	if (NewVisualization.ISMComponents.Num() >= 1)
 	{
@@ -1502,16 +2561,181 @@ void UArsInstancedActorsData::InitializeVisualization(uint8 AllocatedVisualizati
 	}
 }
 
-uint8 UArsInstancedActorsData::AddVisualization(FArsInstancedActorsVisualizationDesc& InOutVisualizationDesc)
+bool UArsInstancedActorsData::HasCollisionOnlyISMComponents() const
 {
-	// Reuse free or create new InstanceVisualizations entry
-	uint8 NewVisualizationIndex = AllocateVisualization();
+	const AArsInstancedActorsManager* Manager = GetManager();
+	return Manager && Manager->IsHeadlessServer() && InstanceVisualizations.IsValidIndex(0) && !InstanceVisualizations[0].ISMComponents.IsEmpty();
+}
+
+void UArsInstancedActorsData::SeedCollisionOnlyInstances(TConstArrayView<FTransform> LocalTransforms)
+{
+	if (!HasCollisionOnlyISMComponents())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsData SeedCollisionOnlyInstances);
+
+	// Trailing invalid instances need no placeholders, as nothing follows them to keep indexed
+	int32 NumSeededInstances = LocalTransforms.Num();
+	while (NumSeededInstances > 0 && !UE::ArsInstancedActors::Helpers::IsValidInstanceTransform(LocalTransforms[NumSeededInstances - 1]))
+	{
+		--NumSeededInstances;
+	}
+	const TConstArrayView<FTransform> SeededTransforms = LocalTransforms.Left(NumSeededInstances);
+
+	FTransform InvalidTransform;
+	UE::ArsInstancedActors::Helpers::InvalidateInstanceTransform(InvalidTransform);
 
+	for (UInstancedStaticMeshComponent* ISMComponent : InstanceVisualizations[0].ISMComponents)
+	{
+		if (!ensure(IsValid(ISMComponent)))
+		{
+			continue;
+		}
+
+		if (ISMComponent->GetInstanceCount() == 0)
+		{
+			ISMComponent->AddInstances(TArray<FTransform>(SeededTransforms.GetData(), SeededTransforms.Num()), /*bShouldReturnIndices*/false, /*bWorldSpace*/false);
+			continue;
+		}
+
+		// Only touch instances that differ, leaving unchanged instance bodies in place
+		for (int32 InstanceIndex = 0; InstanceIndex < ISMComponent->GetInstanceCount(); ++InstanceIndex)
+		{
+			const FTransform& SeededTransform = SeededTransforms.IsValidIndex(InstanceIndex) ? SeededTransforms[InstanceIndex] : InvalidTransform;
+			FTransform CurrentTransform;
+			if (ISMComponent->GetInstanceTransform(InstanceIndex, CurrentTransform, /*bWorldSpace*/false) && !CurrentTransform.Equals(SeededTransform))
+			{
+				ISMComponent->UpdateInstanceTransform(InstanceIndex, SeededTransform, /*bWorldSpace*/false, /*bMarkRenderStateDirty*/false, /*bTeleport*/true);
+			}
+		}
+		if (SeededTransforms.Num() > ISMComponent->GetInstanceCount())
+		{
+			const TConstArrayView<FTransform> AppendedTransforms = SeededTransforms.RightChop(ISMComponent->GetInstanceCount());
+			ISMComponent->AddInstances(TArray<FTransform>(AppendedTransforms.GetData(), AppendedTransforms.Num()), /*bShouldReturnIndices*/false, /*bWorldSpace*/false);
+		}
+	}
+}
+
+void UArsInstancedActorsData::ClearCollisionOnlyInstances()
+{
+	if (!HasCollisionOnlyISMComponents())
+	{
+		return;
+	}
+
+	for (UInstancedStaticMeshComponent* ISMComponent : InstanceVisualizations[0].ISMComponents)
+	{
+		if (ensure(IsValid(ISMComponent)))
+		{
+			ISMComponent->ClearInstances();
+		}
+	}
+}
+
+void UArsInstancedActorsData::UpdateCollisionOnlyInstances(TConstArrayView<FArsInstancedActorsInstanceIndex> InstanceIndices, TConstArrayView<FTransform> LocalTransforms)
+{
+	check(InstanceIndices.Num() == LocalTransforms.Num());
+	if (!HasCollisionOnlyISMComponents())
+	{
+		return;
+	}
+
+	FTransform InvalidTransform;
+	UE::ArsInstancedActors::Helpers::InvalidateInstanceTransform(InvalidTransform);
+
+	for (UInstancedStaticMeshComponent* ISMComponent : InstanceVisualizations[0].ISMComponents)
+	{
+		if (!ensure(IsValid(ISMComponent)))
+		{
+			continue;
+		}
+
+		for (int32 Index = 0; Index < InstanceIndices.Num(); ++Index)
+		{
+			const int32 InstanceIndex = InstanceIndices[Index].GetIndex();
+			while (ISMComponent->GetInstanceCount() < InstanceIndex)
+			{
+				ISMComponent->AddInstance(InvalidTransform, /*bWorldSpace*/false);
+			}
+
+			if (InstanceIndex == ISMComponent->GetInstanceCount())
+			{
+				ISMComponent->AddInstance(LocalTransforms[Index], /*bWorldSpace*/false);
+			}
+			else
+			{
+				ISMComponent->UpdateInstanceTransform(InstanceIndex, LocalTransforms[Index], /*bWorldSpace*/false, /*bMarkRenderStateDirty*/false, /*bTeleport*/true);
+			}
+		}
+	}
+}
+
+void UArsInstancedActorsData::RemoveCollisionOnlyInstances(TConstArrayView<FArsInstancedActorsInstanceIndex> InstanceIndices)
+{
+	if (!HasCollisionOnlyISMComponents())
+	{
+		return;
+	}
+
+	// Zero scaling rather than removing instances keeps later instances' indices, and their instance bodies, in place
+	FTransform InvalidTransform;
+	UE::ArsInstancedActors::Helpers::InvalidateInstanceTransform(InvalidTransform);
+
+	for (UInstancedStaticMeshComponent* ISMComponent : InstanceVisualizations[0].ISMComponents)
+	{
+		if (!ensure(IsValid(ISMComponent)))
+		{
+			continue;
+		}
+
+		for (const FArsInstancedActorsInstanceIndex InstanceIndex : InstanceIndices)
+		{
+			if (InstanceIndex.GetIndex() < ISMComponent->GetInstanceCount())
+			{
+				ISMComponent->UpdateInstanceTransform(InstanceIndex.GetIndex(), InvalidTransform, /*bWorldSpace*/false, /*bMarkRenderStateDirty*/false, /*bTeleport*/true);
+			}
+		}
+	}
+}
+
+AActor* UArsInstancedActorsData::GetExemplarOrClassDefaultActor() const
+{
 	if (ExemplarActorData.IsValid() && ExemplarActorData->Actor)
 	{
-		GetManagerChecked().GetInstancedActorSubsystemChecked().ModifyVisualDescriptionForActor(TNotNull<AActor*>(ExemplarActorData->Actor.Get()), InOutVisualizationDesc);
+		return ExemplarActorData->Actor.Get();
+	}
+
+	// Initialized from class defaults, @see IA.ExemplarActors.UseClassDefaults
+	if (UE::ArsInstancedActors::CVars::bUseClassDefaultsForExemplars && ActorClass)
+	{
+		return ActorClass->GetDefaultObject<AActor>();
+	}
+
+	return nullptr;
+}
+
+uint8 UArsInstancedActorsData::AddVisualization(FArsInstancedActorsVisualizationDesc& InOutVisualizationDesc)
+{
+	if (AActor* ExemplarActor = GetExemplarOrClassDefaultActor())
+	{
+		GetManagerChecked().GetInstancedActorSubsystemChecked().ModifyVisualDescriptionForActor(TNotNull<AActor*>(ExemplarActor), InOutVisualizationDesc);
 	}
 
+	// Revive a matching pooled visualization, with its ISMCs and Mass registration still intact
+	const int32 PoolIndex = FindPooledVisualization(InOutVisualizationDesc);
+	if (PoolIndex != INDEX_NONE)
+	{
+		const uint8 PooledVisualizationIndex = PooledVisualizations[PoolIndex].Key;
+		PooledVisualizations.RemoveAt(PoolIndex);
+		InstanceVisualizationAllocationFlags[PooledVisualizationIndex] = true;
+		return PooledVisualizationIndex;
+	}
+
+	// Reuse free or create new InstanceVisualizations entry
+	uint8 NewVisualizationIndex = AllocateVisualization();
+
 	// Init new visualization
 	InitializeVisualization(NewVisualizationIndex, InOutVisualizationDesc);
 
@@ -1539,41 +2763,125 @@ uint8 UArsInstancedActorsData::AddVisualizationAsync(const FArsInstancedActorsSo
 		uint8 ReservedVisualizationIndex = AllocateVisualization();
 
 		check(InstanceVisualizations.IsValidIndex(ReservedVisualizationIndex));
-		FArsInstancedActorsVisualizationInfo& ReservedVisualization = InstanceVisualizations[ReservedVisualizationIndex];
+		InstanceVisualizations[ReservedVisualizationIndex].bAsyncLoading = true;
 
-		TWeakObjectPtr<UArsInstancedActorsSubsystem> WeakArsInstancedActorsSubsystem = GetManagerChecked().GetInstancedActorSubsystem();
+		UArsInstancedActorsSubsystem& ArsInstancedActorsSubsystem = GetManagerChecked().GetInstancedActorSubsystemChecked();
 
-		// Async load assets and complete initialization when load completes
-		ReservedVisualization.AssetLoadHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(VisualizationAssetsToLoad, FStreamableDelegate::CreateWeakLambda(this, [this, SoftVisualizationDesc, ReservedVisualizationIndex, WeakArsInstancedActorsSubsystem]()
+		// Render a placeholder until the load completes. Modified as per the final visualization, so ISMCs line up when swapping meshes in
+		// OnVisualizationAssetsLoaded.
+		if (UStaticMesh* PlaceholderMesh = ArsInstancedActorsSubsystem.GetVisualizationLoadPlaceholderMesh())
+		{
+			FArsInstancedActorsVisualizationDesc PlaceholderVisualizationDesc = SoftVisualizationDesc.ToPlaceholderVisualizationDesc(*PlaceholderMesh);
+			if (AActor* ExemplarActor = GetExemplarOrClassDefaultActor())
 			{
-				// Check visualization is still allocated
-				if (!ensure(InstanceVisualizations.IsValidIndex(ReservedVisualizationIndex)))
-				{
-					return;
-				}
-				check(InstanceVisualizationAllocationFlags.IsValidIndex(ReservedVisualizationIndex));
-				if (!ensure(InstanceVisualizationAllocationFlags[ReservedVisualizationIndex] == true))
+				ArsInstancedActorsSubsystem.ModifyVisualDescriptionForActor(TNotNull<AActor*>(ExemplarActor), PlaceholderVisualizationDesc);
+			}
+			InitializeVisualization(ReservedVisualizationIndex, PlaceholderVisualizationDesc);
+
+			// Placeholder meshes shouldn't be collided with, collision is enabled in ApplyLoadedVisualization along with the final meshes
+			for (UInstancedStaticMeshComponent* ISMComponent : InstanceVisualizations[ReservedVisualizationIndex].ISMComponents)
+			{
+				if (ensure(IsValid(ISMComponent)))
 				{
-					return;
+					AArsInstancedActorsManager::SetInstanceCollisionEnabled(*ISMComponent, /*bEnable*/false);
 				}
-				FArsInstancedActorsVisualizationInfo& Visualization = InstanceVisualizations[ReservedVisualizationIndex];
+			}
+		}
 
-				// Resolve hard visualization description
-				FArsInstancedActorsVisualizationDesc VisualizationDesc(SoftVisualizationDesc);
+		// Queue the load, shared with any other requests for the same assets, completing initialization in OnVisualizationAssetsLoaded
+		ArsInstancedActorsSubsystem.RequestVisualizationLoad(*this, ReservedVisualizationIndex, SoftVisualizationDesc);
 
-				if (WeakArsInstancedActorsSubsystem.IsValid() && ExemplarActorData.IsValid() && ExemplarActorData->Actor)
-				{
-					WeakArsInstancedActorsSubsystem->ModifyVisualDescriptionForActor(TNotNull<AActor*>(ExemplarActorData->Actor.Get()), VisualizationDesc);
-				}
+		return ReservedVisualizationIndex;
+	}
+}
+
+void UArsInstancedActorsData::OnVisualizationAssetsLoaded(const uint8 VisualizationIndex, const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc)
+{
+	// Check visualization is still allocated and awaiting this load
+	if (!ensure(InstanceVisualizations.IsValidIndex(VisualizationIndex)))
+	{
+		return;
+	}
+	check(InstanceVisualizationAllocationFlags.IsValidIndex(VisualizationIndex));
+	if (!ensure(InstanceVisualizationAllocationFlags[VisualizationIndex] == true) || !ensure(InstanceVisualizations[VisualizationIndex].IsAsyncLoading()))
+	{
+		return;
+	}
 
-				// Init reserved visualization
-				InitializeVisualization(ReservedVisualizationIndex, VisualizationDesc);
+	// Resolve hard visualization description
+	FArsInstancedActorsVisualizationDesc VisualizationDesc(SoftVisualizationDesc);
 
-				Visualization.AssetLoadHandle.Reset(); 
-			}));
+	if (AActor* ExemplarActor = GetExemplarOrClassDefaultActor())
+	{
+		GetManagerChecked().GetInstancedActorSubsystemChecked().ModifyVisualDescriptionForActor(TNotNull<AActor*>(ExemplarActor), VisualizationDesc);
+	}
 
-		return ReservedVisualizationIndex;
+	FArsInstancedActorsVisualizationInfo& Visualization = InstanceVisualizations[VisualizationIndex];
+	if (Visualization.MassStaticMeshDescHandle.IsValid())
+	{
+		// Swap placeholder meshes in place, keeping the ISMCs and their settings
+		ApplyLoadedVisualization(VisualizationIndex, VisualizationDesc);
+	}
+	else
+	{
+		// Init reserved visualization
+		InitializeVisualization(VisualizationIndex, VisualizationDesc);
 	}
+
+	Visualization.bAsyncLoading = false;
+}
+
+void UArsInstancedActorsData::ApplyLoadedVisualization(const uint8 VisualizationIndex, const FArsInstancedActorsVisualizationDesc& VisualizationDesc)
+{
+	check(InstanceVisualizations.IsValidIndex(VisualizationIndex));
+	FArsInstancedActorsVisualizationInfo& Visualization = InstanceVisualizations[VisualizationIndex];
+	AArsInstancedActorsManager& Manager = GetManagerChecked();
+
+	ensureMsgf(Visualization.ISMComponents.Num() == VisualizationDesc.ISMComponentDescriptors.Num(), TEXT("%s InstanceVisualizations[%d] loaded %d ISMC descriptors but has %d placeholder ISMCs. Unmatched descriptors won't be rendered.")
+		, *GetDebugName(), VisualizationIndex, VisualizationDesc.ISMComponentDescriptors.Num(), Visualization.ISMComponents.Num());
+
+	const int32 NumISMComponents = FMath::Min(Visualization.ISMComponents.Num(), VisualizationDesc.ISMComponentDescriptors.Num());
+	for (int32 ISMComponentIndex = 0; ISMComponentIndex < NumISMComponents; ++ISMComponentIndex)
+	{
+		UInstancedStaticMeshComponent* ISMComponent = Visualization.ISMComponents[ISMComponentIndex];
+		if (!ensure(IsValid(ISMComponent)))
+		{
+			continue;
+		}
+
+		const FISMComponentDescriptor& ISMComponentDescriptor = VisualizationDesc.ISMComponentDescriptors[ISMComponentIndex];
+		ISMComponent->SetStaticMesh(ISMComponentDescriptor.StaticMesh);
+		ISMComponent->EmptyOverrideMaterials();
+		for (int32 MaterialIndex = 0; MaterialIndex < ISMComponentDescriptor.OverrideMaterials.Num(); ++MaterialIndex)
+		{
+			ISMComponent->SetMaterial(MaterialIndex, ISMComponentDescriptor.OverrideMaterials[MaterialIndex]);
+		}
+		ISMComponent->SetOverlayMaterial(ISMComponentDescriptor.OverlayMaterial);
+		ISMComponent->RuntimeVirtualTextures = ISMComponentDescriptor.RuntimeVirtualTextures;
+		ISMComponent->MarkRenderStateDirty();
+
+		AArsInstancedActorsManager::SetInstanceCollisionEnabled(*ISMComponent, Manager.ShouldEnableInstanceCollision());
+	}
+
+	Visualization.VisualizationDesc = VisualizationDesc;
+
+	// Re-register the ISMCs with Mass under the loaded description, replacing the placeholder's. The new description is added
+	// first, so the ISMCs stay registered throughout, then entities are moved over before the placeholder's is removed.
+	UArsInstancedActorsRepresentationSubsystem* RepresentationSubsystem = UWorld::GetSubsystem<UArsInstancedActorsRepresentationSubsystem>(Manager.GetWorld());
+	check(RepresentationSubsystem);
+	const FStaticMeshInstanceVisualizationDescHandle PlaceholderStaticMeshDescHandle = Visualization.MassStaticMeshDescHandle;
+	const FStaticMeshInstanceVisualizationDescHandle LoadedStaticMeshDescHandle = RepresentationSubsystem->AddVisualDescWithISMComponents(VisualizationDesc.ToMassVisualizationDesc(), Visualization.ISMComponents);
+	if (ensureMsgf(LoadedStaticMeshDescHandle.IsValid(), TEXT("Couldn't register loaded instance visual description for %s InstanceVisualizations[%d], keeping placeholder's"), *GetDebugName(), VisualizationIndex))
+	{
+		Visualization.MassStaticMeshDescHandle = LoadedStaticMeshDescHandle;
+		if (HasSpawnedEntities())
+		{
+			RepresentationSubsystem->RetargetStaticMeshDesc(GetMassEntityManagerChecked(), Entities, PlaceholderStaticMeshDescHandle, LoadedStaticMeshDescHandle);
+		}
+		RepresentationSubsystem->RemoveVisualDesc(PlaceholderStaticMeshDescHandle);
+	}
+
+	UpdateCullDistance();
 }
 
 void UArsInstancedActorsData::ForEachVisualization(TFunctionRef<bool(uint8 /*VisualizationIndex*/, const FArsInstancedActorsVisualizationInfo& /*Visualization*/)> InFunction, const bool bSkipAsyncLoadingVisualizations) const
@@ -1601,24 +2909,57 @@ void UArsInstancedActorsData::ForEachVisualization(TFunctionRef<bool(uint8 /*Vis
 
 void UArsInstancedActorsData::SwitchInstanceVisualization(FArsInstancedActorsInstanceIndex InstanceToSwitch, uint8 NewVisualizationIndex)
 {
-	if (!ensure(InstanceVisualizations.IsValidIndex(NewVisualizationIndex)) || !ensure(Entities.IsValidIndex(InstanceToSwitch.GetIndex())))
+	SwitchInstanceVisualizations(MakeArrayView(&InstanceToSwitch, 1), NewVisualizationIndex);
+}
+
+void UArsInstancedActorsData::SwitchInstanceVisualizations(TConstArrayView<FArsInstancedActorsInstanceIndex> InstancesToSwitch, uint8 NewVisualizationIndex)
+{
+	if (!ensure(InstanceVisualizations.IsValidIndex(NewVisualizationIndex)))
 	{
 		return;
 	}
 
 	FMassEntityManager& MassEntityManager = GetMassEntityManagerChecked();
-	const FMassEntityHandle& EntityHandle = Entities[InstanceToSwitch.GetIndex()];
-	if (!ensure(MassEntityManager.IsEntityValid(EntityHandle)))
+
+	TArray<FMassEntityHandle, TInlineAllocator<16>> EntitiesToSwitch;
+	EntitiesToSwitch.Reserve(InstancesToSwitch.Num());
+	for (const FArsInstancedActorsInstanceIndex InstanceToSwitch : InstancesToSwitch)
+	{
+		if (!ensure(Entities.IsValidIndex(InstanceToSwitch.GetIndex())))
+		{
+			continue;
+		}
+
+		const FMassEntityHandle& EntityHandle = Entities[InstanceToSwitch.GetIndex()];
+		if (ensure(MassEntityManager.IsEntityValid(EntityHandle)))
+		{
+			EntitiesToSwitch.Add(EntityHandle);
+		}
+	}
+
+	if (EntitiesToSwitch.IsEmpty())
 	{
 		return;
 	}
 
 	const FArsInstancedActorsVisualizationInfo& NewVisualization = InstanceVisualizations[NewVisualizationIndex];
 
-	FArsInstancedActorsMeshSwitchFragment MeshSwitchFragment;
-	MeshSwitchFragment.NewStaticMeshDescHandle = NewVisualization.MassStaticMeshDescHandle;
+	if (UE::ArsInstancedActors::CVars::bBatchVisualizationSwitches)
+	{
+		UArsInstancedActorsRepresentationSubsystem* RepresentationSubsystem = UWorld::GetSubsystem<UArsInstancedActorsRepresentationSubsystem>(GetWorld());
+		check(RepresentationSubsystem);
+		RepresentationSubsystem->RequestVisualizationSwitches(EntitiesToSwitch, NewVisualization.MassStaticMeshDescHandle);
+	}
+	else
+	{
+		FArsInstancedActorsMeshSwitchFragment MeshSwitchFragment;
+		MeshSwitchFragment.NewStaticMeshDescHandle = NewVisualization.MassStaticMeshDescHandle;
 
-	MassEntityManager.Defer().PushCommand<FMassCommandAddFragmentInstances>(EntityHandle, MeshSwitchFragment);
+		for (const FMassEntityHandle EntityHandle : EntitiesToSwitch)
+		{
+			MassEntityManager.Defer().PushCommand<FMassCommandAddFragmentInstances>(EntityHandle, MeshSwitchFragment);
+		}
+	}
 }
 
 void UArsInstancedActorsData::RemoveVisualization(uint8 VisualizationIndex)
@@ -1635,24 +2976,53 @@ void UArsInstancedActorsData::RemoveVisualization(uint8 VisualizationIndex)
 		return;
 	}
 
+	// Pool fully initialized visualizations, deferring their ISMC destruction, in case they're re-added shortly after (e.g: by
+	// lifecycle phase changes). Visualizations that are still loading have nothing worth pooling.
+	const FArsInstancedActorsVisualizationInfo& RemovedVisualization = InstanceVisualizations[VisualizationIndex];
+	UWorld* World = GetWorld();
+	if (UE::ArsInstancedActors::CVars::VisualizationPoolReleaseDelay > 0.0f && VisualizationIndex != 0 && World
+		&& !RemovedVisualization.IsAsyncLoading() && RemovedVisualization.MassStaticMeshDescHandle.IsValid())
+	{
+		InstanceVisualizationAllocationFlags[VisualizationIndex] = false;
+		PooledVisualizations.Emplace(VisualizationIndex, World->GetTimeSeconds() + UE::ArsInstancedActors::CVars::VisualizationPoolReleaseDelay);
+
+		if (PooledVisualizations.Num() == 1)
+		{
+			GetManagerChecked().GetInstancedActorSubsystemChecked().RequestPooledVisualizationsRelease(*this);
+		}
+		return;
+	}
+
+	ReleaseVisualization(VisualizationIndex);
+}
+
+void UArsInstancedActorsData::ReleaseVisualization(uint8 VisualizationIndex)
+{
+	check(InstanceVisualizations.IsValidIndex(VisualizationIndex));
 	FArsInstancedActorsVisualizationInfo& RemovedVisualization = InstanceVisualizations[VisualizationIndex];
 
 	// Cancel async loading
-	if (RemovedVisualization.AssetLoadHandle.IsValid())
+	if (RemovedVisualization.IsAsyncLoading())
 	{
-		RemovedVisualization.AssetLoadHandle->CancelHandle();
-		RemovedVisualization.AssetLoadHandle.Reset();
+		if (UArsInstancedActorsSubsystem* ArsInstancedActorsSubsystem = GetManagerChecked().GetInstancedActorSubsystem())
+		{
+			ArsInstancedActorsSubsystem->CancelVisualizationLoad(*this, VisualizationIndex);
+		}
+		RemovedVisualization.bAsyncLoading = false;
 	}
 
-	// Deregister ISMCs from Mass and destroy
-	if (RemovedVisualization.MassStaticMeshDescHandle.IsValid())
+	// Deregister ISMCs from Mass and destroy. Note: Collision-only ISMCs were never registered with Mass
+	if (RemovedVisualization.MassStaticMeshDescHandle.IsValid() || !RemovedVisualization.ISMComponents.IsEmpty())
 	{
 		AArsInstancedActorsManager& Manager = GetManagerChecked();
-		UWorld* World = Manager.GetWorld();
-		check(World);
-		UArsInstancedActorsRepresentationSubsystem* RepresentationSubsystem = World->GetSubsystem<UArsInstancedActorsRepresentationSubsystem>();
-		check(RepresentationSubsystem);
-		RepresentationSubsystem->RemoveVisualDesc(RemovedVisualization.MassStaticMeshDescHandle);
+		if (RemovedVisualization.MassStaticMeshDescHandle.IsValid())
+		{
+			UWorld* World = Manager.GetWorld();
+			check(World);
+			UArsInstancedActorsRepresentationSubsystem* RepresentationSubsystem = World->GetSubsystem<UArsInstancedActorsRepresentationSubsystem>();
+			check(RepresentationSubsystem);
+			RepresentationSubsystem->RemoveVisualDesc(RemovedVisualization.MassStaticMeshDescHandle);
+		}
 
 		for (UInstancedStaticMeshComponent* ISMComponent : RemovedVisualization.ISMComponents)
 		{
@@ -1671,11 +3041,46 @@ void UArsInstancedActorsData::RemoveVisualization(uint8 VisualizationIndex)
 	InstanceVisualizationAllocationFlags[VisualizationIndex] = false;
 }
 
+int32 UArsInstancedActorsData::FindPooledVisualization(const FArsInstancedActorsVisualizationDesc& VisualizationDesc) const
+{
+	for (int32 PoolIndex = 0; PoolIndex < PooledVisualizations.Num(); ++PoolIndex)
+	{
+		if (InstanceVisualizations[PooledVisualizations[PoolIndex].Key].VisualizationDesc == VisualizationDesc)
+		{
+			return PoolIndex;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool UArsInstancedActorsData::ReleaseExpiredPooledVisualizations(const double CurrentTime)
+{
+	// Pooled in removal order with a fixed delay, so expired visualizations are always at the front
+	int32 NumExpired = 0;
+	while (NumExpired < PooledVisualizations.Num() && PooledVisualizations[NumExpired].Value <= CurrentTime)
+	{
+		ReleaseVisualization(PooledVisualizations[NumExpired].Key);
+		++NumExpired;
+	}
+	PooledVisualizations.RemoveAt(0, NumExpired, EAllowShrinking::No);
+
+	return !PooledVisualizations.IsEmpty();
+}
+
 void UArsInstancedActorsData::RemoveAllVisualizations()
 {
-	for (uint8 VisualizationIndex = 0; VisualizationIndex < InstanceVisualizations.Num(); ++VisualizationIndex)
+	for (const TPair<uint8, double>& PooledVisualization : PooledVisualizations)
 	{
-		RemoveVisualization(VisualizationIndex);
+		ReleaseVisualization(PooledVisualization.Key);
+	}
+	PooledVisualizations.Reset();
+
+	for (int32 VisualizationIndex = 0; VisualizationIndex < InstanceVisualizations.Num(); ++VisualizationIndex)
+	{
+		if (InstanceVisualizationAllocationFlags[VisualizationIndex])
+		{
+			ReleaseVisualization(static_cast<uint8>(VisualizationIndex));
+		}
 	}
 	check(!InstanceVisualizationAllocationFlags.Contains(true));
 
@@ -1696,7 +3101,7 @@ void UArsInstancedActorsData::DestroyInstance(FArsInstancedActorsInstanceIndex I
 		// Remove instance locally on authority
 		RuntimeRemoveInstances(MakeArrayView(&InstanceToDestroy, 1));
 
-		Manager.RequestPersistentDataSave();
+		Manager.RequestInstancePersistentDataSave(*this, InstanceToDestroy);
 	}
 	else
 	{
@@ -1771,6 +3176,66 @@ bool UArsInstancedActorsData::OnInstancedActorMoved(AActor& MovedActor, const FM
 	return false;
 }
 
+void UArsInstancedActorsData::OnInstancedActorHydrationChanged(const FMassEntityHandle EntityHandle, const bool bHydrated)
+{
+	if (!HasCollisionOnlyISMComponents())
+	{
+		return;
+	}
+
+	// Skip removed instances, whose entity handles are reset before their entities and actors are destroyed
+	FArsInstancedActorsInstanceIndex InstanceIndex = GetInstanceIndexForEntity(EntityHandle);
+	if (!InstanceIndex.IsValid() || GetEntityHandleForIndex(InstanceIndex) != EntityHandle)
+	{
+		return;
+	}
+
+	if (bHydrated)
+	{
+		RemoveCollisionOnlyInstances(MakeArrayView(&InstanceIndex, 1));
+		return;
+	}
+
+	// Actors released whilst removing instances mustn't restore their collision
+	if (bRemovingInstances)
+	{
+		return;
+	}
+
+	FMassEntityManager& EntityManager = GetMassEntityManagerChecked();
+	if (!EntityManager.IsEntityValid(EntityHandle))
+	{
+		return;
+	}
+
+	const FTransformFragment* TransformFragment = EntityManager.GetFragmentDataPtr<FTransformFragment>(EntityHandle);
+	if (ensure(TransformFragment))
+	{
+		const FTransform LocalTransform = TransformFragment->GetTransform().GetRelativeTransform(GetManagerChecked().GetActorTransform());
+		UpdateCollisionOnlyInstances(MakeArrayView(&InstanceIndex, 1), MakeArrayView(&LocalTransform, 1));
+	}
+}
+
+void UArsInstancedActorsData::OnInstancedActorHydrationChanged(const AActor& Actor, const bool bHydrated)
+{
+	const UArsInstancedActorsComponent* InstancedActorComponent = Actor.FindComponentByClass<UArsInstancedActorsComponent>();
+	if (InstancedActorComponent == nullptr)
+	{
+		return;
+	}
+
+	const FMassEntityHandle EntityHandle = InstancedActorComponent->GetMassEntityHandle();
+	if (!EntityHandle.IsValid())
+	{
+		return;
+	}
+
+	if (UArsInstancedActorsData* InstanceData = GetInstanceDataForEntity(InstancedActorComponent->GetMassEntityManagerChecked(), EntityHandle))
+	{
+		InstanceData->OnInstancedActorHydrationChanged(EntityHandle, bHydrated);
+	}
+}
+
 void UArsInstancedActorsData::OnPersistentDataRestored()
 {
 	// AArsInstancedActorsManager::SerializeInstancePersistenceData will have restored the InstanceDeltas list and replicated that
@@ -1780,9 +3245,23 @@ void UArsInstancedActorsData::OnPersistentDataRestored()
 
 void UArsInstancedActorsData::OnRep_InstanceDeltas(TConstArrayView<int32> UpdatedInstanceDeltaIndices)
 {
+	// Instance deltas may be received ahead of OnRep_RuntimeCreationDesc, so make sure runtime created IADs are registered first
+	if (IsRuntimeCreated())
+	{
+		GetManagerChecked().OnRuntimeInstanceDataReplicated(*this);
+	}
+
 	ApplyInstanceDeltas(UpdatedInstanceDeltaIndices);
 }
 
+void UArsInstancedActorsData::OnRep_RuntimeCreationDesc()
+{
+	if (IsRuntimeCreated())
+	{
+		GetManagerChecked().OnRuntimeInstanceDataReplicated(*this);
+	}
+}
+
 void UArsInstancedActorsData::OnRep_PreRemoveInstanceDeltas(TConstArrayView<int32> RemovedInstanceDeltaIndices)
 {
 	RollbackInstanceDeltas(RemovedInstanceDeltaIndices);
@@ -1790,6 +3269,12 @@ void UArsInstancedActorsData::OnRep_PreRemoveInstanceDeltas(TConstArrayView<int3
 
 int32 UArsInstancedActorsData::GetEntityIndexFromCollisionIndex(const UInstancedStaticMeshComponent& ISMComponent, const int32 CollisionIndex) const
 {
+	// Collision-only ISMC instances are indexed by instance index, without any Mass ISMC data to map through
+	if (HasCollisionOnlyISMComponents())
+	{
+		return Entities.IsValidIndex(CollisionIndex) && Entities[CollisionIndex].IsValid() ? CollisionIndex : INDEX_NONE;
+	}
+
 	const UArsInstancedActorsRepresentationSubsystem* RepresentationSubsystem = UWorld::GetSubsystem<UArsInstancedActorsRepresentationSubsystem>(GetWorld());
 	if (!ensure(RepresentationSubsystem))
 	{
@@ -0,0 +1,126 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#include "ArsInstancedActorsISMComponent.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Engine/World.h"
+
+
+void UArsInstancedActorsISMComponent::CreatePhysicsStateWithPendingInstanceBodies()
+{
+	if (!IsRegistered() || IsPhysicsStateCreated())
+	{
+		return;
+	}
+
+	// UInstancedStaticMeshComponent only creates instance bodies given a body setup, so hide it for the duration
+	{
+		TGuardValue<bool> SuppressBodySetupGuard(bSuppressBodySetup, true);
+		CreatePhysicsState(/*bAllowDeferral=*/false);
+	}
+
+	if (IsPhysicsStateCreated())
+	{
+		// Null instance bodies are expected by UInstancedStaticMeshComponent, e.g: for zero scaled instances, and are filled in
+		// by instance transform updates as well as CreatePendingInstanceBodies
+		InstanceBodies.SetNumZeroed(PerInstanceSMData.Num());
+		NextPendingInstanceBodyIndex = 0;
+		bHasPendingInstanceBodies = !InstanceBodies.IsEmpty();
+	}
+}
+
+int32 UArsInstancedActorsISMComponent::CreatePendingInstanceBodies(const int32 MaxBodies)
+{
+	if (!bHasPendingInstanceBodies)
+	{
+		return 0;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsISMComponent CreatePendingInstanceBodies);
+
+	if (!IsPhysicsStateCreated() || GetBodySetup() == nullptr)
+	{
+		bHasPendingInstanceBodies = false;
+		return 0;
+	}
+
+	UBodySetup* BodySetup = GetBodySetup();
+	const bool bBatchStaticBodies = Mobility != EComponentMobility::Movable;
+
+	// Static instance bodies are gathered and added to the physics scene in one batch via FBodyInstance::InitStaticBodies, as
+	// UInstancedStaticMeshComponent::CreateAllInstanceBodies does, rather than one InitInstanceBody scene addition per body
+	TArray<FBodyInstance*> StaticBodies;
+	TArray<FTransform> StaticBodyTransforms;
+
+	int32 NumBodiesCreated = 0;
+	while (NumBodiesCreated < MaxBodies)
+	{
+		NextPendingInstanceBodyIndex = FindMissingInstanceBody(NextPendingInstanceBodyIndex);
+		if (NextPendingInstanceBodyIndex == INDEX_NONE)
+		{
+			// Instances removed whilst bodies were pending shift later instances down, possibly behind NextPendingInstanceBodyIndex,
+			// so check once more from the start before finishing
+			NextPendingInstanceBodyIndex = FindMissingInstanceBody(0);
+			if (NextPendingInstanceBodyIndex == INDEX_NONE)
+			{
+				bHasPendingInstanceBodies = false;
+				NextPendingInstanceBodyIndex = 0;
+				break;
+			}
+		}
+
+		FBodyInstance* InstanceBody = new FBodyInstance();
+		if (bBatchStaticBodies)
+		{
+			InstanceBody->CopyBodyInstancePropertiesFrom(&BodyInstance);
+			InstanceBody->InstanceBodyIndex = NextPendingInstanceBodyIndex;
+			InstanceBody->bAutoWeld = false;
+			InstanceBody->bSimulatePhysics = false;
+
+			StaticBodies.Add(InstanceBody);
+			StaticBodyTransforms.Add(FTransform(PerInstanceSMData[NextPendingInstanceBodyIndex].Transform) * GetComponentTransform());
+		}
+		else
+		{
+			InitInstanceBody(NextPendingInstanceBodyIndex, InstanceBody);
+		}
+		InstanceBodies[NextPendingInstanceBodyIndex] = InstanceBody;
+		++NextPendingInstanceBodyIndex;
+		++NumBodiesCreated;
+	}
+
+	if (!StaticBodies.IsEmpty())
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsISMComponent InitStaticBodies);
+		FBodyInstance::InitStaticBodies(MoveTemp(StaticBodies), MoveTemp(StaticBodyTransforms), BodySetup, this, GetWorld()->GetPhysicsScene());
+	}
+
+	return NumBodiesCreated;
+}
+
+int32 UArsInstancedActorsISMComponent::FindMissingInstanceBody(const int32 StartIndex) const
+{
+	const int32 NumInstances = FMath::Min(InstanceBodies.Num(), PerInstanceSMData.Num());
+	for (int32 InstanceIndex = StartIndex; InstanceIndex < NumInstances; ++InstanceIndex)
+	{
+		if (InstanceBodies[InstanceIndex] == nullptr && !PerInstanceSMData[InstanceIndex].Transform.GetScaleVector().IsNearlyZero())
+		{
+			return InstanceIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+UBodySetup* UArsInstancedActorsISMComponent::GetBodySetup()
+{
+	return bSuppressBodySetup ? nullptr : Super::GetBodySetup();
+}
+
+void UArsInstancedActorsISMComponent::OnDestroyPhysicsState()
+{
+	bHasPendingInstanceBodies = false;
+	NextPendingInstanceBodyIndex = 0;
+
+	Super::OnDestroyPhysicsState();
+}
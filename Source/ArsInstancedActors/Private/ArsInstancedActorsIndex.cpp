@@ -3,6 +3,8 @@
 #include "ArsInstancedActorsIndex.h"
 #include "ArsInstancedActorsManager.h"
 #include "ArsInstancedActorsData.h"
+#include "ArsInstancedActorsCustomVersion.h"
+#include "Serialization/CustomVersion.h"
 
 
 FArsInstancedActorsInstanceHandle::FArsInstancedActorsInstanceHandle(UArsInstancedActorsData& InInstancedActorData, FArsInstancedActorsInstanceIndex InIndex)
@@ -11,6 +13,96 @@ FArsInstancedActorsInstanceHandle::FArsInstancedActorsInstanceHandle(UArsInstanc
 {
 }
 
+namespace UE::ArsInstancedActors::Private
+{
+	// Loads a pre-FArsInstancedActorsCustomVersion::WideInstanceIndices 16-bit index, where MAX_uint16 denoted INDEX_NONE
+	int32 NarrowToWideInstanceIndex(const uint16 NarrowIndex)
+	{
+		return NarrowIndex == MAX_uint16 ? INDEX_NONE : int32(NarrowIndex);
+	}
+
+	uint16 WideToNarrowInstanceIndex(const int32 WideIndex)
+	{
+		checkf(WideIndex <= FArsInstancedActorsInstanceIndex::MaxNarrowIndex, TEXT("Instance index %d can't be stored in a narrow 16-bit instance index"), WideIndex);
+		return WideIndex == INDEX_NONE ? MAX_uint16 : uint16(WideIndex);
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FArsInstancedActorsInstanceIndex& InstanceIndex)
+{
+	Ar.UsingCustomVersion(FArsInstancedActorsCustomVersion::GUID);
+
+	if (Ar.IsLoading() && Ar.CustomVer(FArsInstancedActorsCustomVersion::GUID) < FArsInstancedActorsCustomVersion::WideInstanceIndices)
+	{
+		uint16 NarrowIndex = MAX_uint16;
+		Ar << NarrowIndex;
+		InstanceIndex.Index = UE::ArsInstancedActors::Private::NarrowToWideInstanceIndex(NarrowIndex);
+	}
+	else
+	{
+		Ar << InstanceIndex.Index;
+	}
+	return Ar;
+}
+
+void operator<<(FStructuredArchive::FSlot Slot, FArsInstancedActorsInstanceIndex& InstanceIndex)
+{
+	FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
+	UnderlyingArchive.UsingCustomVersion(FArsInstancedActorsCustomVersion::GUID);
+
+	const bool bWide = !UnderlyingArchive.IsLoading() || UnderlyingArchive.CustomVer(FArsInstancedActorsCustomVersion::GUID) >= FArsInstancedActorsCustomVersion::WideInstanceIndices;
+	FArsInstancedActorsInstanceIndex::SerializeWithWidth(Slot, InstanceIndex, bWide);
+}
+
+void FArsInstancedActorsInstanceIndex::SerializeWithWidth(FStructuredArchive::FSlot Slot, FArsInstancedActorsInstanceIndex& InstanceIndex, const bool bWide)
+{
+	if (bWide)
+	{
+		Slot << InstanceIndex.Index;
+	}
+	else
+	{
+		uint16 NarrowIndex = Slot.GetUnderlyingArchive().IsLoading() ? MAX_uint16 : UE::ArsInstancedActors::Private::WideToNarrowInstanceIndex(InstanceIndex.Index);
+		Slot << NarrowIndex;
+		InstanceIndex.Index = UE::ArsInstancedActors::Private::NarrowToWideInstanceIndex(NarrowIndex);
+	}
+}
+
+bool FArsInstancedActorsInstanceIndex::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// Offset by one so INDEX_NONE packs to 0
+	uint32 PackedIndex = uint32(Index + 1);
+	Ar.SerializeIntPacked(PackedIndex);
+	if (Ar.IsLoading())
+	{
+		Index = int32(PackedIndex) - 1;
+		bOutSuccess = (Index >= INDEX_NONE) && (Index <= MaxWideIndex);
+	}
+	else
+	{
+		bOutSuccess = true;
+	}
+	return true;
+}
+
+void FArsInstancedActorsInstanceIndex::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsSaving())
+	{
+		// Tagged property saves don't otherwise record our version, which loads need to tell 32-bit indices from converted 16-bit ones
+		const_cast<FArchive&>(Ar).UsingCustomVersion(FArsInstancedActorsCustomVersion::GUID);
+	}
+	else if (Ar.IsLoading() && Index == MAX_uint16)
+	{
+		// A 16-bit Index property converts to int32 as is, turning the narrow INDEX_NONE sentinel into 65535
+		const FCustomVersion* CustomVersion = Ar.GetCustomVersions().GetVersion(FArsInstancedActorsCustomVersion::GUID);
+		if (CustomVersion == nullptr || CustomVersion->Version < FArsInstancedActorsCustomVersion::WideInstanceIndices)
+		{
+			Index = INDEX_NONE;
+		}
+	}
+}
+
 FString FArsInstancedActorsInstanceIndex::GetDebugName() const
 {
 	return FString::Printf(TEXT("%d"), Index);
@@ -7,6 +7,7 @@
 #include "ArsInstancedActorsData.h"
 
 #include "MassCommonFragments.h"
+#include "MassRepresentationFragments.h"
 #include "MassExecutionContext.h"
 #include "MassEntityQuery.h"
 #include "MassActorSubsystem.h"
@@ -27,16 +28,15 @@ void UArsInstancedActorsInitializerProcessor::ConfigureQueries(const TSharedRef<
 	EntityQuery.AddRequirement<FArsInstancedActorsFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddRequirement<FMassGuidFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FMassRepresentationFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
 }
 
 /**
-* Initializes transform and GUID fragments. For the transform, we're going to apply the InstanceActor's parent transform (i.e.,
-* the ActorInstanceManager transform). As for the GUID, we'll assign it to an incremental index, that grows each time a fragment
-* is initialized.
+* Initializes transform, instance and GUID fragments from spawn data prepared by UArsInstancedActorsData::BeginPrepareSpawnEntities.
+* Prepared transforms are already filtered and in world space, so this is a block copy plus per-entity index bookkeeping.
 */
-template<bool bApplyManagerTranslationOnly, bool bFilterInstanceTransforms>
-void InitInstanceFragments(UArsInstancedActorsData* InstanceData, int32& NextInstanceIndex, const FVector& ManagerLocation
-	, const FTransform& ManagerTransform, FMassExecutionContext& Context, TArray<FMassEntityHandle>& InOutEntitiesToSignal)
+void InitInstanceFragments(UArsInstancedActorsData& InstanceData, const UE::ArsInstancedActors::FSpawnEntitiesPreparation& Preparation
+	, AArsInstancedActorsManager& Manager, const int32 InstanceDataId, int32& NextPreparedIndex, FMassExecutionContext& Context, TArray<FMassEntityHandle>& InOutEntitiesToSignal)
 {
 	const int32 NumEntities = Context.GetNumEntities();
 	InOutEntitiesToSignal.Reserve(InOutEntitiesToSignal.Num() + NumEntities);
@@ -45,62 +45,40 @@ void InitInstanceFragments(UArsInstancedActorsData* InstanceData, int32& NextIns
 	TArrayView<FArsInstancedActorsFragment> InstancedActorFragments = Context.GetMutableFragmentView<FArsInstancedActorsFragment>();
 	TArrayView<FTransformFragment> TransformFragments = Context.GetMutableFragmentView<FTransformFragment>();
 	TArrayView<FMassGuidFragment> GuidFragments = Context.GetMutableFragmentView<FMassGuidFragment>();
+	TArrayView<FMassRepresentationFragment> RepresentationFragments = Context.GetMutableFragmentView<FMassRepresentationFragment>();
 
-	// Block copy instance transforms if we don't need to filter for invalidated transforms
-	if constexpr (!bFilterInstanceTransforms)
-	{
-		check(NextInstanceIndex + NumEntities <= InstanceData->InstanceTransforms.Num());
-		check(TransformFragments.GetTypeSize() == InstanceData->InstanceTransforms.GetTypeSize());
-		FMemory::Memcpy(TransformFragments.GetData(), &InstanceData->InstanceTransforms[NextInstanceIndex], NumEntities * TransformFragments.GetTypeSize());
-	}
+	// Entity templates are shared between instance datas so per-IAD values are filled in here rather than in the template
+	const FStaticMeshInstanceVisualizationDescHandle StaticMeshDescHandle = InstanceData.GetDefaultVisualizationChecked().MassStaticMeshDescHandle;
+
+	check(NextPreparedIndex + NumEntities <= Preparation.WorldTransforms.Num());
+	check(TransformFragments.GetTypeSize() == Preparation.WorldTransforms.GetTypeSize());
+	FMemory::Memcpy(TransformFragments.GetData(), &Preparation.WorldTransforms[NextPreparedIndex], NumEntities * TransformFragments.GetTypeSize());
 
-	AArsInstancedActorsManager& Manager = InstanceData->GetManagerChecked();
 	for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
 	{
-		FMassActorInstanceFragment& MassActorInstanceFragment = MassActorInstanceFragments[EntityIt];
-		FArsInstancedActorsFragment& InstancedActorFragment = InstancedActorFragments[EntityIt];
-		FTransformFragment& TransformFragment = TransformFragments[EntityIt];
+		const FArsInstancedActorsInstanceIndex InstanceIndex = Preparation.InstanceIndices[NextPreparedIndex];
 		const FMassEntityHandle EntityHandle(Context.GetEntity(EntityIt));
 		InOutEntitiesToSignal.Add(EntityHandle);
 
-		if constexpr (bFilterInstanceTransforms)
-		{
-			// Skip invalidated (scale 0) instance transforms
-			while (InstanceData->InstanceTransforms[NextInstanceIndex].GetScale3D().IsZero())
-			{
-				++NextInstanceIndex;
-				check(InstanceData->InstanceTransforms.IsValidIndex(NextInstanceIndex));
-			}
-
-			// Copy local space transform
-			TransformFragment.GetMutableTransform() = InstanceData->InstanceTransforms[NextInstanceIndex];
-		}
-
-		InstancedActorFragment.InstanceIndex = FArsInstancedActorsInstanceIndex(NextInstanceIndex);
-		InstanceData->Entities[NextInstanceIndex] = EntityHandle;
+		InstancedActorFragments[EntityIt].InstanceData = &InstanceData;
+		InstancedActorFragments[EntityIt].InstanceIndex = InstanceIndex;
+		InstanceData.Entities[InstanceIndex.GetIndex()] = EntityHandle;
 
-		const int32 InstanceDataId = Manager.GetAllInstanceData().Find(InstanceData);
-		check(InstanceDataId != INDEX_NONE);
-		MassActorInstanceFragment.Handle = FActorInstanceHandle::MakeDehydratedActorHandle(Manager
-			, FArsInstancedActorsInstanceIndex::BuildCompositeIndex(InstanceDataId, NextInstanceIndex));
+		MassActorInstanceFragments[EntityIt].Handle = FActorInstanceHandle::MakeDehydratedActorHandle(Manager
+			, FArsInstancedActorsInstanceIndex::BuildCompositeIndex(InstanceDataId, InstanceIndex.GetIndex(), Manager.GetCompositeInstanceIndexBits()));
 
-		// @todo make GuidFragments required if we decide to go with deterministic entity naming/guid-ing
-		if (GuidFragments.Num())
+		if (RepresentationFragments.Num())
 		{
-			GuidFragments[EntityIt].Guid.D = NextInstanceIndex;
+			RepresentationFragments[EntityIt].StaticMeshDescHandle = StaticMeshDescHandle;
 		}
 
-		// Convert to world space
-		if constexpr (bApplyManagerTranslationOnly)
-		{
-			TransformFragment.GetMutableTransform().AddToTranslation(ManagerLocation);
-		}
-		else
+		// @todo make GuidFragments required if we decide to go with deterministic entity naming/guid-ing
+		if (GuidFragments.Num())
 		{
-			TransformFragment.GetMutableTransform() *= ManagerTransform;
+			GuidFragments[EntityIt].Guid.D = InstanceIndex.GetIndex();
 		}
 
-		++NextInstanceIndex;
+		++NextPreparedIndex;
 	}
 }
 
@@ -114,43 +92,21 @@ void UArsInstancedActorsInitializerProcessor::Execute(FMassEntityManager& Entity
 	FArsInstancedActorsMassSpawnData& AuxData = Context.GetMutableAuxData().GetMutable<FArsInstancedActorsMassSpawnData>();
 	UArsInstancedActorsData* InstanceData = AuxData.InstanceData.Get();
 	check(InstanceData);
+	check(AuxData.Preparation);
+	const UE::ArsInstancedActors::FSpawnEntitiesPreparation& Preparation = *AuxData.Preparation;
 
-
-	const AArsInstancedActorsManager& Manager = InstanceData->GetManagerChecked();
-	const FVector ManagerLocation = Manager.GetActorLocation();
-	const FTransform& ManagerTransform = Manager.GetActorTransform();
-	const bool bApplyManagerTranslationOnly = (Manager.GetActorQuat().IsIdentity() && Manager.GetActorScale().Equals(FVector::OneVector));
-	const bool bFilterInstanceTransforms = InstanceData->GetNumFreeInstances() > 0;
+	AArsInstancedActorsManager& Manager = InstanceData->GetManagerChecked();
+	const int32 InstanceDataId = Manager.GetAllInstanceData().Find(InstanceData);
+	check(InstanceDataId != INDEX_NONE);
 	
 	int32 NumInitializedEntities = 0;
-	int32 NextInstanceIndex = 0;
+	int32 NextPreparedIndex = 0;
 
 	TArray<FMassEntityHandle> EntitiesToSignal;
 
-	EntityQuery.ForEachEntityChunk(Context, [InstanceData, &NumInitializedEntities, &NextInstanceIndex, &ManagerLocation, &ManagerTransform, bApplyManagerTranslationOnly, bFilterInstanceTransforms, &EntitiesToSignal](FMassExecutionContext& Context)
+	EntityQuery.ForEachEntityChunk(Context, [InstanceData, &Preparation, &Manager, InstanceDataId, &NumInitializedEntities, &NextPreparedIndex, &EntitiesToSignal](FMassExecutionContext& Context)
 	{
-		if (bApplyManagerTranslationOnly)
-		{
-			if (bFilterInstanceTransforms)
-			{
-				InitInstanceFragments<true, true>(InstanceData, NextInstanceIndex, ManagerLocation, ManagerTransform, Context, EntitiesToSignal);
-			}
-			else
-			{
-				InitInstanceFragments<true, false>(InstanceData, NextInstanceIndex, ManagerLocation, ManagerTransform, Context, EntitiesToSignal);
-			}
-		}
-		else
-		{
-			if (bFilterInstanceTransforms)
-			{
-				InitInstanceFragments<false, true>(InstanceData, NextInstanceIndex, ManagerLocation, ManagerTransform, Context, EntitiesToSignal);
-			}
-			else
-			{
-				InitInstanceFragments<false, false>(InstanceData, NextInstanceIndex, ManagerLocation, ManagerTransform, Context, EntitiesToSignal);
-			}
-		}
+		InitInstanceFragments(*InstanceData, Preparation, Manager, InstanceDataId, NextPreparedIndex, Context, EntitiesToSignal);
 
 		NumInitializedEntities += Context.GetNumEntities();
 	});
@@ -163,7 +119,7 @@ void UArsInstancedActorsInitializerProcessor::Execute(FMassEntityManager& Entity
 	}
 
 #if DO_CHECK
-	checkf(NumInitializedEntities == InstanceData->NumValidInstances
-		, TEXT("UArsInstancedActorsInitializerProcessor expects to initialize all spawned entities at once and to have the same number of valid transforms to assign"));
+	checkf(NumInitializedEntities == Preparation.InstanceIndices.Num()
+		, TEXT("UArsInstancedActorsInitializerProcessor expects to initialize all spawned entities at once and to have the same number of prepared transforms to assign"));
 #endif // DO_CHECK
 }
@@ -1,9 +1,11 @@
 // Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
 
 #include "ArsInstancedActorsManager.h"
+#include "ArsInstancedActorsBoundsTests.h"
 #include "ArsInstancedActorsData.h"
 #include "ArsInstancedActorsComponent.h"
 #include "ArsInstancedActorsCustomVersion.h"
+#include "ArsInstancedActorsISMComponent.h"
 #include "ArsInstancedActorsIteration.h"
 #include "ArsInstancedActorsModifierVolumeComponent.h"
 #include "ArsInstancedActorsSettingsTypes.h"
@@ -26,7 +28,12 @@
 #include "MassExecutionContext.h"
 #include "MassRepresentationFragments.h"
 #include "MassRepresentationSubsystem.h"
+#include "MassSignalSubsystem.h"
 #include "Math/NumericLimits.h"
+#include "Net/UnrealNetwork.h"
+#include "Serialization/Formatters/BinaryArchiveFormatter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 #if UE_WITH_IRIS
 #include "Net/Iris/ReplicationSystem/ReplicationSystemUtil.h"
@@ -57,6 +64,28 @@ namespace UE::ArsInstancedActors
 			TEXT("When enabled, Instanced Actor destroyed state will persist in the saved game"),
 			ECVF_Default);
 
+		bool bIncrementalPersistence = true;
+		FAutoConsoleVariableRef CVarIncrementalPersistence(
+			TEXT("IA.Persistence.Incremental"),
+			bIncrementalPersistence,
+			TEXT("When enabled, Instanced Actor Managers re-use their last full persistence snapshot when saving and append a delta record ")
+			TEXT("containing only instances and IAC data changed since the previous save. When disabled, every save writes a full snapshot."),
+			ECVF_Default);
+
+		int32 MaxPersistenceDeltaRecords = 32;
+		FAutoConsoleVariableRef CVarMaxPersistenceDeltaRecords(
+			TEXT("IA.Persistence.MaxDeltaRecords"),
+			MaxPersistenceDeltaRecords,
+			TEXT("Number of incremental persistence delta records after which the next save compacts them into a new full snapshot"),
+			ECVF_Default);
+
+		float MaxPersistenceDeltaRecordsSizeRatio = 0.5f;
+		FAutoConsoleVariableRef CVarMaxPersistenceDeltaRecordsSizeRatio(
+			TEXT("IA.Persistence.MaxDeltaRecordsSizeRatio"),
+			MaxPersistenceDeltaRecordsSizeRatio,
+			TEXT("Size of incremental persistence delta records, as a ratio of the full snapshot size, after which the next save compacts them into a new full snapshot"),
+			ECVF_Default);
+
 		bool bInstanceCollisionsOnClient = true;
 		FAutoConsoleVariableRef CVarCollisionsOnClient(
 			TEXT("IA.InstanceCollisionsOnClient"),
@@ -71,6 +100,15 @@ namespace UE::ArsInstancedActors
 			TEXT("When enabled, Instanced Actor Manager ISMC's will be created with collision enabled on server"),
 			ECVF_Default);
 
+		bool bHeadlessServer = false;
+		FAutoConsoleVariableRef CVarHeadlessServer(
+			TEXT("IA.HeadlessServer"),
+			bHeadlessServer,
+			TEXT("When enabled, Instanced Actor Managers on dedicated servers skip render-only ISMC setup, creating ISMC's purely as ")
+			TEXT("instance collision carriers. If IA.InstanceCollisionsOnServer is also disabled, no ISMC's are created or registered ")
+			TEXT("with Mass representation at all. Must be set before managers begin play."),
+			ECVF_Default);
+
 		int32 WorldPositionOffsetDisableDistance = 0;
 		FAutoConsoleVariableRef CVarWorldPositionOffsetDisableDistance(
 			TEXT("IA.WorldPositionOffsetDisableDistance"),
@@ -205,6 +243,41 @@ namespace UE::ArsInstancedActors
 		return false;
 	}
 
+	template <>
+	bool PassesBoundsTest<FOrientedBox>(const FOrientedBox& QueryBounds, EBoundsTestType BoundsTestType, const FArsInstancedActorsInstanceHandle& InstanceHandle, const FTransform& InstanceTransform)
+	{
+		switch (BoundsTestType)
+		{
+		case EBoundsTestType::Intersect:
+			{
+				// Cheap test first
+				if (BoundsTests::IsInside(QueryBounds, InstanceTransform.GetLocation()))
+				{
+					return true;
+				}
+
+				const FBox InstancedActorBounds = InstanceHandle.GetInstanceActorData()->GetCachedLocalBounds().TransformBy(InstanceTransform);
+				return BoundsTests::Intersect(QueryBounds, InstancedActorBounds);
+			}
+		case EBoundsTestType::Enclosed:
+			{
+				// Cheap test first
+				if (!BoundsTests::IsInside(QueryBounds, InstanceTransform.GetLocation()))
+				{
+					return false;
+				}
+
+				const FBox InstancedActorBounds = InstanceHandle.GetInstanceActorData()->GetCachedLocalBounds().TransformBy(InstanceTransform);
+				return BoundsTests::IsInside(QueryBounds, InstancedActorBounds);
+			}
+		default:
+			ensureMsgf(false, TEXT("Unexpected BoundsTestType: %i"), (int)BoundsTestType);
+			break;
+		}
+
+		return false;
+	}
+
 } // namespace ArsInstancedActors
 
 //-----------------------------------------------------------------------------
@@ -273,6 +346,12 @@ void AArsInstancedActorsManager::BeginPlay()
 	// spatially index the manager.
 	InstanceBounds = CalculateLocalInstanceBounds().TransformBy(GetActorTransform());
 
+	// Include instances added at runtime, e.g: restored from persistence prior to BeginPlay
+	if (RuntimeAddedInstanceBounds.IsValid)
+	{
+		InstanceBounds += RuntimeAddedInstanceBounds;
+	}
+
 	// Register with IA subsystem if it's available already, otherwise the subsystem will
 	// collect this manager when it initializes later and call OnAddedToSubsystem
 	UArsInstancedActorsSubsystem* PreinitializedInstancedActorSubsystem = UE::ArsInstancedActors::Utils::GetArsInstancedActorsSubsystem(*World);
@@ -331,6 +410,48 @@ void AArsInstancedActorsManager::OnAddedToSubsystem(UArsInstancedActorsSubsystem
 }
 
 void AArsInstancedActorsManager::InitializeModifyAndSpawnEntities()
+{
+	InitializeAndRunPreSpawnModifiers();
+	SpawnEntitiesAndRunPostSpawnModifiers();
+}
+
+void AArsInstancedActorsManager::InitializeModifyAndPrepareSpawnEntities()
+{
+	check(!bIsPreparingSpawnEntities);
+
+	InitializeAndRunPreSpawnModifiers();
+
+	// Prepare spawn data off the game thread, now that pre-spawn modifiers have had their chance to remove instances
+	for (TObjectPtr<UArsInstancedActorsData>& InstanceData : PerActorClassInstanceData)
+	{
+		check(InstanceData);
+		InstanceData->BeginPrepareSpawnEntities();
+	}
+	bIsPreparingSpawnEntities = true;
+}
+
+bool AArsInstancedActorsManager::IsSpawnEntitiesPreparationComplete() const
+{
+	for (const TObjectPtr<UArsInstancedActorsData>& InstanceData : PerActorClassInstanceData)
+	{
+		if (InstanceData && !InstanceData->IsSpawnEntitiesPreparationComplete())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void AArsInstancedActorsManager::CommitPreparedSpawnEntities()
+{
+	if (ensureMsgf(bIsPreparingSpawnEntities, TEXT("%s: CommitPreparedSpawnEntities called without InitializeModifyAndPrepareSpawnEntities"), *GetPathName()))
+	{
+		bIsPreparingSpawnEntities = false;
+		SpawnEntitiesAndRunPostSpawnModifiers();
+	}
+}
+
+void AArsInstancedActorsManager::InitializeAndRunPreSpawnModifiers()
 {
 	check(IsValid(InstancedActorSubsystem));
 
@@ -358,8 +479,147 @@ void AArsInstancedActorsManager::InitializeModifyAndSpawnEntities()
 		InstanceData->Initialize();
 	}
 
+	UpdateCompositeInstanceIndexBits();
+
 	// Run pending modifiers that can run pre-entity spawn
 	TryRunPendingModifiers();
+}
+
+int32 AArsInstancedActorsManager::CalculateCompositeInstanceIndexBits() const
+{
+	int32 MaxNumInstances = 0;
+	int32 MaxInstanceDataID = PerActorClassInstanceData.Num() - 1;
+	bool bHasWideInstanceIndices = false;
+	for (const TObjectPtr<UArsInstancedActorsData>& InstanceData : PerActorClassInstanceData)
+	{
+		check(InstanceData);
+		MaxNumInstances = FMath::Max(MaxNumInstances, InstanceData->GetNumInstances());
+		MaxInstanceDataID = FMath::Max(MaxInstanceDataID, InstanceData->GetInstanceDataID());
+		bHasWideInstanceIndices |= InstanceData->bWideInstanceIndices;
+	}
+
+	const int32 InstanceIndexBits = FMath::Max<int32>(FArsInstancedActorsInstanceIndex::DefaultCompositeInstanceIndexBits, FMath::CeilLogTwo(uint32(MaxNumInstances)));
+	const int32 InstanceDataIDBits = FMath::CeilLogTwo(uint32(MaxInstanceDataID + 1));
+	ensureMsgf(InstanceIndexBits + InstanceDataIDBits <= 32, TEXT("%s: %d instances in it's largest IAD & instance data IDs up to %d can't be addressed by 32-bit composite indices")
+		, *GetPathName(), MaxNumInstances, MaxInstanceDataID);
+	ensureMsgf(!bHasWideInstanceIndices || MaxInstanceDataID < FArsInstancedActorsInstanceIndex::MaxWideInstanceDataIDs
+		, TEXT("%s: Instance data IDs up to %d exceed the %d addressable alongside wide instance indices. Consider splitting this manager's instances across more managers")
+		, *GetPathName(), MaxInstanceDataID, FArsInstancedActorsInstanceIndex::MaxWideInstanceDataIDs);
+
+	return InstanceIndexBits;
+}
+
+void AArsInstancedActorsManager::UpdateCompositeInstanceIndexBits()
+{
+	if (bCompositeInstanceIndexBitsFrozen)
+	{
+		return;
+	}
+
+	CompositeInstanceIndexBits = uint8(CalculateCompositeInstanceIndexBits());
+}
+
+void AArsInstancedActorsManager::FreezeCompositeInstanceIndexBits(const int32 InstanceIndexBits)
+{
+	SetCompositeInstanceIndexBits(InstanceIndexBits);
+	bCompositeInstanceIndexBitsFrozen = true;
+
+	if (HasAuthority() && AuthorityCompositeInstanceIndexBits != CompositeInstanceIndexBits)
+	{
+		AuthorityCompositeInstanceIndexBits = CompositeInstanceIndexBits;
+		FlushNetDormancy();
+	}
+}
+
+void AArsInstancedActorsManager::SetCompositeInstanceIndexBits(const int32 InstanceIndexBits)
+{
+	check(InstanceIndexBits > 0 && InstanceIndexBits < 32);
+	if (InstanceIndexBits == CompositeInstanceIndexBits)
+	{
+		return;
+	}
+
+	CompositeInstanceIndexBits = uint8(InstanceIndexBits);
+
+	if (!HasSpawnedEntities())
+	{
+		return;
+	}
+
+	// Re-encode spawned entities' dehydrated actor handles, as per UArsInstancedActorsInitializerProcessor. Hydrated handles
+	// resolve via their cached actor instead.
+	FMassEntityManager& EntityManager = GetMassEntityManagerChecked();
+	TArray<FMassEntityHandle> EntitiesToSignal;
+	for (int32 InstanceDataIndex = 0; InstanceDataIndex < PerActorClassInstanceData.Num(); ++InstanceDataIndex)
+	{
+		const UArsInstancedActorsData* InstanceData = PerActorClassInstanceData[InstanceDataIndex];
+		check(InstanceData);
+		for (int32 InstanceIndex = 0; InstanceIndex < InstanceData->Entities.Num(); ++InstanceIndex)
+		{
+			const FMassEntityHandle EntityHandle = InstanceData->Entities[InstanceIndex];
+			FMassActorInstanceFragment* ActorInstanceFragment = EntityHandle.IsValid() ? EntityManager.GetFragmentDataPtr<FMassActorInstanceFragment>(EntityHandle) : nullptr;
+			if (ActorInstanceFragment && ActorInstanceFragment->Handle.GetCachedActor() == nullptr)
+			{
+				ActorInstanceFragment->Handle = FActorInstanceHandle::MakeDehydratedActorHandle(*this
+					, FArsInstancedActorsInstanceIndex::BuildCompositeIndex(InstanceDataIndex, InstanceIndex, CompositeInstanceIndexBits));
+				EntitiesToSignal.Add(EntityHandle);
+			}
+		}
+	}
+
+	if (EntitiesToSignal.Num())
+	{
+		UMassSignalSubsystem* SignalSubsystem = UWorld::GetSubsystem<UMassSignalSubsystem>(GetWorld());
+		if (ensure(SignalSubsystem))
+		{
+			SignalSubsystem->SignalEntities(UE::Mass::Signals::ActorInstanceHandleChanged, EntitiesToSignal);
+		}
+	}
+}
+
+bool AArsInstancedActorsManager::FitCompositeInstanceIndexBits(const int32 InstanceIndex)
+{
+	if (!bCompositeInstanceIndexBitsFrozen || InstanceIndex < (1 << CompositeInstanceIndexBits))
+	{
+		return true;
+	}
+
+	// The server's width is final, and it only adds instances that fit it
+	if (HasAuthority() || AuthorityCompositeInstanceIndexBits != 0)
+	{
+		return false;
+	}
+
+	const int32 InstanceIndexBits = FMath::CeilLogTwo(uint32(InstanceIndex) + 1);
+	UE_LOG(LogArsInstancedActors, Verbose, TEXT("%s: Widening composite instance indices from %u to %d bits to fit replicated instance %d, pending the server's width")
+		, *GetPathName(), CompositeInstanceIndexBits, InstanceIndexBits, InstanceIndex);
+	SetCompositeInstanceIndexBits(InstanceIndexBits);
+	return true;
+}
+
+void AArsInstancedActorsManager::OnRep_AuthorityCompositeInstanceIndexBits()
+{
+	if (AuthorityCompositeInstanceIndexBits == 0)
+	{
+		return;
+	}
+
+	UE_CLOG(bCompositeInstanceIndexBitsFrozen && AuthorityCompositeInstanceIndexBits != CompositeInstanceIndexBits, LogArsInstancedActors, Verbose
+		, TEXT("%s: Adopting the server's %u bit composite instance indices in place of the %u bits used since spawning entities")
+		, *GetPathName(), AuthorityCompositeInstanceIndexBits, CompositeInstanceIndexBits);
+
+	FreezeCompositeInstanceIndexBits(AuthorityCompositeInstanceIndexBits);
+}
+
+void AArsInstancedActorsManager::SpawnEntitiesAndRunPostSpawnModifiers()
+{
+	// Runtime instance additions may have grown IADs since InitializeModifyAndSpawnEntities. Composite instance index width
+	// is fixed from here on, including across respawns, as spawned entities' actor handles encode it. Clients may spawn before 
+	// receiving the server's width, in which case they freeze their own until OnRep_AuthorityCompositeInstanceIndexBits.
+	if (!bCompositeInstanceIndexBitsFrozen)
+	{
+		FreezeCompositeInstanceIndexBits(CalculateCompositeInstanceIndexBits());
+	}
 
 	// SpawnEntities for all PerActorClassInstanceData
 	for (TObjectPtr<UArsInstancedActorsData>& InstanceData : PerActorClassInstanceData)
@@ -418,6 +678,13 @@ void AArsInstancedActorsManager::EndPlay(const EEndPlayReason::Type EndPlayReaso
 	Super::EndPlay(EndPlayReason);
 }
 
+void AArsInstancedActorsManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AArsInstancedActorsManager, AuthorityCompositeInstanceIndexBits);
+}
+
 bool AArsInstancedActorsManager::IsHLODRelevant() const
 {
 	return false;
@@ -482,57 +749,87 @@ void AArsInstancedActorsManager::Serialize(FStructuredArchive::FRecord Record)
 			FlushNetDormancy();
 		}
 
-		// Store / retrieve world real time at serialization
-		UWorld* World = GetWorld();
-		check(World);
-		const FDateTime TimeNow = FDateTime::UtcNow();
-		FDateTime SerializedTime = TimeNow;
-		Record << SA_VALUE(TEXT("Time"), SerializedTime);
-		
-		int64 TimeDelta = UnderlyingArchive.IsLoading() ? (TimeNow - SerializedTime).GetTotalSeconds() : 0;
-		if (!ensure(TimeDelta >= 0))
+		if (UnderlyingArchive.CustomVer(FArsInstancedActorsCustomVersion::GUID) < FArsInstancedActorsCustomVersion::IncrementalPersistence)
 		{
-			TimeDelta = 0;
+			// Prior to incremental persistence, a single full persistence record was serialized inline
+			check(UnderlyingArchive.IsLoading());
+			SerializePersistenceRecord(Record, /*bDeltaRecord*/false);
 		}
+		else if (UnderlyingArchive.IsLoading())
+		{
+			TArray<uint8> Snapshot;
+			int32 NumDeltaRecords = 0;
+			TArray<uint8> DeltaRecords;
+			Record << SA_VALUE(TEXT("Snapshot"), Snapshot);
+			Record << SA_VALUE(TEXT("NumDeltaRecords"), NumDeltaRecords);
+			Record << SA_VALUE(TEXT("DeltaRecords"), DeltaRecords);
+
+			if (!ensureMsgf(!UnderlyingArchive.IsError() && NumDeltaRecords >= 0, TEXT("Error reading persistence records. Aborting corrupted persistence archive read. Persistence data may be lost as a result.")))
+			{
+				UnderlyingArchive.SetError();
+				return;
+			}
 
-		// Seialize each IAD
-		int32 NumInstanceDatas = PerActorClassInstanceData.Num();
-		FStructuredArchiveArray InstanceDataArray = Record.EnterArray(TEXT("InstanceData"), NumInstanceDatas);
+			// Apply the base snapshot then each delta record in the order they were saved
+			if (!SerializePersistenceRecords(Snapshot, 1, /*bDeltaRecords*/false, UnderlyingArchive)
+				|| !SerializePersistenceRecords(DeltaRecords, NumDeltaRecords, /*bDeltaRecords*/true, UnderlyingArchive))
+			{
+				UnderlyingArchive.SetError();
+				return;
+			}
 
-		for (int32 InstanceDataIndex = 0; InstanceDataIndex < NumInstanceDatas; ++InstanceDataIndex)
+			// Force a full snapshot on next save to expunge any records we couldn't match up to IADs
+			bHasPersistenceSnapshot = false;
+			PersistenceSnapshot.Empty();
+			PersistenceDeltaRecords.Empty();
+			NumPersistenceDeltaRecords = 0;
+			PersistenceDirtyStates.Reset();
+		}
+		else
 		{
-			FStructuredArchiveRecord InstanceDataRecord = InstanceDataArray.EnterElement().EnterRecord();
+			using namespace UE::ArsInstancedActors::CVars;
 
-			UArsInstancedActorsData* InstanceData = nullptr;
-			if (UnderlyingArchive.IsLoading())
-			{
-				// Find IAD for ID
-				uint16 InstanceDataID;
-				InstanceDataRecord << SA_VALUE(TEXT("ID"), InstanceDataID);
-				InstanceData = FindInstanceDataByID(InstanceDataID);
+			// Compact into a new full snapshot when we don't have one to append to, or delta records have grown too large
+			const bool bCompact = !bIncrementalPersistence
+				|| !bHasPersistenceSnapshot
+				|| NumPersistenceDeltaRecords >= MaxPersistenceDeltaRecords
+				|| PersistenceDeltaRecords.Num() > PersistenceSnapshot.Num() * MaxPersistenceDeltaRecordsSizeRatio;
 
-				if (InstanceData == nullptr)
-				{
-					UE_LOG(LogArsInstancedActors, Warning, TEXT("%s - no IAD found with ID %u to restore persistent data. Data will be ignored and expunged on re-save"), *GetPathName(), InstanceDataID);
-				}
+			if (bCompact)
+			{
+				PersistenceSnapshot.Reset();
+				PersistenceDeltaRecords.Reset();
+				NumPersistenceDeltaRecords = 0;
+				bHasPersistenceSnapshot = SerializePersistenceRecords(PersistenceSnapshot, 1, /*bDeltaRecords*/false, UnderlyingArchive);
 			}
-			else
+			else if (!PersistenceDirtyStates.IsEmpty())
 			{
-				// Save ID for later matchup
-				check(PerActorClassInstanceData.IsValidIndex(InstanceDataIndex));
-				InstanceData = PerActorClassInstanceData[InstanceDataIndex];
-				check(IsValid(InstanceData));
-				InstanceDataRecord << SA_VALUE(TEXT("ID"), InstanceData->ID);
+				const int32 NumDeltaRecordBytes = PersistenceDeltaRecords.Num();
+				if (SerializePersistenceRecords(PersistenceDeltaRecords, 1, /*bDeltaRecords*/true, UnderlyingArchive))
+				{
+					++NumPersistenceDeltaRecords;
+				}
+				else
+				{
+					// Discard the partial record and write a full snapshot next time
+					PersistenceDeltaRecords.SetNum(NumDeltaRecordBytes);
+					bHasPersistenceSnapshot = false;
+				}
 			}
+			PersistenceDirtyStates.Reset();
 
-			// Serialize / deserialize IAD persistence data
-			// Note: This is performed even if InstanceData = nullptr to seek the archive past the saved data
-			SerializeInstancePersistenceData(InstanceDataRecord, InstanceData, TimeDelta);
-
-			if (UnderlyingArchive.IsError())
+			if (!bHasPersistenceSnapshot)
 			{
+				UnderlyingArchive.SetError();
 				return;
 			}
+
+			Record << SA_VALUE(TEXT("Snapshot"), PersistenceSnapshot);
+			Record << SA_VALUE(TEXT("NumDeltaRecords"), NumPersistenceDeltaRecords);
+			Record << SA_VALUE(TEXT("DeltaRecords"), PersistenceDeltaRecords);
+
+			UE_LOG(LogArsInstancedActors, Verbose, TEXT("%s saved persistent data %s (snapshot: %d bytes, delta records: %d, %d bytes)")
+				, *GetPathName(), bCompact ? TEXT("snapshot") : TEXT("incrementally"), PersistenceSnapshot.Num(), NumPersistenceDeltaRecords, PersistenceDeltaRecords.Num());
 		}
 	}
 	else
@@ -541,103 +838,600 @@ void AArsInstancedActorsManager::Serialize(FStructuredArchive::FRecord Record)
 	}
 }
 
-void AArsInstancedActorsManager::SerializeInstancePersistenceData(FStructuredArchive::FRecord Record, UArsInstancedActorsData* InstanceData, int64 TimeDelta) const
+void AArsInstancedActorsManager::SerializePersistenceRecord(FStructuredArchive::FRecord Record, const bool bDeltaRecord)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(AArsInstancedActorsManager::SerializeInstancePersistenceData);
+	TRACE_CPUPROFILER_EVENT_SCOPE(AArsInstancedActorsManager::SerializePersistenceRecord);
 
 	FArchive& UnderlyingArchive = Record.GetUnderlyingArchive();
 	check(UnderlyingArchive.IsSaveGame());
 
-	// Note: InstanceData may be nullptr when loading, if there were persitence records saved for IAD's that have since been removed. In this case
-	// we still need to ensure the archive is seeked past this data to safely ignore it.
-	if (InstanceData == nullptr)
+	// Store / retrieve world real time at serialization
+	UWorld* World = GetWorld();
+	check(World);
+	const FDateTime TimeNow = FDateTime::UtcNow();
+	FDateTime SerializedTime = TimeNow;
+	Record << SA_VALUE(TEXT("Time"), SerializedTime);
+	
+	int64 TimeDelta = UnderlyingArchive.IsLoading() ? (TimeNow - SerializedTime).GetTotalSeconds() : 0;
+	if (!ensure(TimeDelta >= 0))
 	{
-		check(UnderlyingArchive.IsLoading());
+		TimeDelta = 0;
 	}
 
-	// Note: Rather than serializing a flat array of InstanceDelta's directly as an Array Of Structs, we instead serialize a Struct Of Arrays
-	//       to optimize for the common case where we have lots of destroyed instances where rather than storing an array of instances with
-	//       true / false for destroyed state, we can just have an array of destroyed instane indices, factoring out the extra byte for destroyed
-	//       state.
-	// @todo: In hindsight we could / should just intrinisically have separate arrays / 'delta lists' of Destroyed Instances and Lifecycle Changes.
-
-	// Destroyed instance indices
-	int32 NumDestroyedInstances = InstanceData ? InstanceData->InstanceDeltas.GetNumDestroyedInstanceDeltas() : INDEX_NONE;
-	FStructuredArchive::FArray DestroyedInstancesArray = Record.EnterArray(TEXT("DestroyedInstances"), NumDestroyedInstances);
+	// Restore the composite index width before any runtime IADs or instances, which must fit it
+	SerializeCompositeInstanceIndexBits(Record);
 
-	if (UnderlyingArchive.IsLoading())
+	// Delta records only include IADs with persistence changes since the previous save
+	TArray<UArsInstancedActorsData*> InstanceDatasToSave;
+	if (!UnderlyingArchive.IsLoading())
 	{
-		for (uint16 ArrayIndex = 0; ArrayIndex < NumDestroyedInstances; ++ArrayIndex)
+		if (bDeltaRecord)
 		{
-			if (!ensureMsgf(InstanceData && ArrayIndex < InstanceData->GetNumInstances(), TEXT("Attempting to destroy more instances (%d) than actually exist (%d). Aborting corrupted persistence archive read. Persistence data may be lost as a result."), NumDestroyedInstances, InstanceData->GetNumInstances()))
+			for (const TPair<uint16, UE::ArsInstancedActors::FInstanceDataPersistenceDirtyState>& DirtyStateItem : PersistenceDirtyStates)
 			{
-				UnderlyingArchive.SetError();
-				return;
+				if (UArsInstancedActorsData* InstanceData = FindInstanceDataByID(DirtyStateItem.Key))
+				{
+					InstanceDatasToSave.Add(InstanceData);
+				}
 			}
+		}
+		else
+		{
+			InstanceDatasToSave.Append(PerActorClassInstanceData);
+		}
+	}
 
-			FArsInstancedActorsInstanceIndex DestroyedInstanceIndex;
-			DestroyedInstancesArray << DestroyedInstanceIndex;
+	// Seialize each IAD
+	int32 NumInstanceDatas = InstanceDatasToSave.Num();
+	FStructuredArchiveArray InstanceDataArray = Record.EnterArray(TEXT("InstanceData"), NumInstanceDatas);
 
-			if (!ensureMsgf(!UnderlyingArchive.GetError(), TEXT("Error reading DestroyedInstancesArray element. Aborting corrupted persistence archive read. Persistence data may be lost as a result.")))
+	for (int32 InstanceDataIndex = 0; InstanceDataIndex < NumInstanceDatas; ++InstanceDataIndex)
+	{
+		FStructuredArchiveRecord InstanceDataRecord = InstanceDataArray.EnterElement().EnterRecord();
+
+		UArsInstancedActorsData* InstanceData = nullptr;
+		if (UnderlyingArchive.IsLoading())
+		{
+			// Find IAD for ID
+			uint16 InstanceDataID;
+			InstanceDataRecord << SA_VALUE(TEXT("ID"), InstanceDataID);
+			InstanceData = FindInstanceDataByID(InstanceDataID);
+
+			// Recreate IADs created at runtime, absent from cooked data
+			FSoftClassPath RuntimeActorClassPath;
+			TArray<FName> RuntimeAdditionalTagNames;
+			if (SerializeRuntimeCreatedInstanceData(InstanceDataRecord, nullptr, RuntimeActorClassPath, RuntimeAdditionalTagNames) && InstanceData == nullptr)
 			{
-				return;
+				if (TSubclassOf<AActor> RuntimeActorClass = RuntimeActorClassPath.TryLoadClass<AActor>())
+				{
+					FGameplayTagContainer RuntimeAdditionalTags;
+					for (const FName TagName : RuntimeAdditionalTagNames)
+					{
+						RuntimeAdditionalTags.AddTag(FGameplayTag::RequestGameplayTag(TagName, /*ErrorIfNotFound*/false));
+					}
+					InstanceData = CreateRuntimeInstanceData(RuntimeActorClass, FArsInstancedActorsTagSet(RuntimeAdditionalTags), InstanceDataID);
+				}
 			}
 
-			if (InstanceData)
+			if (InstanceData == nullptr)
 			{
-				InstanceData->InstanceDeltas.SetInstanceDestroyed(DestroyedInstanceIndex);
+				UE_LOG(LogArsInstancedActors, Warning, TEXT("%s - no IAD found with ID %u to restore persistent data. Data will be ignored and expunged on re-save"), *GetPathName(), InstanceDataID);
 			}
 		}
-	}
-	else
-	{
-		check(InstanceData);
+		else
+		{
+			// Save ID for later matchup
+			check(InstanceDatasToSave.IsValidIndex(InstanceDataIndex));
+			InstanceData = InstanceDatasToSave[InstanceDataIndex];
+			check(IsValid(InstanceData));
+			InstanceDataRecord << SA_VALUE(TEXT("ID"), InstanceData->ID);
 
-		uint16 NumDestroyedInstancesWritten = 0;
-		const TArray<FArsInstancedActorsDelta>& InstanceDeltas = InstanceData->InstanceDeltas.GetInstanceDeltas();
-		for (const FArsInstancedActorsDelta& Delta : InstanceDeltas)
+			FSoftClassPath RuntimeActorClassPath;
+			TArray<FName> RuntimeAdditionalTagNames;
+			SerializeRuntimeCreatedInstanceData(InstanceDataRecord, InstanceData, RuntimeActorClassPath, RuntimeAdditionalTagNames);
+		}
+
+		// Serialize / deserialize IAD persistence data
+		// Note: This is performed even if InstanceData = nullptr to seek the archive past the saved data
+		SerializeInstancePersistenceData(InstanceDataRecord, InstanceData, TimeDelta, bDeltaRecord);
+
+		if (UnderlyingArchive.IsError())
 		{
-			if (Delta.IsDestroyed())
-			{
-				FArsInstancedActorsInstanceIndex DestroyedInstanceIndex = Delta.GetInstanceIndex();
-				DestroyedInstancesArray << DestroyedInstanceIndex;
-				++NumDestroyedInstancesWritten;
-			}
+			return;
 		}
-		ensureMsgf(NumDestroyedInstancesWritten == NumDestroyedInstances, TEXT("AArsInstancedActorsManager::SerializeInstancePersistenceData: Expectations are for the Number of Instances destroyed to match the number of Instances marked to be destroyed in serialization"));
 	}
+}
 
-	// Allow UInstancedActorComponents (IAC's) to extend persistence
-	//
-	// IAC persistence entries are written out with an ID & size header so they can be matched up with their
-	// serialization implementation when read back later or safely skipped if the IAC has since been removed
-	// from ActorClass
-	TMap<uint32, UArsInstancedActorsComponent*, TInlineSetAllocator<2>> IACsByPersistenceID;
-	TMap<UArsInstancedActorsComponent*, uint32, TInlineSetAllocator<2>> IACPersistenceIDs;
-	int32 NumPersistedIACs = 0;
-	if (InstanceData)
+void AArsInstancedActorsManager::SerializeCompositeInstanceIndexBits(FStructuredArchive::FRecord Record)
+{
+	FArchive& UnderlyingArchive = Record.GetUnderlyingArchive();
+	if (UnderlyingArchive.CustomVer(FArsInstancedActorsCustomVersion::GUID) < FArsInstancedActorsCustomVersion::PersistedCompositeInstanceIndexBits)
 	{
-		TSharedPtr<UE::ArsInstancedActors::FExemplarActorData> ExemplarActorData = GetInstancedActorSubsystemChecked().GetOrCreateExemplarActor(InstanceData->ActorClass);
-		const AActor* const ExemplarActor = ExemplarActorData->Actor.Get();
-		check(ExemplarActor);
-		ExemplarActor->ForEachComponent<UArsInstancedActorsComponent>(/*bIncludeFromChildActors*/ false, [&](UArsInstancedActorsComponent* InstancedActorComponent)
-			{
-				// Skip IAC's that don't want / need serialization. When writing this ensures we don't waste space by writing empty entries.
-				if (InstancedActorComponent->ShouldSerializeInstancePersistenceData(UnderlyingArchive, InstanceData, TimeDelta))
-				{
-					const uint32 IACPersistenceID = InstancedActorComponent->GetInstancePersistenceDataID();
-					if (ensureMsgf(IACPersistenceID != 0, TEXT("UArsInstancedActorsComponent classes implementing ShouldSerializeInstancePersistenceData (%s) must also implement GetInstancePersistenceDataID and return a non-zero value"), *InstancedActorComponent->GetClass()->GetPathName()))
-					{
-						IACsByPersistenceID.Add(IACPersistenceID, InstancedActorComponent);
-						IACPersistenceIDs.Add(InstancedActorComponent, IACPersistenceID);
-						++NumPersistedIACs;
-					}
-				} });
+		return;
 	}
-	FStructuredArchiveArray InstancedActorComponentDataArray = Record.EnterArray(TEXT("InstancedActorComponentData"), NumPersistedIACs);
-	if (UnderlyingArchive.IsLoading())
+
+	bool bFrozen = bCompositeInstanceIndexBitsFrozen;
+	uint8 InstanceIndexBits = CompositeInstanceIndexBits;
+	Record << SA_VALUE(TEXT("CompositeInstanceIndexBitsFrozen"), bFrozen);
+	Record << SA_VALUE(TEXT("CompositeInstanceIndexBits"), InstanceIndexBits);
+
+	if (!UnderlyingArchive.IsLoading() || !bFrozen || InstanceIndexBits == CompositeInstanceIndexBits)
 	{
-		for (int32 IACIndex = 0; IACIndex < NumPersistedIACs; ++IACIndex)
+		return;
+	}
+
+	if (bCompositeInstanceIndexBitsFrozen)
+	{
+		UE_LOG(LogArsInstancedActors, Warning, TEXT("%s: Persisted %u bit composite instance indices differ from the %u bits already in use since entity spawning. Keeping current width")
+			, *GetPathName(), InstanceIndexBits, CompositeInstanceIndexBits);
+	}
+	else if (InstanceIndexBits < CalculateCompositeInstanceIndexBits())
+	{
+		UE_LOG(LogArsInstancedActors, Warning, TEXT("%s: Persisted %u bit composite instance indices no longer fit this manager's instance data. Ignoring persisted width")
+			, *GetPathName(), InstanceIndexBits);
+	}
+	else
+	{
+		FreezeCompositeInstanceIndexBits(InstanceIndexBits);
+	}
+}
+
+bool AArsInstancedActorsManager::SerializeRuntimeCreatedInstanceData(FStructuredArchive::FRecord Record, const UArsInstancedActorsData* InstanceData
+	, FSoftClassPath& InOutActorClassPath, TArray<FName>& InOutAdditionalTagNames) const
+{
+	FArchive& UnderlyingArchive = Record.GetUnderlyingArchive();
+	if (UnderlyingArchive.CustomVer(FArsInstancedActorsCustomVersion::GUID) < FArsInstancedActorsCustomVersion::RuntimeCreatedInstanceData)
+	{
+		return false;
+	}
+
+	bool bRuntimeCreated = InstanceData && InstanceData->IsRuntimeCreated();
+	Record << SA_VALUE(TEXT("RuntimeCreated"), bRuntimeCreated);
+	if (!bRuntimeCreated)
+	{
+		return false;
+	}
+
+	// Tags are saved by name, as FGameplayTagContainer's properties aren't SaveGame and would be skipped by SaveGame archives
+	if (!UnderlyingArchive.IsLoading())
+	{
+		check(InstanceData);
+		InOutActorClassPath = FSoftClassPath(InstanceData->RuntimeCreationDesc.ActorClass.Get());
+		for (const FGameplayTag& Tag : InstanceData->RuntimeCreationDesc.AdditionalTags)
+		{
+			InOutAdditionalTagNames.Add(Tag.GetTagName());
+		}
+	}
+	Record << SA_VALUE(TEXT("ActorClass"), InOutActorClassPath);
+	Record << SA_VALUE(TEXT("AdditionalTags"), InOutAdditionalTagNames);
+
+	return true;
+}
+
+bool AArsInstancedActorsManager::SerializePersistenceRecords(TArray<uint8>& Bytes, const int32 NumRecords, const bool bDeltaRecords, const FArchive& OuterArchive)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(AArsInstancedActorsManager::SerializePersistenceRecords);
+
+	// Records are always binary, regardless of OuterArchive's format, so they can be cached and appended to as raw bytes.
+	// New records are appended to the end of Bytes when saving.
+	TUniquePtr<FArchive> BytesArchive;
+	if (OuterArchive.IsLoading())
+	{
+		BytesArchive = MakeUnique<FMemoryReader>(Bytes, /*bIsPersistent*/true);
+	}
+	else
+	{
+		BytesArchive = MakeUnique<FMemoryWriter>(Bytes, /*bIsPersistent*/true, /*bSetOffset*/true);
+	}
+	BytesArchive->ArIsSaveGame = true;
+	BytesArchive->SetUEVer(OuterArchive.UEVer());
+	BytesArchive->SetLicenseeUEVer(OuterArchive.LicenseeUEVer());
+	BytesArchive->SetCustomVersions(OuterArchive.GetCustomVersions());
+
+	for (int32 RecordIndex = 0; RecordIndex < NumRecords && !BytesArchive->IsError(); ++RecordIndex)
+	{
+		FBinaryArchiveFormatter Formatter(*BytesArchive);
+		FStructuredArchive StructuredArchive(Formatter);
+		SerializePersistenceRecord(StructuredArchive.Open().EnterRecord(), bDeltaRecords);
+	}
+
+	return !BytesArchive->IsError();
+}
+
+void AArsInstancedActorsManager::SerializeInstancePersistenceData(FStructuredArchive::FRecord Record, UArsInstancedActorsData* InstanceData, int64 TimeDelta, const bool bDeltaRecord) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(AArsInstancedActorsManager::SerializeInstancePersistenceData);
+
+	FArchive& UnderlyingArchive = Record.GetUnderlyingArchive();
+	check(UnderlyingArchive.IsSaveGame());
+
+	// Note: InstanceData may be nullptr when loading, if there were persitence records saved for IAD's that have since been removed. In this case
+	// we still need to ensure the archive is seeked past this data to safely ignore it.
+	if (InstanceData == nullptr)
+	{
+		check(UnderlyingArchive.IsLoading());
+	}
+
+	// Note: Rather than serializing a flat array of InstanceDelta's directly as an Array Of Structs, we instead serialize a Struct Of Arrays
+	//       to optimize for the common case where we have lots of destroyed instances where rather than storing an array of instances with
+	//       true / false for destroyed state, we can just have an array of destroyed instane indices, factoring out the extra byte for destroyed
+	//       state.
+	// @todo: In hindsight we could / should just intrinisically have separate arrays / 'delta lists' of Destroyed Instances and Lifecycle Changes.
+
+	// Instance index width. Prior to FArsInstancedActorsCustomVersion::WideInstanceIndices, all indices were 16-bit.
+	// Note: This is the width at save time, which may differ from InstanceData->bWideInstanceIndices when loading
+	bool bWideInstanceIndices = false;
+	if (UnderlyingArchive.CustomVer(FArsInstancedActorsCustomVersion::GUID) >= FArsInstancedActorsCustomVersion::WideInstanceIndices)
+	{
+		bWideInstanceIndices = InstanceData && (InstanceData->bWideInstanceIndices || InstanceData->GetNumInstances() > FArsInstancedActorsInstanceIndex::MaxNarrowIndex + 1);
+		Record << SA_VALUE(TEXT("WideInstanceIndices"), bWideInstanceIndices);
+	}
+
+	// Delta records only contain the persistence state of instances and IAC data changed since the previous save
+	const UE::ArsInstancedActors::FInstanceDataPersistenceDirtyState* DirtyState = nullptr;
+	if (bDeltaRecord && !UnderlyingArchive.IsLoading())
+	{
+		check(InstanceData);
+		DirtyState = PersistenceDirtyStates.Find(InstanceData->ID);
+		check(DirtyState);
+	}
+
+	// Instances the delta record was saved for. Their persisted state is reset before applying the delta record, so that
+	// instances no longer destroyed or with fragments removed since the previous record are restored correctly
+	TArray<FArsInstancedActorsInstanceIndex> DirtyInstances;
+	if (bDeltaRecord)
+	{
+		if (DirtyState)
+		{
+			DirtyInstances.Reserve(DirtyState->InstanceIndices.Num());
+			for (const int32 DirtyInstanceIndex : DirtyState->InstanceIndices)
+			{
+				DirtyInstances.Emplace(DirtyInstanceIndex);
+			}
+		}
+
+		int32 NumDirtyInstances = DirtyInstances.Num();
+		FStructuredArchive::FArray DirtyInstancesArray = Record.EnterArray(TEXT("DirtyInstances"), NumDirtyInstances);
+		for (int32 ArrayIndex = 0; ArrayIndex < NumDirtyInstances; ++ArrayIndex)
+		{
+			FArsInstancedActorsInstanceIndex DirtyInstanceIndex = UnderlyingArchive.IsLoading() ? FArsInstancedActorsInstanceIndex() : DirtyInstances[ArrayIndex];
+			FArsInstancedActorsInstanceIndex::SerializeWithWidth(DirtyInstancesArray.EnterElement(), DirtyInstanceIndex, bWideInstanceIndices);
+
+			if (!ensureMsgf(!UnderlyingArchive.GetError(), TEXT("Error reading DirtyInstancesArray element. Aborting corrupted persistence archive read. Persistence data may be lost as a result.")))
+			{
+				return;
+			}
+
+			if (UnderlyingArchive.IsLoading() && InstanceData)
+			{
+				if (const FArsInstancedActorsDelta* InstanceDelta = InstanceData->InstanceDeltas.FindInstanceDelta(DirtyInstanceIndex))
+				{
+					TArray<const UScriptStruct*, TInlineAllocator<4>> PersistedFragmentTypes;
+					InstanceDelta->ForEachFragment([&PersistedFragmentTypes](FConstStructView Fragment)
+						{
+							if (EnumHasAnyFlags(UE::ArsInstancedActors::GetInstanceFragmentTypeFlags(Fragment.GetScriptStruct()), EArsInstancedActorsFragmentFlags::Persisted))
+							{
+								PersistedFragmentTypes.Add(Fragment.GetScriptStruct());
+							}
+						});
+
+					// Note: InstanceDelta may be removed from here on once it has no remaining deltas
+					if (InstanceDelta->IsDestroyed())
+					{
+						InstanceData->InstanceDeltas.RemoveDestroyedInstanceDelta(DirtyInstanceIndex);
+					}
+					for (const UScriptStruct* PersistedFragmentType : PersistedFragmentTypes)
+					{
+						InstanceData->InstanceDeltas.RemoveInstanceFragment(DirtyInstanceIndex, *PersistedFragmentType);
+					}
+				}
+			}
+		}
+	}
+
+	// Runtime added instances, with their manager-relative transforms. Serialized ahead of other instance state, so it can be
+	// applied to them. Note: Added state is never removed, so isn't reset for DirtyInstances above.
+	// @see UArsInstancedActorsData::AddRuntimeInstances
+	if (UnderlyingArchive.CustomVer(FArsInstancedActorsCustomVersion::GUID) >= FArsInstancedActorsCustomVersion::RuntimeAddedInstances)
+	{
+		TArray<const FArsInstancedActorsDelta*> AddedInstanceDeltas;
+		if (!UnderlyingArchive.IsLoading())
+		{
+			check(InstanceData);
+
+			if (bDeltaRecord)
+			{
+				for (const FArsInstancedActorsInstanceIndex& DirtyInstanceIndex : DirtyInstances)
+				{
+					const FArsInstancedActorsDelta* InstanceDelta = InstanceData->InstanceDeltas.FindInstanceDelta(DirtyInstanceIndex);
+					if (InstanceDelta && InstanceDelta->IsAdded())
+					{
+						AddedInstanceDeltas.Add(InstanceDelta);
+					}
+				}
+			}
+			else
+			{
+				AddedInstanceDeltas.Reserve(InstanceData->InstanceDeltas.GetNumAddedInstanceDeltas());
+				for (const FArsInstancedActorsDelta& Delta : InstanceData->InstanceDeltas.GetInstanceDeltas())
+				{
+					if (Delta.IsAdded())
+					{
+						AddedInstanceDeltas.Add(&Delta);
+					}
+				}
+			}
+		}
+
+		int32 NumAddedInstances = AddedInstanceDeltas.Num();
+		FStructuredArchive::FArray AddedInstancesArray = Record.EnterArray(TEXT("AddedInstances"), NumAddedInstances);
+
+		TArray<FArsInstancedActorsInstanceIndex> LoadedInstanceIndices;
+		TArray<FTransform> LoadedInstanceTransforms;
+		for (int32 ArrayIndex = 0; ArrayIndex < NumAddedInstances; ++ArrayIndex)
+		{
+			FStructuredArchiveRecord AddedInstanceRecord = AddedInstancesArray.EnterElement().EnterRecord();
+
+			FArsInstancedActorsInstanceIndex AddedInstanceIndex = UnderlyingArchive.IsLoading() ? FArsInstancedActorsInstanceIndex() : AddedInstanceDeltas[ArrayIndex]->GetInstanceIndex();
+			FArsInstancedActorsInstanceIndex::SerializeWithWidth(AddedInstanceRecord.EnterField(TEXT("InstanceIndex")), AddedInstanceIndex, bWideInstanceIndices);
+
+			FTransform AddedTransform = UnderlyingArchive.IsLoading() ? FTransform::Identity : AddedInstanceDeltas[ArrayIndex]->GetAddedTransform();
+			AddedInstanceRecord << SA_VALUE(TEXT("Transform"), AddedTransform);
+
+			if (!ensureMsgf(!UnderlyingArchive.GetError(), TEXT("Error reading AddedInstancesArray element. Aborting corrupted persistence archive read. Persistence data may be lost as a result.")))
+			{
+				return;
+			}
+
+			if (UnderlyingArchive.IsLoading() && InstanceData)
+			{
+				if (!ensureMsgf(AddedInstanceIndex.GetIndex() < InstanceData->GetMaxNumInstances() && UE::ArsInstancedActors::IsValidInstanceTransform(AddedTransform)
+					, TEXT("Skipping invalid persisted runtime added instance %s in %s"), *AddedInstanceIndex.GetDebugName(), *InstanceData->GetDebugName()))
+				{
+					continue;
+				}
+
+				LoadedInstanceIndices.Add(AddedInstanceIndex);
+				LoadedInstanceTransforms.Add(AddedTransform);
+			}
+		}
+
+		if (InstanceData && !LoadedInstanceIndices.IsEmpty())
+		{
+			// Instantiate before adding deltas, so they can cache instance locations for relevancy
+			InstanceData->InstantiateAddedInstances(LoadedInstanceIndices, LoadedInstanceTransforms);
+			for (int32 LoadedIndex = 0; LoadedIndex < LoadedInstanceIndices.Num(); ++LoadedIndex)
+			{
+				const FArsInstancedActorsDelta* InstanceDelta = InstanceData->InstanceDeltas.FindInstanceDelta(LoadedInstanceIndices[LoadedIndex]);
+				if (InstanceDelta == nullptr || !InstanceDelta->IsAdded())
+				{
+					InstanceData->InstanceDeltas.SetInstanceAdded(LoadedInstanceIndices[LoadedIndex], LoadedInstanceTransforms[LoadedIndex]);
+				}
+			}
+		}
+	}
+
+	// Destroyed instance indices
+	TArray<FArsInstancedActorsInstanceIndex> DestroyedInstances;
+	if (!UnderlyingArchive.IsLoading())
+	{
+		check(InstanceData);
+
+		if (bDeltaRecord)
+		{
+			for (const FArsInstancedActorsInstanceIndex& DirtyInstanceIndex : DirtyInstances)
+			{
+				const FArsInstancedActorsDelta* InstanceDelta = InstanceData->InstanceDeltas.FindInstanceDelta(DirtyInstanceIndex);
+				if (InstanceDelta && InstanceDelta->IsDestroyed())
+				{
+					DestroyedInstances.Add(DirtyInstanceIndex);
+				}
+			}
+		}
+		else
+		{
+			DestroyedInstances.Reserve(InstanceData->InstanceDeltas.GetNumDestroyedInstanceDeltas());
+			for (const FArsInstancedActorsDelta& Delta : InstanceData->InstanceDeltas.GetInstanceDeltas())
+			{
+				if (Delta.IsDestroyed())
+				{
+					DestroyedInstances.Add(Delta.GetInstanceIndex());
+				}
+			}
+			ensureMsgf(DestroyedInstances.Num() == InstanceData->InstanceDeltas.GetNumDestroyedInstanceDeltas(), TEXT("AArsInstancedActorsManager::SerializeInstancePersistenceData: Expectations are for the Number of Instances destroyed to match the number of Instances marked to be destroyed in serialization"));
+		}
+	}
+
+	int32 NumDestroyedInstances = UnderlyingArchive.IsLoading() ? INDEX_NONE : DestroyedInstances.Num();
+	FStructuredArchive::FArray DestroyedInstancesArray = Record.EnterArray(TEXT("DestroyedInstances"), NumDestroyedInstances);
+
+	if (UnderlyingArchive.IsLoading())
+	{
+		for (int32 ArrayIndex = 0; ArrayIndex < NumDestroyedInstances; ++ArrayIndex)
+		{
+			if (!ensureMsgf(InstanceData && ArrayIndex < InstanceData->GetNumInstances(), TEXT("Attempting to destroy more instances (%d) than actually exist (%d). Aborting corrupted persistence archive read. Persistence data may be lost as a result."), NumDestroyedInstances, InstanceData->GetNumInstances()))
+			{
+				UnderlyingArchive.SetError();
+				return;
+			}
+
+			FArsInstancedActorsInstanceIndex DestroyedInstanceIndex;
+			FArsInstancedActorsInstanceIndex::SerializeWithWidth(DestroyedInstancesArray.EnterElement(), DestroyedInstanceIndex, bWideInstanceIndices);
+
+			if (!ensureMsgf(!UnderlyingArchive.GetError(), TEXT("Error reading DestroyedInstancesArray element. Aborting corrupted persistence archive read. Persistence data may be lost as a result.")))
+			{
+				return;
+			}
+
+			if (InstanceData)
+			{
+				InstanceData->InstanceDeltas.SetInstanceDestroyed(DestroyedInstanceIndex);
+			}
+		}
+	}
+	else
+	{
+		for (FArsInstancedActorsInstanceIndex& DestroyedInstanceIndex : DestroyedInstances)
+		{
+			FArsInstancedActorsInstanceIndex::SerializeWithWidth(DestroyedInstancesArray.EnterElement(), DestroyedInstanceIndex, bWideInstanceIndices);
+		}
+	}
+
+	// Registered Persisted instance fragment values, serialized by type with a size header so values for types that are no longer
+	// registered can be safely skipped
+	// @see UE::ArsInstancedActors::RegisterInstanceFragmentType
+	if (UnderlyingArchive.CustomVer(FArsInstancedActorsCustomVersion::GUID) >= FArsInstancedActorsCustomVersion::InstanceFragments)
+	{
+		TArray<TPair<FArsInstancedActorsInstanceIndex, FConstStructView>> PersistedFragments;
+		if (!UnderlyingArchive.IsLoading())
+		{
+			check(InstanceData);
+			auto AddPersistedFragments = [&PersistedFragments](const FArsInstancedActorsDelta& Delta)
+				{
+					Delta.ForEachFragment([&PersistedFragments, &Delta](FConstStructView Fragment)
+						{
+							if (EnumHasAnyFlags(UE::ArsInstancedActors::GetInstanceFragmentTypeFlags(Fragment.GetScriptStruct()), EArsInstancedActorsFragmentFlags::Persisted))
+							{
+								PersistedFragments.Emplace(Delta.GetInstanceIndex(), Fragment);
+							}
+						});
+				};
+
+			if (bDeltaRecord)
+			{
+				for (const FArsInstancedActorsInstanceIndex& DirtyInstanceIndex : DirtyInstances)
+				{
+					if (const FArsInstancedActorsDelta* InstanceDelta = InstanceData->InstanceDeltas.FindInstanceDelta(DirtyInstanceIndex))
+					{
+						AddPersistedFragments(*InstanceDelta);
+					}
+				}
+			}
+			else
+			{
+				for (const FArsInstancedActorsDelta& Delta : InstanceData->InstanceDeltas.GetInstanceDeltas())
+				{
+					AddPersistedFragments(Delta);
+				}
+			}
+		}
+
+		int32 NumPersistedFragments = PersistedFragments.Num();
+		FStructuredArchiveArray InstanceFragmentsArray = Record.EnterArray(TEXT("InstanceFragments"), NumPersistedFragments);
+		for (int32 FragmentIndex = 0; FragmentIndex < NumPersistedFragments; ++FragmentIndex)
+		{
+			FStructuredArchiveRecord InstanceFragmentRecord = InstanceFragmentsArray.EnterElement().EnterRecord();
+
+			FArsInstancedActorsInstanceIndex InstanceIndex = UnderlyingArchive.IsLoading() ? FArsInstancedActorsInstanceIndex() : PersistedFragments[FragmentIndex].Key;
+			FArsInstancedActorsInstanceIndex::SerializeWithWidth(InstanceFragmentRecord.EnterField(TEXT("InstanceIndex")), InstanceIndex, bWideInstanceIndices);
+
+			const UScriptStruct* FragmentType = UnderlyingArchive.IsLoading() ? nullptr : PersistedFragments[FragmentIndex].Value.GetScriptStruct();
+			FString FragmentTypePath = FragmentType ? FragmentType->GetPathName() : FString();
+			InstanceFragmentRecord << SA_VALUE(TEXT("FragmentType"), FragmentTypePath);
+
+			const int64 FragmentDataSizeOffset = UnderlyingArchive.Tell();
+			int32 FragmentDataSize = 0;
+			InstanceFragmentRecord << SA_VALUE(TEXT("FragmentDataSize"), FragmentDataSize);
+
+			const int64 FragmentDataStartOffset = UnderlyingArchive.Tell();
+			if (UnderlyingArchive.IsLoading())
+			{
+				if (!ensureMsgf(!UnderlyingArchive.IsError() && (FragmentDataSize >= 0 || UnderlyingArchive.IsTextFormat()), TEXT("Error reading InstanceFragments element. Aborting corrupted persistence archive read. Persistence data may be lost as a result.")))
+				{
+					UnderlyingArchive.SetError();
+					return;
+				}
+
+				FragmentType = FindObject<UScriptStruct>(nullptr, *FragmentTypePath);
+				if (InstanceData && EnumHasAnyFlags(UE::ArsInstancedActors::GetInstanceFragmentTypeFlags(FragmentType), EArsInstancedActorsFragmentFlags::Persisted))
+				{
+					FInstancedStruct Fragment;
+					Fragment.InitializeAs(FragmentType);
+					FragmentType->SerializeItem(InstanceFragmentRecord.EnterField(TEXT("FragmentData")), Fragment.GetMutableMemory(), /*Defaults*/nullptr);
+
+					// Make sure we read the full block. Text archives don't back-patch sizes or support seeking, see below, but
+					// don't need to as fields are read by name.
+					if (UnderlyingArchive.IsTextFormat() || ensure(IntCastChecked<int32>(UnderlyingArchive.Tell() - FragmentDataStartOffset) == FragmentDataSize))
+					{
+						InstanceData->InstanceDeltas.SetInstanceFragment(InstanceIndex, FConstStructView(Fragment));
+					}
+					else
+					{
+						UnderlyingArchive.Seek(FragmentDataStartOffset + FragmentDataSize);
+					}
+				}
+				else
+				{
+					// Skip values for types which are no longer registered as persisted
+					UE_CLOG(InstanceData, LogArsInstancedActors, Warning, TEXT("%s: Instance fragment type %s is no longer registered as Persisted. Skipping persisted value which will be lost on resave."), *InstanceData->GetDebugName(), *FragmentTypePath);
+					if (!UnderlyingArchive.IsTextFormat())
+					{
+						UnderlyingArchive.Seek(FragmentDataStartOffset + FragmentDataSize);
+					}
+				}
+			}
+			else
+			{
+				check(FragmentType);
+				FragmentType->SerializeItem(InstanceFragmentRecord.EnterField(TEXT("FragmentData")), const_cast<uint8*>(PersistedFragments[FragmentIndex].Value.GetMemory()), /*Defaults*/nullptr);
+
+				// Seek back and re-write the size now we know what it is
+				const int64 FragmentDataEndOffset = UnderlyingArchive.Tell();
+				FragmentDataSize = IntCastChecked<int32>(FragmentDataEndOffset - FragmentDataStartOffset);
+				if (!UnderlyingArchive.IsTextFormat())
+				{
+					UnderlyingArchive.Seek(FragmentDataSizeOffset);
+					UnderlyingArchive << FragmentDataSize;
+					UnderlyingArchive.Seek(FragmentDataEndOffset);
+				}
+			}
+
+			if (UnderlyingArchive.IsError())
+			{
+				return;
+			}
+		}
+	}
+
+	// Allow UInstancedActorComponents (IAC's) to extend persistence
+	//
+	// IAC persistence entries are written out with an ID & size header so they can be matched up with their
+	// serialization implementation when read back later or safely skipped if the IAC has since been removed
+	// from ActorClass
+	TMap<uint32, UArsInstancedActorsComponent*, TInlineSetAllocator<2>> IACsByPersistenceID;
+	TMap<UArsInstancedActorsComponent*, uint32, TInlineSetAllocator<2>> IACPersistenceIDs;
+	int32 NumPersistedIACs = 0;
+	if (InstanceData)
+	{
+		TSharedPtr<UE::ArsInstancedActors::FExemplarActorData> ExemplarActorData = GetInstancedActorSubsystemChecked().GetOrCreateExemplarActor(InstanceData->ActorClass);
+		const AActor* const ExemplarActor = ExemplarActorData->Actor.Get();
+		check(ExemplarActor);
+		ExemplarActor->ForEachComponent<UArsInstancedActorsComponent>(/*bIncludeFromChildActors*/ false, [&](UArsInstancedActorsComponent* InstancedActorComponent)
+			{
+				// Skip IAC's that don't want / need serialization. When writing this ensures we don't waste space by writing empty entries.
+				if (InstancedActorComponent->ShouldSerializeInstancePersistenceData(UnderlyingArchive, InstanceData, TimeDelta))
+				{
+					const uint32 IACPersistenceID = InstancedActorComponent->GetInstancePersistenceDataID();
+
+					// Delta records only write IAC data that has changed since the previous save, for IACs which report their changes
+					if (DirtyState && !DirtyState->bAllIACPersistenceData && InstancedActorComponent->SupportsIncrementalPersistence()
+						&& !DirtyState->IACPersistenceIDs.Contains(IACPersistenceID))
+					{
+						return;
+					}
+
+					if (ensureMsgf(IACPersistenceID != 0, TEXT("UArsInstancedActorsComponent classes implementing ShouldSerializeInstancePersistenceData (%s) must also implement GetInstancePersistenceDataID and return a non-zero value"), *InstancedActorComponent->GetClass()->GetPathName()))
+					{
+						IACsByPersistenceID.Add(IACPersistenceID, InstancedActorComponent);
+						IACPersistenceIDs.Add(InstancedActorComponent, IACPersistenceID);
+						++NumPersistedIACs;
+					}
+				} });
+	}
+	FStructuredArchiveArray InstancedActorComponentDataArray = Record.EnterArray(TEXT("InstancedActorComponentData"), NumPersistedIACs);
+	if (UnderlyingArchive.IsLoading())
+	{
+		for (int32 IACIndex = 0; IACIndex < NumPersistedIACs; ++IACIndex)
 		{
 			FStructuredArchiveRecord InstancedActorComponentDataRecord = InstancedActorComponentDataArray.EnterElement().EnterRecord();
 
@@ -657,18 +1451,21 @@ void AArsInstancedActorsManager::SerializeInstancePersistenceData(FStructuredArc
 				// Deserialize IAC data
 				(*InstancedActorComponent)->SerializeInstancePersistenceData(InstancedActorComponentDataRecord, InstanceData, TimeDelta);
 
-				const int64 IACPersistenceDataEndOffset = UnderlyingArchive.Tell();
-				const int32 IACPersistenceDataSizeRead = IntCastChecked<int32>(IACPersistenceDataEndOffset - IACPersistenceDataStartOffset);
-
-				// Make sure we read the full block
-				if (!ensure(IACPersistenceDataSizeRead == IACPersistenceDataSize))
+				// Make sure we read the full block. Text archives don't back-patch sizes or support seeking, but don't need to as
+				// fields are read by name.
+				if (!UnderlyingArchive.IsTextFormat())
 				{
-					UnderlyingArchive.Seek(IACPersistenceDataStartOffset + IACPersistenceDataSize);
+					const int64 IACPersistenceDataEndOffset = UnderlyingArchive.Tell();
+					const int32 IACPersistenceDataSizeRead = IntCastChecked<int32>(IACPersistenceDataEndOffset - IACPersistenceDataStartOffset);
+					if (!ensure(IACPersistenceDataSizeRead == IACPersistenceDataSize))
+					{
+						UnderlyingArchive.Seek(IACPersistenceDataStartOffset + IACPersistenceDataSize);
+					}
 				}
 			}
 			else
 			{
-				if (!ensureMsgf(IACPersistenceDataSize >= 0, TEXT("Expected valid positive data size in bytes >= 0. Found: %d. Aborting persistence archive read. Persistence data may be lost as a result."), IACPersistenceDataSize))
+				if (!UnderlyingArchive.IsTextFormat() && !ensureMsgf(IACPersistenceDataSize >= 0, TEXT("Expected valid positive data size in bytes >= 0. Found: %d. Aborting persistence archive read. Persistence data may be lost as a result."), IACPersistenceDataSize))
 				{
 					UnderlyingArchive.SetError();
 					return;
@@ -677,7 +1474,10 @@ void AArsInstancedActorsManager::SerializeInstancePersistenceData(FStructuredArc
 				// Skip IAC data block which we no longer have a matching IAC to read with
 				UE_CLOG(!InstanceData, LogArsInstancedActors, Error, TEXT("No UInstancedActorComponent with PersistenceID %u found due to no IAD found to get exemplar for! Skipping this IAC data block which will be lost on resave!"), IACPersistenceID);
 				UE_CLOG(InstanceData, LogArsInstancedActors, Error, TEXT("No UInstancedActorComponent with PersistenceID %u found in %s ExemplarActor. Skipping this IAC data block which will be lost on resave!"), IACPersistenceID, *InstanceData->ActorClass->GetPathName());
-				UnderlyingArchive.Seek(UnderlyingArchive.Tell() + IACPersistenceDataSize);
+				if (!UnderlyingArchive.IsTextFormat())
+				{
+					UnderlyingArchive.Seek(UnderlyingArchive.Tell() + IACPersistenceDataSize);
+				}
 			}
 
 			if (UnderlyingArchive.IsError())
@@ -757,32 +1557,14 @@ void AArsInstancedActorsManager::SetGridGuid(const FGuid& InGuid)
 	ManagerGridGuid = InGuid;
 }
 
-UArsInstancedActorsData* AArsInstancedActorsManager::CreateNextInstanceActorData(TSubclassOf<AActor> ActorClass, const FArsInstancedActorsTagSet& AdditionalInstanceTags)
-{
-	check(ArsInstancedActorsDataClass);
-
-	const FString InstanceDataNameStr = FString::Printf(TEXT("ArsInstancedActorsData_%s"), *ActorClass->GetFName().ToString());
-	const FName UniqueName = MakeUniqueObjectName(this, ArsInstancedActorsDataClass, FName(InstanceDataNameStr));
-	UArsInstancedActorsData* NewInstanceData = NewObject<UArsInstancedActorsData>(this, ArsInstancedActorsDataClass, UniqueName);
-	// @todo it's conceivable the NextInstanceDataID will overflow. We need to use some handle system in place instead. 
-	NewInstanceData->ID = NextInstanceDataID++;
-	NewInstanceData->ActorClass = ActorClass;
-	NewInstanceData->AdditionalTags = AdditionalInstanceTags;
-	check(Algo::NoneOf(PerActorClassInstanceData, [NewInstanceData](UArsInstancedActorsData* InstanceData)
-		{
-			return InstanceData->ID == NewInstanceData->ID;
-		}));
-
-	return NewInstanceData;
-}
-
 UArsInstancedActorsData& AArsInstancedActorsManager::GetOrCreateActorInstanceData(TSubclassOf<AActor> ActorClass, const FArsInstancedActorsTagSet& AdditionalInstanceTags, bool bCreateEditorPreviewISMCs)
 {
 	checkf(HasActorBegunPlay() == false, TEXT("AArsInstancedActorsManager doesn't yet support runtime addition of instances"));
 
 	TObjectPtr<UArsInstancedActorsData>* InstanceData = PerActorClassInstanceData.FindByPredicate([ActorClass, AdditionalInstanceTags](TObjectPtr<UArsInstancedActorsData> InstanceData)
 		{ 
-			return InstanceData->ActorClass == ActorClass && InstanceData->AdditionalTags == AdditionalInstanceTags; 
+			// Note: Full IAD's are skipped, spilling further instances into a new IAD
+			return InstanceData->ActorClass == ActorClass && InstanceData->AdditionalTags == AdditionalInstanceTags && InstanceData->CanAddInstance();
 		});
 
 	if (InstanceData != nullptr)
@@ -793,6 +1575,7 @@ UArsInstancedActorsData& AArsInstancedActorsManager::GetOrCreateActorInstanceDat
 
 	UArsInstancedActorsData* NewInstanceData = CreateNextInstanceActorData(ActorClass, AdditionalInstanceTags);
 	PerActorClassInstanceData.Add(NewInstanceData);
+	InstanceDataClassMasks.Reset();
 
 	if (bCreateEditorPreviewISMCs)
 	{
@@ -871,6 +1654,114 @@ bool AArsInstancedActorsManager::RemoveActorInstance(const FArsInstancedActorsIn
 }
 #endif // WITH_EDITOR
 
+UArsInstancedActorsData* AArsInstancedActorsManager::CreateNextInstanceActorData(TSubclassOf<AActor> ActorClass, const FArsInstancedActorsTagSet& AdditionalInstanceTags)
+{
+	check(ArsInstancedActorsDataClass);
+
+	const FString InstanceDataNameStr = FString::Printf(TEXT("ArsInstancedActorsData_%s"), *ActorClass->GetFName().ToString());
+	const FName UniqueName = MakeUniqueObjectName(this, ArsInstancedActorsDataClass, FName(InstanceDataNameStr));
+	UArsInstancedActorsData* NewInstanceData = NewObject<UArsInstancedActorsData>(this, ArsInstancedActorsDataClass, UniqueName);
+	// @todo it's conceivable the NextInstanceDataID will overflow. We need to use some handle system in place instead. 
+	NewInstanceData->ID = NextInstanceDataID++;
+	NewInstanceData->ActorClass = ActorClass;
+	NewInstanceData->bWideInstanceIndices = GetDefault<UArsInstancedActorsProjectSettings>()->bWideInstanceIndicesByDefault;
+	NewInstanceData->AdditionalTags = AdditionalInstanceTags;
+	check(Algo::NoneOf(PerActorClassInstanceData, [NewInstanceData](UArsInstancedActorsData* InstanceData)
+		{
+			return InstanceData->ID == NewInstanceData->ID;
+		}));
+
+	return NewInstanceData;
+}
+
+UArsInstancedActorsData* AArsInstancedActorsManager::CreateRuntimeInstanceData(TSubclassOf<AActor> ActorClass, const FArsInstancedActorsTagSet& AdditionalInstanceTags, const TOptional<uint16> InstanceDataID)
+{
+	check(ActorClass);
+	if (!ensureMsgf(HasAuthority(), TEXT("Runtime instance data creation is authority only. Clients receive runtime created IADs via replication")))
+	{
+		return nullptr;
+	}
+
+	const uint16 NewInstanceDataID = InstanceDataID.Get(NextInstanceDataID);
+	if (!ensureMsgf(NewInstanceDataID < MAX_uint16, TEXT("%s has run out of instance data IDs"), *GetPathName())
+		|| !ensureMsgf(FindInstanceDataByID(NewInstanceDataID) == nullptr, TEXT("%s already has an IAD with ID %u"), *GetPathName(), NewInstanceDataID))
+	{
+		return nullptr;
+	}
+
+	// Once frozen, composite index width can't grow to fit, so the IAD ID must fit the high bits left by the instance index
+	if (bCompositeInstanceIndexBitsFrozen && uint64(NewInstanceDataID) >= (uint64(1) << (32 - CompositeInstanceIndexBits)))
+	{
+		UE_LOG(LogArsInstancedActors, Warning, TEXT("%s: Can't create a runtime IAD for %s with ID %u, exceeding this manager's %d bit composite instance data IDs")
+			, *GetPathName(), *ActorClass->GetName(), NewInstanceDataID, 32 - CompositeInstanceIndexBits);
+		return nullptr;
+	}
+
+	const uint16 PrevNextInstanceDataID = NextInstanceDataID;
+	NextInstanceDataID = NewInstanceDataID;
+	UArsInstancedActorsData* NewInstanceData = CreateNextInstanceActorData(ActorClass, AdditionalInstanceTags);
+	NextInstanceDataID = FMath::Max<uint16>(PrevNextInstanceDataID, NewInstanceDataID + 1);
+	check(NewInstanceData);
+
+	NewInstanceData->RuntimeCreationDesc.ActorClass = ActorClass;
+	NewInstanceData->RuntimeCreationDesc.AdditionalTags = AdditionalInstanceTags.GetTags();
+	NewInstanceData->RuntimeCreationDesc.ID = NewInstanceData->ID;
+	NewInstanceData->RuntimeCreationDesc.bWideInstanceIndices = NewInstanceData->bWideInstanceIndices;
+
+	RegisterRuntimeInstanceData(*NewInstanceData);
+
+	UE_LOG(LogArsInstancedActors, Verbose, TEXT("%s created runtime instance data %s"), *GetPathName(), *NewInstanceData->GetDebugName(/*bCompact*/ true));
+
+	return NewInstanceData;
+}
+
+void AArsInstancedActorsManager::OnRuntimeInstanceDataReplicated(UArsInstancedActorsData& InstanceData)
+{
+	check(InstanceData.IsRuntimeCreated());
+	if (PerActorClassInstanceData.Contains(&InstanceData))
+	{
+		return;
+	}
+
+	const FArsInstancedActorsRuntimeInstanceDataDesc& RuntimeCreationDesc = InstanceData.RuntimeCreationDesc;
+	InstanceData.ID = RuntimeCreationDesc.ID;
+	InstanceData.ActorClass = RuntimeCreationDesc.ActorClass;
+	InstanceData.AdditionalTags = FArsInstancedActorsTagSet(RuntimeCreationDesc.AdditionalTags);
+	InstanceData.bWideInstanceIndices = RuntimeCreationDesc.bWideInstanceIndices;
+
+	if (!ensureMsgf(FindInstanceDataByID(InstanceData.ID) == nullptr, TEXT("%s already has an IAD with ID %u, ignoring replicated runtime IAD %s")
+		, *GetPathName(), InstanceData.ID, *InstanceData.GetName()))
+	{
+		return;
+	}
+
+	RegisterRuntimeInstanceData(InstanceData);
+}
+
+void AArsInstancedActorsManager::RegisterRuntimeInstanceData(UArsInstancedActorsData& InstanceData)
+{
+	check(!PerActorClassInstanceData.Contains(&InstanceData));
+
+	PerActorClassInstanceData.Add(&InstanceData);
+	InstanceDataClassMasks.Reset();
+
+	InstanceData.CachedLocalBounds = CalculateBounds(InstanceData.ActorClass);
+	ensure(InstanceData.CachedLocalBounds.IsValid);
+
+	REDIRECT_OBJECT_TO_VLOG(&InstanceData, this);
+	// As per SetupLoadedInstances, added on clients too for replays
+	AddReplicatedSubObject(&InstanceData);
+
+	// Once the other IADs have been initialized, there's no later InitializeModifyAndSpawnEntities to initialize this one. Its
+	// entities are then spawned by UArsInstancedActorsData::InstantiateAddedInstances as instances are added.
+	if (HasSpawnedEntities() || IsPreparingSpawnEntities())
+	{
+		InstanceData.Initialize();
+	}
+
+	FlushNetDormancy();
+}
+
 UArsInstancedActorsData* AArsInstancedActorsManager::FindInstanceDataByID(uint16 InstanceDataID) const
 {
 	// Shortcut for the usual case where no IAD's have been deleted
@@ -905,10 +1796,20 @@ void AArsInstancedActorsManager::RuntimeRemoveAllInstances()
 	{
 		InstanceData->RuntimeRemoveAllInstances();
 	}
-}
+}
+
+void AArsInstancedActorsManager::DespawnAllEntities()
+{
+	// Discard any spawn preparation that was never committed
+	if (bIsPreparingSpawnEntities)
+	{
+		for (TObjectPtr<UArsInstancedActorsData> InstanceData : PerActorClassInstanceData)
+		{
+			InstanceData->CancelSpawnEntitiesPreparation();
+		}
+		bIsPreparingSpawnEntities = false;
+	}
 
-void AArsInstancedActorsManager::DespawnAllEntities()
-{
 	// DespawnEntities for all PerActorClassInstanceData
 	if (HasSpawnedEntities())
 	{
@@ -919,6 +1820,28 @@ void AArsInstancedActorsManager::DespawnAllEntities()
 		}
 		bHasSpawnedEntities = false;
 	}
+
+	// Runtime added instances have been truncated in DespawnEntities, to be re-added from instance deltas
+	RuntimeAddedInstanceBounds.Init();
+}
+
+void AArsInstancedActorsManager::OnRuntimeInstancesAdded(const FBox& AddedInstancesBounds)
+{
+	RuntimeAddedInstanceBounds += AddedInstancesBounds;
+
+	// Prior to BeginPlay, RuntimeAddedInstanceBounds will be included when first calculating InstanceBounds
+	if (!InstanceBounds.IsValid || InstanceBounds.IsInsideOrOn(AddedInstancesBounds))
+	{
+		return;
+	}
+
+	const FBox PreviousInstanceBounds = InstanceBounds;
+	InstanceBounds += AddedInstancesBounds;
+
+	if (ManagerHandle.IsValid() && InstancedActorSubsystem)
+	{
+		InstancedActorSubsystem->UpdateManagerBounds(ManagerHandle, PreviousInstanceBounds);
+	}
 }
 
 bool AArsInstancedActorsManager::ForEachInstance(FInstanceOperationFunc Operation) const
@@ -929,8 +1852,34 @@ bool AArsInstancedActorsManager::ForEachInstance(FInstanceOperationFunc Operatio
 }
 
 bool AArsInstancedActorsManager::ForEachInstance(FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate) const
+{
+	for (TObjectPtr<UArsInstancedActorsData> InstanceData : PerActorClassInstanceData)
+	{
+		// InstancedActorDataPredicate filter PerActorClassInstanceData
+		check(IsValid(InstanceData));
+		if (InstancedActorDataPredicate.IsSet())
+		{
+			const bool bPassedPredicate = ::Invoke(*InstancedActorDataPredicate, *InstanceData);
+			if (!bPassedPredicate)
+			{
+				continue;
+			}
+		}
+
+		if (!ForEachInstanceInInstanceData(*InstanceData, Operation, IterationContext))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool AArsInstancedActorsManager::ForEachInstanceInInstanceData(UArsInstancedActorsData& InstanceData, FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext
+	, TOptional<TConstArrayView<FArsInstancedActorsInstanceIndex>> InstanceIndices, TOptional<FInstanceLocationFilterFunc> LocationFilter) const
 {
 	FArsInstancedActorsInstanceHandle InstanceHandle;
+	InstanceHandle.InstancedActorData = &InstanceData;
 
 	bool bContinue = true;
 
@@ -939,55 +1888,86 @@ bool AArsInstancedActorsManager::ForEachInstance(FInstanceOperationFunc Operatio
 	{
 		check(MassEntityManager.IsValid());
 
-		for (TObjectPtr<UArsInstancedActorsData> InstanceData : PerActorClassInstanceData)
+		TArray<FMassArchetypeEntityCollection> EntityCollections;
+		if (InstanceIndices.IsSet())
 		{
-			// InstancedActorDataPredicate filter PerActorClassInstanceData
-			check(IsValid(InstanceData));
-			if (InstancedActorDataPredicate.IsSet())
+			TArray<FMassEntityHandle> CandidateEntities;
+			CandidateEntities.Reserve(InstanceIndices->Num());
+			for (const FArsInstancedActorsInstanceIndex InstanceIndex : *InstanceIndices)
 			{
-				const bool bPassedPredicate = ::Invoke(*InstancedActorDataPredicate, *InstanceData);
-				if (!bPassedPredicate)
+				const FMassEntityHandle EntityHandle = InstanceData.GetEntity(InstanceIndex);
+				if (EntityHandle.IsSet())
 				{
-					continue;
+					CandidateEntities.Add(EntityHandle);
 				}
 			}
 
-			InstanceHandle.InstancedActorData = InstanceData;
+			if (CandidateEntities.IsEmpty())
+			{
+				return true;
+			}
+
+			UE::Mass::Utils::CreateEntityCollections(*MassEntityManager, CandidateEntities, FMassArchetypeEntityCollection::NoDuplicates, EntityCollections);
+		}
+		else
+		{
+			UE::Mass::Utils::CreateEntityCollections(*MassEntityManager, InstanceData.Entities, FMassArchetypeEntityCollection::NoDuplicates, EntityCollections);
+		}
 
-			TArray<FMassArchetypeEntityCollection> EntityCollections;
-			UE::Mass::Utils::CreateEntityCollections(*MassEntityManager, InstanceData->Entities, FMassArchetypeEntityCollection::NoDuplicates, EntityCollections);
+		UE::ArsInstancedActors::BoundsTests::FLocationsSoA ChunkLocations;
+		TArray<int32> ChunkCandidates;
 
-			FMassExecutionContext ExecutionContext(*MassEntityManager);
-			InstancedActorLocationQuery.ForEachEntityChunkInCollections(EntityCollections, ExecutionContext, [&IterationContext, &InstanceHandle, &Operation, &bContinue](FMassExecutionContext& Context)
+		FMassExecutionContext ExecutionContext(*MassEntityManager);
+		InstancedActorLocationQuery.ForEachEntityChunkInCollections(EntityCollections, ExecutionContext, [&IterationContext, &InstanceHandle, &Operation, &LocationFilter, &ChunkLocations, &ChunkCandidates, &bContinue](FMassExecutionContext& Context)
+			{
+				if (!bContinue)
 				{
-					if (!bContinue)
-					{
-						return;
-					}
+					return;
+				}
 
-					TConstArrayView<FArsInstancedActorsFragment> InstancedActorFragments = Context.GetFragmentView<FArsInstancedActorsFragment>();
-					TConstArrayView<FTransformFragment> TransformsFragments = Context.GetFragmentView<FTransformFragment>();
-					for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
+				TConstArrayView<FArsInstancedActorsFragment> InstancedActorFragments = Context.GetFragmentView<FArsInstancedActorsFragment>();
+				TConstArrayView<FTransformFragment> TransformsFragments = Context.GetFragmentView<FTransformFragment>();
+
+				auto ExecuteOperation = [&](const int32 EntityIndex)
 					{
-						const FTransformFragment& TransformFragment = TransformsFragments[EntityIt];
+						const FTransformFragment& TransformFragment = TransformsFragments[EntityIndex];
 
-						const FArsInstancedActorsFragment& InstancedActorFragment = InstancedActorFragments[EntityIt];
+						const FArsInstancedActorsFragment& InstancedActorFragment = InstancedActorFragments[EntityIndex];
 						InstanceHandle.Index = InstancedActorFragment.InstanceIndex;
 
 						// Execute operation
-						bContinue = Operation(InstanceHandle, TransformFragment.GetTransform(), IterationContext);
+						return Operation(InstanceHandle, TransformFragment.GetTransform(), IterationContext);
+					};
+
+				// Batch test the chunk's locations, only visiting entities which pass
+				if (LocationFilter.IsSet())
+				{
+					ChunkLocations.Reset();
+					ChunkLocations.AddTransforms(TransformsFragments);
+					ChunkCandidates.Reset();
+					::Invoke(*LocationFilter, ChunkLocations, ChunkCandidates);
+
+					for (const int32 EntityIndex : ChunkCandidates)
+					{
+						bContinue = ExecuteOperation(EntityIndex);
 						if (!bContinue)
 						{
 							return;
 						}
 					}
-				});
-
-			if (!bContinue)
-			{
-				break;
-			}
-		}
+				}
+				else
+				{
+					for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
+					{
+						bContinue = ExecuteOperation(EntityIt);
+						if (!bContinue)
+						{
+							return;
+						}
+					}
+				}
+			});
 	}
 	// Before begin play, iterate source InstanceTransforms list
 	else
@@ -996,53 +1976,95 @@ bool AArsInstancedActorsManager::ForEachInstance(FInstanceOperationFunc Operatio
 		const FTransform& ManagerTransform = GetActorTransform();
 		const bool bApplyManagerTranslationOnly = (GetActorQuat().IsIdentity() && GetActorScale().Equals(FVector::OneVector));
 
-		for (TObjectPtr<UArsInstancedActorsData> InstanceData : PerActorClassInstanceData)
-		{
-			// InstancedActorDataPredicate filter PerActorClassInstanceData
-			check(IsValid(InstanceData));
-			if (InstancedActorDataPredicate.IsSet())
+		const int32 NumToIterate = InstanceIndices.IsSet() ? InstanceIndices->Num() : InstanceData.InstanceTransforms.Num();
+
+		// @return InstanceTransforms index of the IterationIndex'th instance to visit, or INDEX_NONE if invalid
+		auto GetValidInstanceIndex = [&](const int32 IterationIndex)
 			{
-				const bool bPassedPredicate = ::Invoke(*InstancedActorDataPredicate, *InstanceData);
-				if (!bPassedPredicate)
+				const int32 InstanceIndex = InstanceIndices.IsSet() ? (*InstanceIndices)[IterationIndex].GetIndex() : IterationIndex;
+				if (!InstanceData.InstanceTransforms.IsValidIndex(InstanceIndex)
+					|| !UE::ArsInstancedActors::IsValidInstanceTransform(InstanceData.InstanceTransforms[InstanceIndex]))
 				{
-					continue;
+					return int32(INDEX_NONE);
 				}
-			}
-
-			InstanceHandle.InstancedActorData = InstanceData;
+				return InstanceIndex;
+			};
 
-			uint16 InstanceIndex = 0;
-			for (const FTransform& InstanceTransform : InstanceData->InstanceTransforms)
+		auto ComputeWorldSpaceInstanceTransform = [&](const int32 InstanceIndex)
 			{
-				if (UE::ArsInstancedActors::IsValidInstanceTransform(InstanceTransform))
+				FTransform WorldSpaceInstanceTransform = InstanceData.InstanceTransforms[InstanceIndex];
+				if (bApplyManagerTranslationOnly)
 				{
-					InstanceHandle.Index = FArsInstancedActorsInstanceIndex(InstanceIndex);
+					WorldSpaceInstanceTransform.AddToTranslation(ManagerLocation);
+				}
+				else
+				{
+					WorldSpaceInstanceTransform *= ManagerTransform;
+				}
+				return WorldSpaceInstanceTransform;
+			};
 
-					// Compute world space transform
-					FTransform WorldSpaceInstanceTransform = InstanceTransform;
-					if (bApplyManagerTranslationOnly)
-					{
-						WorldSpaceInstanceTransform.AddToTranslation(ManagerLocation);
-					}
-					else
+		auto ExecuteOperation = [&](const int32 InstanceIndex, const FTransform& WorldSpaceInstanceTransform)
+			{
+				InstanceHandle.Index = FArsInstancedActorsInstanceIndex(InstanceIndex);
+
+				// Execute operation
+				return Operation(InstanceHandle, WorldSpaceInstanceTransform, IterationContext);
+			};
+
+		// Batch test world space locations in blocks, only visiting instances which pass
+		if (LocationFilter.IsSet())
+		{
+			constexpr int32 BlockSize = 256;
+			TArray<int32, TInlineAllocator<BlockSize>> BlockInstanceIndices;
+			TArray<FTransform> BlockTransforms;
+			BlockTransforms.Reserve(FMath::Min(BlockSize, NumToIterate));
+			UE::ArsInstancedActors::BoundsTests::FLocationsSoA BlockLocations;
+			TArray<int32> BlockCandidates;
+
+			for (int32 BlockStart = 0; bContinue && BlockStart < NumToIterate; BlockStart += BlockSize)
+			{
+				BlockInstanceIndices.Reset();
+				BlockTransforms.Reset();
+				const int32 BlockEnd = FMath::Min(BlockStart + BlockSize, NumToIterate);
+				for (int32 IterationIndex = BlockStart; IterationIndex < BlockEnd; ++IterationIndex)
+				{
+					const int32 InstanceIndex = GetValidInstanceIndex(IterationIndex);
+					if (InstanceIndex != INDEX_NONE)
 					{
-						WorldSpaceInstanceTransform *= ManagerTransform;
+						BlockInstanceIndices.Add(InstanceIndex);
+						BlockTransforms.Add(ComputeWorldSpaceInstanceTransform(InstanceIndex));
 					}
+				}
 
-					// Execute operation
-					bContinue = Operation(InstanceHandle, WorldSpaceInstanceTransform, IterationContext);
+				BlockLocations.Reset();
+				BlockLocations.AddTransforms(BlockTransforms);
+				BlockCandidates.Reset();
+				::Invoke(*LocationFilter, BlockLocations, BlockCandidates);
+
+				for (const int32 BlockIndex : BlockCandidates)
+				{
+					bContinue = ExecuteOperation(BlockInstanceIndices[BlockIndex], BlockTransforms[BlockIndex]);
 					if (!bContinue)
 					{
 						break;
 					}
 				}
-
-				++InstanceIndex;
 			}
-
-			if (!bContinue)
+		}
+		else
+		{
+			for (int32 IterationIndex = 0; IterationIndex < NumToIterate; ++IterationIndex)
 			{
-				break;
+				const int32 InstanceIndex = GetValidInstanceIndex(IterationIndex);
+				if (InstanceIndex != INDEX_NONE)
+				{
+					bContinue = ExecuteOperation(InstanceIndex, ComputeWorldSpaceInstanceTransform(InstanceIndex));
+					if (!bContinue)
+					{
+						break;
+					}
+				}
 			}
 		}
 	}
@@ -1061,20 +2083,133 @@ bool AArsInstancedActorsManager::ForEachInstance(const TBoundsType& QueryBounds,
 template <typename TBoundsType>
 bool AArsInstancedActorsManager::ForEachInstance(const TBoundsType& QueryBounds, FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate) const
 {
-	return ForEachInstance([&QueryBounds, &Operation](const FArsInstancedActorsInstanceHandle& InstanceHandle, const FTransform& InstanceTransform, FArsInstancedActorsIterationContext& IterationContext)
+	using UE::ArsInstancedActors::EBoundsTestType;
+
+	return ForEachInstanceInBounds(QueryBounds, Operation, IterationContext, [&InstancedActorDataPredicate](const UArsInstancedActorsData& InstanceData) -> TOptional<EBoundsTestType>
 		{
-			if (UE::ArsInstancedActors::PassesBoundsTest(QueryBounds, UE::ArsInstancedActors::EBoundsTestType::Intersect, InstanceHandle, InstanceTransform))
+			if (InstancedActorDataPredicate.IsSet() && !::Invoke(*InstancedActorDataPredicate, InstanceData))
 			{
-				return Operation(InstanceHandle, InstanceTransform, IterationContext);
+				return TOptional<EBoundsTestType>();
 			}
-			return true;
-		},
-		IterationContext, InstancedActorDataPredicate);
+			return EBoundsTestType::Intersect;
+		});
+}
+
+template <typename TBoundsType>
+bool AArsInstancedActorsManager::ForEachInstanceInBounds(const TBoundsType& QueryBounds, FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext
+	, FInstancedActorDataBoundsTestTypeFunc BoundsTestTypeFunc) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(AArsInstancedActorsManager ForEachInstanceInBounds);
+
+	using namespace UE::ArsInstancedActors;
+
+	TArray<FArsInstancedActorsInstanceIndex> CandidateInstances;
+
+	for (TObjectPtr<UArsInstancedActorsData> InstanceData : PerActorClassInstanceData)
+	{
+		check(IsValid(InstanceData));
+		const TOptional<EBoundsTestType> BoundsTestType = ::Invoke(BoundsTestTypeFunc, *InstanceData);
+		if (!BoundsTestType.IsSet())
+		{
+			continue;
+		}
+
+		// Intersect tests may pass for instances whose bounds reach QueryBounds from outside it, so pad location tests by the
+		// instance bounds radius. Enclosed tests require the location itself to be inside.
+		const double InstanceBoundsRadius = (*BoundsTestType == EBoundsTestType::Intersect) ? BoundsTests::GetBoundsRadius(InstanceData->GetCachedLocalBounds()) : 0.0;
+		const BoundsTests::TInstanceLocationFilter<TBoundsType> LocationFilter(QueryBounds, InstanceBoundsRadius);
+		auto GatherLocationCandidates = [&LocationFilter](const BoundsTests::FLocationsSoA& Locations, TArray<int32>& OutCandidates)
+			{
+				return LocationFilter.GatherCandidates(Locations, OutCandidates);
+			};
+
+		auto PreciseTest = [&QueryBounds, &Operation, InstanceBoundsTestType = *BoundsTestType](const FArsInstancedActorsInstanceHandle& InstanceHandle, const FTransform& InstanceTransform, FArsInstancedActorsIterationContext& IterationContext)
+			{
+				if (PassesBoundsTest(QueryBounds, InstanceBoundsTestType, InstanceHandle, InstanceTransform))
+				{
+					return Operation(InstanceHandle, InstanceTransform, IterationContext);
+				}
+				return true;
+			};
+
+		bool bContinue = true;
+		if (const FInstanceSpatialIndex* SpatialIndex = InstanceData->GetOrBuildSpatialIndex())
+		{
+			CandidateInstances.Reset();
+			if (SpatialIndex->GatherCandidates(QueryBounds, CandidateInstances) > 0)
+			{
+				bContinue = ForEachInstanceInInstanceData(*InstanceData, PreciseTest, IterationContext, TConstArrayView<FArsInstancedActorsInstanceIndex>(CandidateInstances), FInstanceLocationFilterFunc(GatherLocationCandidates));
+			}
+		}
+		// No spatial index available, batch test all instances
+		else
+		{
+			bContinue = ForEachInstanceInInstanceData(*InstanceData, PreciseTest, IterationContext, TOptional<TConstArrayView<FArsInstancedActorsInstanceIndex>>(), FInstanceLocationFilterFunc(GatherLocationCandidates));
+		}
+
+		if (!bContinue)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <typename TBoundsType>
+bool AArsInstancedActorsManager::ForEachCandidateInstance(const TBoundsType& QueryBounds, FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate) const
+{
+	TArray<FArsInstancedActorsInstanceIndex> CandidateInstances;
+
+	for (TObjectPtr<UArsInstancedActorsData> InstanceData : PerActorClassInstanceData)
+	{
+		// InstancedActorDataPredicate filter PerActorClassInstanceData
+		check(IsValid(InstanceData));
+		if (InstancedActorDataPredicate.IsSet())
+		{
+			const bool bPassedPredicate = ::Invoke(*InstancedActorDataPredicate, *InstanceData);
+			if (!bPassedPredicate)
+			{
+				continue;
+			}
+		}
+
+		bool bContinue = true;
+		if (const UE::ArsInstancedActors::FInstanceSpatialIndex* SpatialIndex = InstanceData->GetOrBuildSpatialIndex())
+		{
+			CandidateInstances.Reset();
+			if (SpatialIndex->GatherCandidates(QueryBounds, CandidateInstances) > 0)
+			{
+				bContinue = ForEachInstanceInInstanceData(*InstanceData, Operation, IterationContext, TConstArrayView<FArsInstancedActorsInstanceIndex>(CandidateInstances));
+			}
+		}
+		// No spatial index available, iterate all instances
+		else
+		{
+			bContinue = ForEachInstanceInInstanceData(*InstanceData, Operation, IterationContext);
+		}
+
+		if (!bContinue)
+		{
+			return false;
+		}
+	}
+
+	return true;
 }
 
-// Instantiate FBox and FSphere implementations
+// Instantiate FBox, FSphere and, where used, FOrientedBox implementations
 template bool AArsInstancedActorsManager::ForEachInstance<FBox>(const FBox& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation) const;
 template bool AArsInstancedActorsManager::ForEachInstance<FSphere>(const FSphere& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation) const;
+template bool AArsInstancedActorsManager::ForEachInstance<FOrientedBox>(const FOrientedBox& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation) const;
+template bool AArsInstancedActorsManager::ForEachInstance<FBox>(const FBox& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate) const;
+template bool AArsInstancedActorsManager::ForEachInstance<FSphere>(const FSphere& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate) const;
+template bool AArsInstancedActorsManager::ForEachInstance<FOrientedBox>(const FOrientedBox& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate) const;
+template bool AArsInstancedActorsManager::ForEachCandidateInstance<FBox>(const FBox& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate) const;
+template bool AArsInstancedActorsManager::ForEachCandidateInstance<FSphere>(const FSphere& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate) const;
+template bool AArsInstancedActorsManager::ForEachInstanceInBounds<FBox>(const FBox& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, FInstancedActorDataBoundsTestTypeFunc BoundsTestTypeFunc) const;
+template bool AArsInstancedActorsManager::ForEachInstanceInBounds<FSphere>(const FSphere& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, FInstancedActorDataBoundsTestTypeFunc BoundsTestTypeFunc) const;
+template bool AArsInstancedActorsManager::ForEachInstanceInBounds<FOrientedBox>(const FOrientedBox& QueryBounds, AArsInstancedActorsManager::FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext, FInstancedActorDataBoundsTestTypeFunc BoundsTestTypeFunc) const;
 
 template<>
 UE::ArsInstancedActors::EInsideBoundsTestResult AArsInstancedActorsManager::IsInstanceInsideBounds<FBox>(const FBox& QueryBounds
@@ -1122,15 +2257,16 @@ bool AArsInstancedActorsManager::HasInstancesOfClass(const FBox& InQueryBounds,
 	ensure(ActorClass);
 	check(InstancedActorSubsystem);
 
+	// Early out for managers without any instance datas of ActorClass, before any instances are touched
+	const TBitArray<>& InstanceDataClassMask = GetInstanceDataClassMask(ActorClass);
+	if (!InstanceDataClassMask.Contains(true))
+	{
+		return false;
+	}
+
 	FScopedArsInstancedActorsIterationContext IterationContext;
 	bool bHasInstance = false;
 
-	auto InstancedActorDataMask = TOptional<AArsInstancedActorsManager::FInstancedActorDataPredicateFunc>([=](const UArsInstancedActorsData& InstancedActorData)
-		{
-			return ((int(AllowedLODs) & (1 << int(InstancedActorData.GetBulkLOD()))) != 0)
-				&& InstancedActorData.ActorClass->IsChildOf(ActorClass);
-		});
-
 	struct FQueryBounds
 	{
 		FBox QueryBounds;
@@ -1147,7 +2283,7 @@ bool AArsInstancedActorsManager::HasInstancesOfClass(const FBox& InQueryBounds,
 	};
 	FQueryBounds CachedQueryBounds(InQueryBounds);
 
-	ForEachInstance([Manager = this, CachedQueryBounds, ActorClass, &bHasInstance, InstancedActorSubsystem=InstancedActorSubsystem, bTestActorsIfSpawned](const FArsInstancedActorsInstanceHandle& InstanceHandle, const FTransform& InstanceTransform, FArsInstancedActorsIterationContext& IterationContext)
+	auto PreciseTest = [Manager = this, CachedQueryBounds, ActorClass, &bHasInstance, InstancedActorSubsystem=InstancedActorSubsystem, bTestActorsIfSpawned](const FArsInstancedActorsInstanceHandle& InstanceHandle, const FTransform& InstanceTransform, FArsInstancedActorsIterationContext& IterationContext)
 		{
 			const EInsideBoundsTestResult OverlapResult = Manager->IsInstanceInsideBounds(CachedQueryBounds.QueryBounds, InstanceHandle, InstanceTransform);
 			
@@ -1194,12 +2330,65 @@ bool AArsInstancedActorsManager::HasInstancesOfClass(const FBox& InQueryBounds,
 
 			const bool bContinue = !bHasInstance;
 			return bContinue;
+		};
+
+	TArray<FArsInstancedActorsInstanceIndex> OverlapCandidates;
+	for (TConstSetBitIterator<> InstanceDataIt(InstanceDataClassMask); InstanceDataIt; ++InstanceDataIt)
+	{
+		UArsInstancedActorsData* InstanceData = PerActorClassInstanceData[InstanceDataIt.GetIndex()];
+		check(IsValid(InstanceData));
+		if ((int(AllowedLODs) & (1 << int(InstanceData->GetBulkLOD()))) == 0)
+		{
+			continue;
+		}
+
+		if (const UE::ArsInstancedActors::FInstanceSpatialIndex* SpatialIndex = InstanceData->GetOrBuildSpatialIndex())
+		{
+			// Coarse test, answering from indexed instance locations where possible. Only instances whose bounds may overlap the
+			// query without their location being inside it need precise (and potentially actor overlap) tests.
+			OverlapCandidates.Reset();
+			if (SpatialIndex->TestOccupancy(InQueryBounds, OverlapCandidates))
+			{
+				UE_VLOG_BOX(this, LogArsInstancedActors, Log, InQueryBounds, FColor::Red, TEXT("Instance of class %s"), *GetNameSafe(InstanceData->ActorClass));
+				return true;
+			}
+
+			if (!OverlapCandidates.IsEmpty())
+			{
+				ForEachInstanceInInstanceData(*InstanceData, PreciseTest, IterationContext, TConstArrayView<FArsInstancedActorsInstanceIndex>(OverlapCandidates));
+			}
+		}
+		// No spatial index available, test all instances
+		else
+		{
+			ForEachInstanceInInstanceData(*InstanceData, PreciseTest, IterationContext);
+		}
+
+		if (bHasInstance)
+		{
+			break;
 		}
-		, IterationContext, InstancedActorDataMask);
+	}
 
 	return bHasInstance;
 }
 
+const TBitArray<>& AArsInstancedActorsManager::GetInstanceDataClassMask(const UClass* ActorClass) const
+{
+	if (const TBitArray<>* ExistingClassMask = InstanceDataClassMasks.Find(ActorClass))
+	{
+		return *ExistingClassMask;
+	}
+
+	TBitArray<> ClassMask(false, PerActorClassInstanceData.Num());
+	for (int32 InstanceDataIndex = 0; InstanceDataIndex < PerActorClassInstanceData.Num(); ++InstanceDataIndex)
+	{
+		const UArsInstancedActorsData* InstanceData = PerActorClassInstanceData[InstanceDataIndex];
+		ClassMask[InstanceDataIndex] = InstanceData && InstanceData->ActorClass && InstanceData->ActorClass->IsChildOf(ActorClass);
+	}
+	return InstanceDataClassMasks.Add(ActorClass, MoveTemp(ClassMask));
+}
+
 void AArsInstancedActorsManager::AuditInstances(FOutputDevice& Ar, bool bDebugDraw, float DebugDrawDuration) const
 {
 	UWorld* World = GetWorld();
@@ -1249,7 +2438,7 @@ void AArsInstancedActorsManager::AuditInstances(FOutputDevice& Ar, bool bDebugDr
 			const FArsInstancedActorsSettings* Settings = InstanceData->GetSettingsPtr<const FArsInstancedActorsSettings>();
 			Ar.Logf(TEXT("\t\tSettings: %s"), Settings ? *Settings->DebugToString() : TEXT("?"));
 		}
-		Ar.Logf(InstanceData->NumValidInstances > 0 ? ELogVerbosity::Log : ELogVerbosity::Warning, TEXT("\t\tNum Instances: %u"), InstanceData->NumValidInstances);
+		Ar.Logf(InstanceData->NumValidInstances > 0 ? ELogVerbosity::Log : ELogVerbosity::Warning, TEXT("\t\tNum Instances: %d"), InstanceData->NumValidInstances);
 		if (InstanceData->GetNumFreeInstances() > 0)
 		{
 			Ar.Logf(ELogVerbosity::Warning, TEXT("\t\tNum Free Instances: %d - these incur extra runtime cost! Consider running IA.CompactInstances console command"), InstanceData->GetNumFreeInstances());
@@ -1276,7 +2465,7 @@ void AArsInstancedActorsManager::AuditInstances(FOutputDevice& Ar, bool bDebugDr
 		const int32 NumDeltas = InstanceData->InstanceDeltas.GetInstanceDeltas().Num();
 		if (NumDeltas > 0)
 		{
-			Ar.Logf(TEXT("\t\tNum Deltas: %d (Destroyed: %u, Lifecycle Phases: %u)"), NumDeltas, InstanceData->InstanceDeltas.GetNumDestroyedInstanceDeltas(), InstanceData->InstanceDeltas.GetNumLifecyclePhaseDeltas());
+			Ar.Logf(TEXT("\t\tNum Deltas: %d (Destroyed: %d, Lifecycle Phases: %d)"), NumDeltas, InstanceData->InstanceDeltas.GetNumDestroyedInstanceDeltas(), InstanceData->InstanceDeltas.GetNumLifecyclePhaseDeltas());
 		}
 
 #if UE_ENABLE_DEBUG_DRAWING
@@ -1494,6 +2683,21 @@ void AArsInstancedActorsManager::UpdateInstanceStats(int32 InstanceCount, EArsIn
 #endif // !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 }
 
+void AArsInstancedActorsManager::MarkInstanceDeltasForRelevancyUpdate()
+{
+	// Bumps each list's array replication key, so NetDeltaSerialize re-evaluates deferred deltas rather than early-outing on
+	// an unchanged array for connections which have since approached them
+	for (const TObjectPtr<UArsInstancedActorsData>& InstanceData : PerActorClassInstanceData)
+	{
+		if (InstanceData)
+		{
+			InstanceData->InstanceDeltas.MarkArrayDirty();
+		}
+	}
+
+	FlushNetDormancy();
+}
+
 void AArsInstancedActorsManager::RequestPersistentDataSave()
 {
 	if (!UE::ArsInstancedActors::CVars::bEnablePersistence)
@@ -1501,6 +2705,43 @@ void AArsInstancedActorsManager::RequestPersistentDataSave()
 		return;
 	}
 
+	// We don't know what changed, so all IAC persistence data will be re-saved
+	for (const TObjectPtr<UArsInstancedActorsData>& InstanceData : PerActorClassInstanceData)
+	{
+		if (InstanceData)
+		{
+			PersistenceDirtyStates.FindOrAdd(InstanceData->ID).bAllIACPersistenceData = true;
+		}
+	}
+
+	RequestActorSave(this);
+}
+
+void AArsInstancedActorsManager::RequestInstancePersistentDataSave(const UArsInstancedActorsData& InstanceData, FArsInstancedActorsInstanceIndex InstanceIndex)
+{
+	if (!UE::ArsInstancedActors::CVars::bEnablePersistence)
+	{
+		return;
+	}
+
+	check(InstanceData.GetManager() == this);
+	check(InstanceIndex.IsValid());
+	PersistenceDirtyStates.FindOrAdd(InstanceData.ID).InstanceIndices.Add(InstanceIndex.GetIndex());
+
+	RequestActorSave(this);
+}
+
+void AArsInstancedActorsManager::RequestComponentPersistentDataSave(const UArsInstancedActorsData& InstanceData, uint32 IACPersistenceID)
+{
+	if (!UE::ArsInstancedActors::CVars::bEnablePersistence)
+	{
+		return;
+	}
+
+	check(InstanceData.GetManager() == this);
+	ensureMsgf(IACPersistenceID != 0, TEXT("Expecting a non-zero UArsInstancedActorsComponent::GetInstancePersistenceDataID"));
+	PersistenceDirtyStates.FindOrAdd(InstanceData.ID).IACPersistenceIDs.Add(IACPersistenceID);
+
 	RequestActorSave(this);
 }
 
@@ -1544,16 +2785,50 @@ void AArsInstancedActorsManager::UnregisterInstanceDatasComponent(UInstancedStat
 	ensureMsgf(ISMComponentToInstanceDataMap.Remove(&Component) > 0, TEXT("Trying to unregister %s but it's cannot be found in ISMComponentToInstanceDataMap"), *Component.GetPathName());
 }
 
+bool AArsInstancedActorsManager::IsHeadlessServer() const
+{
+	return UE::ArsInstancedActors::CVars::bHeadlessServer && IsNetMode(NM_DedicatedServer);
+}
+
+bool AArsInstancedActorsManager::ShouldCreateISMComponents() const
+{
+	// Without rendering or collision, headless servers have no use for ISMC's
+	return !IsHeadlessServer() || UE::ArsInstancedActors::CVars::bInstanceCollisionsOnServer;
+}
+
+bool AArsInstancedActorsManager::ShouldEnableInstanceCollision() const
+{
+	// @todo Add support for non-replay NM_Standalone where we should use bInstanceCollisionsOnServer
+	return IsNetMode(NM_DedicatedServer) ? UE::ArsInstancedActors::CVars::bInstanceCollisionsOnServer : UE::ArsInstancedActors::CVars::bInstanceCollisionsOnClient;
+}
+
+void AArsInstancedActorsManager::SetInstanceCollisionEnabled(UInstancedStaticMeshComponent& ISMComponent, const bool bEnable)
+{
+	ISMComponent.bDisableCollision = !bEnable;
+
+	// Note: The base profile doesn't use Physics, only Query, but some use cases might rely on physics
+	// so we need the IAM's to ensure that is turned on.
+	// Note: Setting both bDisableCollision and ECollisionEnabled::NoCollision when disabling collision, to
+	// 		 avoid confusion of conflicting values.
+	ISMComponent.SetCollisionEnabled(bEnable ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+}
+
 void AArsInstancedActorsManager::CreateISMComponents(const FArsInstancedActorsVisualizationDesc& VisualizationDesc, FConstSharedStruct SharedSettings
 	, TArray<TObjectPtr<UInstancedStaticMeshComponent>>& OutComponents, const bool bEditorPreviewISMCs)
 {
-	const bool bEnableInstanceCollision = IsNetMode(NM_DedicatedServer) ? UE::ArsInstancedActors::CVars::bInstanceCollisionsOnServer : UE::ArsInstancedActors::CVars::bInstanceCollisionsOnClient;
+	if (!bEditorPreviewISMCs && !ShouldCreateISMComponents())
+	{
+		return;
+	}
+
+	const bool bEnableInstanceCollision = ShouldEnableInstanceCollision();
+	const bool bCollisionOnly = !bEditorPreviewISMCs && IsHeadlessServer();
 
 	const FArsInstancedActorsSettings* Settings = SharedSettings.GetPtr<const FArsInstancedActorsSettings>();
 
 	for (const FISMComponentDescriptor& ISMCDescriptor : VisualizationDesc.ISMComponentDescriptors)
 	{
-		UInstancedStaticMeshComponent* ISMComponent = NewObject<UInstancedStaticMeshComponent>(this);
+		UInstancedStaticMeshComponent* ISMComponent = NewObject<UArsInstancedActorsISMComponent>(this);
 		// the following two checks are meant to catch unexpected reuse of existing UInstancedStaticMeshComponent (which can happen if the generated name is being used already).
 		checkf(ISMComponent->GetOwner() == this, TEXT("Newly created ISM component seems to be a reused one - it has a different owner,\nexpected: %s,\nactual: %s"), *GetNameSafe(ISMComponent->GetOwner()), *GetName());
 		checkf(ISMComponent->GetAttachParent() == nullptr, TEXT("Newly created ISM component already has a non-null attach parent: %s"), *ISMComponent->GetAttachParent()->GetName());
@@ -1564,14 +2839,7 @@ void AArsInstancedActorsManager::CreateISMComponents(const FArsInstancedActorsVi
 		ISMComponent->SetMobility(EComponentMobility::Stationary);
 		ISMComponent->SetupAttachment(RootComponent);
 
-		// @todo Add support for non-replay NM_Standalone where we should use bInstanceCollisionsOnServer
-		ISMComponent->bDisableCollision = !bEnableInstanceCollision;
-
-		// Note: The base profile doesn't use Physics, only Query, but some use cases might rely on physics
-		// so we need the IAM's to ensure that is turned on.
-		// Note: Setting both bDisableCollision and ECollisionEnabled::NoCollision when disabling collision, to
-		// 		 avoid confusion of conflicting values.
-		ISMComponent->SetCollisionEnabled(bEnableInstanceCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+		SetInstanceCollisionEnabled(*ISMComponent, bEnableInstanceCollision);
 
 		// Use conservative bounds to decrease bounds calculation cost when we have high instance counts.
 		ISMComponent->SetUseConservativeBounds(true);
@@ -1620,6 +2888,17 @@ void AArsInstancedActorsManager::CreateISMComponents(const FArsInstancedActorsVi
 			ISMComponent->bCastFarShadow = ISMComponent->bAffectDistanceFieldLighting;
 		}
 
+		// Headless server ISMC's are only used for collision & instance index lookups, strip anything render related. These
+		// aren't registered with Mass representation, @see UArsInstancedActorsData::SeedCollisionOnlyInstances
+		if (bCollisionOnly)
+		{
+			ISMComponent->SetCastShadow(false);
+			ISMComponent->bCastFarShadow = false;
+			ISMComponent->bAffectDistanceFieldLighting = false;
+			ISMComponent->bAffectDynamicIndirectLighting = false;
+			ISMComponent->SetEvaluateWorldPositionOffset(false);
+		}
+
 		// Editor preview overrides
 		if (bEditorPreviewISMCs)
 		{
@@ -1678,7 +2957,7 @@ int32 AArsInstancedActorsManager::ConvertCollisionIndexToInstanceIndex(int32 InI
 		check(PerActorClassInstanceData[*InstanceDataID]);
 		const int32 EntityIndex = PerActorClassInstanceData[*InstanceDataID]->GetEntityIndexFromCollisionIndex(*AsISMComponent, InIndex);
 		return EntityIndex != INDEX_NONE
-			? FArsInstancedActorsInstanceIndex::BuildCompositeIndex(*InstanceDataID, EntityIndex)
+			? FArsInstancedActorsInstanceIndex::BuildCompositeIndex(*InstanceDataID, EntityIndex, CompositeInstanceIndexBits)
 			: INDEX_NONE;
 	}
 
@@ -1715,8 +2994,8 @@ AActor* AArsInstancedActorsManager::FindActorInternal(const FActorInstanceHandle
 	}
 
 	const int32 CompositeIndex = Handle.GetInstanceIndex();
-	const int32 InstancedActorDataIndex = FArsInstancedActorsInstanceIndex::ExtractInstanceDataID(CompositeIndex);
-	const FArsInstancedActorsInstanceIndex InternalInstanceIndex = FArsInstancedActorsInstanceIndex(FArsInstancedActorsInstanceIndex::ExtractInternalInstanceIndex(CompositeIndex));
+	const int32 InstancedActorDataIndex = FArsInstancedActorsInstanceIndex::ExtractInstanceDataID(CompositeIndex, CompositeInstanceIndexBits);
+	const FArsInstancedActorsInstanceIndex InternalInstanceIndex = FArsInstancedActorsInstanceIndex(FArsInstancedActorsInstanceIndex::ExtractInternalInstanceIndex(CompositeIndex, CompositeInstanceIndexBits));
 
 	if (PerActorClassInstanceData.IsValidIndex(InstancedActorDataIndex))
 	{
@@ -1792,8 +3071,8 @@ AActor* AArsInstancedActorsManager::FindOrCreateActor(const FActorInstanceHandle
 #if WITH_ARSINSTANCEDACTORS_DEBUG
 		{
 			const int32 CompositeIndex = Handle.GetInstanceIndex();
-			const int32 InstancedActorDataIndex = FArsInstancedActorsInstanceIndex::ExtractInstanceDataID(CompositeIndex);
-			const FArsInstancedActorsInstanceIndex InternalInstanceIndex = FArsInstancedActorsInstanceIndex(FArsInstancedActorsInstanceIndex::ExtractInternalInstanceIndex(CompositeIndex));
+			const int32 InstancedActorDataIndex = FArsInstancedActorsInstanceIndex::ExtractInstanceDataID(CompositeIndex, CompositeInstanceIndexBits);
+			const FArsInstancedActorsInstanceIndex InternalInstanceIndex = FArsInstancedActorsInstanceIndex(FArsInstancedActorsInstanceIndex::ExtractInternalInstanceIndex(CompositeIndex, CompositeInstanceIndexBits));
 			const UArsInstancedActorsData* InstanceData = PerActorClassInstanceData.IsValidIndex(InstancedActorDataIndex) ? PerActorClassInstanceData[InstancedActorDataIndex] : nullptr;
 			ensureMsgf(InstanceData && InstanceData->CanHydrate()
 				, TEXT("We're about to spawn an actor while the relevant IAD %s has been configured to not hydrate its instances")
@@ -1811,8 +3090,8 @@ AActor* AArsInstancedActorsManager::FindOrCreateActor(const FActorInstanceHandle
 		if (Actor == nullptr)
 		{
 			const int32 CompositeIndex = Handle.GetInstanceIndex();
-			const int32 InstancedActorDataIndex = FArsInstancedActorsInstanceIndex::ExtractInstanceDataID(CompositeIndex);
-			const FArsInstancedActorsInstanceIndex InternalInstanceIndex = FArsInstancedActorsInstanceIndex(FArsInstancedActorsInstanceIndex::ExtractInternalInstanceIndex(CompositeIndex));
+			const int32 InstancedActorDataIndex = FArsInstancedActorsInstanceIndex::ExtractInstanceDataID(CompositeIndex, CompositeInstanceIndexBits);
+			const FArsInstancedActorsInstanceIndex InternalInstanceIndex = FArsInstancedActorsInstanceIndex(FArsInstancedActorsInstanceIndex::ExtractInternalInstanceIndex(CompositeIndex, CompositeInstanceIndexBits));
 			const UArsInstancedActorsData* InstanceData = PerActorClassInstanceData[InstancedActorDataIndex];
 			ensureMsgf(Actor, TEXT("Failed spawning actor for %s actor instance handle %d (Instance Index: %d)"), *InstanceData->GetDebugName(), CompositeIndex, InternalInstanceIndex.GetIndex());
 		}
@@ -1838,7 +3117,7 @@ UClass* AArsInstancedActorsManager::GetRepresentedClass(const int32 InstanceInde
 		return GetClass();
 	}
 
-	const int32 InstanceDataID = FArsInstancedActorsInstanceIndex::ExtractInstanceDataID(InstanceIndex);
+	const int32 InstanceDataID = FArsInstancedActorsInstanceIndex::ExtractInstanceDataID(InstanceIndex, CompositeInstanceIndexBits);
 	return ensure(PerActorClassInstanceData.IsValidIndex(InstanceDataID))
 		? PerActorClassInstanceData[InstanceDataID]->ActorClass
 		: nullptr;
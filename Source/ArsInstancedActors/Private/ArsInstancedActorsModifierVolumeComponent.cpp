@@ -2,6 +2,7 @@
 
 
 #include "ArsInstancedActorsModifierVolumeComponent.h"
+#include "ArsInstancedActorsBoundsTests.h"
 #include "ArsInstancedActorsDebug.h"
 #include "ArsInstancedActorsIteration.h"
 #include "ArsInstancedActorsModifiers.h"
@@ -38,6 +39,17 @@ namespace UE::ArsInstancedActors
 		}
 	} // Helpers
 
+	namespace CVars
+	{
+		bool bOrientedBoxModifierVolumes = false;
+		FAutoConsoleVariableRef CVarOrientedBoxModifierVolumes(
+			TEXT("IA.ModifierVolumes.OrientedBoxes"),
+			bOrientedBoxModifierVolumes,
+			TEXT("If enabled, Box shaped UArsInstancedActorsModifierVolumeComponents test instances against their rotated box. Otherwise (default) ")
+			TEXT("they test against their world space axis aligned bounding box, which includes more instances for rotated volumes."),
+			ECVF_Default);
+	} // CVars
+
 } // namespace ArsInstancedActors
 
 //-----------------------------------------------------------------------------
@@ -147,27 +159,11 @@ void UArsInstancedActorsModifierVolumeComponent::OnRemovedFromManager(AArsInstan
 	ModifiedManagers.Remove(&Manager);
 }
 
-bool UArsInstancedActorsModifierVolumeComponent::TryRunPendingModifiers(AArsInstancedActorsManager& Manager, TBitArray<>& InOutPendingModifiers)
+bool UArsInstancedActorsModifierVolumeComponent::IsIgnoringManager(const AArsInstancedActorsManager& Manager) const
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE_STR("UArsInstancedActorsModifierVolumeComponent ModifyInstances");
-
-#if WITH_EDITOR
-	// Need to do this or the PIE experience is not a valid representation of the cooked game.
-	if (IsEditorOnlyObject(this, true))
-	{
-		return true;
-	}
-#endif
-
-	if (!ensure(InOutPendingModifiers.Num() == Modifiers.Num()))
-	{
-		return false;
-	}
-
 	check(GetOwner());
 	if (bIgnoreOwnLevelsInstances)
 	{
-		// If logic matches, return true as if we have successfully run all modifiers, so they don't attempt to run again.
 		ULevel* ManagerLevel = Manager.GetLevel();
 		ULevel* OwnerLevel = GetOwner()->GetLevel();
 
@@ -207,25 +203,85 @@ bool UArsInstancedActorsModifierVolumeComponent::TryRunPendingModifiers(AArsInst
 			// a valid lower level (Asset ID, GUID, etc) check.
 			if (LevelsToIgnore.ContainsByPredicate([&](const TSoftObjectPtr<UWorld>& LevelToCheck) { return ManagerMapPath.StartsWith(LevelToCheck.GetLongPackageName()); }))
 			{
-				// Return true to clear dirty state for Manager's modifiers
-				// so we don't keep attempting to execute them.
 				return true;
 			}
 		}
 	}
 
+	return false;
+}
+
+FOrientedBox UArsInstancedActorsModifierVolumeComponent::GetOrientedBox() const
+{
+	const FTransform& ComponentTransform = GetComponentTransform();
+	const FVector ScaledExtent = Extent * ComponentTransform.GetScale3D().GetAbs();
+
+	FOrientedBox OrientedBox;
+	OrientedBox.Center = ComponentTransform.GetLocation();
+	OrientedBox.AxisX = ComponentTransform.GetUnitAxis(EAxis::X);
+	OrientedBox.AxisY = ComponentTransform.GetUnitAxis(EAxis::Y);
+	OrientedBox.AxisZ = ComponentTransform.GetUnitAxis(EAxis::Z);
+	OrientedBox.ExtentX = ScaledExtent.X;
+	OrientedBox.ExtentY = ScaledExtent.Y;
+	OrientedBox.ExtentZ = ScaledExtent.Z;
+	return OrientedBox;
+}
+
+bool UArsInstancedActorsModifierVolumeComponent::IsInside(const FVector& Location) const
+{
+	switch (Shape)
+	{
+		case EArsInstancedActorsVolumeShape::Box:
+			return UE::ArsInstancedActors::CVars::bOrientedBoxModifierVolumes
+				? UE::ArsInstancedActors::BoundsTests::IsInside(GetOrientedBox(), Location)
+				: Bounds.GetBox().IsInside(Location);
+		case EArsInstancedActorsVolumeShape::Sphere:
+			return Bounds.GetSphere().IsInside(Location);
+		default:
+			checkNoEntry();
+			return false;
+	}
+}
+
+bool UArsInstancedActorsModifierVolumeComponent::TryRunPendingModifiers(AArsInstancedActorsManager& Manager, TBitArray<>& InOutPendingModifiers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_STR("UArsInstancedActorsModifierVolumeComponent ModifyInstances");
+
+#if WITH_EDITOR
+	// Need to do this or the PIE experience is not a valid representation of the cooked game.
+	if (IsEditorOnlyObject(this, true))
+	{
+		return true;
+	}
+#endif
+
+	if (!ensure(InOutPendingModifiers.Num() == Modifiers.Num()))
+	{
+		return false;
+	}
+
+	if (IsIgnoringManager(Manager))
+	{
+		// Return true as if we have successfully run all modifiers, so they don't attempt to run again.
+		return true;
+	}
+
 	FArsInstancedActorsIterationContext IterationContext;
 	ON_SCOPE_EXIT { IterationContext.FlushDeferredActions(); };
 
+	// Box volumes optionally test instances against the rotated box itself, rather than its world space bounding box
+	const bool bOrientedBox = Shape == EArsInstancedActorsVolumeShape::Box && UE::ArsInstancedActors::CVars::bOrientedBoxModifierVolumes;
+	const FOrientedBox OrientedBox = bOrientedBox ? GetOrientedBox() : FOrientedBox();
+
 	// Is manager entirely inside the volume?
 	bool bEnvelopesManager = false;
 	switch (Shape)
 	{
-		// @todo Use an OrientedBox for instance inclusion testing
 		case EArsInstancedActorsVolumeShape::Box:
 		{
-			const FBox QueryBounds = Bounds.GetBox();
-			bEnvelopesManager = QueryBounds.IsInside(Manager.GetInstanceBounds());
+			bEnvelopesManager = bOrientedBox
+				? UE::ArsInstancedActors::BoundsTests::IsInside(OrientedBox, Manager.GetInstanceBounds())
+				: Bounds.GetBox().IsInside(Manager.GetInstanceBounds());
 			break;
 		}
 		case EArsInstancedActorsVolumeShape::Sphere:
@@ -274,7 +330,14 @@ bool UArsInstancedActorsModifierVolumeComponent::TryRunPendingModifiers(AArsInst
 							switch (Shape)
 							{
 								case EArsInstancedActorsVolumeShape::Box:
-									Modifier->ModifyAllInstancesInBounds(Bounds.GetBox(), Manager, IterationContext);
+									if (bOrientedBox)
+									{
+										Modifier->ModifyAllInstancesInBounds(OrientedBox, Manager, IterationContext);
+									}
+									else
+									{
+										Modifier->ModifyAllInstancesInBounds(Bounds.GetBox(), Manager, IterationContext);
+									}
 									/** 
 									@todo mikko: These will test based on if the bounds overlaps with an instance.
 										Why are the tests different? If the modifier bounds contains the whole manager 
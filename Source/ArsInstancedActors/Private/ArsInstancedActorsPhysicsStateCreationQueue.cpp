@@ -0,0 +1,112 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#include "ArsInstancedActorsPhysicsStateCreationQueue.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+
+namespace UE::ArsInstancedActors
+{
+void FPhysicsStateCreationQueue::Place(const int32 Index, FPhysicsStateCreationRequest&& Request)
+{
+	QueueIndices.FindChecked(Request.ISMComponentKey) = Index;
+	Heap[Index] = MoveTemp(Request);
+}
+
+void FPhysicsStateCreationQueue::SiftUp(int32 Index)
+{
+	FPhysicsStateCreationRequest Request = MoveTemp(Heap[Index]);
+	while (Index > 0)
+	{
+		const int32 ParentIndex = (Index - 1) / 2;
+		if (!(Request < Heap[ParentIndex]))
+		{
+			break;
+		}
+		Place(Index, MoveTemp(Heap[ParentIndex]));
+		Index = ParentIndex;
+	}
+	Place(Index, MoveTemp(Request));
+}
+
+void FPhysicsStateCreationQueue::SiftDown(int32 Index)
+{
+	const int32 Count = Heap.Num();
+	FPhysicsStateCreationRequest Request = MoveTemp(Heap[Index]);
+	while (true)
+	{
+		int32 ChildIndex = 2 * Index + 1;
+		if (ChildIndex >= Count)
+		{
+			break;
+		}
+		if (ChildIndex + 1 < Count && Heap[ChildIndex + 1] < Heap[ChildIndex])
+		{
+			++ChildIndex;
+		}
+		if (!(Heap[ChildIndex] < Request))
+		{
+			break;
+		}
+		Place(Index, MoveTemp(Heap[ChildIndex]));
+		Index = ChildIndex;
+	}
+	Place(Index, MoveTemp(Request));
+}
+
+void FPhysicsStateCreationQueue::Push(FPhysicsStateCreationRequest&& Request)
+{
+	check(Request.ISMComponent.IsValid());
+	Request.ISMComponentKey = TObjectKey<const UInstancedStaticMeshComponent>(Request.ISMComponent.Get());
+	checkf(!QueueIndices.Contains(Request.ISMComponentKey), TEXT("%s is already queued"), *GetNameSafe(Request.ISMComponent.Get()));
+
+	const int32 Index = Heap.AddDefaulted();
+	QueueIndices.Add(Request.ISMComponentKey, Index);
+	Place(Index, MoveTemp(Request));
+	SiftUp(Index);
+}
+
+void FPhysicsStateCreationQueue::Pop()
+{
+	RemoveAt(0);
+}
+
+bool FPhysicsStateCreationQueue::Remove(const UInstancedStaticMeshComponent& ISMComponent)
+{
+	if (const int32* Index = QueueIndices.Find(TObjectKey<const UInstancedStaticMeshComponent>(&ISMComponent)))
+	{
+		RemoveAt(*Index);
+		return true;
+	}
+
+	return false;
+}
+
+void FPhysicsStateCreationQueue::RemoveAt(const int32 Index)
+{
+	check(Heap.IsValidIndex(Index));
+
+	const FPhysicsStateCreationRequest& Removed = Heap[Index];
+	QueueIndices.Remove(Removed.ISMComponentKey);
+
+	FPhysicsStateCreationRequest Last = Heap.Pop(EAllowShrinking::No);
+	if (Index < Heap.Num())
+	{
+		const bool bSiftUp = Last < Heap[Index];
+		Place(Index, MoveTemp(Last));
+		if (bSiftUp)
+		{
+			SiftUp(Index);
+		}
+		else
+		{
+			SiftDown(Index);
+		}
+	}
+}
+
+void FPhysicsStateCreationQueue::Reset()
+{
+	Heap.Reset();
+	QueueIndices.Reset();
+}
+} // UE::ArsInstancedActors
@@ -2,8 +2,141 @@
 
 #include "ArsInstancedActorsReplication.h"
 #include "ArsInstancedActorsData.h"
+#include "ArsInstancedActorsManager.h"
+#include "ArsInstancedActorsSubsystem.h"
+#include "Engine/NetConnection.h"
+#include "Engine/PackageMapClient.h"
 
 
+namespace UE::ArsInstancedActors
+{
+	namespace CVars
+	{
+		float DeltaRelevancyDistance = 0.0f;
+		FAutoConsoleVariableRef CVarDeltaRelevancyDistance(
+			TEXT("IA.DeltaRelevancy.Distance"),
+			DeltaRelevancyDistance,
+			TEXT("If > 0, instance deltas (destruction, lifecycle phase) are only replicated to connections whose view target is within this ")
+			TEXT("distance of the instance. Out of range deltas are deferred until the connection approaches. Deltas already received ")
+			TEXT("by a connection continue to replicate regardless of distance. <= 0 = Replicate all deltas to all connections (default)."),
+			ECVF_Default);
+
+		int32 DeltaRelevancyMaxNewDeltasPerConnectionPerFrame = 256;
+		FAutoConsoleVariableRef CVarDeltaRelevancyMaxNewDeltasPerConnectionPerFrame(
+			TEXT("IA.DeltaRelevancy.MaxNewDeltasPerConnectionPerFrame"),
+			DeltaRelevancyMaxNewDeltasPerConnectionPerFrame,
+			TEXT("With IA.DeltaRelevancy.Distance enabled, the maximum number of deltas new to a connection to write to it per frame, across ")
+			TEXT("all managers. Remaining deltas are deferred, and retried every IA.DeltaRelevancy.FlushInterval. <= 0 = Unlimited."),
+			ECVF_Default);
+	} // CVars
+} // UE::ArsInstancedActors
+
+struct FArsInstancedActorsDeltaRelevancyContext
+{
+	// View location of the connection being written to
+	FVector ViewLocation = FVector::ZeroVector;
+
+	double RelevancyDistanceSquared = 0.0;
+
+	// Replication IDs already received by the connection. Null if the connection hasn't received this list before.
+	const TMap<int32, int32>* SentReplicationIDs = nullptr;
+
+	UE::ArsInstancedActors::FConnectionDeltaRelevancy* ConnectionRelevancy = nullptr;
+
+	// Bounds of the deltas deferred for being out of range during this NetDeltaSerialize
+	FBox OutOfRangeDeferredBounds = FBox(ForceInit);
+
+	// True if any deltas were deferred by the connection's per-frame budget during this NetDeltaSerialize
+	bool bBudgetDeferredDeltas = false;
+};
+
+
+//-----------------------------------------------------------------------------
+// FArsInstancedActorsDelta
+//-----------------------------------------------------------------------------
+const FInstancedStruct* FArsInstancedActorsDelta::FindFragment(const UScriptStruct* FragmentType) const
+{
+	auto MatchesType = [FragmentType](const FInstancedStruct& Fragment)
+		{
+			return Fragment.GetScriptStruct() == FragmentType;
+		};
+
+	if (const FInstancedStruct* Fragment = ReplicatedFragments.FindByPredicate(MatchesType))
+	{
+		return Fragment;
+	}
+#if WITH_SERVER_CODE
+	return ServerFragments.FindByPredicate(MatchesType);
+#else
+	return nullptr;
+#endif
+}
+
+void FArsInstancedActorsDelta::ForEachFragment(TFunctionRef<void(FConstStructView)> Function) const
+{
+	for (const FInstancedStruct& Fragment : ReplicatedFragments)
+	{
+		Function(FConstStructView(Fragment));
+	}
+#if WITH_SERVER_CODE
+	for (const FInstancedStruct& Fragment : ServerFragments)
+	{
+		Function(FConstStructView(Fragment));
+	}
+#endif
+}
+
+bool FArsInstancedActorsDelta::SetFragment(FConstStructView Fragment, bool bReplicated)
+{
+	const UScriptStruct* FragmentType = Fragment.GetScriptStruct();
+	check(FragmentType);
+
+#if WITH_SERVER_CODE
+	TArray<FInstancedStruct>& Fragments = bReplicated ? ReplicatedFragments : ServerFragments;
+#else
+	if (!ensureMsgf(bReplicated, TEXT("Non-replicated instance fragments are server-only")))
+	{
+		return false;
+	}
+	TArray<FInstancedStruct>& Fragments = ReplicatedFragments;
+#endif
+
+	FInstancedStruct* ExistingFragment = Fragments.FindByPredicate([FragmentType](const FInstancedStruct& ExistingFragment)
+		{
+			return ExistingFragment.GetScriptStruct() == FragmentType;
+		});
+	if (ExistingFragment == nullptr)
+	{
+		Fragments.AddDefaulted_GetRef().InitializeAs(FragmentType, Fragment.GetMemory());
+		return true;
+	}
+
+	if (FragmentType->CompareScriptStruct(ExistingFragment->GetMemory(), Fragment.GetMemory(), PPF_None))
+	{
+		return false;
+	}
+
+	FragmentType->CopyScriptStruct(ExistingFragment->GetMutableMemory(), Fragment.GetMemory());
+	return true;
+}
+
+bool FArsInstancedActorsDelta::RemoveFragment(const UScriptStruct* FragmentType)
+{
+	auto MatchesType = [FragmentType](const FInstancedStruct& Fragment)
+		{
+			return Fragment.GetScriptStruct() == FragmentType;
+		};
+
+	bool bRemoved = ReplicatedFragments.RemoveAllSwap(MatchesType) > 0;
+#if WITH_SERVER_CODE
+	bRemoved |= ServerFragments.RemoveAllSwap(MatchesType) > 0;
+#endif
+	return bRemoved;
+}
+
+//-----------------------------------------------------------------------------
+// FArsInstancedActorsDeltaList
+//-----------------------------------------------------------------------------
 void FArsInstancedActorsDeltaList::Initialize(UArsInstancedActorsData& InOwnerInstancedActorData)
 {
 	const uintptr_t ThisStart = (uintptr_t)this;
@@ -25,24 +158,31 @@ void FArsInstancedActorsDeltaList::Initialize(UArsInstancedActorsData& InOwnerIn
 
 FArsInstancedActorsDelta& FArsInstancedActorsDeltaList::FindOrAddInstanceDelta(FArsInstancedActorsInstanceIndex InstanceIndex)
 {
-	uint16& DeltaIndex = InstanceIndexToDeltaIndex.FindOrAdd(InstanceIndex, (uint16)INDEX_NONE);
-	if (DeltaIndex == (uint16)INDEX_NONE)
+	int32& DeltaIndex = InstanceIndexToDeltaIndex.FindOrAdd(InstanceIndex, INDEX_NONE);
+	if (DeltaIndex == INDEX_NONE)
 	{
-		const int32 NewDeltaIndex = InstanceDeltas.Emplace(InstanceIndex);
-		checkf(NewDeltaIndex < std::numeric_limits<uint16>::max(), TEXT("Reach limit of supported deltas"));
-		DeltaIndex = NewDeltaIndex;
+		DeltaIndex = InstanceDeltas.Emplace(InstanceIndex);
+
+#if WITH_SERVER_CODE
+		// Cache the instance location for per-connection relevancy
+		FVector InstanceLocation;
+		if (InstancedActorData != nullptr && InstancedActorData->GetInstanceLocation(InstanceIndex, InstanceLocation))
+		{
+			InstanceDeltas[DeltaIndex].RelevancyLocation = InstanceLocation;
+		}
+#endif // WITH_SERVER_CODE
 	}
 
 	check(InstanceDeltas.IsValidIndex(DeltaIndex));
 	return InstanceDeltas[DeltaIndex];
 }
 
-void FArsInstancedActorsDeltaList::RemoveInstanceDelta(uint16 DeltaIndex)
+void FArsInstancedActorsDeltaList::RemoveInstanceDelta(int32 DeltaIndex)
 {
 	check(InstanceDeltas.IsValidIndex(DeltaIndex));
 	FArsInstancedActorsDelta& InstanceDelta = InstanceDeltas[DeltaIndex];
 
-	uint16* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceDelta.GetInstanceIndex());
+	int32* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceDelta.GetInstanceIndex());
 	if (ensureMsgf(DeltaIndexPtr && *DeltaIndexPtr == DeltaIndex, TEXT("Expecting the instance to exist and match the delta index")))
 	{
 		InstanceIndexToDeltaIndex.Remove(InstanceDelta.GetInstanceIndex());
@@ -54,8 +194,8 @@ void FArsInstancedActorsDeltaList::RemoveInstanceDelta(uint16 DeltaIndex)
 		if (InstanceDeltas.IsValidIndex(DeltaIndex))
 		{
 			FArsInstancedActorsDelta& SwappedInInstanceDelta = InstanceDeltas[DeltaIndex];
-			uint16* SwappedInInstanceDeltaIndex = InstanceIndexToDeltaIndex.Find(SwappedInInstanceDelta.GetInstanceIndex());
-			if (ensureMsgf(SwappedInInstanceDeltaIndex, TEXT("InstanceIndexToDeltaIndex and InstanceDeltas have gotten out of sync! Couldn't find delta index for swapped in instance delta %s (RemoveAtSwap'd index: %u)"), *SwappedInInstanceDelta.GetInstanceIndex().GetDebugName(), DeltaIndex))
+			int32* SwappedInInstanceDeltaIndex = InstanceIndexToDeltaIndex.Find(SwappedInInstanceDelta.GetInstanceIndex());
+			if (ensureMsgf(SwappedInInstanceDeltaIndex, TEXT("InstanceIndexToDeltaIndex and InstanceDeltas have gotten out of sync! Couldn't find delta index for swapped in instance delta %s (RemoveAtSwap'd index: %d)"), *SwappedInInstanceDelta.GetInstanceIndex().GetDebugName(), DeltaIndex))
 			{
 				*SwappedInInstanceDeltaIndex = DeltaIndex;
 			}
@@ -65,9 +205,82 @@ void FArsInstancedActorsDeltaList::RemoveInstanceDelta(uint16 DeltaIndex)
 
 bool FArsInstancedActorsDeltaList::NetDeltaSerialize(FNetDeltaSerializeInfo& NetDeltaParams)
 {
+#if WITH_SERVER_CODE
+	// Per-connection relevancy when writing on the server
+	if (UE::ArsInstancedActors::CVars::DeltaRelevancyDistance > 0.0f && NetDeltaParams.Writer != nullptr && !NetDeltaParams.bIsWritingOnClient
+		&& InstancedActorData != nullptr && !InstanceDeltas.IsEmpty())
+	{
+		const UPackageMapClient* PackageMap = Cast<UPackageMapClient>(NetDeltaParams.Map);
+		const UNetConnection* Connection = PackageMap ? PackageMap->GetConnection() : nullptr;
+		const AActor* ViewTarget = Connection ? Connection->ViewTarget.Get() : nullptr;
+		if (ViewTarget != nullptr)
+		{
+			AArsInstancedActorsManager& Manager = InstancedActorData->GetManagerChecked();
+
+			FArsInstancedActorsDeltaRelevancyContext Context;
+			Context.ViewLocation = ViewTarget->GetActorLocation();
+			Context.RelevancyDistanceSquared = FMath::Square((double)UE::ArsInstancedActors::CVars::DeltaRelevancyDistance);
+			Context.ConnectionRelevancy = &Manager.GetInstancedActorSubsystemChecked().GetConnectionDeltaRelevancy(*Connection);
+			if (NetDeltaParams.OldState != nullptr)
+			{
+				Context.SentReplicationIDs = &static_cast<const FNetFastTArrayBaseState*>(NetDeltaParams.OldState)->IDToCLMap;
+			}
+
+			RelevancyContext = &Context;
+			const bool bWroteDeltas = FFastArraySerializer::FastArrayDeltaSerialize<FArsInstancedActorsDelta, FArsInstancedActorsDeltaList>(InstanceDeltas, NetDeltaParams, *this);
+			RelevancyContext = nullptr;
+
+			// Record deferred deltas against the connection, for the subsystem to re-replicate this manager once the connection
+			// approaches them (or has budget again)
+			const int32 ManagerID = Manager.GetManagerHandle().GetManagerID();
+			if (Context.OutOfRangeDeferredBounds.IsValid)
+			{
+				Context.ConnectionRelevancy->OutOfRangeDeferredBounds.FindOrAdd(ManagerID, FBox(ForceInit)) += Context.OutOfRangeDeferredBounds;
+			}
+			if (Context.bBudgetDeferredDeltas)
+			{
+				Context.ConnectionRelevancy->BudgetDeferredManagerIDs.Add(ManagerID);
+			}
+
+			return bWroteDeltas;
+		}
+	}
+#endif // WITH_SERVER_CODE
+
 	return FFastArraySerializer::FastArrayDeltaSerialize<FArsInstancedActorsDelta, FArsInstancedActorsDeltaList>(InstanceDeltas, NetDeltaParams, *this);
 }
 
+bool FArsInstancedActorsDeltaList::ShouldWriteInstanceDelta(const FArsInstancedActorsDelta& InstanceDelta)
+{
+	check(RelevancyContext);
+
+	// Deltas the connection has already received must keep being written, otherwise the fast array would consider
+	// them removed on the connection
+	if (RelevancyContext->SentReplicationIDs != nullptr && RelevancyContext->SentReplicationIDs->Contains(InstanceDelta.ReplicationID))
+	{
+		return true;
+	}
+
+#if WITH_SERVER_CODE
+	if (InstanceDelta.RelevancyLocation.IsSet()
+		&& FVector::DistSquared(InstanceDelta.RelevancyLocation.GetValue(), RelevancyContext->ViewLocation) > RelevancyContext->RelevancyDistanceSquared)
+	{
+		RelevancyContext->OutOfRangeDeferredBounds += InstanceDelta.RelevancyLocation.GetValue();
+		return false;
+	}
+#endif // WITH_SERVER_CODE
+
+	const int32 MaxNewDeltas = UE::ArsInstancedActors::CVars::DeltaRelevancyMaxNewDeltasPerConnectionPerFrame;
+	if (MaxNewDeltas > 0 && RelevancyContext->ConnectionRelevancy->NumNewDeltasWritten >= MaxNewDeltas)
+	{
+		RelevancyContext->bBudgetDeferredDeltas = true;
+		return false;
+	}
+
+	++RelevancyContext->ConnectionRelevancy->NumNewDeltasWritten;
+	return true;
+}
+
 // @todo consider merging the data in these two call backs (also PostReplicatedChange()) see CallPostReplicatedReceiveOrNot()
 void FArsInstancedActorsDeltaList::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
 {
@@ -93,6 +306,17 @@ void FArsInstancedActorsDeltaList::PreReplicatedRemove(const TArrayView<int32>&
 	}
 }
 
+const FArsInstancedActorsDelta* FArsInstancedActorsDeltaList::FindInstanceDelta(FArsInstancedActorsInstanceIndex InstanceIndex) const
+{
+	const int32* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceIndex);
+	if (DeltaIndexPtr != nullptr && ensureMsgf(InstanceDeltas.IsValidIndex(*DeltaIndexPtr), TEXT("Expecting a valid delta index")))
+	{
+		return &InstanceDeltas[*DeltaIndexPtr];
+	}
+
+	return nullptr;
+}
+
 void FArsInstancedActorsDeltaList::SetInstanceDestroyed(FArsInstancedActorsInstanceIndex InstanceIndex)
 {
 	FArsInstancedActorsDelta& InstanceDelta = FindOrAddInstanceDelta(InstanceIndex);
@@ -106,10 +330,10 @@ void FArsInstancedActorsDeltaList::SetInstanceDestroyed(FArsInstancedActorsInsta
 
 void FArsInstancedActorsDeltaList::RemoveDestroyedInstanceDelta(FArsInstancedActorsInstanceIndex InstanceIndex)
 {
-	uint16* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceIndex);
+	int32* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceIndex);
 	if (DeltaIndexPtr != nullptr)
 	{
-		uint16 DeltaIndex = *DeltaIndexPtr;
+		int32 DeltaIndex = *DeltaIndexPtr;
 
 		if (ensureMsgf(InstanceDeltas.IsValidIndex(DeltaIndex), TEXT("Expecting a valid delta index")))
 		{
@@ -124,6 +348,10 @@ void FArsInstancedActorsDeltaList::RemoveDestroyedInstanceDelta(FArsInstancedAct
 					{
 						RemoveInstanceDelta(DeltaIndex);
 					}
+					else
+					{
+						MarkItemDirty(InstanceDelta);
+					}
 
 					--NumDestroyedInstanceDeltas;
 				}
@@ -132,6 +360,17 @@ void FArsInstancedActorsDeltaList::RemoveDestroyedInstanceDelta(FArsInstancedAct
 	}
 }
 
+void FArsInstancedActorsDeltaList::SetInstanceAdded(FArsInstancedActorsInstanceIndex InstanceIndex, const FTransform& LocalTransform)
+{
+	FArsInstancedActorsDelta& InstanceDelta = FindOrAddInstanceDelta(InstanceIndex);
+	if (ensureMsgf(!InstanceDelta.IsAdded(), TEXT("Instance %s has already been added"), *InstanceIndex.GetDebugName()))
+	{
+		InstanceDelta.SetAdded(LocalTransform);
+		++NumAddedInstanceDeltas;
+		MarkItemDirty(InstanceDelta);
+	}
+}
+
 void FArsInstancedActorsDeltaList::SetCurrentLifecyclePhaseIndex(FArsInstancedActorsInstanceIndex InstanceIndex, uint8 InCurrentLifecyclePhaseIndex)
 {
 	FArsInstancedActorsDelta& InstanceDelta = FindOrAddInstanceDelta(InstanceIndex);
@@ -148,10 +387,10 @@ void FArsInstancedActorsDeltaList::SetCurrentLifecyclePhaseIndex(FArsInstancedAc
 
 void FArsInstancedActorsDeltaList::RemoveLifecyclePhaseDelta(FArsInstancedActorsInstanceIndex InstanceIndex)
 {
-	uint16* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceIndex);
+	int32* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceIndex);
 	if (DeltaIndexPtr != nullptr)
 	{
-		uint16 DeltaIndex = *DeltaIndexPtr;
+		int32 DeltaIndex = *DeltaIndexPtr;
 
 		if (ensureMsgf(InstanceDeltas.IsValidIndex(DeltaIndex), TEXT("Expecting a valid delta index")))
 		{
@@ -178,6 +417,51 @@ void FArsInstancedActorsDeltaList::RemoveLifecyclePhaseDelta(FArsInstancedActors
 	}
 }
 
+void FArsInstancedActorsDeltaList::SetInstanceFragment(FArsInstancedActorsInstanceIndex InstanceIndex, FConstStructView Fragment)
+{
+	const EArsInstancedActorsFragmentFlags FragmentFlags = UE::ArsInstancedActors::GetInstanceFragmentTypeFlags(Fragment.GetScriptStruct());
+	if (!ensureMsgf(FragmentFlags != EArsInstancedActorsFragmentFlags::None, TEXT("Instance fragment type %s must be registered via RegisterInstanceFragmentType before use"), *GetNameSafe(Fragment.GetScriptStruct())))
+	{
+		return;
+	}
+
+	const bool bReplicated = EnumHasAnyFlags(FragmentFlags, EArsInstancedActorsFragmentFlags::Replicated);
+
+	FArsInstancedActorsDelta& InstanceDelta = FindOrAddInstanceDelta(InstanceIndex);
+	if (InstanceDelta.SetFragment(Fragment, bReplicated) && bReplicated)
+	{
+		MarkItemDirty(InstanceDelta);
+	}
+}
+
+void FArsInstancedActorsDeltaList::RemoveInstanceFragment(FArsInstancedActorsInstanceIndex InstanceIndex, const UScriptStruct& FragmentType)
+{
+	int32* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceIndex);
+	if (DeltaIndexPtr != nullptr)
+	{
+		int32 DeltaIndex = *DeltaIndexPtr;
+
+		if (ensureMsgf(InstanceDeltas.IsValidIndex(DeltaIndex), TEXT("Expecting a valid delta index")))
+		{
+			FArsInstancedActorsDelta& InstanceDelta = InstanceDeltas[DeltaIndex];
+			if (ensureMsgf(InstanceDelta.GetInstanceIndex() == InstanceIndex, TEXT("Expecting instance index to match")))
+			{
+				if (InstanceDelta.RemoveFragment(&FragmentType))
+				{
+					if (!InstanceDelta.HasAnyDeltas())
+					{
+						RemoveInstanceDelta(DeltaIndex);
+					}
+					else if (EnumHasAnyFlags(UE::ArsInstancedActors::GetInstanceFragmentTypeFlags(&FragmentType), EArsInstancedActorsFragmentFlags::Replicated))
+					{
+						MarkItemDirty(InstanceDelta);
+					}
+				}
+			}
+		}
+	}
+}
+
 #if WITH_SERVER_CODE
 void FArsInstancedActorsDeltaList::SetCurrentLifecyclePhaseTimeElapsed(FArsInstancedActorsInstanceIndex InstanceIndex, FFloat16 InCurrentLifecyclePhaseTimeElapsed)
 {
@@ -195,10 +479,10 @@ void FArsInstancedActorsDeltaList::SetCurrentLifecyclePhaseTimeElapsed(FArsInsta
 
 void FArsInstancedActorsDeltaList::RemoveLifecyclePhaseTimeElapsedDelta(FArsInstancedActorsInstanceIndex InstanceIndex)
 {
-	uint16* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceIndex);
+	int32* DeltaIndexPtr = InstanceIndexToDeltaIndex.Find(InstanceIndex);
 	if (DeltaIndexPtr != nullptr)
 	{
-		uint16 DeltaIndex = *DeltaIndexPtr;
+		int32 DeltaIndex = *DeltaIndexPtr;
 
 		if (ensureMsgf(InstanceDeltas.IsValidIndex(DeltaIndex), TEXT("Expecting a valid delta index")))
 		{
@@ -228,6 +512,7 @@ void FArsInstancedActorsDeltaList::Reset(bool bMarkDirty)
 	InstanceIndexToDeltaIndex.Reset();
 
 	NumDestroyedInstanceDeltas = 0;
+	NumAddedInstanceDeltas = 0;
 	NumLifecyclePhaseDeltas = 0;
 	NumLifecyclePhaseTimeElapsedDeltas = 0;
 
@@ -36,8 +36,18 @@ EMassActorSpawnRequestAction UArsInstancedActorsRepresentationActorManagement::O
 			}
 		}
 
-		// Allow settings to turn off damage for this actor.
 		UArsInstancedActorsSubsystem& InstancedActorSubsystem = UArsInstancedActorsSubsystem::GetChecked(MassActorSpawnRequest.SpawnedActor);
+
+		// Hydration implies a viewer is amongst these instances, so their ISMC collision must not be pending
+		if (UArsInstancedActorsData* InstanceData = UArsInstancedActorsData::GetInstanceDataForEntity(*EntityManager, MassActorSpawnRequest.MassAgent))
+		{
+			InstancedActorSubsystem.FlushDeferredPhysicsStateCreation(*InstanceData);
+
+			// The actor now provides this instance's collision
+			InstanceData->OnInstancedActorHydrationChanged(MassActorSpawnRequest.MassAgent, /*bHydrated*/true);
+		}
+
+		// Allow settings to turn off damage for this actor.
 		FSharedStruct SharedSettings = InstancedActorSubsystem.GetOrCompileSettingsForActorClass(MassActorSpawnRequest.SpawnedActor->GetClass());
 		const FArsInstancedActorsSettings* Settings = SharedSettings.GetPtr<FArsInstancedActorsSettings>();
 		if (Settings && Settings->bOverride_bCanBeDamaged)
@@ -77,6 +87,14 @@ void UArsInstancedActorsRepresentationActorManagement::SetActorEnabled(const EMa
 	{
 		Super::SetActorEnabled(EnabledType, Actor, EntityIdx, CommandBuffer);
 	}
+
+	// Disabled actors no longer collide, so hand collision back to the instance until re-enabled. Deferred as per 
+	// SetActorEnableCollision above, as this updates instance bodies.
+	const bool bHydrated = (EnabledType != EMassActorEnabledType::Disabled);
+	CommandBuffer.PushCommand<FMassDeferredSetCommand>([&Actor, bHydrated](FMassEntityManager&)
+		{
+			UArsInstancedActorsData::OnInstancedActorHydrationChanged(Actor, bHydrated);
+		});
 }
 
 void UArsInstancedActorsRepresentationActorManagement::TeleportActor(const FTransform& Transform, AActor& Actor, FMassCommandBuffer& CommandBuffer) const
@@ -182,6 +200,13 @@ AActor* UArsInstancedActorsRepresentationActorManagement::FindOrInstantlySpawnAc
 
 	if (SpawnedActor)
 	{
+		// As per OnPostActorSpawn, make sure neighbouring instances' ISMC collision isn't pending
+		if (UArsInstancedActorsData* InstanceData = UArsInstancedActorsData::GetInstanceDataForEntity(EntityManager, EntityView.GetEntity()))
+		{
+			UArsInstancedActorsSubsystem::GetChecked(SpawnedActor).FlushDeferredPhysicsStateCreation(*InstanceData);
+			InstanceData->OnInstancedActorHydrationChanged(EntityView.GetEntity(), /*bHydrated*/true);
+		}
+
 		FMassRepresentationLODFragment& RepresentationLOD = EntityView.GetFragmentData<FMassRepresentationLODFragment>();
 		RepresentationLOD.LOD = EMassLOD::High;
 
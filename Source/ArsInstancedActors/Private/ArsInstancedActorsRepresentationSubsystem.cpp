@@ -2,6 +2,10 @@
 
 #include "ArsInstancedActorsRepresentationSubsystem.h"
 #include "ArsInstancedActorsSettings.h"
+#include "ArsInstancedActorsTypes.h"
+#include "ArsInstancedActorsVisualizationSwitcherProcessor.h"
+#include "MassEntityManager.h"
+#include "MassRepresentationFragments.h"
 
 
 void UArsInstancedActorsRepresentationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -24,10 +28,73 @@ void UArsInstancedActorsRepresentationSubsystem::Deinitialize()
 {
 	GET_ARSINSTANCEDACTORS_CONFIG_VALUE(GetOnSettingsUpdated()).Remove(OnSettingsChangedHandle);
 	ActorSpawnerSubsystem = nullptr;
+	PendingVisualizationSwitches.Empty();
 
 	Super::Deinitialize();
 }
 
+void UArsInstancedActorsRepresentationSubsystem::RequestVisualizationSwitches(TConstArrayView<FMassEntityHandle> EntityHandles, const FStaticMeshInstanceVisualizationDescHandle NewStaticMeshDescHandle)
+{
+	PendingVisualizationSwitches.Reserve(PendingVisualizationSwitches.Num() + EntityHandles.Num());
+	for (const FMassEntityHandle EntityHandle : EntityHandles)
+	{
+		PendingVisualizationSwitches.Add(EntityHandle, NewStaticMeshDescHandle);
+	}
+}
+
+void UArsInstancedActorsRepresentationSubsystem::ConsumePendingVisualizationSwitches(TArray<TPair<FMassEntityHandle, FStaticMeshInstanceVisualizationDescHandle>>& OutSwitches)
+{
+	OutSwitches.Reset(PendingVisualizationSwitches.Num());
+	for (const TPair<FMassEntityHandle, FStaticMeshInstanceVisualizationDescHandle>& PendingSwitch : PendingVisualizationSwitches)
+	{
+		OutSwitches.Add(PendingSwitch);
+	}
+	PendingVisualizationSwitches.Reset();
+
+	OutSwitches.Sort([](const TPair<FMassEntityHandle, FStaticMeshInstanceVisualizationDescHandle>& A, const TPair<FMassEntityHandle, FStaticMeshInstanceVisualizationDescHandle>& B)
+		{
+			return A.Value.ToIndex() < B.Value.ToIndex();
+		});
+}
+
+void UArsInstancedActorsRepresentationSubsystem::RetargetStaticMeshDesc(FMassEntityManager& EntityManager, TConstArrayView<FMassEntityHandle> EntityHandles
+	, const FStaticMeshInstanceVisualizationDescHandle OldStaticMeshDescHandle, const FStaticMeshInstanceVisualizationDescHandle NewStaticMeshDescHandle)
+{
+	for (TPair<FMassEntityHandle, FStaticMeshInstanceVisualizationDescHandle>& PendingSwitch : PendingVisualizationSwitches)
+	{
+		if (PendingSwitch.Value == OldStaticMeshDescHandle)
+		{
+			PendingSwitch.Value = NewStaticMeshDescHandle;
+		}
+	}
+
+	FMassInstancedStaticMeshInfoArrayView ISMInfosView = GetMutableInstancedStaticMeshInfos();
+	for (const FMassEntityHandle EntityHandle : EntityHandles)
+	{
+		if (!EntityManager.IsEntityValid(EntityHandle))
+		{
+			continue;
+		}
+
+		if (FMassRepresentationFragment* RepresentationFragment = EntityManager.GetFragmentDataPtr<FMassRepresentationFragment>(EntityHandle))
+		{
+			if (RepresentationFragment->StaticMeshDescHandle == OldStaticMeshDescHandle)
+			{
+				UArsInstancedActorsVisualizationSwitcherProcessor::SwitchEntityMeshDesc(ISMInfosView, *RepresentationFragment, EntityHandle, NewStaticMeshDescHandle);
+			}
+		}
+
+		// Unbatched switch requests already added as fragments, @see IA.Visualizations.BatchSwitches
+		if (FArsInstancedActorsMeshSwitchFragment* MeshSwitchFragment = EntityManager.GetFragmentDataPtr<FArsInstancedActorsMeshSwitchFragment>(EntityHandle))
+		{
+			if (MeshSwitchFragment->NewStaticMeshDescHandle == OldStaticMeshDescHandle)
+			{
+				MeshSwitchFragment->NewStaticMeshDescHandle = NewStaticMeshDescHandle;
+			}
+		}
+	}
+}
+
 void UArsInstancedActorsRepresentationSubsystem::OnSettingsChanged()
 {
 	if (UWorld* World = GetWorld())
@@ -124,6 +124,11 @@ void FArsInstancedActorsSettings::OverrideIfDefault(FConstStructView InOverrideS
 	IASETTINGS_OVERRIDE_IF_DEFAULT(DetailedRepresentationLODDistance);
 	IASETTINGS_OVERRIDE_IF_DEFAULT(ForceLowRepresentationLODDistance);
 	IASETTINGS_OVERRIDE_IF_DEFAULT(WorldPositionOffsetDisableDistance);	
+	IASETTINGS_OVERRIDE_IF_DEFAULT(MediumLODDistance);
+	IASETTINGS_OVERRIDE_IF_DEFAULT(MediumLODTickInterval);
+	IASETTINGS_OVERRIDE_IF_DEFAULT(MediumLODForcedLodModel);
+	IASETTINGS_OVERRIDE_IF_DEFAULT(bMediumLODCastShadows);
+	IASETTINGS_OVERRIDE_IF_DEFAULT(bMediumLODEvaluateWorldPositionOffset);
 	IASETTINGS_OVERRIDE_IF_DEFAULT(bEjectOnActorMoved);
 	IASETTINGS_OVERRIDE_IF_DEFAULT(ActorEjectionMovementThreshold);
 	IASETTINGS_OVERRIDE_IF_DEFAULT(bCanEverAffectNavigation);
@@ -135,6 +140,7 @@ void FArsInstancedActorsSettings::OverrideIfDefault(FConstStructView InOverrideS
 	IASETTINGS_OVERRIDE_IF_DEFAULT(bIgnoreModifierVolumes);
 	IASETTINGS_OVERRIDE_IF_DEFAULT(bModifierVolumeCheckFullyEnclosed);
 	IASETTINGS_OVERRIDE_IF_DEFAULT(bControlPhysicsState);
+	IASETTINGS_OVERRIDE_IF_DEFAULT(bMovableInstances);
 	IASETTINGS_OVERRIDE_IF_DEFAULT(GameplayTags);
 	
 	AppliedSettingsOverrides.Add(OverrideSettingsName);
@@ -152,6 +158,11 @@ FString FArsInstancedActorsSettings::DebugToString(bool bOverridesOnly) const
 	IASETTINGS_FLOAT_SETTING_TO_STRING(DetailedRepresentationLODDistance);
 	IASETTINGS_FLOAT_SETTING_TO_STRING(ForceLowRepresentationLODDistance);
 	IASETTINGS_FLOAT_SETTING_TO_STRING(WorldPositionOffsetDisableDistance);
+	IASETTINGS_FLOAT_SETTING_TO_STRING(MediumLODDistance);
+	IASETTINGS_FLOAT_SETTING_TO_STRING(MediumLODTickInterval);
+	IASETTINGS_SETTING_TO_STRING(MediumLODForcedLodModel);
+	IASETTINGS_SETTING_TO_STRING(bMediumLODCastShadows);
+	IASETTINGS_SETTING_TO_STRING(bMediumLODEvaluateWorldPositionOffset);
 	IASETTINGS_SETTING_TO_STRING(bEjectOnActorMoved);
 	IASETTINGS_FLOAT_SETTING_TO_STRING(ActorEjectionMovementThreshold);
 	IASETTINGS_SETTING_TO_STRING(bCanEverAffectNavigation);
@@ -162,6 +173,7 @@ FString FArsInstancedActorsSettings::DebugToString(bool bOverridesOnly) const
 	IASETTINGS_SETTING_TO_STRING(bIgnoreModifierVolumes);
 	IASETTINGS_SETTING_TO_STRING(bModifierVolumeCheckFullyEnclosed);
 	IASETTINGS_SETTING_TO_STRING(bControlPhysicsState);
+	IASETTINGS_SETTING_TO_STRING(bMovableInstances);
 	DisplaySettings(SettingsString, GameplayTags, bOverridesOnly, bOverride_GameplayTags, TEXT("GameplayTags"));
 
 	DisplaySettings(SettingsString, LODDistanceScales, bOverridesOnly, bOverride_LODDistanceScales, TEXT("LODDistanceScales"));
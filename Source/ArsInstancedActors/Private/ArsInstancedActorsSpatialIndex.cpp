@@ -0,0 +1,314 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#include "ArsInstancedActorsSpatialIndex.h"
+#include "ArsInstancedActorsBoundsTests.h"
+
+
+namespace UE::ArsInstancedActors
+{
+	namespace
+	{
+		// Upper limit on cells per axis, bounding CellStarts memory for sparse / very spread out instance sets
+		constexpr int32 MaxCellsPerAxis = 256;
+	} // anonymous
+
+	//-----------------------------------------------------------------------------
+	// FInstanceSpatialIndex
+	//-----------------------------------------------------------------------------
+	void FInstanceSpatialIndex::Build(TConstArrayView<FTransform> InstanceTransforms, const FTransform& InstanceToWorld, const FBox& LocalInstanceBounds, int32 TargetInstancesPerCell)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FInstanceSpatialIndex Build);
+
+		Reset();
+
+		const int32 NumInstances = InstanceTransforms.Num();
+		ValidInstances.Init(false, NumInstances);
+
+		// Gather world space locations for valid instances, along with the location bounds and query padding
+		TArray<FVector> WorldLocations;
+		WorldLocations.SetNumUninitialized(NumInstances);
+		FBox LocationBounds(ForceInit);
+		int32 NumValidInstances = 0;
+		for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+		{
+			const FTransform& InstanceTransform = InstanceTransforms[InstanceIndex];
+			if (InstanceTransform.GetScale3D().IsZero())
+			{
+				continue;
+			}
+
+			const FTransform WorldTransform = InstanceTransform * InstanceToWorld;
+			const FVector WorldLocation = WorldTransform.GetLocation();
+			WorldLocations[InstanceIndex] = WorldLocation;
+			LocationBounds += WorldLocation;
+
+			if (LocalInstanceBounds.IsValid)
+			{
+				const FBox WorldInstanceBounds = LocalInstanceBounds.TransformBy(WorldTransform);
+				IndexedBounds += WorldInstanceBounds;
+				QueryPadding = FMath::Max3(QueryPadding
+					, FMath::Max(WorldLocation.X - WorldInstanceBounds.Min.X, WorldInstanceBounds.Max.X - WorldLocation.X)
+					, FMath::Max(WorldLocation.Y - WorldInstanceBounds.Min.Y, WorldInstanceBounds.Max.Y - WorldLocation.Y));
+				QueryPaddingZ = FMath::Max3(QueryPaddingZ, WorldLocation.Z - WorldInstanceBounds.Min.Z, WorldInstanceBounds.Max.Z - WorldLocation.Z);
+			}
+			else
+			{
+				IndexedBounds += WorldLocation;
+			}
+
+			ValidInstances[InstanceIndex] = true;
+			++NumValidInstances;
+		}
+
+		if (NumValidInstances == 0)
+		{
+			Reset();
+			return;
+		}
+
+		IndexedBounds = IndexedBounds.ExpandBy(FVector(QueryPadding, QueryPadding, 0.0));
+
+		// Choose a square cell size giving roughly TargetInstancesPerCell instances per cell, assuming an even distribution
+		const FVector LocationExtent = LocationBounds.GetSize();
+		const double TargetNumCells = FMath::Max(1.0, double(NumValidInstances) / double(FMath::Max(TargetInstancesPerCell, 1)));
+		const double Area = LocationExtent.X * LocationExtent.Y;
+		const double LongestSide = FMath::Max(LocationExtent.X, LocationExtent.Y);
+		CellSize = (Area > UE_KINDA_SMALL_NUMBER) ? FMath::Sqrt(Area / TargetNumCells) : (LongestSide / TargetNumCells);
+		CellSize = FMath::Max3(CellSize, LongestSide / MaxCellsPerAxis, 1.0);
+
+		GridOrigin = FVector2D(LocationBounds.Min);
+		GridSize.X = FMath::Clamp(FMath::FloorToInt32(LocationExtent.X / CellSize) + 1, 1, MaxCellsPerAxis);
+		GridSize.Y = FMath::Clamp(FMath::FloorToInt32(LocationExtent.Y / CellSize) + 1, 1, MaxCellsPerAxis);
+		const int32 NumCells = GridSize.X * GridSize.Y;
+
+		// Counting sort instances into cells: count, prefix sum, then scatter
+		TArray<int32> InstanceCells;
+		InstanceCells.SetNumUninitialized(NumInstances);
+		CellStarts.SetNumZeroed(NumCells + 1);
+		for (TConstSetBitIterator<> It(ValidInstances); It; ++It)
+		{
+			const FIntPoint CellCoord = GetClampedCellCoord(WorldLocations[It.GetIndex()]);
+			const int32 CellIndex = GetCellIndex(CellCoord.X, CellCoord.Y);
+			InstanceCells[It.GetIndex()] = CellIndex;
+			++CellStarts[CellIndex + 1];
+		}
+
+		for (int32 CellIndex = 1; CellIndex <= NumCells; ++CellIndex)
+		{
+			CellStarts[CellIndex] += CellStarts[CellIndex - 1];
+		}
+
+		TArray<int32> CellWriteOffsets(CellStarts.GetData(), NumCells);
+		CellInstances.SetNumUninitialized(NumValidInstances);
+		CellInstanceLocations.SetNumUninitialized(NumValidInstances);
+		CellZRanges.SetNum(NumCells);
+		for (TConstSetBitIterator<> It(ValidInstances); It; ++It)
+		{
+			const int32 CellIndex = InstanceCells[It.GetIndex()];
+			const FVector& WorldLocation = WorldLocations[It.GetIndex()];
+			const int32 PackedIndex = CellWriteOffsets[CellIndex]++;
+			CellInstances[PackedIndex] = FArsInstancedActorsInstanceIndex(It.GetIndex());
+			CellInstanceLocations[PackedIndex] = WorldLocation;
+			CellZRanges[CellIndex].Include(WorldLocation.Z - QueryPaddingZ);
+			CellZRanges[CellIndex].Include(WorldLocation.Z + QueryPaddingZ);
+		}
+	}
+
+	void FInstanceSpatialIndex::Reset()
+	{
+		GridOrigin = FVector2D::ZeroVector;
+		CellSize = 1.0;
+		GridSize = FIntPoint::ZeroValue;
+		QueryPadding = 0.0;
+		QueryPaddingZ = 0.0;
+		IndexedBounds = FBox(ForceInit);
+		CellStarts.Empty();
+		CellInstances.Empty();
+		CellInstanceLocations.Empty();
+		CellZRanges.Empty();
+		ValidInstances.Empty();
+		AddedInstances.Empty();
+		AddedInstanceLocations.Empty();
+	}
+
+	void FInstanceSpatialIndex::AddInstances(TConstArrayView<FArsInstancedActorsInstanceIndex> InstanceIndices, TConstArrayView<FTransform> WorldTransforms, const FBox& LocalInstanceBounds)
+	{
+		check(InstanceIndices.Num() == WorldTransforms.Num());
+		if (!IsBuilt())
+		{
+			return;
+		}
+
+		// Undo the existing padding, so IndexedBounds can be re-padded by the (possibly grown) QueryPadding below
+		FBox UnpaddedIndexedBounds = IndexedBounds.ExpandBy(FVector(-QueryPadding, -QueryPadding, 0.0));
+		for (int32 AddedIndex = 0; AddedIndex < InstanceIndices.Num(); ++AddedIndex)
+		{
+			const int32 InstanceIndex = InstanceIndices[AddedIndex].GetIndex();
+			const FTransform& WorldTransform = WorldTransforms[AddedIndex];
+			const FVector WorldLocation = WorldTransform.GetLocation();
+
+			if (LocalInstanceBounds.IsValid)
+			{
+				const FBox WorldInstanceBounds = LocalInstanceBounds.TransformBy(WorldTransform);
+				UnpaddedIndexedBounds += WorldInstanceBounds;
+				QueryPadding = FMath::Max3(QueryPadding
+					, FMath::Max(WorldLocation.X - WorldInstanceBounds.Min.X, WorldInstanceBounds.Max.X - WorldLocation.X)
+					, FMath::Max(WorldLocation.Y - WorldInstanceBounds.Min.Y, WorldInstanceBounds.Max.Y - WorldLocation.Y));
+				QueryPaddingZ = FMath::Max3(QueryPaddingZ, WorldLocation.Z - WorldInstanceBounds.Min.Z, WorldInstanceBounds.Max.Z - WorldLocation.Z);
+			}
+			else
+			{
+				UnpaddedIndexedBounds += WorldLocation;
+			}
+
+			if (InstanceIndex >= ValidInstances.Num())
+			{
+				ValidInstances.Add(false, InstanceIndex + 1 - ValidInstances.Num());
+			}
+			ValidInstances[InstanceIndex] = true;
+
+			AddedInstances.Add(InstanceIndices[AddedIndex]);
+			AddedInstanceLocations.Add(WorldLocation);
+		}
+		IndexedBounds = UnpaddedIndexedBounds.ExpandBy(FVector(QueryPadding, QueryPadding, 0.0));
+	}
+
+	void FInstanceSpatialIndex::RemoveInstance(const FArsInstancedActorsInstanceIndex InstanceIndex)
+	{
+		if (ValidInstances.IsValidIndex(InstanceIndex.GetIndex()))
+		{
+			ValidInstances[InstanceIndex.GetIndex()] = false;
+		}
+	}
+
+	void FInstanceSpatialIndex::RemoveAllInstances()
+	{
+		ValidInstances.SetRange(0, ValidInstances.Num(), false);
+	}
+
+	int32 FInstanceSpatialIndex::GatherCandidates(const FBox& QueryBounds, TArray<FArsInstancedActorsInstanceIndex>& OutCandidates) const
+	{
+		if (!IsBuilt() || !IndexedBounds.Intersect(QueryBounds))
+		{
+			return 0;
+		}
+
+		const FBox PaddedQueryBounds = QueryBounds.ExpandBy(FVector(QueryPadding, QueryPadding, 0.0));
+		const FIntPoint MinCell = GetClampedCellCoord(PaddedQueryBounds.Min);
+		const FIntPoint MaxCell = GetClampedCellCoord(PaddedQueryBounds.Max);
+
+		const int32 NumCandidatesBefore = OutCandidates.Num();
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			// Cells along X are contiguous in CellInstances, so we can walk the whole row span at once
+			const int32 RowStart = CellStarts[GetCellIndex(MinCell.X, CellY)];
+			const int32 RowEnd = CellStarts[GetCellIndex(MaxCell.X, CellY) + 1];
+			for (int32 PackedIndex = RowStart; PackedIndex < RowEnd; ++PackedIndex)
+			{
+				const FArsInstancedActorsInstanceIndex InstanceIndex = CellInstances[PackedIndex];
+				if (ValidInstances[InstanceIndex.GetIndex()])
+				{
+					OutCandidates.Add(InstanceIndex);
+				}
+			}
+		}
+
+		// Runtime added instances aren't binned, test their locations directly
+		for (int32 AddedIndex = 0; AddedIndex < AddedInstances.Num(); ++AddedIndex)
+		{
+			const FVector& Location = AddedInstanceLocations[AddedIndex];
+			if (ValidInstances[AddedInstances[AddedIndex].GetIndex()]
+				&& Location.X >= PaddedQueryBounds.Min.X && Location.X <= PaddedQueryBounds.Max.X
+				&& Location.Y >= PaddedQueryBounds.Min.Y && Location.Y <= PaddedQueryBounds.Max.Y)
+			{
+				OutCandidates.Add(AddedInstances[AddedIndex]);
+			}
+		}
+
+		return OutCandidates.Num() - NumCandidatesBefore;
+	}
+
+	int32 FInstanceSpatialIndex::GatherCandidates(const FSphere& QueryBounds, TArray<FArsInstancedActorsInstanceIndex>& OutCandidates) const
+	{
+		return GatherCandidates(FBox(QueryBounds.Center - FVector(QueryBounds.W), QueryBounds.Center + FVector(QueryBounds.W)), OutCandidates);
+	}
+
+	int32 FInstanceSpatialIndex::GatherCandidates(const FOrientedBox& QueryBounds, TArray<FArsInstancedActorsInstanceIndex>& OutCandidates) const
+	{
+		return GatherCandidates(BoundsTests::GetBoundingBox(QueryBounds), OutCandidates);
+	}
+
+	bool FInstanceSpatialIndex::TestOccupancy(const FBox& QueryBounds, TArray<FArsInstancedActorsInstanceIndex>& OutOverlapCandidates) const
+	{
+		if (!IsBuilt() || !IndexedBounds.Intersect(QueryBounds))
+		{
+			return false;
+		}
+
+		// Instances with locations outside PaddedQueryBounds can't have bounds overlapping QueryBounds
+		const FBox PaddedQueryBounds = QueryBounds.ExpandBy(FVector(QueryPadding, QueryPadding, QueryPaddingZ));
+		const FIntPoint MinCell = GetClampedCellCoord(PaddedQueryBounds.Min);
+		const FIntPoint MaxCell = GetClampedCellCoord(PaddedQueryBounds.Max);
+
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+			{
+				const int32 CellIndex = GetCellIndex(CellX, CellY);
+				const FDoubleInterval& CellZRange = CellZRanges[CellIndex];
+				if (!CellZRange.IsValid() || CellZRange.Max < QueryBounds.Min.Z || CellZRange.Min > QueryBounds.Max.Z)
+				{
+					continue;
+				}
+
+				for (int32 PackedIndex = CellStarts[CellIndex]; PackedIndex < CellStarts[CellIndex + 1]; ++PackedIndex)
+				{
+					const FArsInstancedActorsInstanceIndex InstanceIndex = CellInstances[PackedIndex];
+					const FVector& Location = CellInstanceLocations[PackedIndex];
+					if (!ValidInstances[InstanceIndex.GetIndex()] || !PaddedQueryBounds.IsInside(Location))
+					{
+						continue;
+					}
+
+					if (QueryBounds.IsInside(Location))
+					{
+						return true;
+					}
+					OutOverlapCandidates.Add(InstanceIndex);
+				}
+			}
+		}
+
+		// Runtime added instances aren't binned, test their locations directly
+		for (int32 AddedIndex = 0; AddedIndex < AddedInstances.Num(); ++AddedIndex)
+		{
+			const FVector& Location = AddedInstanceLocations[AddedIndex];
+			if (!ValidInstances[AddedInstances[AddedIndex].GetIndex()] || !PaddedQueryBounds.IsInside(Location))
+			{
+				continue;
+			}
+
+			if (QueryBounds.IsInside(Location))
+			{
+				return true;
+			}
+			OutOverlapCandidates.Add(AddedInstances[AddedIndex]);
+		}
+
+		return false;
+	}
+
+	SIZE_T FInstanceSpatialIndex::GetAllocatedSize() const
+	{
+		return CellStarts.GetAllocatedSize() + CellInstances.GetAllocatedSize() + CellInstanceLocations.GetAllocatedSize()
+			+ CellZRanges.GetAllocatedSize() + ValidInstances.GetAllocatedSize()
+			+ AddedInstances.GetAllocatedSize() + AddedInstanceLocations.GetAllocatedSize();
+	}
+
+	FIntPoint FInstanceSpatialIndex::GetClampedCellCoord(const FVector& Location) const
+	{
+		return FIntPoint(
+			FMath::Clamp(FMath::FloorToInt32((Location.X - GridOrigin.X) / CellSize), 0, GridSize.X - 1),
+			FMath::Clamp(FMath::FloorToInt32((Location.Y - GridOrigin.Y) / CellSize), 0, GridSize.Y - 1));
+	}
+} // namespace UE::ArsInstancedActors
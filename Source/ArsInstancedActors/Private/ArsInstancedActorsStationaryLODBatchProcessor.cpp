@@ -13,6 +13,8 @@
 #include "ArsInstancedActorsVisualizationProcessor.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "StaticMeshResources.h"
+#include "ConvexVolume.h"
+#include "SceneManagement.h"
 
 #include "MassActorSubsystem.h"
 #include "MassCommands.h"
@@ -24,6 +26,7 @@
 #include "MassRepresentationTypes.h"
 #include "MassSignalSubsystem.h"
 #include "MassStationaryISMSwitcherProcessor.h"
+#include "Async/ParallelFor.h"
 
 
 DECLARE_CYCLE_STAT(TEXT("ArsInstancedActors LODBatchProcessor"), STAT_ArsInstancedActorsStationaryLODBatchProcessor_Execute, STATGROUP_Mass);
@@ -34,7 +37,17 @@ bool bBatchedStationaryLODEnabled = true;
 bool bLODBasedTicking = true;
 bool bControlPhysicsState = true;
 bool bUpdateLiveCullDistanceTweaking = false;
+bool bParallelBulkLODEvaluation = true;
+int32 ParallelBulkLODEvaluationMinBatchSize = 64;
 float DebugDetailedLevelDistanceOverride = 0.f;
+bool bBulkLODFrustumCulling = false;
+bool bBulkLODOcclusionCulling = false;
+float BulkLODVisibilityCullingMinDistance = 3000.f;
+float BulkLODFrustumCullingMargin = 500.f;
+float BulkLODOcclusionRenderTimeTolerance = 0.5f;
+float BulkLODVisibilityCulledTickInterval = 0.5f;
+float BulkLODHysteresisRatio = 0.05f;
+float BulkLODMinDwellTime = 1.f;
 
 namespace 
 {
@@ -59,6 +72,57 @@ static FAutoConsoleVariableRef AnonymousCVars[] = {
 		bUpdateLiveCullDistanceTweaking,
 		TEXT(""), ECVF_Cheat
 	},
+	{
+		TEXT("IA.ParallelBulkLODEvaluation"),
+		bParallelBulkLODEvaluation,
+		TEXT("If enabled, per instance data viewer distance and bulk LOD evaluation is performed in a ParallelFor, before applying bulk LOD changes serially."), ECVF_Default
+	},
+	{
+		TEXT("IA.ParallelBulkLODEvaluation.MinBatchSize"),
+		ParallelBulkLODEvaluationMinBatchSize,
+		TEXT("Minimum number of instance datas evaluated per IA.ParallelBulkLODEvaluation worker batch."), ECVF_Default
+	},
+	{
+		TEXT("IA.BulkLOD.FrustumCulling"),
+		bBulkLODFrustumCulling,
+		TEXT("If enabled, instance datas within Detailed distance but outside of all viewers' view frustums are capped at Medium bulk LOD."), ECVF_Default
+	},
+	{
+		TEXT("IA.BulkLOD.OcclusionCulling"),
+		bBulkLODOcclusionCulling,
+		TEXT("If enabled, instance datas within Detailed distance whose ISMCs weren't rendered recently (i.e. were occluded last frames) are capped at Medium bulk LOD.")
+		TEXT(" Has no effect on dedicated servers."), ECVF_Default
+	},
+	{
+		TEXT("IA.BulkLOD.VisibilityCullingMinDistance"),
+		BulkLODVisibilityCullingMinDistance,
+		TEXT("Instance datas closer than this to any viewer are never frustum or occlusion culled, keeping physics & hydration around viewers regardless of view direction."), ECVF_Default
+	},
+	{
+		TEXT("IA.BulkLOD.FrustumCullingMargin"),
+		BulkLODFrustumCullingMargin,
+		TEXT("Distance instance data bounds are expanded by before testing them against viewer frustums."), ECVF_Default
+	},
+	{
+		TEXT("IA.BulkLOD.OcclusionRenderTimeTolerance"),
+		BulkLODOcclusionRenderTimeTolerance,
+		TEXT("Seconds since an instance data's ISMCs were last rendered on screen after which it's considered occluded by IA.BulkLOD.OcclusionCulling."), ECVF_Default
+	},
+	{
+		TEXT("IA.BulkLOD.VisibilityCulledTickInterval"),
+		BulkLODVisibilityCulledTickInterval,
+		TEXT("Interval in seconds at which frustum or occlusion culled instance datas are re-evaluated, so they're promoted back to Detailed promptly once visible."), ECVF_Default
+	},
+	{
+		TEXT("IA.BulkLOD.HysteresisRatio"),
+		BulkLODHysteresisRatio,
+		TEXT("Bulk LOD distance thresholds are extended by this ratio for instance datas currently at, or better than, the tier in question, to prevent flip-flopping around boundaries."), ECVF_Default
+	},
+	{
+		TEXT("IA.BulkLOD.MinDwellTime"),
+		BulkLODMinDwellTime,
+		TEXT("Minimum time in seconds an instance data stays at a bulk LOD before it can be lowered to a less detailed one. Promotions aren't delayed."), ECVF_Default
+	},
 	{
 		TEXT("IA.debug.DetailedLevelDistanceOverride"),
 		DebugDetailedLevelDistanceOverride,
@@ -71,35 +135,210 @@ static FAutoConsoleVariableRef AnonymousCVars[] = {
 
 namespace UE::ArsInstancedActors
 {
-	bool EnablePhysicForVisualization(uint8 /*VisualizationIndex*/, const FArsInstancedActorsVisualizationInfo& Visualization)
+	/**
+	 * Requests physics state creation for Visualization's ISMComponents from InstancedActorSubsystem, which time-slices creation
+	 * closest to viewers first. @see IA.PhysicsStateCreation.Deferred
+	 */
+	void EnablePhysicForVisualization(UArsInstancedActorsSubsystem& InstancedActorSubsystem, const FArsInstancedActorsVisualizationInfo& Visualization, const double DistanceSquared)
 	{
 		for (const TObjectPtr<UInstancedStaticMeshComponent>& ISMComponent : Visualization.ISMComponents)
 		{
 			if (ISMComponent)
 			{
-				if (ISMComponent->IsRegistered())
-				{
-					ISMComponent->CreatePhysicsState(/*bAllowDeferral=*/true);
-				}
-				else
-				{
-					UE_LOG(LogArsInstancedActors, Error, TEXT("Failed to call CreatePhysicsState() on component '%s', because component is not registered."), *GetFullNameSafe(ISMComponent));
-				}
+				InstancedActorSubsystem.RequestDeferredPhysicsStateCreation(*ISMComponent, DistanceSquared);
 			}
 		}
-		return true;
 	}
 
-	bool DisablePhysicForVisualization(uint8 /*VisualizationIndex*/, const FArsInstancedActorsVisualizationInfo& Visualization)
+	void DisablePhysicForVisualization(UArsInstancedActorsSubsystem& InstancedActorSubsystem, const FArsInstancedActorsVisualizationInfo& Visualization)
 	{
 		for (const TObjectPtr<UInstancedStaticMeshComponent>& ISMComponent : Visualization.ISMComponents)
 		{
 			if (ISMComponent)
 			{
+				InstancedActorSubsystem.CancelDeferredPhysicsStateCreation(*ISMComponent);
 				ISMComponent->DestroyPhysicsState();
 			}
 		}
-		return true;
+	}
+
+	/** Per-execution inputs shared by all bulk LOD evaluations */
+	struct FBulkLODEvaluationContext
+	{
+		TConstArrayView<FViewerInfo> Viewers;
+
+		// View frustums matching Viewers, or empty if IA.BulkLOD.FrustumCulling is disabled
+		TConstArrayView<FConvexVolume> ViewerFrustums;
+
+		float StaticMeshLODDistanceScale = 1.f;
+		double CurrentTime = 0.0;
+		bool bOcclusionCulling = false;
+	};
+
+	/** Result of evaluating a single due FArsInstancedActorsDataSharedFragment, computed in parallel and applied serially */
+	struct FBulkLODEvaluation
+	{
+		UArsInstancedActorsSubsystem::FNextTickSharedFragment WrappedSharedFragment;
+		EArsInstancedActorsBulkLOD NewBulkLOD = EArsInstancedActorsBulkLOD::MAX;
+
+		// Squared distance from the closest viewer to the instance data's bounds, used to prioritize deferred physics state creation
+		FVector::FReal DistanceSquared = TNumericLimits<FVector::FReal>::Max();
+
+		// True if NewBulkLOD was capped at Medium as the instance data isn't visible to any viewer within Detailed distance
+		bool bVisibilityCulled = false;
+
+		// If > 0, a lower bulk LOD was held back by IA.BulkLOD.MinDwellTime until this time
+		double DwellEndTime = 0.0;
+
+		// Input: true if any of the instance data's ISMCs were recently rendered. Gathered on the game thread prior to evaluation, as 
+		// component render times aren't safe to read from worker threads. Only set when occlusion culling applies. @see WasRecentlyRendered
+		bool bRecentlyRendered = false;
+	};
+
+	/** Builds a view frustum for ViewerInfo, as per the Mass LOD collector */
+	FConvexVolume BuildViewerFrustum(const FViewerInfo& ViewerInfo)
+	{
+		const FMatrix ViewRotationMatrix = FInverseRotationMatrix(ViewerInfo.Rotation) * FMatrix(
+			FPlane(0, 0, 1, 0),
+			FPlane(1, 0, 0, 0),
+			FPlane(0, 1, 0, 0),
+			FPlane(0, 0, 0, 1));
+		const FMatrix ViewMatrix = FTranslationMatrix(-ViewerInfo.Location) * ViewRotationMatrix;
+		const FMatrix ProjectionMatrix = FReversedZPerspectiveMatrix(FMath::DegreesToRadians(ViewerInfo.FOV * 0.5f), ViewerInfo.AspectRatio, 1.0f, 10.0f);
+
+		FConvexVolume Frustum;
+		GetViewFrustumBounds(Frustum, ViewMatrix * ProjectionMatrix, /*bUseNearPlane*/false);
+		return Frustum;
+	}
+
+	/**
+	 * Coarse occlusion test using the renderer's last on-screen render time for InstanceData's ISMCs, which is only updated for
+	 * primitives that passed frustum & occlusion culling. Returns true if any ISMC was rendered within Tolerance seconds.
+	 * Game thread only.
+	 */
+	bool WasRecentlyRendered(const UArsInstancedActorsData& InstanceData, const float Tolerance)
+	{
+		bool bRecentlyRendered = false;
+		InstanceData.ForEachVisualization([&bRecentlyRendered, Tolerance](uint8 /*VisualizationIndex*/, const FArsInstancedActorsVisualizationInfo& Visualization)
+		{
+			for (const TObjectPtr<UInstancedStaticMeshComponent>& ISMComponent : Visualization.ISMComponents)
+			{
+				if (ISMComponent && ISMComponent->WasRecentlyRendered(Tolerance))
+				{
+					bRecentlyRendered = true;
+					break;
+				}
+			}
+			return !bRecentlyRendered;
+		});
+		return bRecentlyRendered;
+	}
+
+	/**
+	 * Calculates bulk LOD for InstanceData based on the distance from the closest viewer to its owner's bounds and, optionally,
+	 * whether it's visible to viewers within Detailed distance. Distance thresholds have hysteresis applied relative to the current
+	 * bulk LOD and lowering bulk LOD is subject to a minimum dwell time. Results are written to OutEvaluation.
+	 * Only reads instance data & settings so is safe to run concurrently for different instance datas.
+	 * NOTE (1): It's called bulk LOD because we're only comparing the viewer to the InstancedActorManager, and not to a specific instance inside it
+	 * NOTE (2): We're caching the scaled squared draw distance to the lowest LOD because the cvar could change
+	 * NOTE (3): Visibility culling only ever caps at Medium, which keeps ISMCs visible so the renderer can tell us when they're seen again
+	 */
+	void EvaluateBulkLOD(const FBulkLODEvaluationContext& EvaluationContext, const FArsInstancedActorsDataSharedFragment& SharedFragment
+		, const UArsInstancedActorsData& InstanceData, FBulkLODEvaluation& OutEvaluation)
+	{
+		const FArsInstancedActorsSettings& Settings = InstanceData.GetSettings<const FArsInstancedActorsSettings>();
+		const EArsInstancedActorsBulkLOD CurrentBulkLOD = SharedFragment.BulkLOD;
+
+		// Thresholds of tiers we're currently at, or more detailed than, are extended by the hysteresis ratio
+		const FVector::FReal HysteresisScale = 1.0 + FMath::Max(UE::Mass::Tweakables::BulkLODHysteresisRatio, 0.f);
+		auto GetThresholdSquared = [CurrentBulkLOD, HysteresisScale](const FVector::FReal Distance, const EArsInstancedActorsBulkLOD Tier)
+		{
+			return FMath::Square(CurrentBulkLOD <= Tier ? Distance * HysteresisScale : Distance);
+		};
+
+		const FVector::FReal ForcedDetailedLevelDistanceSquared = GetThresholdSquared(
+#if WITH_ARSINSTANCEDACTORS_DEBUG
+			UE::Mass::Tweakables::DebugDetailedLevelDistanceOverride ? FVector::FReal(UE::Mass::Tweakables::DebugDetailedLevelDistanceOverride) :
+#endif
+			Settings.DetailedRepresentationLODDistance
+			, EArsInstancedActorsBulkLOD::Detailed);
+		const FVector::FReal VisibilityCullingMinDistanceSquared = FMath::Square(FVector::FReal(UE::Mass::Tweakables::BulkLODVisibilityCullingMinDistance));
+
+		// Calculates distance sqr from the viewer to the bounds of the InstancedActorManager who owns the FArsInstancedActorsDataSharedFragment
+		const FBox WorldSpaceBounds = InstanceData.Bounds.TransformBy(InstanceData.GetManagerChecked().GetActorTransform());
+		FVector::FReal DistanceSquared = TNumericLimits<FVector::FReal>::Max();
+
+		const bool bFrustumCulling = EvaluationContext.ViewerFrustums.Num() == EvaluationContext.Viewers.Num();
+		const FVector FrustumTestOrigin = WorldSpaceBounds.GetCenter();
+		const FVector FrustumTestExtent = WorldSpaceBounds.GetExtent() + FVector(UE::Mass::Tweakables::BulkLODFrustumCullingMargin);
+		bool bInViewFrustum = !bFrustumCulling;
+
+		for (int32 ViewerIndex = 0; ViewerIndex < EvaluationContext.Viewers.Num(); ++ViewerIndex)
+		{
+			const FViewerInfo& ViewerInfo = EvaluationContext.Viewers[ViewerIndex];
+			const FVector::FReal ViewerDistanceSquared = ComputeSquaredDistanceFromBoxToPoint(WorldSpaceBounds.Min, WorldSpaceBounds.Max, ViewerInfo.Location);
+			DistanceSquared = FMath::Min(DistanceSquared, ViewerDistanceSquared);
+
+			// Only viewers within Detailed distance can keep the instance data at Detailed, so only they need frustum testing
+			if (!bInViewFrustum && ViewerDistanceSquared < ForcedDetailedLevelDistanceSquared)
+			{
+				bInViewFrustum = ViewerDistanceSquared < VisibilityCullingMinDistanceSquared
+					|| EvaluationContext.ViewerFrustums[ViewerIndex].IntersectBox(FrustumTestOrigin, FrustumTestExtent);
+			}
+
+			// Note: All viewers are visited, rather than stopping at the first visible one within Detailed distance, as DistanceSquared 
+			// must be to the closest viewer to correctly prioritize deferred physics state creation
+		}
+
+		OutEvaluation.DistanceSquared = DistanceSquared;
+
+		// Medium bulk LOD extends up to MediumLODDistance if set, or the low LOD draw distance otherwise
+		const float MediumLODDistance = (Settings.bOverride_MediumLODDistance && Settings.MediumLODDistance > 0.0) ? float(Settings.MediumLODDistance) : InstanceData.LowLODDrawDistance;
+		const float ScaledMediumLODDistance = MediumLODDistance / EvaluationContext.StaticMeshLODDistanceScale;
+		EArsInstancedActorsBulkLOD NewBulkLOD = EArsInstancedActorsBulkLOD::Off;
+		if (DistanceSquared < ForcedDetailedLevelDistanceSquared)
+		{
+			NewBulkLOD = EArsInstancedActorsBulkLOD::Detailed;
+		}
+		else if (DistanceSquared < GetThresholdSquared(ScaledMediumLODDistance, EArsInstancedActorsBulkLOD::Medium))
+		{
+			NewBulkLOD = EArsInstancedActorsBulkLOD::Medium;
+		}
+		else if (DistanceSquared < GetThresholdSquared(InstanceData.MaxDrawDistance, EArsInstancedActorsBulkLOD::Low) || (InstanceData.MaxDrawDistance == 0.0f))
+		{
+			NewBulkLOD = EArsInstancedActorsBulkLOD::Low;
+		}
+
+		// Caps Detailed at Medium if the instance data can't be seen by any viewer, unless it's within the minimum culling distance
+		if (NewBulkLOD == EArsInstancedActorsBulkLOD::Detailed && DistanceSquared >= VisibilityCullingMinDistanceSquared)
+		{
+			bool bVisible = bInViewFrustum;
+
+			// Occlusion relies on render feedback from visible ISMCs, which isn't available if we were previously Off (hidden) or unevaluated
+			if (bVisible && EvaluationContext.bOcclusionCulling && CurrentBulkLOD < EArsInstancedActorsBulkLOD::Off)
+			{
+				bVisible = OutEvaluation.bRecentlyRendered;
+			}
+
+			if (!bVisible)
+			{
+				NewBulkLOD = EArsInstancedActorsBulkLOD::Medium;
+				OutEvaluation.bVisibilityCulled = true;
+			}
+		}
+
+		// Holds back lowering bulk LOD until the current one has been held for the minimum dwell time
+		if (NewBulkLOD > CurrentBulkLOD && CurrentBulkLOD < EArsInstancedActorsBulkLOD::MAX)
+		{
+			const double DwellEndTime = SharedFragment.BulkLODChangeTime + UE::Mass::Tweakables::BulkLODMinDwellTime;
+			if (EvaluationContext.CurrentTime < DwellEndTime)
+			{
+				NewBulkLOD = CurrentBulkLOD;
+				OutEvaluation.DwellEndTime = DwellEndTime;
+			}
+		}
+
+		OutEvaluation.NewBulkLOD = NewBulkLOD;
 	}
 }
 
@@ -186,7 +425,7 @@ void UArsInstancedActorsStationaryLODBatchProcessor::Execute(FMassEntityManager&
 	}
 
 	const UMassLODSubsystem& LODSubsystem = Context.GetSubsystemChecked<UMassLODSubsystem>();
-	// note we're copying the array on purpose since we intend to use parallel-for here (eventually)
+	// note we're copying the array on purpose since we use it from parallel-for bulk LOD evaluation below
 	TArray<FViewerInfo> Viewers = LODSubsystem.GetViewers();
 
 	// we don't care about streaming-sources
@@ -223,184 +462,250 @@ void UArsInstancedActorsStationaryLODBatchProcessor::Execute(FMassEntityManager&
 		static const auto ICVarStaticMeshLODDistanceScale = IConsoleManager::Get().FindConsoleVariable(TEXT("r.StaticMeshLODDistanceScale"));
 		const float StaticMeshLODDistanceScale = ICVarStaticMeshLODDistanceScale->GetFloat();
 
-		auto ExecutionFunction = [Viewers = MakeArrayView((const FViewerInfo*)&Viewers[0], Viewers.Num()), &EntityManager, &Context
-			, LODChangingEntityQuery = &LODChangingEntityQuery, StaticMeshLODDistanceScale, CurrentTime
+		// Applies a bulk LOD evaluation's side effects (stats, ISMC physics & visibility, Mass LOD & tags) and returns the next tick time.
+		// Must run serially as it touches components and Mass entity data.
+		auto ApplyFunction = [&EntityManager, &Context, InstancedActorSubsystem, LODChangingEntityQuery = &LODChangingEntityQuery, CurrentTime
 			, DelayPerBulkLOD = MakeArrayView((const double*)&DelayPerBulkLOD[0], (int)EArsInstancedActorsBulkLOD::MAX)]
-			(FArsInstancedActorsDataSharedFragment& ManagerSharedFragment) -> double
+			(FArsInstancedActorsDataSharedFragment& ManagerSharedFragment, const UE::ArsInstancedActors::FBulkLODEvaluation& Evaluation) -> double
 			{
-				double NextTickTime = CurrentTime + DelayPerBulkLOD[(int)EArsInstancedActorsBulkLOD::Off];
-				if (UArsInstancedActorsData* InstanceData = ManagerSharedFragment.InstanceData.Get())
+				const EArsInstancedActorsBulkLOD NewBulkLOD = Evaluation.NewBulkLOD;
+				const FVector::FReal DistanceSquared = Evaluation.DistanceSquared;
+				UArsInstancedActorsData* InstanceData = ManagerSharedFragment.InstanceData.Get();
+				if (InstanceData == nullptr || NewBulkLOD == EArsInstancedActorsBulkLOD::MAX)
 				{
-					const FArsInstancedActorsSettings& Settings = InstanceData->GetSettings<const FArsInstancedActorsSettings>();
-					
-					const FVector::FReal ForcedDetailedLevelDistanceSquared = FMath::Square(
-#if WITH_ARSINSTANCEDACTORS_DEBUG
-						UE::Mass::Tweakables::DebugDetailedLevelDistanceOverride ? FVector::FReal(UE::Mass::Tweakables::DebugDetailedLevelDistanceOverride) :
-#endif
-						Settings.DetailedRepresentationLODDistance
-					);
-
-					// Calculates distance sqr from the viewer to the bounds of the InstancedActorManager who owns the FArsInstancedActorsDataSharedFragment
-					const FBox WorldSpaceBounds = InstanceData->Bounds.TransformBy(InstanceData->GetManagerChecked().GetActorTransform());
-					FVector::FReal DistanceSquared = TNumericLimits<FVector::FReal>::Max();
+					return CurrentTime + DelayPerBulkLOD[(int)EArsInstancedActorsBulkLOD::Off];
+				}
 
-					for (const FViewerInfo& ViewerInfo : Viewers)
-					{
-						DistanceSquared = FMath::Min(DistanceSquared, ComputeSquaredDistanceFromBoxToPoint(WorldSpaceBounds.Min, WorldSpaceBounds.Max, ViewerInfo.Location));
-						if (DistanceSquared < ForcedDetailedLevelDistanceSquared)
-						{
-							// if it's inside the "inner circle" we don't need to continue calculating the distance.
-							break;
-						}
-					}
+				const FArsInstancedActorsSettings& Settings = InstanceData->GetSettings<const FArsInstancedActorsSettings>();
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-					// Only update cull distances when tweaking is enabled for runtime profiling & iteration
-					if (UE::Mass::Tweakables::bUpdateLiveCullDistanceTweaking)
-					{
-						InstanceData->UpdateCullDistance();
-					}
+				// Only update cull distances when tweaking is enabled for runtime profiling & iteration
+				if (UE::Mass::Tweakables::bUpdateLiveCullDistanceTweaking)
+				{
+					InstanceData->UpdateCullDistance();
+				}
 #endif
 
-					// Calculates LOD for a given FArsInstancedActorsDataSharedFragment based on the distance from the viewer to its owner's bounds
-					// NOTE (1): It's called bulk LOD because we're only comparing the viewer to the InstancedActorManager, and not to a specific instance inside it
-					// NOTE (2): We're caching the scaled squared draw distance to the lowest LOD because the cvar could change
-					const float ScaledForceLowLODDrawDistance = InstanceData->LowLODDrawDistance / StaticMeshLODDistanceScale;
-					EArsInstancedActorsBulkLOD NewBulkLOD = EArsInstancedActorsBulkLOD::Off;
-					if (DistanceSquared < ForcedDetailedLevelDistanceSquared)
-					{
-						NewBulkLOD = EArsInstancedActorsBulkLOD::Detailed;
-					}
-					else if (DistanceSquared < FMath::Square(ScaledForceLowLODDrawDistance))
-					{
-						NewBulkLOD = EArsInstancedActorsBulkLOD::Medium;
-					}
-					else if (DistanceSquared < FMath::Square(InstanceData->MaxDrawDistance) || (InstanceData->MaxDrawDistance == 0.0f))
-					{
-						NewBulkLOD = EArsInstancedActorsBulkLOD::Low;
-					}
+				// Updates the time at which the FArsInstancedActorsDataSharedFragment will tick depending on its bulk LOD value
+				const double BulkLODDelay = (NewBulkLOD == EArsInstancedActorsBulkLOD::Medium && Settings.bOverride_MediumLODTickInterval)
+					? double(Settings.MediumLODTickInterval) : DelayPerBulkLOD[(int)NewBulkLOD];
+				double NextTickTime = CurrentTime + (BulkLODDelay * 0.95 + FMath::FRand() * 0.1);
 
-					check(NewBulkLOD != EArsInstancedActorsBulkLOD::MAX);
-					// Updates the time at which the FArsInstancedActorsDataSharedFragment will tick depending on its bulk LOD value
-					NextTickTime = CurrentTime + (DelayPerBulkLOD[(int)NewBulkLOD] * 0.95 + FMath::FRand() * 0.1);
+				// Re-evaluate visibility culled instance datas sooner so they're promoted promptly once seen, and held back ones once allowed to change
+				if (Evaluation.bVisibilityCulled)
+				{
+					NextTickTime = FMath::Min(NextTickTime, CurrentTime + UE::Mass::Tweakables::BulkLODVisibilityCulledTickInterval);
+				}
+				if (Evaluation.DwellEndTime > 0.0)
+				{
+					NextTickTime = FMath::Min(NextTickTime, Evaluation.DwellEndTime);
+				}
 
-					if (const bool bHasBulkLODChanged = (ManagerSharedFragment.BulkLOD != NewBulkLOD))
+				if (const bool bHasBulkLODChanged = (ManagerSharedFragment.BulkLOD != NewBulkLOD))
+				{
+					// Decrements stats with current state, and then increments stats with the new one
 					{
-						// Decrements stats with current state, and then increments stats with the new one
+						AArsInstancedActorsManager::UpdateInstanceStats(InstanceData->NumInstances, ManagerSharedFragment.BulkLOD, false);
+						ManagerSharedFragment.BulkLOD = NewBulkLOD;
+						ManagerSharedFragment.BulkLODChangeTime = CurrentTime;
+						AArsInstancedActorsManager::UpdateInstanceStats(InstanceData->NumInstances, ManagerSharedFragment.BulkLOD, true);
+					}
+					// Toggles physics state for the IA's ISM depending on the new bulk LOD value.
+					// If enabled = physics on (time-sliced by the subsystem), else = physics off.
+					if (UE::Mass::Tweakables::bControlPhysicsState && Settings.bControlPhysicsState)
+					{
+						if (NewBulkLOD == EArsInstancedActorsBulkLOD::Detailed)
 						{
-							AArsInstancedActorsManager::UpdateInstanceStats(InstanceData->NumInstances, ManagerSharedFragment.BulkLOD, false);
-							ManagerSharedFragment.BulkLOD = NewBulkLOD;
-							AArsInstancedActorsManager::UpdateInstanceStats(InstanceData->NumInstances, ManagerSharedFragment.BulkLOD, true);
+							InstanceData->ForEachVisualization([InstancedActorSubsystem, DistanceSquared](uint8 /*VisualizationIndex*/, const FArsInstancedActorsVisualizationInfo& Visualization)
+							{
+								UE::ArsInstancedActors::EnablePhysicForVisualization(*InstancedActorSubsystem, Visualization, DistanceSquared);
+								return true;
+							});
 						}
-						// Toggles physics state for the IA's ISM depending on the new bulk LOD value.
-						// If enabled = physics on, else = physics off.				
-						if (UE::Mass::Tweakables::bControlPhysicsState && Settings.bControlPhysicsState)
+						else
 						{
-							if (NewBulkLOD == EArsInstancedActorsBulkLOD::Detailed)
-							{
-								InstanceData->ForEachVisualization(&UE::ArsInstancedActors::EnablePhysicForVisualization);
-							}
-							else
+							InstanceData->ForEachVisualization([InstancedActorSubsystem](uint8 /*VisualizationIndex*/, const FArsInstancedActorsVisualizationInfo& Visualization)
 							{
-								InstanceData->ForEachVisualization(UE::ArsInstancedActors::DisablePhysicForVisualization);
-							}
+								UE::ArsInstancedActors::DisablePhysicForVisualization(*InstancedActorSubsystem, Visualization);
+								return true;
+							});
 						}
+					}
+					// Headless server ISMCs are collision-only and never rendered, @see AArsInstancedActorsManager::CreateISMComponents
+					if (!InstanceData->GetManagerChecked().IsHeadlessServer())
+					{
+						// Toggles visibility for the IA's ISM depending on the new bulk LOD value.
+						// If enabled = use default visibility (probably on), else = physics off.
+						if (NewBulkLOD != EArsInstancedActorsBulkLOD::Off)
 						{
-							// Toggles visibility for the IA's ISM depending on the new bulk LOD value.
-							// If enabled = use default visibility (probably on), else = physics off.
-							if (NewBulkLOD != EArsInstancedActorsBulkLOD::Off)
+							// Low forces the lowest mesh LOD. Medium applies its own cheaper mesh LOD, shadow & WPO settings, whilst
+							// Detailed restores defaults.
+							const bool bMediumLOD = NewBulkLOD == EArsInstancedActorsBulkLOD::Medium;
+							int32 ForcedLodModel = 0; // 0 means forced LOD disabled, 8 means lowest because it's clamped
+							if (NewBulkLOD == EArsInstancedActorsBulkLOD::Low)
 							{
-								const bool bForcedLowLOD = NewBulkLOD == EArsInstancedActorsBulkLOD::Low;
-								InstanceData->ForEachVisualization([&bForcedLowLOD](uint8 VisualizationIndex, const FArsInstancedActorsVisualizationInfo& Visualization)
-								{
-									for (int32 ISMComponentIndex = 0; ISMComponentIndex < Visualization.ISMComponents.Num(); ++ISMComponentIndex)
-									{
-										check(Visualization.VisualizationDesc.ISMComponentDescriptors.IsValidIndex(ISMComponentIndex));
-										const FISMComponentDescriptor& ISMComponentDescriptor = Visualization.VisualizationDesc.ISMComponentDescriptors[ISMComponentIndex];
-										const TObjectPtr<UInstancedStaticMeshComponent>& ISMComponent = Visualization.ISMComponents[ISMComponentIndex];
-
-										ISMComponent->SetVisibility(ISMComponentDescriptor.bVisible); // Restore default visibility state
-										ISMComponent->SetForcedLodModel(bForcedLowLOD ? 8 : 0); // 0 means forced LOD disabled, 8 means lowest because it's clamped		
-									}
-									return true;
-								});
+								ForcedLodModel = 8;
 							}
-							else
+							else if (bMediumLOD && Settings.bOverride_MediumLODForcedLodModel)
 							{
-								InstanceData->ForEachVisualization([](uint8 VisualizationIndex, const FArsInstancedActorsVisualizationInfo& Visualization)
-								{
-									for (const TObjectPtr<UInstancedStaticMeshComponent>& ISMComponent : Visualization.ISMComponents)
-									{
-										ISMComponent->SetVisibility(false);
-									}
-									return true;
-								});
+								ForcedLodModel = FMath::Clamp(Settings.MediumLODForcedLodModel, 0, 8);
 							}
-						}
-						// Toggles MassProcessors on/off depending on the bulk LOD, by pushing or removing tags that are used by those processor's queries.
-						// NOTE: Forcibly updates the mass LOD to off or low when bulk LOD is smaller than Detailed
-						if (ManagerSharedFragment.BulkLOD == EArsInstancedActorsBulkLOD::Detailed && InstanceData->CanHydrate())
-						{
-							EntityManager.Defer().PushCommand<UE::ArsInstancedActors::FEnableDetailedLODCommand>(InstanceData->Entities);
+							const bool bAllowCastShadows = !bMediumLOD || !Settings.bOverride_bMediumLODCastShadows || Settings.bMediumLODCastShadows;
+							const bool bAllowWorldPositionOffset = !bMediumLOD || !Settings.bOverride_bMediumLODEvaluateWorldPositionOffset || Settings.bMediumLODEvaluateWorldPositionOffset;
+
+							InstanceData->ForEachVisualization([&Settings, ForcedLodModel, bAllowCastShadows, bAllowWorldPositionOffset](uint8 VisualizationIndex, const FArsInstancedActorsVisualizationInfo& Visualization)
+							{
+								for (int32 ISMComponentIndex = 0; ISMComponentIndex < Visualization.ISMComponents.Num(); ++ISMComponentIndex)
+								{
+									check(Visualization.VisualizationDesc.ISMComponentDescriptors.IsValidIndex(ISMComponentIndex));
+									const FISMComponentDescriptor& ISMComponentDescriptor = Visualization.VisualizationDesc.ISMComponentDescriptors[ISMComponentIndex];
+									const TObjectPtr<UInstancedStaticMeshComponent>& ISMComponent = Visualization.ISMComponents[ISMComponentIndex];
+
+									ISMComponent->SetVisibility(ISMComponentDescriptor.bVisible); // Restore default visibility state
+									ISMComponent->SetForcedLodModel(ForcedLodModel);
+
+									// Defaults as per AArsInstancedActorsManager::CreateISMComponents
+									const bool bDefaultCastShadow = Settings.bOverride_bInstancesCastShadows ? Settings.bInstancesCastShadows : bool(ISMComponentDescriptor.bCastShadow);
+									ISMComponent->SetCastShadow(bDefaultCastShadow && bAllowCastShadows);
+									ISMComponent->SetEvaluateWorldPositionOffset(ISMComponentDescriptor.bEvaluateWorldPositionOffset && bAllowWorldPositionOffset);
+								}
+								return true;
+							});
 						}
 						else
 						{
-							// Force given LOD for all the hosted entities 
-							EMassLOD::Type NewLOD = EMassLOD::Off;
-							switch (ManagerSharedFragment.BulkLOD)
+							InstanceData->ForEachVisualization([](uint8 VisualizationIndex, const FArsInstancedActorsVisualizationInfo& Visualization)
 							{
-							case EArsInstancedActorsBulkLOD::Detailed:
-								ensureMsgf(InstanceData->CanHydrate() == false, TEXT("This case is only valid for non-hydrating instance, broken for %s"), *GetNameSafe(InstanceData->ActorClass));
-								NewLOD = EMassLOD::Low;
-								break;
-							case EArsInstancedActorsBulkLOD::Medium: // right now falling through since we don't have a medium-level visualization
-							case EArsInstancedActorsBulkLOD::Low:
-								NewLOD = EMassLOD::Low;
-								break;
-							default:
-								NewLOD = EMassLOD::Off;
-								break;
-							}
+								for (const TObjectPtr<UInstancedStaticMeshComponent>& ISMComponent : Visualization.ISMComponents)
+								{
+									ISMComponent->SetVisibility(false);
+								}
+								return true;
+							});
+						}
+					}
+					// Toggles MassProcessors on/off depending on the bulk LOD, by pushing or removing tags that are used by those processor's queries.
+					// NOTE: Forcibly updates the mass LOD to off or low when bulk LOD is smaller than Detailed
+					if (ManagerSharedFragment.BulkLOD == EArsInstancedActorsBulkLOD::Detailed && InstanceData->CanHydrate())
+					{
+						EntityManager.Defer().PushCommand<UE::ArsInstancedActors::FEnableDetailedLODCommand>(InstanceData->Entities);
+					}
+					else
+					{
+						// Force given LOD for all the hosted entities 
+						EMassLOD::Type NewLOD = EMassLOD::Off;
+						switch (ManagerSharedFragment.BulkLOD)
+						{
+						case EArsInstancedActorsBulkLOD::Detailed:
+							ensureMsgf(InstanceData->CanHydrate() == false, TEXT("This case is only valid for non-hydrating instance, broken for %s"), *GetNameSafe(InstanceData->ActorClass));
+							NewLOD = EMassLOD::Low;
+							break;
+						// Medium & Low both use the ISMC representation, without per-entity representation processing. Medium differs
+						// in the ISMC settings applied above.
+						case EArsInstancedActorsBulkLOD::Medium:
+						case EArsInstancedActorsBulkLOD::Low:
+							NewLOD = EMassLOD::Low;
+							break;
+						default:
+							NewLOD = EMassLOD::Off;
+							break;
+						}
 
-							// Grabs entity collections from the entities stored by the fragment we're processing, so that we can process them as chunks
-							TArray<FMassArchetypeEntityCollection> EntityCollections;
-							UE::Mass::Utils::CreateEntityCollections(EntityManager, InstanceData->Entities, FMassArchetypeEntityCollection::NoDuplicates, EntityCollections);
+						// Grabs entity collections from the entities stored by the fragment we're processing, so that we can process them as chunks
+						TArray<FMassArchetypeEntityCollection> EntityCollections;
+						UE::Mass::Utils::CreateEntityCollections(EntityManager, InstanceData->Entities, FMassArchetypeEntityCollection::NoDuplicates, EntityCollections);
 
-							LODChangingEntityQuery->ForEachEntityChunkInCollections(EntityCollections, Context, [NewLOD](FMassExecutionContext& Context)
+						LODChangingEntityQuery->ForEachEntityChunkInCollections(EntityCollections, Context, [NewLOD](FMassExecutionContext& Context)
+							{
+								const TArrayView<FMassRepresentationLODFragment> RepresentationLODFragments = Context.GetMutableFragmentView<FMassRepresentationLODFragment>();
+								for (FMassRepresentationLODFragment& LODFragment : RepresentationLODFragments)
 								{
-									const TArrayView<FMassRepresentationLODFragment> RepresentationLODFragments = Context.GetMutableFragmentView<FMassRepresentationLODFragment>();
-									for (FMassRepresentationLODFragment& LODFragment : RepresentationLODFragments)
-									{
-										LODFragment.LOD = NewLOD;
-									}
-
-									FMassRepresentationUpdateParams Params;
-									Params.bTestCollisionAvailibilityForActorVisualization = false;
-									UMassRepresentationProcessor::UpdateRepresentation(Context, Params);
-									UMassStationaryISMSwitcherProcessor::ProcessContext(Context);
-								});
-
-							// Removes a bunch of tags from all mass entities that belong to an ArsInstancedActorsData, so that we don't spend MassProcessor time on them
-							EntityManager.Defer().PushCommand<UE::ArsInstancedActors::FEnableBatchLODCommand>(InstanceData->Entities);
-						}
+									LODFragment.LOD = NewLOD;
+								}
+
+								FMassRepresentationUpdateParams Params;
+								Params.bTestCollisionAvailibilityForActorVisualization = false;
+								UMassRepresentationProcessor::UpdateRepresentation(Context, Params);
+								UMassStationaryISMSwitcherProcessor::ProcessContext(Context);
+							});
+
+						// Removes a bunch of tags from all mass entities that belong to an ArsInstancedActorsData, so that we don't spend MassProcessor time on them
+						EntityManager.Defer().PushCommand<UE::ArsInstancedActors::FEnableBatchLODCommand>(InstanceData->Entities);
 					}
 				}
 
 				return NextTickTime;
 			};
 
-		TArray<UArsInstancedActorsSubsystem::FNextTickSharedFragment>& SortedSharedFragments = InstancedActorSubsystem->GetTickableSharedFragments();
+		UE::ArsInstancedActors::FSharedFragmentTickQueue& SortedSharedFragments = InstancedActorSubsystem->GetTickableSharedFragments();
 		if (SortedSharedFragments.Num() > 0)
 		{
-			while (SortedSharedFragments.HeapTop().NextTickTime < CurrentTime)
+			// There's no render feedback on dedicated servers
+			const bool bOcclusionCulling = UE::Mass::Tweakables::bBulkLODOcclusionCulling && !IsRunningDedicatedServer();
+
+			// Gather all shared fragments due to tick this frame, along with their ISMCs' render times which must be read on the game thread
+			TArray<UE::ArsInstancedActors::FBulkLODEvaluation> Evaluations;
+			while (SortedSharedFragments.Num() > 0 && SortedSharedFragments.Top().NextTickTime < CurrentTime)
 			{
-				UArsInstancedActorsSubsystem::FNextTickSharedFragment WrappedSharedFragment;
-				SortedSharedFragments.HeapPop(WrappedSharedFragment, EAllowShrinking::No);
-				FArsInstancedActorsDataSharedFragment& ManagerSharedFragment = WrappedSharedFragment.SharedStruct.Get<FArsInstancedActorsDataSharedFragment>();
-				
+				UE::ArsInstancedActors::FBulkLODEvaluation& Evaluation = Evaluations.AddDefaulted_GetRef();
+				SortedSharedFragments.Pop(Evaluation.WrappedSharedFragment);
+
+				const FArsInstancedActorsDataSharedFragment& ManagerSharedFragment = Evaluation.WrappedSharedFragment.SharedStruct.Get<FArsInstancedActorsDataSharedFragment>();
+				const UArsInstancedActorsData* InstanceData = ManagerSharedFragment.InstanceData.Get();
+				if (bOcclusionCulling && InstanceData && ManagerSharedFragment.BulkLOD < EArsInstancedActorsBulkLOD::Off)
+				{
+					Evaluation.bRecentlyRendered = UE::ArsInstancedActors::WasRecentlyRendered(*InstanceData, UE::Mass::Tweakables::BulkLODOcclusionRenderTimeTolerance);
+				}
+			}
+
+			// Evaluate viewer distances and new bulk LODs. This only reads instance data, so can be spread across worker threads.
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsStationaryLODBatchProcessor EvaluateBulkLOD);
+
+				// View frustums are built once per execution rather than per instance data
+				TArray<FConvexVolume> ViewerFrustums;
+				if (UE::Mass::Tweakables::bBulkLODFrustumCulling)
+				{
+					ViewerFrustums.Reserve(Viewers.Num());
+					for (const FViewerInfo& ViewerInfo : Viewers)
+					{
+						ViewerFrustums.Add(UE::ArsInstancedActors::BuildViewerFrustum(ViewerInfo));
+					}
+				}
+
+				UE::ArsInstancedActors::FBulkLODEvaluationContext EvaluationContext;
+				EvaluationContext.Viewers = Viewers;
+				EvaluationContext.ViewerFrustums = ViewerFrustums;
+				EvaluationContext.StaticMeshLODDistanceScale = StaticMeshLODDistanceScale;
+				EvaluationContext.CurrentTime = CurrentTime;
+				EvaluationContext.bOcclusionCulling = bOcclusionCulling;
+
+				const EParallelForFlags ParallelForFlags = UE::Mass::Tweakables::bParallelBulkLODEvaluation ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+				ParallelFor(TEXT("IA.EvaluateBulkLOD"), Evaluations.Num(), FMath::Max(UE::Mass::Tweakables::ParallelBulkLODEvaluationMinBatchSize, 1)
+					, [&Evaluations, &EvaluationContext](int32 EvaluationIndex)
+					{
+						UE::ArsInstancedActors::FBulkLODEvaluation& Evaluation = Evaluations[EvaluationIndex];
+						const FArsInstancedActorsDataSharedFragment& ManagerSharedFragment = Evaluation.WrappedSharedFragment.SharedStruct.Get<FArsInstancedActorsDataSharedFragment>();
+						if (const UArsInstancedActorsData* InstanceData = ManagerSharedFragment.InstanceData.Get())
+						{
+							UE::ArsInstancedActors::EvaluateBulkLOD(EvaluationContext, ManagerSharedFragment, *InstanceData, Evaluation);
+						}
+					}, ParallelForFlags);
+			}
+
+			// Apply bulk LOD changes and reschedule
+			for (UE::ArsInstancedActors::FBulkLODEvaluation& Evaluation : Evaluations)
+			{
+				FArsInstancedActorsDataSharedFragment& ManagerSharedFragment = Evaluation.WrappedSharedFragment.SharedStruct.Get<FArsInstancedActorsDataSharedFragment>();
+
 				ManagerSharedFragment.LastTickTime = CurrentTime;
-				WrappedSharedFragment.NextTickTime = ExecutionFunction(ManagerSharedFragment);
-				SortedSharedFragments.HeapPush(MoveTemp(WrappedSharedFragment));
+				Evaluation.WrappedSharedFragment.NextTickTime = ApplyFunction(ManagerSharedFragment, Evaluation);
+
+				// Shared fragments of deinitialized instance datas are left unqueued until UArsInstancedActorsSubsystem::RegisterSharedFragment
+				if (ManagerSharedFragment.InstanceData.IsValid())
+				{
+					SortedSharedFragments.Push(MoveTemp(Evaluation.WrappedSharedFragment));
+				}
 			}
 		}
 
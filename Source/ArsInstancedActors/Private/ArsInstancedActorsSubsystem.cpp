@@ -2,21 +2,28 @@
 
 #include "ArsInstancedActorsSubsystem.h"
 #include "ArsInstancedActorsManager.h"
+#include "ArsInstancedActorsComponent.h"
 #include "ArsInstancedActorsModifierVolume.h"
 #include "ArsInstancedActorsModifierVolumeComponent.h"
 #include "ArsInstancedActorsDebug.h"
 #include "ArsInstancedActorsData.h"
+#include "ArsInstancedActorsISMComponent.h"
 #include "ArsInstancedActorsSettingsTypes.h"
 #include "ArsInstancedActorsSettings.h"
 #include "ActorPartition/ActorPartitionSubsystem.h"
 #include "Algo/Find.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "DataRegistry.h"
 #include "DataRegistrySubsystem.h"
+#include "Engine/AssetManager.h"
 #include "Engine/Engine.h"
 #include "Engine/Level.h"
+#include "Engine/NetConnection.h"
+#include "Engine/StaticMesh.h"
 #include "EngineUtils.h"
 #include "MassEntityTypes.h"
 #include "MassEntitySubsystem.h"
+#include "MassLODSubsystem.h"
 #include "Misc/ArchiveMD5.h"
 #include "Misc/ReverseIterate.h"
 #include "VisualLogger/VisualLogger.h"
@@ -38,6 +45,70 @@ namespace ArsInstancedActorsCVars
 		TEXT("After this time, remaining requests will be left for subsequent frames. INFINITY = Unbounded deferred spawning."),
 		ECVF_Default);
 
+	bool bDeferSpawnEntitiesAsyncPreparation = true;
+	FAutoConsoleVariableRef CVarDeferSpawnEntitiesAsyncPreparation(
+		TEXT("IA.DeferSpawnEntities.AsyncPreparation"),
+		bDeferSpawnEntitiesAsyncPreparation,
+		TEXT("When IA.DeferSpawnEntities is enabled, deferred managers prepare entity spawn data (transform filtering, world space transforms, ")
+		TEXT("persisted instance removal) in tasks, only committing entity creation on the game thread once preparation completes."),
+		ECVF_Default);
+
+	float DeferSpawnEntitiesReprioritizeDistance = 1000.0f;
+	FAutoConsoleVariableRef CVarDeferSpawnEntitiesReprioritizeDistance(
+		TEXT("IA.DeferSpawnEntities.ReprioritizeDistance"),
+		DeferSpawnEntitiesReprioritizeDistance,
+		TEXT("Deferred entity spawning is prioritized by distance from viewers to managers. Once any viewer has moved further than this distance ")
+		TEXT("since pending requests were last prioritized, they are re-prioritized. <= 0 = Re-prioritize every tick."),
+		ECVF_Default);
+
+	bool bDeferPhysicsStateCreation = true;
+	FAutoConsoleVariableRef CVarDeferPhysicsStateCreation(
+		TEXT("IA.PhysicsStateCreation.Deferred"),
+		bDeferPhysicsStateCreation,
+		TEXT("When enabled with IA.LODDrivenPhysicsState, ISMC physics state creation on switching to Detailed bulk LOD is time-sliced across ")
+		TEXT("frames in UArsInstancedActorsSubsystem::Tick, closest to viewers first. When disabled, physics state is created immediately."),
+		ECVF_Default);
+
+	float MaxPhysicsStateCreationTimePerTick = 0.001f;
+	FAutoConsoleVariableRef CVarMaxPhysicsStateCreationTimePerTick(
+		TEXT("IA.PhysicsStateCreation.MaxTimePerTick"),
+		MaxPhysicsStateCreationTimePerTick,
+		TEXT("When IA.PhysicsStateCreation.Deferred is enabled, the max time in seconds to spend per frame creating ISMC physics state.")
+		TEXT("After this time, remaining requests will be left for subsequent frames. INFINITY = Unbounded."),
+		ECVF_Default);
+
+	int32 MaxPhysicsStateCreationBodiesPerTick = 2048;
+	FAutoConsoleVariableRef CVarMaxPhysicsStateCreationBodiesPerTick(
+		TEXT("IA.PhysicsStateCreation.MaxBodiesPerTick"),
+		MaxPhysicsStateCreationBodiesPerTick,
+		TEXT("When IA.PhysicsStateCreation.Deferred is enabled, the max number of instance bodies to create per frame. At least one ISMC ")
+		TEXT("is always processed per frame regardless of it's instance count."),
+		ECVF_Default);
+
+	float PhysicsStateCreationImmediateDistance = 0.0f;
+	FAutoConsoleVariableRef CVarPhysicsStateCreationImmediateDistance(
+		TEXT("IA.PhysicsStateCreation.ImmediateDistance"),
+		PhysicsStateCreationImmediateDistance,
+		TEXT("When IA.PhysicsStateCreation.Deferred is enabled, ISMC physics state is still created immediately for instance datas with a viewer ")
+		TEXT("within this distance of their bounds, so viewers are never amongst instances without bodies. 0 = Viewers inside instance bounds only."),
+		ECVF_Default);
+
+	int32 MaxConcurrentVisualizationLoads = 8;
+	FAutoConsoleVariableRef CVarMaxConcurrentVisualizationLoads(
+		TEXT("IA.VisualizationLoads.MaxConcurrent"),
+		MaxConcurrentVisualizationLoads,
+		TEXT("The max number of distinct visualization descriptors async loading at once for UArsInstancedActorsData::AddVisualizationAsync.")
+		TEXT("Further requests are queued and started as loads complete, closest to viewers first. <= 0 = Unbounded."),
+		ECVF_Default);
+
+	float DeltaRelevancyFlushInterval = 0.5f;
+	FAutoConsoleVariableRef CVarDeltaRelevancyFlushInterval(
+		TEXT("IA.DeltaRelevancy.FlushInterval"),
+		DeltaRelevancyFlushInterval,
+		TEXT("When IA.DeltaRelevancy.Distance is enabled, the interval in seconds at which connections' deferred instance deltas are ")
+		TEXT("checked against their view target, re-replicating only managers whose deferred deltas a connection has since approached."),
+		ECVF_Default);
+
 	float ManagerHashGridSize = 500.0f;
 	FAutoConsoleVariableRef CVarManagerHashGridSize(
 		TEXT("IA.ManagerHashGridSize"),
@@ -75,6 +146,22 @@ namespace ArsInstancedActorsCVars
 		TEXT("3 = Ensure (log stack trace and break debugger), log a message log error, skip instancing ActorClass."),
 		ECVF_Default);
 
+	float ExemplarActorCacheMemoryBudgetMB = 0.0f;
+	FAutoConsoleVariableRef CVarExemplarActorCacheMemoryBudgetMB(
+		TEXT("IA.ExemplarActorCache.MemoryBudgetMB"),
+		ExemplarActorCacheMemoryBudgetMB,
+		TEXT("Memory budget in MB (estimated via GetResourceSizeBytes) for released exemplar actors retained for reuse, avoiding respawning them ")
+		TEXT("as instance datas of the same class stream back in. Least recently released exemplars are destroyed first once over budget. ")
+		TEXT("0 = Disabled, exemplar actors are destroyed as soon as they're released."),
+		ECVF_Default);
+
+	int32 ExemplarActorCacheMaxActors = 64;
+	FAutoConsoleVariableRef CVarExemplarActorCacheMaxActors(
+		TEXT("IA.ExemplarActorCache.MaxActors"),
+		ExemplarActorCacheMaxActors,
+		TEXT("When IA.ExemplarActorCache.MemoryBudgetMB is enabled, the max number of released exemplar actors to retain regardless of their size."),
+		ECVF_Default);
+
 #if WITH_EDITOR
 	static TAutoConsoleVariable<int32> CVarRefreshSettings(
 		TEXT("IA.RefreshSettings"),
@@ -85,6 +172,32 @@ namespace ArsInstancedActorsCVars
 #endif
 }
 
+namespace UE::ArsInstancedActors::Helpers
+{
+	/** 
+	 * Creates ISMComponent's instance bodies, allowing the physics scene to defer and batch their insertion. Completes any
+	 * instance bodies still pending for a partially created UArsInstancedActorsISMComponent.
+	 * @return true if physics state or any pending instance bodies were created
+	 */
+	bool CreatePhysicsState(UInstancedStaticMeshComponent& ISMComponent)
+	{
+		if (!ISMComponent.IsRegistered())
+		{
+			UE_LOG(LogArsInstancedActors, Error, TEXT("Failed to call CreatePhysicsState() on component '%s', because component is not registered."), *ISMComponent.GetFullName());
+			return false;
+		}
+
+		if (ISMComponent.IsPhysicsStateCreated())
+		{
+			UArsInstancedActorsISMComponent* IAISMComponent = Cast<UArsInstancedActorsISMComponent>(&ISMComponent);
+			return IAISMComponent && IAISMComponent->CreatePendingInstanceBodies() > 0;
+		}
+
+		ISMComponent.CreatePhysicsState(/*bAllowDeferral=*/true);
+		return true;
+	}
+} // UE::ArsInstancedActors::Helpers
+
 //-----------------------------------------------------------------------------
 // UArsInstancedActorsSubsystem
 //-----------------------------------------------------------------------------
@@ -151,6 +264,9 @@ void UArsInstancedActorsSubsystem::Initialize(FSubsystemCollectionBase& Collecti
 	ProjectSettings = GetDefault<UArsInstancedActorsProjectSettings>();
 	check(IsValid(ProjectSettings));
 
+	// Placeholders are shown in place of still loading visualizations, so must be immediately available themselves
+	VisualizationLoadPlaceholderMesh = ProjectSettings->VisualizationLoadPlaceholderMesh.LoadSynchronous();
+
 	ManagersHashGrid = FManagersHashGridType(ArsInstancedActorsCVars::ManagerHashGridSize);
 	ModifierVolumesHashGrid = FModifierVolumesHashGridType(ArsInstancedActorsCVars::ModifierVolumeHashGridSize);
 
@@ -218,6 +334,23 @@ void UArsInstancedActorsSubsystem::Deinitialize()
 
 	EntityManager.Reset();
 	ExemplarActors.Reset();
+	RetainedExemplarActors.Reset();
+	RetainedExemplarActorsResourceSize = 0;
+	ClassDefaultVisualizations.Reset();
+	PendingPhysicsStateCreations.Reset();
+	SortedSharedFragments.Reset();
+
+	for (TPair<FArsInstancedActorsSoftVisualizationDesc, FVisualizationLoadRequest>& VisualizationLoadRequest : VisualizationLoadRequests)
+	{
+		if (VisualizationLoadRequest.Value.LoadHandle.IsValid())
+		{
+			VisualizationLoadRequest.Value.LoadHandle->CancelHandle();
+		}
+	}
+	VisualizationLoadRequests.Reset();
+	NumActiveVisualizationLoads = 0;
+	VisualizationLoadPlaceholderMesh = nullptr;
+	NumRegisteredSharedFragments = 0;
 
 	if (IsValid(ExemplarActorWorld))
 	{
@@ -229,6 +362,36 @@ void UArsInstancedActorsSubsystem::Tick(float DeltaTime)
 {
 	// Spawn entities for pending managers added in RequestDeferredSpawnEntities
 	ExecutePendingDeferredSpawnEntitiesRequests(/*StopAfterSeconds*/ArsInstancedActorsCVars::MaxDeferSpawnEntitiesTimePerTick);
+
+	// Re-replicate managers with instance deltas deferred by per-connection relevancy
+	FlushDeferredInstanceDeltas();
+
+	// Create ISMC physics state requested by bulk LOD changes
+	if (!PendingPhysicsStateCreations.IsEmpty())
+	{
+		ExecutePendingPhysicsStateCreations(/*StopAfterSeconds*/ArsInstancedActorsCVars::MaxPhysicsStateCreationTimePerTick
+			, /*MaxBodies*/FMath::Max(ArsInstancedActorsCVars::MaxPhysicsStateCreationBodiesPerTick, 1));
+	}
+
+	// Start visualization loads queued by RequestVisualizationLoad beyond IA.VisualizationLoads.MaxConcurrent
+	if (NumActiveVisualizationLoads < VisualizationLoadRequests.Num())
+	{
+		StartPendingVisualizationLoads();
+	}
+
+	// Release visualizations pooled by UArsInstancedActorsData::RemoveVisualization once expired
+	if (!InstanceDatasWithPooledVisualizations.IsEmpty())
+	{
+		const double CurrentTime = GetWorldRef().GetTimeSeconds();
+		for (int32 Index = InstanceDatasWithPooledVisualizations.Num() - 1; Index >= 0; --Index)
+		{
+			UArsInstancedActorsData* InstanceData = InstanceDatasWithPooledVisualizations[Index].Get();
+			if (InstanceData == nullptr || !InstanceData->ReleaseExpiredPooledVisualizations(CurrentTime))
+			{
+				InstanceDatasWithPooledVisualizations.RemoveAtSwap(Index, EAllowShrinking::No);
+			}
+		}
+	}
 }
 
 TStatId UArsInstancedActorsSubsystem::GetStatId() const
@@ -236,6 +399,193 @@ TStatId UArsInstancedActorsSubsystem::GetStatId() const
 	RETURN_QUICK_DECLARE_CYCLE_STAT(UArsInstancedActorsSubsystem, STATGROUP_Tickables);
 }
 
+void UArsInstancedActorsSubsystem::RequestPooledVisualizationsRelease(UArsInstancedActorsData& InstanceData)
+{
+	InstanceDatasWithPooledVisualizations.AddUnique(&InstanceData);
+}
+
+void UArsInstancedActorsSubsystem::RequestVisualizationLoad(UArsInstancedActorsData& InstanceData, const uint8 VisualizationIndex, const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc)
+{
+	FVisualizationLoadRequest* Request = VisualizationLoadRequests.Find(SoftVisualizationDesc);
+	if (Request == nullptr)
+	{
+		Request = &VisualizationLoadRequests.Add(SoftVisualizationDesc);
+		SoftVisualizationDesc.GetAssetsToLoad(Request->AssetsToLoad);
+		Request->RequestOrder = NextVisualizationLoadRequestOrder++;
+	}
+
+	Request->Requesters.Add({ &InstanceData, VisualizationIndex });
+
+	// Start straight away while under the concurrency limit, rather than waiting for Tick which doesn't run in paused or editor worlds.
+	// Note: Loads of already resident assets may complete, calling InstanceData.OnVisualizationAssetsLoaded, immediately.
+	if (!Request->LoadHandle.IsValid() && NumActiveVisualizationLoads < GetMaxConcurrentVisualizationLoads())
+	{
+		StartVisualizationLoad(SoftVisualizationDesc);
+	}
+}
+
+void UArsInstancedActorsSubsystem::CancelVisualizationLoad(const UArsInstancedActorsData& InstanceData, const uint8 VisualizationIndex)
+{
+	for (auto It = VisualizationLoadRequests.CreateIterator(); It; ++It)
+	{
+		FVisualizationLoadRequest& Request = It.Value();
+		const int32 NumRemoved = Request.Requesters.RemoveAllSwap([&InstanceData, VisualizationIndex](const FVisualizationLoadRequester& Requester)
+			{
+				return Requester.InstanceData.Get() == &InstanceData && Requester.VisualizationIndex == VisualizationIndex;
+			});
+		if (NumRemoved == 0)
+		{
+			continue;
+		}
+
+		// Cancel streaming once nothing is waiting on it
+		if (Request.Requesters.IsEmpty())
+		{
+			if (Request.LoadHandle.IsValid())
+			{
+				Request.LoadHandle->CancelHandle();
+				--NumActiveVisualizationLoads;
+			}
+			It.RemoveCurrent();
+		}
+		return;
+	}
+}
+
+void UArsInstancedActorsSubsystem::StartPendingVisualizationLoads()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem::StartPendingVisualizationLoads);
+
+	const int32 MaxConcurrentLoads = GetMaxConcurrentVisualizationLoads();
+	if (NumActiveVisualizationLoads >= MaxConcurrentLoads || bStartingVisualizationLoads)
+	{
+		return;
+	}
+
+	// Loads completing immediately below would otherwise start further loads re-entrantly, from OnVisualizationLoadCompleted
+	TGuardValue<bool> StartingVisualizationLoadsGuard(bStartingVisualizationLoads, true);
+
+	TArray<FVector> ViewerLocations;
+	GatherDeferredSpawnViewerLocations(ViewerLocations);
+
+	struct FPendingVisualizationLoad
+	{
+		FArsInstancedActorsSoftVisualizationDesc SoftVisualizationDesc;
+		double DistanceSquared = TNumericLimits<double>::Max();
+		uint32 RequestOrder = 0;
+
+		bool operator<(const FPendingVisualizationLoad& Other) const
+		{
+			return DistanceSquared < Other.DistanceSquared || (DistanceSquared == Other.DistanceSquared && RequestOrder < Other.RequestOrder);
+		}
+	};
+
+	// Prioritize queued loads by distance to the closest viewer. Copying descriptors out, as loads of already resident assets may complete
+	// (and be removed from VisualizationLoadRequests) immediately.
+	TArray<FPendingVisualizationLoad> PendingLoads;
+	for (const TPair<FArsInstancedActorsSoftVisualizationDesc, FVisualizationLoadRequest>& VisualizationLoadRequest : VisualizationLoadRequests)
+	{
+		if (!VisualizationLoadRequest.Value.LoadHandle.IsValid())
+		{
+			PendingLoads.Add({ VisualizationLoadRequest.Key, ComputeVisualizationLoadDistanceSquared(VisualizationLoadRequest.Value, ViewerLocations), VisualizationLoadRequest.Value.RequestOrder });
+		}
+	}
+	PendingLoads.Sort();
+
+	for (const FPendingVisualizationLoad& PendingLoad : PendingLoads)
+	{
+		if (NumActiveVisualizationLoads >= MaxConcurrentLoads)
+		{
+			break;
+		}
+
+		const FVisualizationLoadRequest* Request = VisualizationLoadRequests.Find(PendingLoad.SoftVisualizationDesc);
+		if (Request == nullptr || Request->LoadHandle.IsValid())
+		{
+			continue;
+		}
+
+		StartVisualizationLoad(PendingLoad.SoftVisualizationDesc);
+	}
+
+	UE_CLOG(NumActiveVisualizationLoads < VisualizationLoadRequests.Num(), LogArsInstancedActors, Verbose, TEXT("UArsInstancedActorsSubsystem deferring %d visualization loads, %d in flight")
+		, VisualizationLoadRequests.Num() - NumActiveVisualizationLoads, NumActiveVisualizationLoads);
+}
+
+void UArsInstancedActorsSubsystem::StartVisualizationLoad(const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc)
+{
+	FVisualizationLoadRequest* Request = VisualizationLoadRequests.Find(SoftVisualizationDesc);
+	check(Request && !Request->LoadHandle.IsValid());
+
+	++NumActiveVisualizationLoads;
+	TSharedPtr<FStreamableHandle> LoadHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(Request->AssetsToLoad
+		, FStreamableDelegate::CreateWeakLambda(this, [this, SoftVisualizationDesc]()
+		{
+			OnVisualizationLoadCompleted(SoftVisualizationDesc);
+		}));
+
+	// Request may have already completed
+	Request = VisualizationLoadRequests.Find(SoftVisualizationDesc);
+	if (Request != nullptr)
+	{
+		if (LoadHandle.IsValid())
+		{
+			Request->LoadHandle = MoveTemp(LoadHandle);
+		}
+		else
+		{
+			// Failed to start, complete with whatever could be resolved rather than leaving requesters waiting forever
+			OnVisualizationLoadCompleted(SoftVisualizationDesc);
+		}
+	}
+}
+
+int32 UArsInstancedActorsSubsystem::GetMaxConcurrentVisualizationLoads()
+{
+	return ArsInstancedActorsCVars::MaxConcurrentVisualizationLoads > 0 ? ArsInstancedActorsCVars::MaxConcurrentVisualizationLoads : MAX_int32;
+}
+
+double UArsInstancedActorsSubsystem::ComputeVisualizationLoadDistanceSquared(const FVisualizationLoadRequest& Request, TConstArrayView<FVector> ViewerLocations) const
+{
+	double DistanceSquared = TNumericLimits<double>::Max();
+	for (const FVisualizationLoadRequester& Requester : Request.Requesters)
+	{
+		if (const UArsInstancedActorsData* InstanceData = Requester.InstanceData.Get())
+		{
+			DistanceSquared = FMath::Min(DistanceSquared, ComputeDeferredSpawnDistanceSquared(InstanceData->GetManagerChecked().GetManagerHandle(), ViewerLocations));
+		}
+	}
+	return DistanceSquared;
+}
+
+void UArsInstancedActorsSubsystem::OnVisualizationLoadCompleted(const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem::OnVisualizationLoadCompleted);
+
+	FVisualizationLoadRequest Request;
+	if (!VisualizationLoadRequests.RemoveAndCopyValue(SoftVisualizationDesc, Request))
+	{
+		return;
+	}
+
+	check(NumActiveVisualizationLoads > 0);
+	--NumActiveVisualizationLoads;
+
+	for (const FVisualizationLoadRequester& Requester : Request.Requesters)
+	{
+		if (UArsInstancedActorsData* InstanceData = Requester.InstanceData.Get())
+		{
+			InstanceData->OnVisualizationAssetsLoaded(Requester.VisualizationIndex, SoftVisualizationDesc);
+		}
+	}
+
+	// Start the next queued load in the freed slot, rather than waiting for Tick
+	if (NumActiveVisualizationLoads < VisualizationLoadRequests.Num())
+	{
+		StartPendingVisualizationLoads();
+	}
+}
+
 FArsInstancedActorsManagerHandle UArsInstancedActorsSubsystem::AddManager(AArsInstancedActorsManager& Manager)
 {
 	FArsInstancedActorsManagerHandle ManagerHandle;
@@ -293,63 +643,429 @@ void UArsInstancedActorsSubsystem::RemoveManager(const FArsInstancedActorsManage
 	}
 }
 
-void UArsInstancedActorsSubsystem::RequestDeferredSpawnEntities(FArsInstancedActorsManagerHandle ManagerHandle)
+void UArsInstancedActorsSubsystem::UpdateManagerBounds(const FArsInstancedActorsManagerHandle ManagerHandle, const FBox& PreviousManagerBounds)
+{
+	if (ensureMsgf(Managers.IsValidIndex(ManagerHandle.GetManagerID()), TEXT("Attempting to update bounds for unknown manager (%d)"), ManagerHandle.GetManagerID()))
+	{
+		AArsInstancedActorsManager* Manager = Managers[ManagerHandle.GetManagerID()].Get();
+		if (ensureMsgf(Manager != nullptr, TEXT("Attempting to update bounds for invalid manager")))
+		{
+			const FBox ManagerBounds = Manager->GetInstanceBounds();
+
+			ManagersHashGrid.Remove(ManagerHandle.GetManagerID(), PreviousManagerBounds);
+			ManagersHashGrid.Add(ManagerHandle, ManagerBounds);
+
+#if WITH_ARSINSTANCEDACTORS_DEBUG
+			DebugManagerBounds.FindOrAdd(Manager) = ManagerBounds;
+#endif
+		}
+	}
+}
+
+void UArsInstancedActorsSubsystem::RequestDeferredSpawnEntities(FArsInstancedActorsManagerHandle ManagerHandle)
+{
+	if (ensureMsgf(Managers.IsValidIndex(ManagerHandle.GetManagerID()), TEXT("Attempting to request deferred spawn entities for unknown manager (%d)"), ManagerHandle.GetManagerID()))
+	{
+		if (PendingManagersToSpawnEntities.IsEmpty())
+		{
+			// Nothing pending means viewer locations may be arbitrarily stale
+			GatherDeferredSpawnViewerLocations(DeferredSpawnViewerLocations);
+		}
+
+		FPendingSpawnEntitiesRequest Request;
+		Request.ManagerHandle = ManagerHandle;
+		Request.DistanceSquared = ComputeDeferredSpawnDistanceSquared(ManagerHandle, DeferredSpawnViewerLocations);
+		Request.RequestOrder = NextDeferredSpawnRequestOrder++;
+		PendingManagersToSpawnEntities.HeapPush(Request);
+	}
+}
+
+UE::ArsInstancedActors::FConnectionDeltaRelevancy& UArsInstancedActorsSubsystem::GetConnectionDeltaRelevancy(const UNetConnection& Connection)
+{
+	UE::ArsInstancedActors::FConnectionDeltaRelevancy& ConnectionRelevancy = ConnectionDeltaRelevancies.FindOrAdd(&Connection);
+
+	// Budgets are per-frame, across all delta lists
+	if (ConnectionRelevancy.BudgetFrame != GFrameCounter)
+	{
+		ConnectionRelevancy.BudgetFrame = GFrameCounter;
+		ConnectionRelevancy.NumNewDeltasWritten = 0;
+	}
+
+	return ConnectionRelevancy;
+}
+
+void UArsInstancedActorsSubsystem::RequestDeferredPhysicsStateCreation(UInstancedStaticMeshComponent& ISMComponent, double DistanceSquared)
+{
+	// Create immediately for viewers within IA.PhysicsStateCreation.ImmediateDistance, as they may already be amongst these instances
+	const double ImmediateDistanceSquared = FMath::Square(FMath::Max(ArsInstancedActorsCVars::PhysicsStateCreationImmediateDistance, 0.0f));
+	if (!ArsInstancedActorsCVars::bDeferPhysicsStateCreation || DistanceSquared <= ImmediateDistanceSquared)
+	{
+		CancelDeferredPhysicsStateCreation(ISMComponent);
+		UE::ArsInstancedActors::Helpers::CreatePhysicsState(ISMComponent);
+		return;
+	}
+
+	if (HasPendingPhysicsStateCreation(ISMComponent))
+	{
+		return;
+	}
+
+	UE::ArsInstancedActors::FPhysicsStateCreationRequest Request;
+	Request.ISMComponent = &ISMComponent;
+	Request.DistanceSquared = DistanceSquared;
+	Request.RequestOrder = NextPhysicsStateCreationRequestOrder++;
+	PendingPhysicsStateCreations.Push(MoveTemp(Request));
+}
+
+bool UArsInstancedActorsSubsystem::CancelDeferredPhysicsStateCreation(const UInstancedStaticMeshComponent& ISMComponent)
+{
+	return PendingPhysicsStateCreations.Remove(ISMComponent);
+}
+
+void UArsInstancedActorsSubsystem::FlushDeferredPhysicsStateCreation(const UArsInstancedActorsData& InstanceData)
+{
+	if (PendingPhysicsStateCreations.IsEmpty())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem FlushDeferredPhysicsStateCreation);
+
+	InstanceData.ForEachVisualization([this](uint8 /*VisualizationIndex*/, const FArsInstancedActorsVisualizationInfo& Visualization)
+		{
+			for (const TObjectPtr<UInstancedStaticMeshComponent>& ISMComponent : Visualization.ISMComponents)
+			{
+				if (ISMComponent && CancelDeferredPhysicsStateCreation(*ISMComponent))
+				{
+					UE::ArsInstancedActors::Helpers::CreatePhysicsState(*ISMComponent);
+				}
+			}
+			return true;
+		});
+}
+
+void UArsInstancedActorsSubsystem::FlushDeferredPhysicsStateCreation(const FBox& QueryBounds)
+{
+	if (PendingPhysicsStateCreations.IsEmpty())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem FlushDeferredPhysicsStateCreation Bounds);
+
+	TArray<UInstancedStaticMeshComponent*, TInlineAllocator<16>> ISMComponentsToFlush;
+	for (const UE::ArsInstancedActors::FPhysicsStateCreationRequest& Request : PendingPhysicsStateCreations.GetRequests())
+	{
+		UInstancedStaticMeshComponent* ISMComponent = Request.ISMComponent.Get();
+		if (ISMComponent && ISMComponent->Bounds.GetBox().Intersect(QueryBounds))
+		{
+			ISMComponentsToFlush.Add(ISMComponent);
+		}
+	}
+
+	for (UInstancedStaticMeshComponent* ISMComponent : ISMComponentsToFlush)
+	{
+		CancelDeferredPhysicsStateCreation(*ISMComponent);
+		UE::ArsInstancedActors::Helpers::CreatePhysicsState(*ISMComponent);
+	}
+}
+
+bool UArsInstancedActorsSubsystem::ExecutePendingPhysicsStateCreations(double StopAfterSeconds, int32 MaxBodies)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem ExecutePendingPhysicsStateCreations);
+
+	const double TimeAllowedEnd = FPlatformTime::Seconds() + StopAfterSeconds;
+	MaxBodies = FMath::Max(MaxBodies, 1);
+	int32 NumBodiesCreated = 0;
+
+	bool bHasBudgetRemaining = true;
+	while (bHasBudgetRemaining && !PendingPhysicsStateCreations.IsEmpty())
+	{
+		bool bRequestCompleted = true;
+
+		// Components may have been destroyed since requested, e.g: due to visualization switching
+		if (UInstancedStaticMeshComponent* ISMComponent = PendingPhysicsStateCreations.Top().ISMComponent.Get())
+		{
+			// Slice instance body creation within the component, leaving it at the front of the queue until complete
+			if (UArsInstancedActorsISMComponent* IAISMComponent = Cast<UArsInstancedActorsISMComponent>(ISMComponent))
+			{
+				if (!IAISMComponent->IsPhysicsStateCreated())
+				{
+					if (IAISMComponent->IsRegistered())
+					{
+						IAISMComponent->CreatePhysicsStateWithPendingInstanceBodies();
+					}
+					else
+					{
+						UE_LOG(LogArsInstancedActors, Error, TEXT("Failed to create physics state on component '%s', because component is not registered."), *IAISMComponent->GetFullName());
+					}
+				}
+				NumBodiesCreated += IAISMComponent->CreatePendingInstanceBodies(MaxBodies - NumBodiesCreated);
+				bRequestCompleted = !IAISMComponent->HasPendingInstanceBodies();
+			}
+			else if (UE::ArsInstancedActors::Helpers::CreatePhysicsState(*ISMComponent))
+			{
+				NumBodiesCreated += ISMComponent->GetInstanceCount();
+			}
+		}
+
+		if (bRequestCompleted)
+		{
+			PendingPhysicsStateCreations.Pop();
+		}
+
+		bHasBudgetRemaining = NumBodiesCreated < MaxBodies && FPlatformTime::Seconds() < TimeAllowedEnd;
+	}
+
+	UE_CLOG(!PendingPhysicsStateCreations.IsEmpty(), LogArsInstancedActors, Verbose, TEXT("UArsInstancedActorsSubsystem deferring %d remaining physics state creation requests to next frame (%d bodies created this frame)")
+		, PendingPhysicsStateCreations.Num(), NumBodiesCreated);
+	return PendingPhysicsStateCreations.IsEmpty();
+}
+
+bool UArsInstancedActorsSubsystem::HasPendingPhysicsStateCreation(const UInstancedStaticMeshComponent& ISMComponent) const
+{
+	return PendingPhysicsStateCreations.Contains(ISMComponent);
+}
+
+void UArsInstancedActorsSubsystem::FlushDeferredInstanceDeltas()
+{
+	if (ConnectionDeltaRelevancies.IsEmpty())
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	const double CurrentTime = World->GetTimeSeconds();
+	if (CurrentTime < NextDeferredInstanceDeltasFlushTime)
+	{
+		return;
+	}
+	NextDeferredInstanceDeltasFlushTime = CurrentTime + ArsInstancedActorsCVars::DeltaRelevancyFlushInterval;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem FlushDeferredInstanceDeltas);
+
+	// With relevancy since disabled, everything deferred is relevant
+	const bool bRelevancyEnabled = UE::ArsInstancedActors::CVars::DeltaRelevancyDistance > 0.0f;
+	const double RelevancyDistanceSquared = FMath::Square((double)UE::ArsInstancedActors::CVars::DeltaRelevancyDistance);
+
+	TSet<int32> ManagerIDsToFlush;
+	for (auto It = ConnectionDeltaRelevancies.CreateIterator(); It; ++It)
+	{
+		const UNetConnection* Connection = It->Key.ResolveObjectPtr();
+		UE::ArsInstancedActors::FConnectionDeltaRelevancy& ConnectionRelevancy = It->Value;
+		if (Connection == nullptr || Connection->GetConnectionState() == USOCK_Closed)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		ManagerIDsToFlush.Append(ConnectionRelevancy.BudgetDeferredManagerIDs);
+		ConnectionRelevancy.BudgetDeferredManagerIDs.Reset();
+
+		const AActor* ViewTarget = Connection->ViewTarget.Get();
+		if (ViewTarget != nullptr || !bRelevancyEnabled)
+		{
+			const FVector ViewLocation = ViewTarget ? ViewTarget->GetActorLocation() : FVector::ZeroVector;
+			for (auto BoundsIt = ConnectionRelevancy.OutOfRangeDeferredBounds.CreateIterator(); BoundsIt; ++BoundsIt)
+			{
+				// Managers still deferring deltas for this connection once re-replicated will simply be re-recorded by 
+				// FArsInstancedActorsDeltaList::NetDeltaSerialize
+				if (!bRelevancyEnabled || BoundsIt->Value.ComputeSquaredDistanceToPoint(ViewLocation) <= RelevancyDistanceSquared)
+				{
+					ManagerIDsToFlush.Add(BoundsIt->Key);
+					BoundsIt.RemoveCurrent();
+				}
+			}
+		}
+
+		// Connections with nothing deferred are re-added by their next NetDeltaSerialize
+		if (!ConnectionRelevancy.HasDeferredDeltas())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const int32 ManagerID : ManagerIDsToFlush)
+	{
+		if (Managers.IsValidIndex(ManagerID))
+		{
+			if (AArsInstancedActorsManager* Manager = Managers[ManagerID].Get())
+			{
+				Manager->MarkInstanceDeltasForRelevancyUpdate();
+			}
+		}
+	}
+}
+
+bool UArsInstancedActorsSubsystem::CancelDeferredSpawnEntitiesRequest(FArsInstancedActorsManagerHandle ManagerHandle)
 {
-	if (ensureMsgf(Managers.IsValidIndex(ManagerHandle.GetManagerID()), TEXT("Attempting to request deferred spawn entities for unknown manager (%d)"), ManagerHandle.GetManagerID()))
+	const int32 RequestIndex = PendingManagersToSpawnEntities.IndexOfByPredicate([ManagerHandle](const FPendingSpawnEntitiesRequest& Request)
+		{
+			return Request.ManagerHandle == ManagerHandle;
+		});
+
+	if (RequestIndex != INDEX_NONE)
 	{
-		PendingManagersToSpawnEntities.Add(ManagerHandle);
+		PendingManagersToSpawnEntities.HeapRemoveAt(RequestIndex, EAllowShrinking::No);
+		return true;
 	}
-}
 
-bool UArsInstancedActorsSubsystem::CancelDeferredSpawnEntitiesRequest(FArsInstancedActorsManagerHandle ManagerHandle)
-{
-	int32 NumRemoved = PendingManagersToSpawnEntities.Remove(ManagerHandle);
-	return NumRemoved > 0;
+	// Note: The manager itself is responsible for discarding it's in-flight preparation @see AArsInstancedActorsManager::DespawnAllEntities
+	return ManagersPreparingSpawnEntities.Remove(ManagerHandle) > 0;
 }
 
 bool UArsInstancedActorsSubsystem::ExecutePendingDeferredSpawnEntitiesRequests(double StopAfterSeconds)
 {
-	if (PendingManagersToSpawnEntities.IsEmpty())
+	if (PendingManagersToSpawnEntities.IsEmpty() && ManagersPreparingSpawnEntities.IsEmpty())
 	{
 		return true;
 	}
 
-	const double TimeAllowedEnd = FMath::IsFinite(StopAfterSeconds) ? FPlatformTime::Seconds() + StopAfterSeconds : INFINITY;
-	
-	// Execute InitializeModifyAndSpawnEntities for pending managers
-	int32 PendingRequestIndex = 0;
-	for (; PendingRequestIndex < PendingManagersToSpawnEntities.Num(); ++PendingRequestIndex)
+	const bool bUnbounded = !FMath::IsFinite(StopAfterSeconds);
+	const double TimeAllowedEnd = bUnbounded ? INFINITY : FPlatformTime::Seconds() + StopAfterSeconds;
+	bool bHasTimeRemaining = true;
+
+	auto GetManager = [this](const FArsInstancedActorsManagerHandle ManagerHandle) -> AArsInstancedActorsManager*
+		{
+			if (ensureMsgf(Managers.IsValidIndex(ManagerHandle.GetManagerID()), TEXT("Attempting to perform deferred entity spawn for unknown manager (%d)"), ManagerHandle.GetManagerID()))
+			{
+				AArsInstancedActorsManager* Manager = Managers[ManagerHandle.GetManagerID()].Get();
+				if (ensureMsgf(IsValid(Manager), TEXT("Attempting to perform deferred entity spawn for invalid manager (%d)"), ManagerHandle.GetManagerID()))
+				{
+					return Manager;
+				}
+			}
+			return nullptr;
+		};
+
+	// Commit managers whose spawn preparation has completed, in the order they started preparing
+	for (int32 PreparingIndex = 0; PreparingIndex < ManagersPreparingSpawnEntities.Num() && bHasTimeRemaining;)
 	{
-		const FArsInstancedActorsManagerHandle& ManagerHandle = PendingManagersToSpawnEntities[PendingRequestIndex];
-		if (ensureMsgf(Managers.IsValidIndex(ManagerHandle.GetManagerID()), TEXT("Attempting to perform deferred entity spawn for unknown manager (%d)"), ManagerHandle.GetManagerID()))
+		AArsInstancedActorsManager* Manager = GetManager(ManagersPreparingSpawnEntities[PreparingIndex]);
+		if (Manager == nullptr || bUnbounded || Manager->IsSpawnEntitiesPreparationComplete())
 		{
-			AArsInstancedActorsManager* Manager = Managers[ManagerHandle.GetManagerID()].Get();
-			if (ensureMsgf(IsValid(Manager), TEXT("Attempting to perform deferred entity spawn for invalid manager (%d)"), ManagerHandle.GetManagerID()))
+			ManagersPreparingSpawnEntities.RemoveAt(PreparingIndex, EAllowShrinking::No);
+			if (Manager)
+			{
+				Manager->CommitPreparedSpawnEntities();
+			}
+
+			// Stop after StopAfterSeconds
+			bHasTimeRemaining = FPlatformTime::Seconds() < TimeAllowedEnd;
+		}
+		else
+		{
+			++PreparingIndex;
+		}
+	}
+
+	if (bHasTimeRemaining && !PendingManagersToSpawnEntities.IsEmpty())
+	{
+		UpdateDeferredSpawnEntitiesPriorities();
+	}
+
+	// Execute InitializeModifyAndSpawnEntities for pending managers, closest to viewers first. With IA.DeferSpawnEntities.AsyncPreparation
+	// only initialization & pre-spawn modifiers run here, with entity spawning committed in a later call once preparation completes.
+	const bool bAsyncPreparation = ArsInstancedActorsCVars::bDeferSpawnEntitiesAsyncPreparation && !bUnbounded;
+	while (bHasTimeRemaining && !PendingManagersToSpawnEntities.IsEmpty())
+	{
+		FPendingSpawnEntitiesRequest Request;
+		PendingManagersToSpawnEntities.HeapPop(Request, EAllowShrinking::No);
+
+		if (AArsInstancedActorsManager* Manager = GetManager(Request.ManagerHandle))
+		{
+			if (bAsyncPreparation)
+			{
+				Manager->InitializeModifyAndPrepareSpawnEntities();
+				ManagersPreparingSpawnEntities.Add(Request.ManagerHandle);
+			}
+			else
 			{
 				Manager->InitializeModifyAndSpawnEntities();
 			}
 		}
 
 		// Stop after StopAfterSeconds
-		if (FPlatformTime::Seconds() >= TimeAllowedEnd)
+		bHasTimeRemaining = FPlatformTime::Seconds() < TimeAllowedEnd;
+	}
+
+	const bool bExecutedAllPending = !HasPendingDeferredSpawnEntitiesRequests();
+	UE_CLOG(!bExecutedAllPending, LogArsInstancedActors, Verbose, TEXT("UArsInstancedActorsSubsystem deferring %d remaining spawn entities requests (%d preparing) to next frame")
+		, PendingManagersToSpawnEntities.Num() + ManagersPreparingSpawnEntities.Num(), ManagersPreparingSpawnEntities.Num());
+	return bExecutedAllPending;
+}
+
+void UArsInstancedActorsSubsystem::GatherDeferredSpawnViewerLocations(TArray<FVector>& OutViewerLocations) const
+{
+	OutViewerLocations.Reset();
+
+	const UMassLODSubsystem* LODSubsystem = UWorld::GetSubsystem<UMassLODSubsystem>(GetWorld());
+	if (LODSubsystem == nullptr)
+	{
+		return;
+	}
+
+	for (const FViewerInfo& Viewer : LODSubsystem->GetViewers())
+	{
+		// Skip streaming sources and viewers that haven't started yet (i.e: no pawn, camera at origin)
+		// @see UArsInstancedActorsStationaryLODBatchProcessor::Execute
+		if (Viewer.StreamingSourceName.IsNone() && !Viewer.Location.IsNearlyZero())
 		{
-			++PendingRequestIndex;
-			break;
+			OutViewerLocations.Add(Viewer.Location);
 		}
 	}
+}
 
-	// Remove processed requests
-	const int32 NumProcessedRequests = PendingRequestIndex;
-	PendingManagersToSpawnEntities.RemoveAt(0, NumProcessedRequests);
+double UArsInstancedActorsSubsystem::ComputeDeferredSpawnDistanceSquared(FArsInstancedActorsManagerHandle ManagerHandle, TConstArrayView<FVector> ViewerLocations) const
+{
+	double DistanceSquared = TNumericLimits<double>::Max();
 
-	const bool bExecutedAllPending = PendingManagersToSpawnEntities.IsEmpty();
-	UE_CLOG(!bExecutedAllPending, LogArsInstancedActors, Verbose, TEXT("UArsInstancedActorsSubsystem deferring %d remaining spawn entities requests to next frame"), PendingManagersToSpawnEntities.Num());
-	return bExecutedAllPending;
+	const AArsInstancedActorsManager* Manager = Managers.IsValidIndex(ManagerHandle.GetManagerID()) ? Managers[ManagerHandle.GetManagerID()].Get() : nullptr;
+	if (Manager == nullptr)
+	{
+		return DistanceSquared;
+	}
+
+	const FBox ManagerBounds = Manager->GetInstanceBounds();
+	for (const FVector& ViewerLocation : ViewerLocations)
+	{
+		DistanceSquared = FMath::Min(DistanceSquared, ComputeSquaredDistanceFromBoxToPoint(ManagerBounds.Min, ManagerBounds.Max, ViewerLocation));
+	}
+	return DistanceSquared;
+}
+
+void UArsInstancedActorsSubsystem::UpdateDeferredSpawnEntitiesPriorities()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem::UpdateDeferredSpawnEntitiesPriorities);
+
+	TArray<FVector> ViewerLocations;
+	GatherDeferredSpawnViewerLocations(ViewerLocations);
+
+	bool bViewersMoved = (ViewerLocations.Num() != DeferredSpawnViewerLocations.Num());
+	const double ReprioritizeDistanceSquared = FMath::Square(FMath::Max(ArsInstancedActorsCVars::DeferSpawnEntitiesReprioritizeDistance, 0.0f));
+	for (int32 ViewerIndex = 0; ViewerIndex < ViewerLocations.Num() && !bViewersMoved; ++ViewerIndex)
+	{
+		bViewersMoved = FVector::DistSquared(ViewerLocations[ViewerIndex], DeferredSpawnViewerLocations[ViewerIndex]) >= ReprioritizeDistanceSquared;
+	}
+
+	if (!bViewersMoved)
+	{
+		return;
+	}
+
+	DeferredSpawnViewerLocations = MoveTemp(ViewerLocations);
+	for (FPendingSpawnEntitiesRequest& Request : PendingManagersToSpawnEntities)
+	{
+		Request.DistanceSquared = ComputeDeferredSpawnDistanceSquared(Request.ManagerHandle, DeferredSpawnViewerLocations);
+	}
+	PendingManagersToSpawnEntities.Heapify();
 }
 
 bool UArsInstancedActorsSubsystem::HasPendingDeferredSpawnEntitiesRequests() const
 {
-	return !PendingManagersToSpawnEntities.IsEmpty();
+	return !PendingManagersToSpawnEntities.IsEmpty() || !ManagersPreparingSpawnEntities.IsEmpty();
 }
 
 FArsInstancedActorsModifierVolumeHandle UArsInstancedActorsSubsystem::AddModifierVolume(UArsInstancedActorsModifierVolumeComponent& ModifierVolume)
@@ -613,6 +1329,126 @@ void UArsInstancedActorsSubsystem::ForEachInstance(const FBox& QueryBounds, TFun
 	});
 }
 
+int32 UArsInstancedActorsSubsystem::AddInstances(TSubclassOf<AActor> ActorClass, TConstArrayView<FTransform> WorldTransforms
+	, const FGameplayTagContainer& AdditionalInstanceTags, TArray<FArsInstancedActorsInstanceHandle>* OutInstanceHandles)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem::AddInstances);
+
+	if (!ensureMsgf(ActorClass, TEXT("Expecting a valid ActorClass. Received None.")))
+	{
+		return 0;
+	}
+
+	const FArsInstancedActorsTagSet AdditionalInstanceTagSet(AdditionalInstanceTags);
+
+	// Group transforms per target IAD, so each IAD spawns its added entities in a single batch
+	TMap<TObjectPtr<UArsInstancedActorsData>, TArray<FTransform>> TransformsPerInstanceData;
+	int32 NumSkippedInstances = 0;
+	int32 NumModifiedInstances = 0;
+	TArray<FArsInstancedActorsManagerHandle> CellManagerHandles;
+	for (const FTransform& WorldTransform : WorldTransforms)
+	{
+		const FVector Location = WorldTransform.GetLocation();
+
+		// Consider all managers sharing Location's hash grid cell, not only those already overlapping it, as instance bounds grow
+		// to fit added instances
+		CellManagerHandles.Reset();
+		ManagersHashGrid.Query(FBox(Location, Location), CellManagerHandles);
+
+		UArsInstancedActorsData* BestInstanceData = nullptr;
+		double BestDistSquared = UE_DOUBLE_BIG_NUMBER;
+		AArsInstancedActorsManager* ClosestManager = nullptr;
+		double ClosestManagerDistSquared = UE_DOUBLE_BIG_NUMBER;
+		for (const FArsInstancedActorsManagerHandle ManagerHandle : CellManagerHandles)
+		{
+			AArsInstancedActorsManager* Manager = Managers[ManagerHandle.GetManagerID()].Get();
+			if (Manager == nullptr || !Manager->HasAuthority())
+			{
+				continue;
+			}
+
+			const double DistSquared = FVector::DistSquared(Manager->GetActorLocation(), Location);
+			if (DistSquared < ClosestManagerDistSquared)
+			{
+				ClosestManager = Manager;
+				ClosestManagerDistSquared = DistSquared;
+			}
+
+			if (DistSquared >= BestDistSquared)
+			{
+				continue;
+			}
+
+			for (const TObjectPtr<UArsInstancedActorsData>& InstanceData : Manager->GetAllInstanceData())
+			{
+				if (InstanceData->ActorClass == ActorClass && InstanceData->GetAdditionalTags() == AdditionalInstanceTagSet)
+				{
+					const TArray<FTransform>* PendingTransforms = TransformsPerInstanceData.Find(InstanceData);
+					if (InstanceData->GetNumAddableRuntimeInstances() > (PendingTransforms ? PendingTransforms->Num() : 0))
+					{
+						BestInstanceData = InstanceData;
+						BestDistSquared = DistSquared;
+						break;
+					}
+				}
+			}
+		}
+
+		AArsInstancedActorsManager* TargetManager = BestInstanceData ? &BestInstanceData->GetManagerChecked() : ClosestManager;
+		if (TargetManager == nullptr)
+		{
+			++NumSkippedInstances;
+			continue;
+		}
+
+		// Skip additions within modifier volumes, which have already run their modifiers for TargetManager
+		bool bInsideModifierVolume = false;
+		ForEachModifierVolume(FBox(Location, Location), [TargetManager, &Location, &bInsideModifierVolume](UArsInstancedActorsModifierVolumeComponent& ModifierVolume)
+			{
+				bInsideModifierVolume = !ModifierVolume.Modifiers.IsEmpty() && !ModifierVolume.IsIgnoringManager(*TargetManager) && ModifierVolume.IsInside(Location);
+				return !bInsideModifierVolume;
+			});
+		if (bInsideModifierVolume)
+		{
+			++NumModifiedInstances;
+			continue;
+		}
+
+		// Fall back to a new IAD in the closest manager. Subsequent transforms will find it as matching instance data.
+		if (BestInstanceData == nullptr)
+		{
+			BestInstanceData = TargetManager->CreateRuntimeInstanceData(ActorClass, AdditionalInstanceTagSet);
+		}
+
+		if (BestInstanceData)
+		{
+			TransformsPerInstanceData.FindOrAdd(BestInstanceData).Add(WorldTransform);
+		}
+		else
+		{
+			++NumSkippedInstances;
+		}
+	}
+
+	UE_CLOG(NumSkippedInstances > 0, LogArsInstancedActors, Warning, TEXT("Skipping %d of %d runtime added %s instances, found no manager in their hash grid cell to add them to")
+		, NumSkippedInstances, WorldTransforms.Num(), *ActorClass->GetName());
+	UE_CLOG(NumModifiedInstances > 0, LogArsInstancedActors, Log, TEXT("Skipping %d of %d runtime added %s instances inside modifier volumes")
+		, NumModifiedInstances, WorldTransforms.Num(), *ActorClass->GetName());
+
+	int32 NumAddedInstances = 0;
+	for (TPair<TObjectPtr<UArsInstancedActorsData>, TArray<FTransform>>& InstanceDataTransforms : TransformsPerInstanceData)
+	{
+		TArray<FArsInstancedActorsInstanceHandle> AddedInstanceHandles = InstanceDataTransforms.Key->AddRuntimeInstances(InstanceDataTransforms.Value, /*bWorldSpace*/true);
+		NumAddedInstances += AddedInstanceHandles.Num();
+		if (OutInstanceHandles)
+		{
+			OutInstanceHandles->Append(MoveTemp(AddedInstanceHandles));
+		}
+	}
+
+	return NumAddedInstances;
+}
+
 bool UArsInstancedActorsSubsystem::HasInstancesOfClass(const FBox& QueryBounds, TSubclassOf<AActor> ActorClass
 	, const bool bTestActorsIfSpawned, const EArsInstancedActorsBulkLODMask AllowedLODs) const
 {
@@ -657,6 +1493,15 @@ TSharedRef<UE::ArsInstancedActors::FExemplarActorData> UArsInstancedActorsSubsys
 		}
 	}
 
+	// Reuse a previously released exemplar?
+	if (AActor* RetainedExemplarActor = TakeRetainedExemplarActor(ActorClassPtr))
+	{
+		TSharedPtr<UE::ArsInstancedActors::FExemplarActorData> RetainedExemplarActorDataPtr{new UE::ArsInstancedActors::FExemplarActorData{RetainedExemplarActor, this}};
+		ExemplarActors.AddByHash(ActorClassHash, ActorClassKey, RetainedExemplarActorDataPtr);
+
+		return RetainedExemplarActorDataPtr.ToSharedRef();
+	}
+
 	// Lazy create a new 'inactive' UWorld to spawn fully constructed 'exemplar' actors in for
 	// exemplary instance data introspection
 	//
@@ -720,6 +1565,172 @@ void UArsInstancedActorsSubsystem::UnregisterExemplarActorClass(TSubclassOf<AAct
 	}
 }
 
+void UArsInstancedActorsSubsystem::ReleaseExemplarActor(AActor& ExemplarActor)
+{
+	UnregisterExemplarActorClass(ExemplarActor.GetClass());
+
+	const SIZE_T MemoryBudget = static_cast<SIZE_T>(FMath::Max(ArsInstancedActorsCVars::ExemplarActorCacheMemoryBudgetMB, 0.0f) * 1024.0f * 1024.0f);
+	if (MemoryBudget == 0 || ArsInstancedActorsCVars::ExemplarActorCacheMaxActors <= 0 || !IsValid(ExemplarActorWorld))
+	{
+		// Not retaining any exemplars, flush any retained before the cache was disabled
+		EvictRetainedExemplarActors(/*MemoryBudget*/0, /*MaxActors*/0);
+
+		ExemplarActor.Destroy();
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem ReleaseExemplarActor);
+
+	// Estimate the memory we'd keep alive by retaining ExemplarActor. Referenced assets (meshes, materials) are shared with the 
+	// instances themselves so aren't accounted for.
+	SIZE_T ResourceSize = ExemplarActor.GetClass()->GetStructureSize() + ExemplarActor.GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	ExemplarActor.ForEachComponent(/*bIncludeFromChildActors*/false, [&ResourceSize](const UActorComponent* Component)
+	{
+		ResourceSize += Component->GetClass()->GetStructureSize() + Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	});
+
+	RetainedExemplarActors.Add({ &ExemplarActor, ResourceSize });
+	RetainedExemplarActorsResourceSize += ResourceSize;
+
+	EvictRetainedExemplarActors(MemoryBudget, ArsInstancedActorsCVars::ExemplarActorCacheMaxActors);
+}
+
+AActor* UArsInstancedActorsSubsystem::TakeRetainedExemplarActor(const UClass* ActorClass)
+{
+	for (int32 RetainedIndex = RetainedExemplarActors.Num() - 1; RetainedIndex >= 0; --RetainedIndex)
+	{
+		AActor* RetainedExemplarActor = RetainedExemplarActors[RetainedIndex].Actor.Get();
+		if (RetainedExemplarActor && RetainedExemplarActor->GetClass() == ActorClass)
+		{
+			RetainedExemplarActorsResourceSize -= RetainedExemplarActors[RetainedIndex].ResourceSize;
+			RetainedExemplarActors.RemoveAt(RetainedIndex, EAllowShrinking::No);
+
+			return RetainedExemplarActor;
+		}
+	}
+
+	return nullptr;
+}
+
+void UArsInstancedActorsSubsystem::EvictRetainedExemplarActors(const SIZE_T MemoryBudget, const int32 MaxActors)
+{
+	int32 NumToEvict = 0;
+	while (NumToEvict < RetainedExemplarActors.Num() 
+		&& (RetainedExemplarActorsResourceSize > MemoryBudget || RetainedExemplarActors.Num() - NumToEvict > MaxActors))
+	{
+		const FRetainedExemplarActor& EvictedExemplarActor = RetainedExemplarActors[NumToEvict++];
+		RetainedExemplarActorsResourceSize -= EvictedExemplarActor.ResourceSize;
+
+		// Note: This can fail in editor with undo/redo in the mix, as per GetOrCreateExemplarActor
+		if (AActor* Actor = EvictedExemplarActor.Actor.Get())
+		{
+			Actor->Destroy();
+		}
+	}
+
+	RetainedExemplarActors.RemoveAt(0, NumToEvict, EAllowShrinking::No);
+}
+
+const FArsInstancedActorsVisualizationDesc* UArsInstancedActorsSubsystem::GetOrCreateClassDefaultVisualization(TSubclassOf<AActor> ActorClass)
+{
+	const UClass* ActorClassPtr = ActorClass.Get();
+	check(ActorClassPtr);
+	const TObjectKey<const UClass> ActorClassKey(ActorClassPtr);
+
+	const FArsInstancedActorsVisualizationDesc* ClassDefaultVisualization = ClassDefaultVisualizations.Find(ActorClassKey);
+	if (ClassDefaultVisualization == nullptr)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem CreateClassDefaultVisualization);
+
+		ClassDefaultVisualization = &ClassDefaultVisualizations.Add(ActorClassKey, CreateVisualDescriptionFromActorClassDefaults(ActorClass));
+	}
+
+	// No visible static meshes in the class defaults, e.g: set up by construction scripts. Exemplar actors are required instead.
+	return ClassDefaultVisualization->ISMComponentDescriptors.Num() > 0 ? ClassDefaultVisualization : nullptr;
+}
+
+TSharedRef<UE::ArsInstancedActors::FSharedEntityTemplate> UArsInstancedActorsSubsystem::GetOrCreateSharedEntityTemplate(UArsInstancedActorsData& InstanceData, const AActor& ExemplarActor)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsSubsystem GetOrCreateSharedEntityTemplate);
+
+	// Templates are built from the first instance data using them, so classes with components modifying them per-instance-data opt out of sharing.
+	// Recorded before making Key, for all subsequent MakeSharedEntityTemplateKey calls to opt out too.
+	bool bCanShareEntityTemplate = true;
+	ExemplarActor.ForEachComponent<UArsInstancedActorsComponent>(/*bIncludeFromChildActors=*/false, [&bCanShareEntityTemplate](const UArsInstancedActorsComponent* InstancedActorComponent)
+		{
+			bCanShareEntityTemplate &= InstancedActorComponent->CanShareEntityTemplate();
+		});
+	if (!bCanShareEntityTemplate)
+	{
+		UnsharedEntityTemplateActorClasses.Add(ExemplarActor.GetClass());
+	}
+
+	const UE::ArsInstancedActors::FSharedEntityTemplateKey Key = InstanceData.MakeSharedEntityTemplateKey();
+	const uint32 KeyHash = GetTypeHash(Key);
+
+	// Return existing?
+	if (const TWeakPtr<UE::ArsInstancedActors::FSharedEntityTemplate>* CachedSharedEntityTemplatePtr = SharedEntityTemplates.FindByHash(KeyHash, Key))
+	{
+		if (TSharedPtr<UE::ArsInstancedActors::FSharedEntityTemplate> CachedSharedEntityTemplate = CachedSharedEntityTemplatePtr->Pin())
+		{
+			return CachedSharedEntityTemplate.ToSharedRef();
+		}
+
+		SharedEntityTemplates.RemoveByHash(KeyHash, Key);
+	}
+
+	// Build new template from InstanceData, the first user of Key
+	TSharedPtr<UE::ArsInstancedActors::FSharedEntityTemplate> NewSharedEntityTemplate{new UE::ArsInstancedActors::FSharedEntityTemplate{Key, this}};
+	NewSharedEntityTemplate->EntityConfig = FMassEntityConfig(*this);
+	NewSharedEntityTemplate->TemplateID = InstanceData.BuildEntityTemplate(ExemplarActor, NewSharedEntityTemplate->EntityConfig);
+
+	// Cache for subsequent calls
+	SharedEntityTemplates.AddByHash(KeyHash, Key, NewSharedEntityTemplate);
+
+	return NewSharedEntityTemplate.ToSharedRef();
+}
+
+TSharedPtr<UE::ArsInstancedActors::FSharedEntityTemplate> UArsInstancedActorsSubsystem::FindSharedEntityTemplate(const UArsInstancedActorsData& InstanceData) const
+{
+	const TWeakPtr<UE::ArsInstancedActors::FSharedEntityTemplate>* CachedSharedEntityTemplatePtr = SharedEntityTemplates.Find(InstanceData.MakeSharedEntityTemplateKey());
+	return CachedSharedEntityTemplatePtr ? CachedSharedEntityTemplatePtr->Pin() : nullptr;
+}
+
+bool UArsInstancedActorsSubsystem::CanShareEntityTemplates(TSubclassOf<AActor> ActorClass) const
+{
+	return !UnsharedEntityTemplateActorClasses.Contains(ActorClass.Get());
+}
+
+void UArsInstancedActorsSubsystem::UnregisterSharedEntityTemplate(const UE::ArsInstancedActors::FSharedEntityTemplateKey& Key)
+{
+	SharedEntityTemplates.Remove(Key);
+}
+
+void UArsInstancedActorsSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	// Keep shared entity templates' traits alive for FMassEntityConfig::DestroyEntityTemplate
+	UArsInstancedActorsSubsystem* This = CastChecked<UArsInstancedActorsSubsystem>(InThis);
+	for (TPair<UE::ArsInstancedActors::FSharedEntityTemplateKey, TWeakPtr<UE::ArsInstancedActors::FSharedEntityTemplate>>& SharedEntityTemplateItem : This->SharedEntityTemplates)
+	{
+		// Keys compare their settings and visualization object pointers, which mustn't be collected and reused by other objects whilst cached
+		UE::ArsInstancedActors::FSharedEntityTemplateKey& Key = const_cast<UE::ArsInstancedActors::FSharedEntityTemplateKey&>(SharedEntityTemplateItem.Key);
+		Collector.AddPropertyReferencesWithStructARO(FArsInstancedActorsVisualizationDesc::StaticStruct(), &Key.VisualizationDesc, This);
+		Key.Settings.AddStructReferencedObjects(Collector);
+
+		if (TSharedPtr<UE::ArsInstancedActors::FSharedEntityTemplate> SharedEntityTemplate = SharedEntityTemplateItem.Value.Pin())
+		{
+			Collector.AddPropertyReferencesWithStructARO(FMassEntityConfig::StaticStruct(), &SharedEntityTemplate->EntityConfig, This);
+		}
+	}
+
+	for (TPair<TObjectKey<const UClass>, FArsInstancedActorsVisualizationDesc>& ClassDefaultVisualizationItem : This->ClassDefaultVisualizations)
+	{
+		Collector.AddPropertyReferencesWithStructARO(FArsInstancedActorsVisualizationDesc::StaticStruct(), &ClassDefaultVisualizationItem.Value, This);
+	}
+}
+
 FSharedStruct UArsInstancedActorsSubsystem::GetOrCompileSettingsForActorClass(TSubclassOf<AActor> ActorClass)
 {
 	// Return cached?
@@ -737,6 +1748,48 @@ FSharedStruct UArsInstancedActorsSubsystem::GetOrCompileSettingsForActorClass(TS
 	return ActorClassSettings;
 }
 
+FSharedStruct UArsInstancedActorsSubsystem::GetOrAddCookedSettingsForActorClass(TSubclassOf<AActor> ActorClass, const FInstancedStruct& CookedSettings)
+{
+	// Return cached?
+	if (const FSharedStruct* CachedActorClassSettings = PerActorClassSettings.Find(ActorClass.Get()))
+	{
+		return *CachedActorClassSettings;
+	}
+
+	if (!CookedSettings.IsValid() || CookedSettings.GetScriptStruct() != SettingsType)
+	{
+		return GetOrCompileSettingsForActorClass(ActorClass);
+	}
+
+	// Cache cooked settings, skipping Data Registry lookups entirely
+	FSharedStruct ActorClassSettings;
+	ActorClassSettings.InitializeAs(CookedSettings.GetScriptStruct(), CookedSettings.GetMemory());
+
+	PerActorClassSettings.Add(ActorClass.Get(), ActorClassSettings);
+	return ActorClassSettings;
+}
+
+#if WITH_EDITOR
+FInstancedStruct UArsInstancedActorsSubsystem::CompileSettingsForCook(TSubclassOf<AActor> ActorClass)
+{
+	check(DataRegistrySubsystem);
+	check(ProjectSettings);
+
+	if (ActorClass == nullptr
+		|| DataRegistrySubsystem->GetRegistryForType(ProjectSettings->ActorClassSettingsRegistryType.GetName()) == nullptr
+		|| DataRegistrySubsystem->GetRegistryForType(ProjectSettings->NamedSettingsRegistryType.GetName()) == nullptr)
+	{
+		return FInstancedStruct();
+	}
+
+	const FSharedStruct CompiledSettings = GetOrCompileSettingsForActorClass(ActorClass);
+
+	FInstancedStruct CookedSettings;
+	CookedSettings.InitializeAs(CompiledSettings.GetScriptStruct(), CompiledSettings.GetMemory());
+	return CookedSettings;
+}
+#endif // WITH_EDITOR
+
 bool UArsInstancedActorsSubsystem::DoesActorClassHaveRegisteredSettings(TSubclassOf<AActor> ActorClass, bool bIncludeSuperClasses)
 {
 	check(DataRegistrySubsystem);
@@ -900,7 +1953,12 @@ FArsInstancedActorsVisualizationDesc UArsInstancedActorsSubsystem::CreateVisualD
 	return FArsInstancedActorsVisualizationDesc::FromActor(ExemplarActor);
 }
 
-TArray<UArsInstancedActorsSubsystem::FNextTickSharedFragment>& UArsInstancedActorsSubsystem::GetTickableSharedFragments()
+FArsInstancedActorsVisualizationDesc UArsInstancedActorsSubsystem::CreateVisualDescriptionFromActorClassDefaults(TSubclassOf<AActor> ActorClass) const
+{
+	return FArsInstancedActorsVisualizationDesc::FromActorClassDefaults(ActorClass);
+}
+
+UE::ArsInstancedActors::FSharedFragmentTickQueue& UArsInstancedActorsSubsystem::GetTickableSharedFragments()
 {	
 	RegisterNewSharedFragmentsInternal();
 	return SortedSharedFragments;
@@ -913,24 +1971,36 @@ void UArsInstancedActorsSubsystem::UpdateAndResetTickTime(TConstStructView<FArsI
 	const bool bParamStructFound = RegisterNewSharedFragmentsInternal(ArsInstancedActorsDataSharedFragment);
 	if (bParamStructFound == false)
 	{
-		// we need to find the one. Naive implementation for now.
-		// starting from back in assumption stuff has been removed and re-added so the relevant data should be closer 
-		// to the back due to being at EMassLOD::Off level
-		for (int32 Index = SortedSharedFragments.Num() - 1; Index >= 0; --Index)
+		// Newly registered fragments are already scheduled for immediate processing, otherwise reschedule via the fragment's 
+		// queue back-pointer. Note: INDEX_NONE means it's currently being processed and will be rescheduled by the processor.
+		const int32 TickQueueIndex = ArsInstancedActorsDataSharedFragment.Get().TickQueueIndex;
+		if (TickQueueIndex != INDEX_NONE)
 		{
-			if (SortedSharedFragments[Index].SharedStruct == ArsInstancedActorsDataSharedFragment)
-			{
-				FNextTickSharedFragment TickFragment = SortedSharedFragments[Index];
-				// setting to 0 will force update the very next time Batch LOD is being calculated. 
-				TickFragment.NextTickTime = 0;
-				SortedSharedFragments.HeapRemoveAt(Index, EAllowShrinking::No);
-				SortedSharedFragments.HeapPush(MoveTemp(TickFragment));
-				break;
-			}
+			// setting to 0 will force update the very next time Batch LOD is being calculated. 
+			SortedSharedFragments.Reschedule(TickQueueIndex, 0);
 		}
 	}
 }
 
+void UArsInstancedActorsSubsystem::RegisterSharedFragment(const FSharedStruct& SharedFragment)
+{
+	const TConstStructView<FArsInstancedActorsDataSharedFragment> SharedFragmentView(SharedFragment.GetMemory());
+	const bool bParamStructFound = RegisterNewSharedFragmentsInternal(SharedFragmentView);
+	if (bParamStructFound == false && SharedFragmentView.Get().TickQueueIndex == INDEX_NONE)
+	{
+		SortedSharedFragments.Push(FNextTickSharedFragment{ SharedFragment, /*NextTickTime*/0 });
+	}
+}
+
+void UArsInstancedActorsSubsystem::UnregisterSharedFragment(TConstStructView<FArsInstancedActorsDataSharedFragment> SharedFragment)
+{
+	const int32 TickQueueIndex = SharedFragment.Get().TickQueueIndex;
+	if (TickQueueIndex != INDEX_NONE)
+	{
+		SortedSharedFragments.RemoveAt(TickQueueIndex);
+	}
+}
+
 bool UArsInstancedActorsSubsystem::RegisterNewSharedFragmentsInternal(TConstStructView<FArsInstancedActorsDataSharedFragment> ArsInstancedActorsDataSharedFragment)
 {
 	check(EntityManager);
@@ -940,20 +2010,17 @@ bool UArsInstancedActorsSubsystem::RegisterNewSharedFragmentsInternal(TConstStru
 	bool bParamStructFound = !bParamStructProvided;
 	TConstArrayView<FSharedStruct> AllSharedFragmentsOfType = EntityManager->GetSharedFragmentsOfType<FArsInstancedActorsDataSharedFragment>();
 	
-	if (SortedSharedFragments.Num() < AllSharedFragmentsOfType.Num())
+	if (NumRegisteredSharedFragments < AllSharedFragmentsOfType.Num())
 	{
-		// We add all of them at the front for immediate processing.
-		const int32 StartingIndex = SortedSharedFragments.Num();
-		const int32 NewItemsCount = (AllSharedFragmentsOfType.Num() - SortedSharedFragments.Num());
-		SortedSharedFragments.InsertDefaulted(0, NewItemsCount);
-		for (int32 NewIndex = 0; NewIndex < NewItemsCount; ++NewIndex)
+		// We add all of them for immediate processing, e.g: all instance datas of a newly streamed in cell at once.
+		const TConstArrayView<FSharedStruct> NewSharedFragments = AllSharedFragmentsOfType.Slice(NumRegisteredSharedFragments, AllSharedFragmentsOfType.Num() - NumRegisteredSharedFragments);
+		if (bParamStructFound == false)
 		{
-			SortedSharedFragments[NewIndex].SharedStruct = AllSharedFragmentsOfType[StartingIndex + NewIndex];
-			bParamStructFound = bParamStructFound || (AllSharedFragmentsOfType[StartingIndex + NewIndex] == ArsInstancedActorsDataSharedFragment);
+			bParamStructFound = NewSharedFragments.Contains(ArsInstancedActorsDataSharedFragment);
 		}
-		SortedSharedFragments.Heapify();
+		SortedSharedFragments.PushBulk(NewSharedFragments, /*NextTickTime*/0);
+		NumRegisteredSharedFragments = AllSharedFragmentsOfType.Num();
 	}
-	check(SortedSharedFragments.Num() == AllSharedFragmentsOfType.Num());
 
 	return bParamStructFound;
 }
@@ -0,0 +1,167 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#include "ArsInstancedActorsTickQueue.h"
+#include "ArsInstancedActorsTypes.h"
+
+
+namespace UE::ArsInstancedActors
+{
+int32& FSharedFragmentTickQueue::GetQueueIndex(const FNextTickSharedFragment& Item)
+{
+	// FSharedStruct is a shared reference to mutable memory, the back-pointer isn't part of the heap ordering
+	return const_cast<FSharedStruct&>(Item.SharedStruct).Get<FArsInstancedActorsDataSharedFragment>().TickQueueIndex;
+}
+
+void FSharedFragmentTickQueue::Place(const int32 Index, FNextTickSharedFragment&& Item)
+{
+	GetQueueIndex(Item) = Index;
+	Heap[Index] = MoveTemp(Item);
+}
+
+void FSharedFragmentTickQueue::SiftUp(int32 Index)
+{
+	FNextTickSharedFragment Item = MoveTemp(Heap[Index]);
+	while (Index > 0)
+	{
+		const int32 ParentIndex = (Index - 1) / 2;
+		if (!(Item < Heap[ParentIndex]))
+		{
+			break;
+		}
+		Place(Index, MoveTemp(Heap[ParentIndex]));
+		Index = ParentIndex;
+	}
+	Place(Index, MoveTemp(Item));
+}
+
+void FSharedFragmentTickQueue::SiftDown(int32 Index)
+{
+	const int32 Count = Heap.Num();
+	FNextTickSharedFragment Item = MoveTemp(Heap[Index]);
+	while (true)
+	{
+		int32 ChildIndex = 2 * Index + 1;
+		if (ChildIndex >= Count)
+		{
+			break;
+		}
+		if (ChildIndex + 1 < Count && Heap[ChildIndex + 1] < Heap[ChildIndex])
+		{
+			++ChildIndex;
+		}
+		if (!(Heap[ChildIndex] < Item))
+		{
+			break;
+		}
+		Place(Index, MoveTemp(Heap[ChildIndex]));
+		Index = ChildIndex;
+	}
+	Place(Index, MoveTemp(Item));
+}
+
+void FSharedFragmentTickQueue::Push(FNextTickSharedFragment&& Item)
+{
+	checkf(GetQueueIndex(Item) == INDEX_NONE, TEXT("Shared fragment is already queued at %d"), GetQueueIndex(Item));
+
+	const int32 Index = Heap.AddDefaulted();
+	Place(Index, MoveTemp(Item));
+	SiftUp(Index);
+}
+
+void FSharedFragmentTickQueue::Pop(FNextTickSharedFragment& OutItem)
+{
+	check(Heap.Num() > 0);
+
+	OutItem = MoveTemp(Heap[0]);
+	GetQueueIndex(OutItem) = INDEX_NONE;
+
+	FNextTickSharedFragment Last = Heap.Pop(EAllowShrinking::No);
+	if (Heap.Num() > 0)
+	{
+		Place(0, MoveTemp(Last));
+		SiftDown(0);
+	}
+}
+
+void FSharedFragmentTickQueue::PushBulk(TConstArrayView<FSharedStruct> SharedStructs, const double NextTickTime)
+{
+	if (SharedStructs.IsEmpty())
+	{
+		return;
+	}
+
+	const int32 StartIndex = Heap.Num();
+	const int32 NewCount = StartIndex + SharedStructs.Num();
+
+	// Individual sift ups cost O(k log n), a full rebuild O(n + k). Pick whichever is cheaper, roughly.
+	const bool bRebuild = SharedStructs.Num() * FMath::FloorLog2(uint32(NewCount) | 1) > NewCount;
+
+	Heap.Reserve(NewCount);
+	for (const FSharedStruct& SharedStruct : SharedStructs)
+	{
+		const int32 Index = Heap.AddDefaulted();
+		checkf(GetQueueIndex(FNextTickSharedFragment{ SharedStruct }) == INDEX_NONE, TEXT("Shared fragment is already queued"));
+		Place(Index, FNextTickSharedFragment{ SharedStruct, NextTickTime });
+		if (!bRebuild)
+		{
+			SiftUp(Index);
+		}
+	}
+
+	if (bRebuild)
+	{
+		// Floyd's bottom-up heap construction
+		for (int32 Index = NewCount / 2 - 1; Index >= 0; --Index)
+		{
+			SiftDown(Index);
+		}
+	}
+}
+
+void FSharedFragmentTickQueue::Reschedule(const int32 QueueIndex, const double NextTickTime)
+{
+	check(Heap.IsValidIndex(QueueIndex));
+
+	const double PreviousTickTime = Heap[QueueIndex].NextTickTime;
+	Heap[QueueIndex].NextTickTime = NextTickTime;
+	if (NextTickTime < PreviousTickTime)
+	{
+		SiftUp(QueueIndex);
+	}
+	else
+	{
+		SiftDown(QueueIndex);
+	}
+}
+
+void FSharedFragmentTickQueue::RemoveAt(const int32 QueueIndex)
+{
+	check(Heap.IsValidIndex(QueueIndex));
+
+	GetQueueIndex(Heap[QueueIndex]) = INDEX_NONE;
+
+	FNextTickSharedFragment Last = Heap.Pop(EAllowShrinking::No);
+	if (QueueIndex < Heap.Num())
+	{
+		const double RemovedTickTime = Heap[QueueIndex].NextTickTime;
+		Place(QueueIndex, MoveTemp(Last));
+		if (Heap[QueueIndex].NextTickTime < RemovedTickTime)
+		{
+			SiftUp(QueueIndex);
+		}
+		else
+		{
+			SiftDown(QueueIndex);
+		}
+	}
+}
+
+void FSharedFragmentTickQueue::Reset()
+{
+	for (const FNextTickSharedFragment& Item : Heap)
+	{
+		GetQueueIndex(Item) = INDEX_NONE;
+	}
+	Heap.Reset();
+}
+} // UE::ArsInstancedActors
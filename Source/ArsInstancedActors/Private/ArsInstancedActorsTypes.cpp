@@ -2,6 +2,10 @@
 
 #include "ArsInstancedActorsTypes.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/InheritableComponentHandler.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/World.h"
 #include "ArsInstancedActorsSettings.h"
@@ -57,6 +61,80 @@ namespace UE::ArsInstancedActors::Utils
 	}
 } // namespace UE::ArsInstancedActors::Utils
 
+namespace UE::ArsInstancedActors
+{
+	namespace Helpers
+	{
+		TMap<TObjectKey<const UScriptStruct>, EArsInstancedActorsFragmentFlags>& GetInstanceFragmentTypeRegistry()
+		{
+			static TMap<TObjectKey<const UScriptStruct>, EArsInstancedActorsFragmentFlags> InstanceFragmentTypeRegistry;
+			return InstanceFragmentTypeRegistry;
+		}
+	} // Helpers
+
+	void RegisterInstanceFragmentType(const UScriptStruct& FragmentType, EArsInstancedActorsFragmentFlags Flags)
+	{
+		check(IsInGameThread());
+
+		if (!ensureMsgf(FragmentType.IsChildOf(FMassFragment::StaticStruct()), TEXT("%s isn't a FMassFragment and can't be registered as an instance fragment"), *FragmentType.GetName()))
+		{
+			return;
+		}
+		if (!ensureMsgf(Flags != EArsInstancedActorsFragmentFlags::None, TEXT("Instance fragment %s registered without any flags"), *FragmentType.GetName()))
+		{
+			return;
+		}
+
+		Helpers::GetInstanceFragmentTypeRegistry().Add(&FragmentType, Flags);
+	}
+
+	void UnregisterInstanceFragmentType(const UScriptStruct& FragmentType)
+	{
+		check(IsInGameThread());
+
+		Helpers::GetInstanceFragmentTypeRegistry().Remove(&FragmentType);
+	}
+
+	EArsInstancedActorsFragmentFlags GetInstanceFragmentTypeFlags(const UScriptStruct* FragmentType)
+	{
+		if (FragmentType == nullptr)
+		{
+			return EArsInstancedActorsFragmentFlags::None;
+		}
+
+		const EArsInstancedActorsFragmentFlags* Flags = Helpers::GetInstanceFragmentTypeRegistry().Find(FragmentType);
+		return Flags ? *Flags : EArsInstancedActorsFragmentFlags::None;
+	}
+
+	bool FSharedEntityTemplateKey::operator==(const FSharedEntityTemplateKey& Other) const
+	{
+		if (InstanceDataClass != Other.InstanceDataClass || ActorClass != Other.ActorClass || SettingsHash != Other.SettingsHash
+			|| VisualizationHash != Other.VisualizationHash || UnsharedID != Other.UnsharedID)
+		{
+			return false;
+		}
+
+		if (!(CombinedTags == Other.CombinedTags))
+		{
+			return false;
+		}
+
+		// Matching hashes are only 32bit CRCs, so compare settings and visualization in full before sharing templates
+		const UScriptStruct* SettingsStruct = Settings.GetScriptStruct();
+		if (SettingsStruct != Other.Settings.GetScriptStruct())
+		{
+			return false;
+		}
+		if (SettingsStruct && Settings.GetMemory() != Other.Settings.GetMemory() 
+			&& !SettingsStruct->CompareScriptStruct(Settings.GetMemory(), Other.Settings.GetMemory(), PPF_None))
+		{
+			return false;
+		}
+
+		return VisualizationDesc == Other.VisualizationDesc;
+	}
+} // namespace UE::ArsInstancedActors
+
 //-----------------------------------------------------------------------------
 // FArsInstancedActorsTagSet
 //-----------------------------------------------------------------------------
@@ -142,6 +220,129 @@ FArsInstancedActorsVisualizationDesc FArsInstancedActorsVisualizationDesc::FromA
 	return MoveTemp(Visualization);
 }
 
+FArsInstancedActorsVisualizationDesc FArsInstancedActorsVisualizationDesc::FromActorClassDefaults(TSubclassOf<AActor> ActorClass)
+{
+	FArsInstancedActorsVisualizationDesc Visualization;
+
+	const AActor* ActorCDO = ActorClass ? ActorClass->GetDefaultObject<AActor>() : nullptr;
+	if (ActorCDO == nullptr)
+	{
+		return MoveTemp(Visualization);
+	}
+
+	auto AddComponentTemplate = [&Visualization](const UStaticMeshComponent& ComponentTemplate, const FTransform& ActorSpaceTransform, const bool bIsRootComponent)
+	{
+		if (!ComponentTemplate.IsVisible() || !IsValid(ComponentTemplate.GetStaticMesh()))
+		{
+			return;
+		}
+
+		FISMComponentDescriptor& ISMComponentDescriptor = Visualization.ISMComponentDescriptors.AddDefaulted_GetRef();
+		ISMComponentDescriptor.InitFrom(&ComponentTemplate);
+
+		// As per FromActor, the root component defines the actor transform so remains at identity
+		if (!bIsRootComponent)
+		{
+			ISMComponentDescriptor.LocalTransform = ActorSpaceTransform;
+		}
+	};
+
+	// Actor space transforms of scene component templates by component / SCS variable name, for resolving SCS node parents
+	TMap<FName, FTransform> ActorSpaceTransforms;
+
+	// Native components, attached in the actor's constructor
+	const USceneComponent* RootComponent = ActorCDO->GetRootComponent();
+	ActorCDO->ForEachComponent<USceneComponent>(/*bIncludeFromChildActors=*/false, [&ActorSpaceTransforms, &AddComponentTemplate, RootComponent](USceneComponent* ComponentTemplate)
+	{
+		FTransform ActorSpaceTransform = ComponentTemplate->GetRelativeTransform();
+		for (const USceneComponent* Parent = ComponentTemplate->GetAttachParent(); Parent; Parent = Parent->GetAttachParent())
+		{
+			ActorSpaceTransform *= Parent->GetRelativeTransform();
+		}
+		ActorSpaceTransforms.Add(ComponentTemplate->GetFName(), ActorSpaceTransform);
+
+		if (const UStaticMeshComponent* StaticMeshComponentTemplate = Cast<UStaticMeshComponent>(ComponentTemplate))
+		{
+			AddComponentTemplate(*StaticMeshComponentTemplate, ActorSpaceTransform, ComponentTemplate == RootComponent);
+		}
+	});
+
+	// Blueprint added components. GetGeneratedClassesHierarchy returns the most derived class first, we walk base classes first so
+	// inherited SCS parents are resolved before their children.
+	TArray<const UBlueprintGeneratedClass*> BlueprintClasses;
+	UBlueprintGeneratedClass::GetGeneratedClassesHierarchy(ActorClass, BlueprintClasses);
+
+	bool bHasRootComponent = RootComponent != nullptr;
+	FTransform RootTransform = RootComponent ? RootComponent->GetRelativeTransform() : FTransform::Identity;
+	for (int32 BlueprintClassIndex = BlueprintClasses.Num() - 1; BlueprintClassIndex >= 0; --BlueprintClassIndex)
+	{
+		const USimpleConstructionScript* SimpleConstructionScript = BlueprintClasses[BlueprintClassIndex]->SimpleConstructionScript;
+		if (SimpleConstructionScript == nullptr)
+		{
+			continue;
+		}
+
+		for (USCS_Node* Node : SimpleConstructionScript->GetAllNodes())
+		{
+			// Use the most derived class's inherited component override, if any
+			const UActorComponent* ComponentTemplate = nullptr;
+			for (int32 DerivedClassIndex = 0; DerivedClassIndex < BlueprintClassIndex && ComponentTemplate == nullptr; ++DerivedClassIndex)
+			{
+				// Note: GetInheritableComponentHandler is non-const only to optionally create the handler, which we don't
+				if (const UInheritableComponentHandler* InheritableComponentHandler = const_cast<UBlueprintGeneratedClass*>(BlueprintClasses[DerivedClassIndex])->GetInheritableComponentHandler())
+				{
+					ComponentTemplate = InheritableComponentHandler->GetOverridenComponentTemplate(FComponentKey(Node));
+				}
+			}
+			if (ComponentTemplate == nullptr)
+			{
+				ComponentTemplate = Node->ComponentTemplate;
+			}
+
+			const USceneComponent* SceneComponentTemplate = Cast<USceneComponent>(ComponentTemplate);
+			if (SceneComponentTemplate == nullptr)
+			{
+				continue;
+			}
+
+			FTransform ParentTransform = FTransform::Identity;
+			bool bIsRootComponent = false;
+			if (const USCS_Node* ParentNode = SimpleConstructionScript->FindParentNode(Node))
+			{
+				ParentTransform = ActorSpaceTransforms.FindRef(ParentNode->GetVariableName());
+			}
+			else if (Node->ParentComponentOrVariableName != NAME_None)
+			{
+				// Attached to a native or inherited component
+				ParentTransform = ActorSpaceTransforms.FindRef(Node->ParentComponentOrVariableName);
+			}
+			else if (!bHasRootComponent)
+			{
+				bHasRootComponent = true;
+				bIsRootComponent = true;
+			}
+			else
+			{
+				ParentTransform = RootTransform;
+			}
+
+			const FTransform ActorSpaceTransform = SceneComponentTemplate->GetRelativeTransform() * ParentTransform;
+			ActorSpaceTransforms.Add(Node->GetVariableName(), ActorSpaceTransform);
+			if (bIsRootComponent)
+			{
+				RootTransform = ActorSpaceTransform;
+			}
+
+			if (const UStaticMeshComponent* StaticMeshComponentTemplate = Cast<UStaticMeshComponent>(SceneComponentTemplate))
+			{
+				AddComponentTemplate(*StaticMeshComponentTemplate, ActorSpaceTransform, bIsRootComponent);
+			}
+		}
+	}
+
+	return MoveTemp(Visualization);
+}
+
 FStaticMeshInstanceVisualizationDesc FArsInstancedActorsVisualizationDesc::ToMassVisualizationDesc() const
 {
 	FStaticMeshInstanceVisualizationDesc OutMassVisualizationDesc;
@@ -206,3 +407,18 @@ void FArsInstancedActorsSoftVisualizationDesc::GetAssetsToLoad(TArray<FSoftObjec
 		}
 	}
 }
+
+FArsInstancedActorsVisualizationDesc FArsInstancedActorsSoftVisualizationDesc::ToPlaceholderVisualizationDesc(UStaticMesh& PlaceholderMesh) const
+{
+	FArsInstancedActorsVisualizationDesc PlaceholderVisualizationDesc;
+	PlaceholderVisualizationDesc.ISMComponentDescriptors.Reserve(ISMComponentDescriptors.Num());
+	for (const FSoftISMComponentDescriptor& SoftISMComponentDescriptor : ISMComponentDescriptors)
+	{
+		// Copy shared settings only, the FSoftISMComponentDescriptor conversion would sync load the assets we're avoiding waiting on
+		FISMComponentDescriptor& PlaceholderISMComponentDescriptor = PlaceholderVisualizationDesc.ISMComponentDescriptors.AddDefaulted_GetRef();
+		static_cast<FISMComponentDescriptorBase&>(PlaceholderISMComponentDescriptor) = SoftISMComponentDescriptor;
+		PlaceholderISMComponentDescriptor.StaticMesh = &PlaceholderMesh;
+		PlaceholderISMComponentDescriptor.ComputeHash();
+	}
+	return PlaceholderVisualizationDesc;
+}
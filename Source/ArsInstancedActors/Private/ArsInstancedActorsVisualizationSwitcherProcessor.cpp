@@ -6,6 +6,7 @@
 #include "ArsInstancedActorsRepresentationSubsystem.h"
 #include "MassCommonFragments.h"
 #include "MassEntityQuery.h"
+#include "MassEntityUtils.h"
 #include "MassExecutionContext.h"
 #include "MassRepresentationFragments.h"
 #include "MassRepresentationProcessor.h"
@@ -15,6 +16,7 @@
 
 UArsInstancedActorsVisualizationSwitcherProcessor::UArsInstancedActorsVisualizationSwitcherProcessor()
 	: EntityQuery(*this)
+	, PendingSwitchQuery(*this)
 {
 	bAutoRegisterWithProcessingPhases = true;
 
@@ -28,10 +30,17 @@ void UArsInstancedActorsVisualizationSwitcherProcessor::ConfigureQueries(const T
 	EntityQuery.AddRequirement<FMassRepresentationFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddSharedRequirement<FMassRepresentationSubsystemSharedFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddSubsystemRequirement<UArsInstancedActorsRepresentationSubsystem>(EMassFragmentAccess::ReadWrite);
+
+	PendingSwitchQuery.AddRequirement<FArsInstancedActorsFragment>(EMassFragmentAccess::ReadOnly);
+	PendingSwitchQuery.AddRequirement<FMassRepresentationFragment>(EMassFragmentAccess::ReadWrite);
+	PendingSwitchQuery.AddSharedRequirement<FMassRepresentationSubsystemSharedFragment>(EMassFragmentAccess::ReadWrite);
+	PendingSwitchQuery.AddSubsystemRequirement<UArsInstancedActorsRepresentationSubsystem>(EMassFragmentAccess::ReadWrite);
 }
 
 void UArsInstancedActorsVisualizationSwitcherProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
+	ExecutePendingSwitches(EntityManager, Context);
+
 	EntityQuery.ForEachEntityChunk(Context, [](FMassExecutionContext& Context)
 	{
 		UMassRepresentationSubsystem* RepresentationSubsystem = Context.GetMutableSharedFragment<FMassRepresentationSubsystemSharedFragment>().RepresentationSubsystem;
@@ -55,6 +64,58 @@ void UArsInstancedActorsVisualizationSwitcherProcessor::Execute(FMassEntityManag
 	});
 }
 
+void UArsInstancedActorsVisualizationSwitcherProcessor::ExecutePendingSwitches(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UArsInstancedActorsRepresentationSubsystem* ArsRepresentationSubsystem = UWorld::GetSubsystem<UArsInstancedActorsRepresentationSubsystem>(EntityManager.GetWorld());
+	if (ArsRepresentationSubsystem == nullptr || !ArsRepresentationSubsystem->HasPendingVisualizationSwitches())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UArsInstancedActorsVisualizationSwitcherProcessor ExecutePendingSwitches);
+
+	TArray<TPair<FMassEntityHandle, FStaticMeshInstanceVisualizationDescHandle>> PendingSwitches;
+	ArsRepresentationSubsystem->ConsumePendingVisualizationSwitches(PendingSwitches);
+
+	// Switches are sorted by new static mesh desc, so we can switch each group of entities in bulk chunk by chunk
+	TArray<FMassEntityHandle> GroupEntities;
+	TArray<FMassArchetypeEntityCollection> EntityCollections;
+	for (int32 GroupStart = 0; GroupStart < PendingSwitches.Num();)
+	{
+		const FStaticMeshInstanceVisualizationDescHandle NewStaticMeshDescHandle = PendingSwitches[GroupStart].Value;
+
+		GroupEntities.Reset();
+		int32 GroupEnd = GroupStart;
+		for (; GroupEnd < PendingSwitches.Num() && PendingSwitches[GroupEnd].Value == NewStaticMeshDescHandle; ++GroupEnd)
+		{
+			// Entities may have been destroyed since requesting the switch
+			if (EntityManager.IsEntityValid(PendingSwitches[GroupEnd].Key))
+			{
+				GroupEntities.Add(PendingSwitches[GroupEnd].Key);
+			}
+		}
+		GroupStart = GroupEnd;
+
+		EntityCollections.Reset();
+		UE::Mass::Utils::CreateEntityCollections(EntityManager, GroupEntities, FMassArchetypeEntityCollection::NoDuplicates, EntityCollections);
+		for (const FMassArchetypeEntityCollection& EntityCollection : EntityCollections)
+		{
+			PendingSwitchQuery.ForEachEntityChunk(EntityCollection, Context, [NewStaticMeshDescHandle](FMassExecutionContext& Context)
+				{
+					UMassRepresentationSubsystem* RepresentationSubsystem = Context.GetMutableSharedFragment<FMassRepresentationSubsystemSharedFragment>().RepresentationSubsystem;
+					check(RepresentationSubsystem);
+					FMassInstancedStaticMeshInfoArrayView ISMInfosView = RepresentationSubsystem->GetMutableInstancedStaticMeshInfos();
+
+					TArrayView<FMassRepresentationFragment> RepresentationFragments = Context.GetMutableFragmentView<FMassRepresentationFragment>();
+					for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
+					{
+						SwitchEntityMeshDesc(ISMInfosView, RepresentationFragments[EntityIt], Context.GetEntity(EntityIt), NewStaticMeshDescHandle);
+					}
+				});
+		}
+	}
+}
+
 void UArsInstancedActorsVisualizationSwitcherProcessor::SwitchEntityMeshDesc(FMassInstancedStaticMeshInfoArrayView& ISMInfosView, FMassRepresentationFragment& RepresentationFragment, FMassEntityHandle EntityHandle, FStaticMeshInstanceVisualizationDescHandle NewStaticMeshDescHandle)
 {
 	if (NewStaticMeshDescHandle != RepresentationFragment.StaticMeshDescHandle)
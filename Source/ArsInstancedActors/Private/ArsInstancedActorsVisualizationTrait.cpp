@@ -52,9 +52,12 @@ void UArsInstancedActorsVisualizationTrait::InitializeFromInstanceData(UArsInsta
 	
 	StaticMeshInstanceDesc = InstanceData->GetDefaultVisualizationChecked().VisualizationDesc.ToMassVisualizationDesc();
 
-	if (StaticMeshInstanceDesc.Meshes.IsEmpty())
+	// Headless servers either don't create ISMC's at all, or only collision-only ones which aren't registered with Mass, so 
+	// there's no ISMC representation to switch to
+	const AArsInstancedActorsManager& Manager = InInstanceData.GetManagerChecked();
+	if (StaticMeshInstanceDesc.Meshes.IsEmpty() || Manager.IsHeadlessServer() || !Manager.ShouldCreateISMComponents())
 	{
-		ensure(InstanceData->GetDefaultVisualizationChecked().ISMComponents.IsEmpty());
+		ensure(Manager.IsHeadlessServer() || InstanceData->GetDefaultVisualizationChecked().ISMComponents.IsEmpty());
 		Params.LODRepresentation[EMassLOD::Low] = EMassRepresentationType::None;
 
 		if (bIsClient)
@@ -86,43 +89,13 @@ void UArsInstancedActorsVisualizationTrait::BuildTemplate(FMassEntityTemplateBui
 	// we need IAs to be processed by a dedicated visualization processor, configured a bit differently than the default one.
 	BuildContext.RemoveTag<FMassVisualizationProcessorTag>();
 
-	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
-
 	BuildContext.AddFragment<FTransformFragment>();
 	BuildContext.AddFragment<FMassActorFragment>();
 
-	FArsInstancedActorsDataSharedFragment ManagerSharedFragment;
-	ManagerSharedFragment.InstanceData = InstanceData;
-	FSharedStruct SubsystemFragment = EntityManager.GetOrCreateSharedFragment(ManagerSharedFragment);
-
-	FArsInstancedActorsDataSharedFragment* AsShared = SubsystemFragment.GetPtr<FArsInstancedActorsDataSharedFragment>();
-	if (ensure(AsShared))
-	{
-		// this can happen when we unload data and then stream it back again - we end up with the same path object, but different pointer.
-		// The old instance should be garbage now
-		if (AsShared->InstanceData != InstanceData)
-		{
-			ensure(AsShared->InstanceData.IsValid() == false);
-			AsShared->InstanceData = InstanceData;
-		}
-		
-		// we also need to make sure the bulk LOD is reset since the shared fragment can survive the death of the original 
-		// InstanceData while preserving the "runtime" value, which will mess up newly spawned entities.
-		AsShared->BulkLOD = EArsInstancedActorsBulkLOD::MAX;
-
-		if (BuildContext.IsInspectingData() == false)
-		{
-			InstanceData->SetSharedInstancedActorDataStruct(SubsystemFragment);
-		}
-	}
-	// not adding SubsystemFragment do BuildContext on purpose, we temporarily use shared fragments to store IAD information.
-	// To be moved to InstancedActorSubsystem in the future
-
-	// ActorInstanceFragment will get initialized by UArsInstancedActorsInitializerProcessor
-	BuildContext.AddFragment_GetRef<FMassActorInstanceFragment>();
-
-	FArsInstancedActorsFragment& InstancedActorFragment = BuildContext.AddFragment_GetRef<FArsInstancedActorsFragment>();
-	InstancedActorFragment.InstanceData = InstanceData;
+	// ActorInstanceFragment, FArsInstancedActorsFragment and FMassRepresentationFragment::StaticMeshDescHandle will get initialized
+	// by UArsInstancedActorsInitializerProcessor, since this template is shared by all instance datas with matching settings
+	BuildContext.AddFragment<FMassActorInstanceFragment>();
+	BuildContext.AddFragment<FArsInstancedActorsFragment>();
 
 	if (BuildContext.IsInspectingData() == false)
 	{
@@ -132,8 +105,6 @@ void UArsInstancedActorsVisualizationTrait::BuildTemplate(FMassEntityTemplateBui
 			FMassRepresentationFragment* RepresentationFragment = BuildContext.GetFragment<FMassRepresentationFragment>();
 			if (ensureMsgf(RepresentationFragment, TEXT("Configuration error, we always expect to have a FMassRepresentationFragment instance at this point")))
 			{
-				RepresentationFragment->StaticMeshDescHandle = InstanceData->GetDefaultVisualizationChecked().MassStaticMeshDescHandle;
-
 				if (RepresentationFragment->LowResTemplateActorIndex == INDEX_NONE)
 				{
 					// if there's no "low res actor" we reuse the high-res one, otherwise we risk the visualization actor getting 
@@ -7,6 +7,31 @@
 #include "Engine/World.h"
 #include "MassEntitySubsystem.h"
 #include "ArsInstancedActorsSettings.h"
+#include "Components/PrimitiveComponent.h"
+
+
+namespace UE::ArsInstancedActors
+{
+	namespace CVars
+	{
+		bool bActorPooling = false;
+		FAutoConsoleVariableRef CVarActorPooling(
+			TEXT("IA.ActorPooling"),
+			bActorPooling,
+			TEXT("If enabled, hydrated actors released by Instanced Actors on servers are parked in a per-class pool, rather than destroyed, and reused ")
+			TEXT("for subsequent hydration of the same class, skipping construction scripts and component registration. Actors are reset via ")
+			TEXT("UArsInstancedActorsComponent::OnReleasedToPool and re-initialized via UArsInstancedActorsComponent::InitializeComponentForInstance, ")
+			TEXT("so only enable this once actor classes reset any per-instance state there."),
+			ECVF_Default);
+
+		int32 MaxPooledActorsPerClass = 32;
+		FAutoConsoleVariableRef CVarMaxPooledActorsPerClass(
+			TEXT("IA.ActorPooling.MaxPerClass"),
+			MaxPooledActorsPerClass,
+			TEXT("When IA.ActorPooling is enabled, the max number of actors to park per actor class. Actors released once the pool is full are destroyed."),
+			ECVF_Default);
+	} // namespace CVars
+} // namespace UE::ArsInstancedActors
 
 //-----------------------------------------------------------------------------
 // UServerArsInstancedActorsSpawnerSubsystem
@@ -26,7 +51,168 @@ bool UServerArsInstancedActorsSpawnerSubsystem::ShouldCreateSubsystem(UObject* O
 
 bool UServerArsInstancedActorsSpawnerSubsystem::ReleaseActorToPool(AActor* Actor)
 {
-	return Super::ReleaseActorToPool(Actor);
+	// Every actor released by Mass passes through here, pooled or not, so restore its instance's collision whilst Actor still
+	// knows its instance
+	if (IsValid(Actor))
+	{
+		UArsInstancedActorsData::OnInstancedActorHydrationChanged(*Actor, /*bHydrated*/false);
+	}
+
+	// Actors implementing IMassActorPoolableInterface are pooled by the base class as usual
+	if (Super::ReleaseActorToPool(Actor))
+	{
+		return true;
+	}
+
+	if (!UE::ArsInstancedActors::CVars::bActorPooling || !IsValid(Actor) || Actor->IsActorBeingDestroyed())
+	{
+		return false;
+	}
+
+	// Only pool actors we spawned for IA instances
+	TInlineComponentArray<UArsInstancedActorsComponent*> InstancedActorComponents(Actor);
+	if (InstancedActorComponents.IsEmpty())
+	{
+		return false;
+	}
+	for (const UArsInstancedActorsComponent* InstancedActorComponent : InstancedActorComponents)
+	{
+		if (!InstancedActorComponent->CanBeReleasedToPool())
+		{
+			return false;
+		}
+	}
+
+	TArray<FPooledActor>& ClassPool = ActorPool.FindOrAdd(Actor->GetClass());
+	ClassPool.RemoveAllSwap([](const FPooledActor& PooledActor) { return !PooledActor.Actor.IsValid(); }, EAllowShrinking::No);
+	if (ClassPool.Num() >= UE::ArsInstancedActors::CVars::MaxPooledActorsPerClass)
+	{
+		return false;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UServerArsInstancedActorsSpawnerSubsystem ReleaseActorToPool);
+
+	for (UArsInstancedActorsComponent* InstancedActorComponent : InstancedActorComponents)
+	{
+		InstancedActorComponent->OnReleasedToPool();
+	}
+
+	// Park the actor, saving what we disable for RetrieveActorFromPool to restore. Stopping replication closes its channels, 
+	// destroying the client copies as with a regular despawn.
+	FPooledActor& PooledActor = ClassPool.AddDefaulted_GetRef();
+	PooledActor.Actor = Actor;
+	PooledActor.bActorTickEnabled = Actor->IsActorTickEnabled();
+	PooledActor.bActorEnableCollision = Actor->GetActorEnableCollision();
+	PooledActor.bActorHiddenInGame = Actor->IsHidden();
+
+	Actor->SetReplicates(false);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	Actor->ForEachComponent(/*bIncludeFromChildActors*/false, [&PooledActor](UActorComponent* Component)
+	{
+		FPooledComponentState& ComponentState = PooledActor.ComponentStates.AddDefaulted_GetRef();
+		ComponentState.Component = Component;
+		ComponentState.bTickEnabled = Component->IsComponentTickEnabled();
+		Component->SetComponentTickEnabled(false);
+
+		if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+		{
+			ComponentState.bVisible = SceneComponent->GetVisibleFlag();
+			SceneComponent->SetVisibility(false, /*bPropagateToChildren*/false);
+		}
+
+		if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Component))
+		{
+			ComponentState.CollisionEnabled = PrimitiveComponent->GetCollisionEnabled();
+			PrimitiveComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		}
+	});
+
+	return true;
+}
+
+AActor* UServerArsInstancedActorsSpawnerSubsystem::RetrieveActorFromPool(const FMassActorSpawnRequest& SpawnRequest, const FArsInstancedActorsInstanceHandle& InstanceHandle) const
+{
+	TArray<FPooledActor>* ClassPool = ActorPool.Find(SpawnRequest.Template.Get());
+	if (ClassPool == nullptr)
+	{
+		return nullptr;
+	}
+
+	AActor* PooledActor = nullptr;
+	FPooledActor PooledActorState;
+	while (PooledActor == nullptr && !ClassPool->IsEmpty())
+	{
+		PooledActorState = ClassPool->Pop(EAllowShrinking::No);
+		PooledActor = PooledActorState.Actor.Get();
+		if (!IsValid(PooledActor) || PooledActor->IsActorBeingDestroyed())
+		{
+			PooledActor = nullptr;
+		}
+	}
+
+	if (PooledActor == nullptr)
+	{
+		return nullptr;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UServerArsInstancedActorsSpawnerSubsystem RetrieveActorFromPool);
+
+	// Pooled actors skip construction, but are 'spawned' for this instance all the same, @see OnInstancedActorComponentInitialize
+	TransientActorBeingSpawned = PooledActor;
+
+	// Fast re-init: the actor is already constructed with registered components, so we only need to move it, restore what 
+	// ReleaseActorToPool disabled and re-initialize its UArsInstancedActorsComponents for the new instance.
+	PooledActor->SetActorTransform(SpawnRequest.Transform, /*bSweep*/false, /*OutSweepHitResult*/nullptr, ETeleportType::ResetPhysics);
+	for (const FPooledComponentState& ComponentState : PooledActorState.ComponentStates)
+	{
+		UActorComponent* Component = ComponentState.Component.Get();
+		if (Component == nullptr)
+		{
+			continue;
+		}
+
+		Component->SetComponentTickEnabled(ComponentState.bTickEnabled);
+
+		if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+		{
+			SceneComponent->SetVisibility(ComponentState.bVisible, /*bPropagateToChildren*/false);
+		}
+
+		if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Component))
+		{
+			PrimitiveComponent->SetCollisionEnabled(ComponentState.CollisionEnabled);
+		}
+	}
+	PooledActor->SetActorTickEnabled(PooledActorState.bActorTickEnabled);
+	PooledActor->SetActorEnableCollision(PooledActorState.bActorEnableCollision);
+	PooledActor->SetActorHiddenInGame(PooledActorState.bActorHiddenInGame);
+
+	PooledActor->ForEachComponent<UArsInstancedActorsComponent>(/*bIncludeFromChildActors*/false, [&InstanceHandle](UArsInstancedActorsComponent* InstancedActorComponent)
+	{
+		InstancedActorComponent->InitializeComponentForInstance(InstanceHandle);
+	});
+
+	// Replicate as a new actor to clients, including the now re-initialized UArsInstancedActorsComponent::InstanceHandle
+	PooledActor->SetReplicates(true);
+
+	return PooledActor;
+}
+
+void UServerArsInstancedActorsSpawnerSubsystem::EmptyActorPool()
+{
+	for (TPair<TObjectKey<const UClass>, TArray<FPooledActor>>& ClassPool : ActorPool)
+	{
+		for (const FPooledActor& PooledActor : ClassPool.Value)
+		{
+			if (AActor* Actor = PooledActor.Actor.Get())
+			{
+				Actor->Destroy();
+			}
+		}
+	}
+	ActorPool.Empty();
 }
 
 void UServerArsInstancedActorsSpawnerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -40,6 +226,7 @@ void UServerArsInstancedActorsSpawnerSubsystem::Initialize(FSubsystemCollectionB
 
 void UServerArsInstancedActorsSpawnerSubsystem::Deinitialize()
 {
+	EmptyActorPool();
 	EntityManager.Reset();
 
 	Super::Deinitialize();
@@ -70,6 +257,17 @@ ESpawnRequestStatus UServerArsInstancedActorsSpawnerSubsystem::SpawnActor(FConst
 	InOutSpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 	// we’re going to call FinishSpawning only if the input parameters don’t indicate that the caller wants to handle it themselves.
 	const bool bCallFinishSpawning = (InOutSpawnParameters.bDeferConstruction == false);
+
+	// Reuse a pooled actor? Only possible if the caller isn't expecting to finish spawning or customize construction itself, as 
+	// pooled actors are already fully constructed.
+	if (UE::ArsInstancedActors::CVars::bActorPooling && bCallFinishSpawning && !InOutSpawnParameters.CustomPreSpawnInitalization)
+	{
+		if (AActor* PooledActor = RetrieveActorFromPool(SpawnRequest, InstanceHandle))
+		{
+			OutSpawnedActor = PooledActor;
+			return ESpawnRequestStatus::Succeeded;
+		}
+	}
 	// we always defer construction to have a chance to configure the UArsInstancedActorsComponent instances
 	// before their InitializeComponent gets called. From the callers point of view nothing changes.
 	InOutSpawnParameters.bDeferConstruction = true;
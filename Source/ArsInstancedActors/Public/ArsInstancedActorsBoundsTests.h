@@ -0,0 +1,98 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#pragma once
+
+#include "ArsMechanicaAPI.h"
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/Box.h"
+#include "Math/OrientedBox.h"
+#include "Math/Sphere.h"
+#include "Math/Transform.h"
+
+
+struct FTransformFragment;
+
+namespace UE::ArsInstancedActors::BoundsTests
+{
+/**
+ * Struct-of-arrays instance locations, for batched (SIMD) bounds tests.
+ * Typically gathered per Mass chunk from its FTransformFragment view, or from a batch of instance transforms prior to entity spawning.
+ * @see TInstanceLocationFilter
+ */
+struct ARSMECHANICA_API FLocationsSoA
+{
+	void Reset();
+	void Reserve(int32 Num);
+
+	void Add(const FVector& Location);
+
+	/** Appends Transforms' locations, growing MaxAbsScale by their scales */
+	void AddTransforms(TConstArrayView<FTransformFragment> Transforms);
+	void AddTransforms(TConstArrayView<FTransform> Transforms);
+
+	int32 Num() const { return X.Num(); }
+
+	TArray<double> X;
+	TArray<double> Y;
+	TArray<double> Z;
+
+	// Largest absolute scale component of all transforms added via AddTransforms
+	double MaxAbsScale = 0.0;
+};
+
+/** @return the number of locations in Locations inside Box expanded by Padding, appending their indices to OutIndices in order */
+ARSMECHANICA_API int32 GatherInside(const FLocationsSoA& Locations, const FBox& Box, double Padding, TArray<int32>& OutIndices);
+
+/** @return the number of locations in Locations inside Sphere expanded by Padding, appending their indices to OutIndices in order */
+ARSMECHANICA_API int32 GatherInside(const FLocationsSoA& Locations, const FSphere& Sphere, double Padding, TArray<int32>& OutIndices);
+
+/** @return the number of locations in Locations inside OrientedBox expanded by Padding, appending their indices to OutIndices in order */
+ARSMECHANICA_API int32 GatherInside(const FLocationsSoA& Locations, const FOrientedBox& OrientedBox, double Padding, TArray<int32>& OutIndices);
+
+/** @return true if Location is inside OrientedBox */
+ARSMECHANICA_API bool IsInside(const FOrientedBox& OrientedBox, const FVector& Location);
+
+/** @return true if Box is entirely inside OrientedBox */
+ARSMECHANICA_API bool IsInside(const FOrientedBox& OrientedBox, const FBox& Box);
+
+/** @return true if OrientedBox and Box may intersect, testing the box face axes of both. Conservative for some edge-on-edge cases. */
+ARSMECHANICA_API bool Intersect(const FOrientedBox& OrientedBox, const FBox& Box);
+
+/** @return the world space axis aligned box enclosing OrientedBox */
+ARSMECHANICA_API FBox GetBoundingBox(const FOrientedBox& OrientedBox);
+
+/** @return the distance from the local space origin to the furthest corner of LocalBounds, 0 if invalid */
+ARSMECHANICA_API double GetBoundsRadius(const FBox& LocalBounds);
+
+/**
+ * Narrows instances down to candidates for precise per-instance bounds tests, by batch testing their locations against QueryBounds
+ * expanded by each instance's maximum possible extent.
+ * @see AArsInstancedActorsManager::ForEachInstanceInBounds
+ */
+template <typename TBoundsType>
+struct TInstanceLocationFilter
+{
+	explicit TInstanceLocationFilter(const TBoundsType& InQueryBounds, const double InInstanceBoundsRadius = 0.0)
+		: QueryBounds(InQueryBounds)
+		, InstanceBoundsRadius(InInstanceBoundsRadius)
+	{
+	}
+
+	/**
+	 * Appends indices of Locations which may pass the bounds test to OutCandidates.
+	 * Locations are padded by InstanceBoundsRadius scaled by Locations.MaxAbsScale, so instances whose bounds may overlap QueryBounds
+	 * without their location being inside are included. An InstanceBoundsRadius of 0 tests locations alone, e.g: for enclosure tests.
+	 */
+	int32 GatherCandidates(const FLocationsSoA& Locations, TArray<int32>& OutCandidates) const
+	{
+		return GatherInside(Locations, QueryBounds, InstanceBoundsRadius * Locations.MaxAbsScale, OutCandidates);
+	}
+
+	TBoundsType QueryBounds;
+
+	// Local space bounds radius of the instances being filtered. @see GetBoundsRadius
+	double InstanceBoundsRadius = 0.0;
+};
+} // namespace UE::ArsInstancedActors::BoundsTests
@@ -48,6 +48,20 @@ public:
 	 */
 	virtual void InitializeComponentForInstance(FArsInstancedActorsInstanceHandle InInstanceHandle);
 
+	/**
+	 * Called on servers when this component's Actor is about to be parked in the IA actor pool rather than destroyed, see IA.ActorPooling.
+	 * Returning false from CanBeReleasedToPool on any of the Actor's UArsInstancedActorsComponents destroys the Actor as usual instead.
+	 */
+	virtual bool CanBeReleasedToPool() const { return true; }
+
+	/**
+	 * Called on servers when this component's Actor is parked in the IA actor pool. Override to reset any per-instance state, as the
+	 * Actor will later be reused for another instance of the same class *without* re-running construction scripts, component 
+	 * registration, InitializeComponent or BeginPlay. InitializeComponentForInstance is called again once the Actor is reused.
+	 * @see UServerArsInstancedActorsSpawnerSubsystem::ReleaseActorToPool
+	 */
+	virtual void OnReleasedToPool();
+
 	/** 
 	 * Called on an 'exemplar' Actor's components for clients & servers during UArsInstancedActorsData::CreateEntityTemplate to provide 
 	 * UArsInstancedActorsComponent's an opportunity to extend Mass entity default traits.
@@ -55,9 +69,14 @@ public:
 	 * Note: The `exemplar' actor is an actor spawned into a separate inactive UWorld by UArsInstancedActorsSubsystem::GetOrCreateExemplarActor
 	 * for data mining like this.
 	 *
+	 * Note: Entity templates are shared by all instance datas with a matching UArsInstancedActorsData::MakeSharedEntityTemplateKey, and
+	 * this is only called for the first of them. Modifications must therefore not depend on the specific InstancedActorData (e.g: its 
+	 * manager, location or per-instance-data state) beyond what the key compares: its class, ActorClass, combined tags, settings and 
+	 * default visualization. Components which do must override CanShareEntityTemplate to opt out of sharing (see IA.ShareEntityTemplates).
+	 *
 	 * @param InMassEntityManager	The MassEntityManager to use for shared fragment registration etc
-	 * @param InstancedActorData	The instance data the mass entity config will be used to spawn entities for. This component will be a default 
-	 *								constructed component in InstancedActorData.ActorClass.
+	 * @param InstancedActorData	The first instance data the mass entity config will be used to spawn entities for. This component will be a 
+	 *								default constructed component in InstancedActorData.ActorClass.
 	 * @param InOutMassEntityConfig The Mass Entity Config to modify, e.g: via InOutMassEntityConfig.AddTrait
 	 */
 	virtual void ModifyMassEntityConfig(FMassEntityManager& InMassEntityManager, UArsInstancedActorsData* InstancedActorData, FMassEntityConfig& InOutMassEntityConfig) const {}
@@ -69,13 +88,24 @@ public:
 	 * Called after ModifyMassEntityConfig, once the entity config has been resolved to a template using GetOrCreateEntityTemplate and
 	 * copied to a transient FMassEntityTemplateData (InOutMassEntityTemplateData) for further modification.
 	 *
+	 * As with ModifyMassEntityConfig, the resulting template is shared between instance datas and this is only called for the first of 
+	 * them, so modifications must not depend on the specific InstancedActorData unless CanShareEntityTemplate opts out of sharing.
+	 *
 	 * @param InMassEntityManager			The MassEntityManager to use for shared fragment registration etc
-	 * @param InstancedActorData			The instance data the mass entity config will be used to spawn entities for. This component will be a default 
+	 * @param InstancedActorData			The first instance data the mass entity config will be used to spawn entities for. This component will be a default 
 	 *        								constructed component in InstancedActorData.ActorClass.
 	 * @param InOutMassEntityTemplateData	The Mass Entity Template to modify, e.g: via InOutMassEntityTemplateData.AddFragment etc 
 	 */
 	virtual void ModifyMassEntityTemplate(FMassEntityManager& InMassEntityManager, UArsInstancedActorsData* InstancedActorData, FMassEntityTemplateData& InOutMassEntityTemplateData) const {}
 
+	/**
+	 * @return false if ModifyMassEntityConfig or ModifyMassEntityTemplate depend on the specific instance data they're called for, in which
+	 * case every instance data of this component's actor class builds its own entity template. Queried on the exemplar actor's components 
+	 * when the class's first template is built.
+	 * @see UArsInstancedActorsSubsystem::GetOrCreateSharedEntityTemplate
+	 */
+	virtual bool CanShareEntityTemplate() const { return true; }
+
 	/**
 	 * Subclasses implementing SerializeInstancePersistenceData must implement this method and return a non-zero unique uint32 used to 
 	 * match serialized persistence records with this UArsInstancedActorsComponent's SerializeInstancePersistenceData implementation.
@@ -88,11 +118,22 @@ public:
 	 */
 	virtual bool ShouldSerializeInstancePersistenceData(const FArchive& Archive, UArsInstancedActorsData* InstanceData, int64 TimeDelta) const { return false; }
 
+	/**
+	 * Opts this IAC class into incremental persistence saves. Subclasses returning true must call 
+	 * AArsInstancedActorsManager::RequestComponentPersistentDataSave (or RequestPersistentDataSave) whenever their persistence data
+	 * changes, as incremental saves skip SerializeInstancePersistenceData for IACs not marked changed since the previous save.
+	 * IACs not opting in have their persistence data written by every save, as if marked changed.
+	 */
+	virtual bool SupportsIncrementalPersistence() const { return false; }
+
 	/**
 	 * Called by AArsInstancedActorsManager::SerializeInstancePersistenceData for IAD's with an ActorClass containing this UArsInstancedActorsComponent,
 	 * to save / load extended persistence data.
 	 *
 	 * Note: This is only called if ShouldSerializeInstancePersistenceData returns true, in which case GetInstancePersistenceDataID must also return a non-zero ID.
+	 * Note: For IACs which SupportsIncrementalPersistence, incremental persistence saves only call this when saving if this IAC's data
+	 *       has been marked changed since the previous save, via AArsInstancedActorsManager::RequestComponentPersistentDataSave or
+	 *       RequestPersistentDataSave. When loading, this may be called once per saved record, with later records overwriting earlier ones.
 	 *
 	 * @param Record			The archive record to read / write IAD save data to
 	 * @param InstanceData		The InstanceData to serialize from / to
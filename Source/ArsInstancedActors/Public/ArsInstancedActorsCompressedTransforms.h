@@ -0,0 +1,99 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#pragma once
+
+#include "ArsMechanicaAPI.h"
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/BitArray.h"
+#include "Math/Transform.h"
+#include "Math/Vector.h"
+
+
+namespace UE::ArsInstancedActors
+{
+/** Maximum acceptable per-instance errors when compressing instance transforms */
+struct FTransformCompressionTolerances
+{
+	// Maximum per-axis location error, in world units
+	double MaxLocationError = 0.1;
+
+	// Maximum rotation error, in degrees
+	double MaxRotationErrorDegrees = 1.0;
+
+	// Maximum per-axis scale error
+	double MaxScaleError = 0.2;
+};
+
+/**
+ * Quantized, bit packed form of UArsInstancedActorsData::InstanceTransforms, used to reduce cooked package size and
+ * streaming I/O for large instance sets.
+ *
+ * Per valid instance, this stores:
+ * - Location: per-axis fixed point offset from the min of all instance locations, with per-axis bit depth chosen to meet
+ *   MaxLocationError.
+ * - Rotation: 'smallest three' quaternion, i.e: 2 bits for the index of the largest component, followed by the remaining
+ *   three components quantized to RotationBits each. Bit depth is the smallest meeting MaxRotationErrorDegrees.
+ * - Scale: index into a shared palette of scales, clustered within MaxScaleError. A single palette entry (i.e: uniform
+ *   scale across all instances) takes no per-instance bits.
+ *
+ * Invalid (zero scale) instances are stored as a single cleared bit in ValidInstances and restored as such in Decompress,
+ * preserving instance indexing.
+ *
+ * @see UArsInstancedActorsData::Serialize, IA.CookCompressedInstances
+ */
+struct ARSMECHANICA_API FCompressedInstanceTransforms
+{
+	/**
+	 * Compresses InstanceTransforms, replacing any previous contents.
+	 * Compression is verified by decompressing and measuring the actual error against Tolerances.
+	 * @return true on success. On failure (e.g: tolerances can't be met, or too many distinct scales), this is left empty
+	 *         and OutFailureReason describes why.
+	 */
+	bool Compress(TConstArrayView<FTransform> InstanceTransforms, const FTransformCompressionTolerances& Tolerances, FString& OutFailureReason);
+
+	/** Decompresses all instances, including invalid ones, into OutInstanceTransforms */
+	void Decompress(TArray<FTransform>& OutInstanceTransforms) const;
+
+	void Reset();
+
+	bool IsEmpty() const { return NumInstances == 0; }
+
+	/** @return the total instance count, including invalid instances */
+	int32 Num() const { return NumInstances; }
+
+	SIZE_T GetAllocatedSize() const;
+
+	friend ARSMECHANICA_API FArchive& operator<<(FArchive& Ar, FCompressedInstanceTransforms& CompressedTransforms);
+
+private:
+	FTransform DecompressInstance(int32& InOutBitOffset) const;
+
+	// Total number of instances, including invalid ones
+	int32 NumInstances = 0;
+
+	// Bit per instance, set for valid instances. Only valid instances have data in PackedInstances.
+	TBitArray<> ValidInstances;
+
+	// Min of all valid instance locations, i.e: the location quantization origin
+	FVector LocationMin = FVector::ZeroVector;
+
+	// Per-axis size of a single location quantization step
+	FVector LocationStep = FVector::ZeroVector;
+
+	// Per-axis location bit depth. 0 if all instances share the same value for that axis.
+	uint8 LocationBits[3] = { 0, 0, 0 };
+
+	// Bit depth of each of the three smallest quaternion components
+	uint8 RotationBits = 0;
+
+	// Bit depth of per-instance indices into ScalePalette. 0 if all instances share ScalePalette[0].
+	uint8 ScaleIndexBits = 0;
+
+	TArray<FVector3f> ScalePalette;
+
+	// Bit packed per valid instance location, rotation and scale index, in instance order
+	TArray<uint32> PackedInstances;
+};
+} // namespace UE::ArsInstancedActors
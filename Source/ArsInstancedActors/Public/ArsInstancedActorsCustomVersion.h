@@ -7,13 +7,42 @@
 #include "Misc/Guid.h"
 
 
-struct FArsInstancedActorsCustomVersion
+struct ARSMECHANICA_API FArsInstancedActorsCustomVersion
 {
 	enum Type
 	{
 		// Before any version changes were made in the plugin
 		InitialVersion = 0,
 
+		// UArsInstancedActorsData may store cooked InstanceTransforms in quantized form @see IA.CookCompressedInstances
+		CompressedInstanceTransforms,
+
+		// FArsInstancedActorsInstanceIndex is serialized as 32-bit, with instance persistence data recording per-IAD index width
+		// @see UArsInstancedActorsData::bWideInstanceIndices
+		WideInstanceIndices,
+
+		// Instance persistence data includes values for instance fragment types registered as Persisted
+		// @see UE::ArsInstancedActors::RegisterInstanceFragmentType
+		InstanceFragments,
+
+		// Manager persistence data is saved as a base snapshot plus appended delta records for dirty instances and IAC data only
+		// @see IA.Persistence.Incremental
+		IncrementalPersistence,
+
+		// UArsInstancedActorsData may store class settings compiled at cook time @see IA.CookBakedSettings
+		CookedSettings,
+
+		// Instance persistence data includes instances added at runtime @see UArsInstancedActorsData::AddRuntimeInstances
+		RuntimeAddedInstances,
+
+		// Manager persistence records identify IADs created at runtime, for recreation on load
+		// @see AArsInstancedActorsManager::CreateRuntimeInstanceData
+		RuntimeCreatedInstanceData,
+
+		// Manager persistence records store the composite instance index bit split, frozen at first entity spawn
+		// @see AArsInstancedActorsManager::GetCompositeInstanceIndexBits
+		PersistedCompositeInstanceIndexBits,
+
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
 		LatestVersion = VersionPlusOne - 1
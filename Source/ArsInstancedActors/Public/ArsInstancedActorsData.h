@@ -6,8 +6,12 @@
 
 #include "ArsInstancedActorsTypes.h"
 #include "ArsInstancedActorsReplication.h"
+#include "ArsInstancedActorsSpatialIndex.h"
+#include "ArsInstancedActorsCompressedTransforms.h"
 #include "MassEntityConfigAsset.h"
 #include "MassEntityTemplate.h"
+#include "StructUtils/InstancedStruct.h"
+#include "Tasks/Task.h"
 
 #include "ArsInstancedActorsData.generated.h"
 
@@ -33,8 +37,80 @@ private:
 
 	friend class ::UArsInstancedActorsSubsystem;
 };
+
+/**
+ * Entity template shared by all UArsInstancedActorsData with a matching FSharedEntityTemplateKey. Reference counted via the
+ * TSharedPtr's held by each IAD, with the template destroyed once the last IAD releases it.
+ * @see UArsInstancedActorsSubsystem::GetOrCreateSharedEntityTemplate
+ */
+struct FSharedEntityTemplate
+{
+	~FSharedEntityTemplate();
+
+	FMassEntityTemplateID TemplateID;
+
+private:
+	FSharedEntityTemplate(const FSharedEntityTemplateKey& InKey, UArsInstancedActorsSubsystem* InInstancedActorSubsystem);
+
+	FSharedEntityTemplateKey Key;
+
+	// Config the template was built from, kept alive for DestroyEntityTemplate. Traits are referenced by UArsInstancedActorsSubsystem::AddReferencedObjects
+	FMassEntityConfig EntityConfig;
+
+	// Weak as the last IAD may release this after the subsystem and its world are torn down, in which case there's nothing left to clean up
+	TWeakObjectPtr<UArsInstancedActorsSubsystem> ArsInstancedActorsSubsystem;
+
+	friend class ::UArsInstancedActorsSubsystem;
+};
+
+/**
+ * Per-entity spawn data for a UArsInstancedActorsData, prepared off the game thread by UArsInstancedActorsData::BeginPrepareSpawnEntities
+ * and consumed by UArsInstancedActorsInitializerProcessor when spawning entities.
+ */
+struct FSpawnEntitiesPreparation
+{
+	void Reset()
+	{
+		WorldTransforms.Empty();
+		InstanceIndices.Empty();
+		DestroyedInstances.Empty();
+	}
+
+	// World space transform for each entity to spawn, matching InstanceIndices
+	TArray<FTransform> WorldTransforms;
+
+	// Instance index for each entity to spawn, in ascending order
+	TArray<FArsInstancedActorsInstanceIndex> InstanceIndices;
+
+	// Valid instances skipped due to persisted destroyed deltas, to be invalidated before spawning
+	TArray<FArsInstancedActorsInstanceIndex> DestroyedInstances;
+};
 } // UE::ArsInstancedActors
 
+/**
+ * Identity of a UArsInstancedActorsData created at runtime by AArsInstancedActorsManager::CreateRuntimeInstanceData, replicated
+ * for clients to register it with their manager, as it isn't present in their cooked data.
+ */
+USTRUCT()
+struct FArsInstancedActorsRuntimeInstanceDataDesc
+{
+	GENERATED_BODY()
+
+	bool IsSet() const { return ActorClass != nullptr; }
+
+	UPROPERTY()
+	TSubclassOf<AActor> ActorClass;
+
+	UPROPERTY()
+	FGameplayTagContainer AdditionalTags;
+
+	UPROPERTY()
+	uint16 ID = 0;
+
+	UPROPERTY()
+	bool bWideInstanceIndices = false;
+};
+
 // @todo there's a lot of public variables in this class, and properties are mixed with functions. A refactor is coming soon.
 
 /**
@@ -54,7 +130,17 @@ public:
 	// Called early in AArsInstancedActorsManager::InitializeModifyAndSpawnEntities to intitalize Settings, default visualization & Mass entity template
 	void Initialize();
 
-	// Called in AArsInstancedActorsManager::InitializeModifyAndSpawnEntities to spawn Mass entities for each instance
+	// Launches a task preparing per-entity spawn data (transform filtering, world space transforms, persisted destroyed
+	// instance filtering) for a subsequent SpawnEntities. Must be called after Initialize and any pre-spawn modifiers.
+	// Runtime changes to InstanceTransforms before SpawnEntities will cancel the preparation.
+	// @see AArsInstancedActorsManager::InitializeModifyAndPrepareSpawnEntities
+	void BeginPrepareSpawnEntities();
+
+	// Returns true if there's no spawn preparation task in flight
+	bool IsSpawnEntitiesPreparationComplete() const;
+
+	// Called in AArsInstancedActorsManager::InitializeModifyAndSpawnEntities to spawn Mass entities for each instance.
+	// Uses data prepared by BeginPrepareSpawnEntities, waiting on it if required, else prepares spawn data inline.
 	void SpawnEntities();
 
 	// Called early in AArsInstancedActorsManager::EndPlay to reconstruct cooked data state from runtime Mass entities as best we can,
@@ -99,6 +185,16 @@ public:
 	UPROPERTY(VisibleAnywhere, Category=ArsInstancedActors)
 	TSubclassOf<AActor> ActorClass;
 
+	// If true, this IAD can hold up to FArsInstancedActorsInstanceIndex::MaxWideIndex instances, with instance indices persisted
+	// as 32-bit values. Otherwise instances are limited to FArsInstancedActorsInstanceIndex::MaxNarrowIndex, with 16-bit persisted
+	// indices, and further instances of the same type are placed into additional IADs.
+	// Initialized from UArsInstancedActorsProjectSettings::bWideInstanceIndicesByDefault in CreateNextInstanceActorData
+	UPROPERTY(EditAnywhere, Category=ArsInstancedActors)
+	bool bWideInstanceIndices = false;
+
+	// Returns the maximum instance count for this IAD, as determined by bWideInstanceIndices
+	int32 GetMaxNumInstances() const;
+
 	const FArsInstancedActorsTagSet& GetAdditionalTags() const
 	{
 		return AdditionalTags;
@@ -159,7 +255,7 @@ public:
 	// @todo Bundle this and InstanceTransforms, Bounds etc into a `SourceData` to separate them from runtime entity data
 	// @see InstanceTransforms
 	UPROPERTY()
-	uint16 NumValidInstances = 0;
+	int32 NumValidInstances = 0;
 
 	// Cumulative mesh bounds for all of InstanceTransfroms
 	UPROPERTY()
@@ -168,7 +264,7 @@ public:
 	// InstanceTransforms.Num() cached in PostLoad so we can restore InstanceTransforms to this
 	// size in ResetInstanceData
 	UPROPERTY(Transient)
-	uint16 NumInstances = 0;
+	int32 NumInstances = 0;
 
 	// Runtime spawned mass instances
 	// @see AArsInstancedActorsManager::SpawnInstances
@@ -200,11 +296,30 @@ public:
 	// Returns true if InstanceHandle refers to this instance data and we have current information for an
 	// instance at InstanceHandle.InstanceIndex
 	bool IsValidInstance(const FArsInstancedActorsInstanceHandle& InstanceHandle) const;
+
+	// Retrieves the current world space location of InstanceIndex, from its spawned entity if any or instance transforms otherwise.
+	// @return false if InstanceIndex is invalid or its location couldn't be determined
+	bool GetInstanceLocation(const FArsInstancedActorsInstanceIndex InstanceIndex, FVector& OutLocation) const;
+
+	// Notifies that InstanceIndex's spawned entity FTransformFragment has been modified at runtime, so DespawnEntities
+	// should read it back rather than restoring the instance's RetainedInstanceTransforms entry. Also stops spatial index
+	// use for this IAD until DespawnEntities, as its indexed locations no longer hold. @see GetOrBuildSpatialIndex
+	// Note: FTransformFragment writes aren't tracked automatically. Instances are assumed stationary, as per their stationary
+	//       Mass representation, so code occasionally moving them must call this. Classes whose instances are moved routinely
+	//       should instead set FArsInstancedActorsSettings::bMovableInstances. @see IA.RetainInstanceTransforms
+	void MarkInstanceTransformDirty(const FArsInstancedActorsInstanceIndex InstanceIndex);
+
+	// Returns true if FArsInstancedActorsSettings::bMovableInstances declares this IAD's instances may be moved at runtime
+	// without MarkInstanceTransformDirty, in which case their spawn transforms can't be relied upon.
+	bool AreInstancesMovable() const;
 	
 	// Performs setup after all Instances have been loaded. Canonically called from PostLoad(), but may need to be called manually
 	// if this UArsInstancedActorsData is created at cook/runtime
 	void SetupLoadedInstances();
 
+	// Returns true if there's room for another instance, either in a free / invalid slot or within GetMaxNumInstances()
+	bool CanAddInstance() const;
+
 #if WITH_EDITOR
 	// Add's an instance of this actor type at Transform
 	// @see AArsInstancedActorsManager::AddActorInstance
@@ -230,6 +345,19 @@ public:
 	void ForEachEditorPreviewISMC(TFunctionRef<bool(UInstancedStaticMeshComponent& /*ISMComponent*/)> InFunction) const;
 #endif
 
+	// Authority: Adds instances at Transforms at runtime, e.g: for player built or regrown content, appending them with new
+	// instance indices after any cooked instances. Prior to entity spawning these simply extend InstanceTransforms, after which
+	// their Mass entities are batch spawned immediately.
+	// Additions are recorded in InstanceDeltas, replicating them to clients and persisting them like any other instance delta.
+	// @param bWorldSpace If true, Transforms are in world space, otherwise relative to the manager
+	// @return Handles to the added instances. Fewer than Transforms.Num() are returned if this IAD runs out of addressable
+	//		   instance indices @see GetNumAddableRuntimeInstances
+	TArray<FArsInstancedActorsInstanceHandle> AddRuntimeInstances(TConstArrayView<FTransform> Transforms, bool bWorldSpace = true);
+
+	// Returns how many more instances can be added via AddRuntimeInstances, limited by GetMaxNumInstances and, once frozen
+	// at first entity spawn, the manager's composite instance index width @see AArsInstancedActorsManager::GetCompositeInstanceIndexBits
+	int32 GetNumAddableRuntimeInstances() const;
+
 	// Removes RuntimeRemoveInstances as if they were never present i.e: these removals are not persisted as
 	// if made by a player.
 	// Prior to entity spawning this simply invalidates InstanceTransforms entries, post entity spawning this
@@ -312,11 +440,17 @@ public:
 	uint8 AddVisualization(FArsInstancedActorsVisualizationDesc& InOutVisualizationDesc);
 
 	// Register additional / alternate VisualizationDesc for instances to switch to, creating ISMC's
-	// for each VisualizationDesc.InstancedMeshes
+	// for each VisualizationDesc.InstancedMeshes once it's assets are loaded. Loads are scheduled by
+	// UArsInstancedActorsSubsystem::RequestVisualizationLoad, rendering placeholder ISMCs until complete
+	// if UArsInstancedActorsProjectSettings::VisualizationLoadPlaceholderMesh is set. Placeholder ISMCs have no collision.
 	// @warning No more than 254 visualizations may be registered at any time to allow for uint8 indexing.
 	// @return Index handle to refer to the registered visualization
 	uint8 AddVisualizationAsync(const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc);
 
+	// Completes initialization of VisualizationIndex, reserved by AddVisualizationAsync, once SoftVisualizationDesc's assets are loaded.
+	// Called by UArsInstancedActorsSubsystem for requests added via RequestVisualizationLoad.
+	void OnVisualizationAssetsLoaded(uint8 VisualizationIndex, const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc);
+
 	// Iterates all currently 'allocated' visualizations previously added with AddVisualization or AddVisualizationAsync
 	// @param InFunction						The function to call for each allocated visualization.
 	// @param bSkipAsyncLoadingVisualizations	If true, skips visualizations that are still async loading
@@ -330,18 +464,31 @@ public:
 	// AddVisualzation. ISMC instances will be removed from the current /former visualization for these instances
 	// and new instances will be added to the ISMC's of the new visualization.
 	//
-	// Note: This is performed via a mass deferred command to add a 'pending' FArsInstancedActorsMeshSwitchFragment
-	// to the instances entity. UArsInstancedActorsVisualizationSwitcherProcessor will then process this switch
-	// fragment to remove the current visualization's ISMC instances if any and setup NewVisualizationIndex
-	// to be instanced instead.
+	// Note: With IA.Visualizations.BatchSwitches (default), switches are queued with UArsInstancedActorsRepresentationSubsystem
+	// and applied in bulk, grouped by new visualization, by the next UArsInstancedActorsVisualizationSwitcherProcessor execution.
+	// Repeated switches of the same instance before then are coalesced. Otherwise, this is performed via a mass deferred command
+	// to add a 'pending' FArsInstancedActorsMeshSwitchFragment to the instances entity, for the same processor to apply.
 	void SwitchInstanceVisualization(FArsInstancedActorsInstanceIndex InstanceToSwitch, uint8 NewVisualizationIndex);
 
-	// Remove previously registered instance visualization, deleting all ISMC's
+	// Batch version of SwitchInstanceVisualization, switching all InstancesToSwitch to NewVisualizationIndex
+	void SwitchInstanceVisualizations(TConstArrayView<FArsInstancedActorsInstanceIndex> InstancesToSwitch, uint8 NewVisualizationIndex);
+
+	// Remove previously registered instance visualization. With IA.Visualizations.PoolReleaseDelay > 0, initialized visualizations
+	// are pooled rather than deleting their ISMC's right away, for subsequent AddVisualization calls with a matching description to 
+	// reuse. Pooled visualizations are released by UArsInstancedActorsSubsystem once the delay has passed.
 	void RemoveVisualization(uint8 VisualizationIndex);
 
-	// Remove all previously registered instance visualization, deleting all ISMC's
+	// Remove all previously registered instance visualization, including pooled visualizations, deleting all ISMC's
 	void RemoveAllVisualizations();
 
+	// Releases visualizations pooled by RemoveVisualization whose pool delay has expired by CurrentTime, deleting their ISMC's.
+	// Called by UArsInstancedActorsSubsystem::Tick.
+	// @return true if any pooled visualizations remain
+	bool ReleaseExpiredPooledVisualizations(double CurrentTime);
+
+	// Returns the number of visualizations currently pooled by RemoveVisualization
+	int32 GetNumPooledVisualizations() const { return PooledVisualizations.Num(); }
+
 	// Called by UArsInstancedActorsRepresentationActorManagement when a managed actor is destroyed
 	void OnInstancedActorDestroyed(AActor& DestroyedActor, const FMassEntityHandle EntityHandle);
 
@@ -349,6 +496,15 @@ public:
 	// @return true if MovedActor was ejected
 	bool OnInstancedActorMoved(AActor& MovedActor, const FMassEntityHandle EntityHandle);
 
+	// Called on servers when EntityHandle's actor is hydrated or released. As hydrated actors provide their own collision,
+	// headless server collision-only ISMC instances are zero scaled whilst hydrated, removing their instance bodies, and
+	// restored from the entity's transform once released, as Mass representation does for rendered ISMCs.
+	// @see HasCollisionOnlyISMComponents
+	void OnInstancedActorHydrationChanged(const FMassEntityHandle EntityHandle, bool bHydrated);
+
+	// OnInstancedActorHydrationChanged for Actor's instance, if Actor was spawned by Instanced Actors
+	static void OnInstancedActorHydrationChanged(const AActor& Actor, bool bHydrated);
+
 	// Called when persistent data has been applied / restored
 	void OnPersistentDataRestored();
 
@@ -362,6 +518,9 @@ public:
 	// Called by FArsInstancedActorsDeltaList::PreReplicatedRemove on InstanceDelta removal replication (just before the actual array element removal)
 	void OnRep_PreRemoveInstanceDeltas(TConstArrayView<int32> RemovedInstanceDeltaIndices);
 
+	// @return true if this IAD was created at runtime by AArsInstancedActorsManager::CreateRuntimeInstanceData, rather than cooked
+	bool IsRuntimeCreated() const { return RuntimeCreationDesc.IsSet(); }
+
 	// Called on both server and client to apply instance delta changes to mass entities
 	// On servers: Called by OnPersistentDataRestored after persistence record has deserialized the delta data
 	// On clients: Called by OnRep_InstanceDeltas when new delta data has replicated from the server
@@ -396,10 +555,27 @@ public:
 	// @todo Provide generic fragment persistence & replication
 	void RemoveInstanceLifecyclePhaseTimeElapsedDelta(FArsInstancedActorsInstanceIndex InstanceIndex);
 
+	// Server-only. Sets InstanceIndex's value for Fragment's type, which must have been registered via 
+	// UE::ArsInstancedActors::RegisterInstanceFragmentType. The value is applied to the instance's entity (if spawned, or otherwise 
+	// once spawned) and stored in InstanceDeltas to be replicated and / or persisted according to the type's EArsInstancedActorsFragmentFlags.
+	void SetInstanceFragment(FArsInstancedActorsInstanceIndex InstanceIndex, FConstStructView Fragment);
+
+	// Server-only. Removes InstanceIndex's FragmentType value from InstanceDeltas, such that it's no longer replicated or persisted. 
+	// Note: The value last applied to the instance's entity is left as is.
+	void RemoveInstanceFragment(FArsInstancedActorsInstanceIndex InstanceIndex, const UScriptStruct& FragmentType);
+
 	int32 GetInstanceDataID() const { return (int32)ID; }
 
 	const FBox& GetCachedLocalBounds() const { return CachedLocalBounds; }
 
+	// Returns the spatial index of this IAD's instances, lazily building it from InstanceTransforms if required.
+	// Returns nullptr if spatial indexing is disabled (IA.SpatialIndex.Enable), there are too few instances to benefit
+	// (IA.SpatialIndex.MinInstances), entities have already been spawned without the index having been built, instances
+	// have been moved since (@see MarkInstanceTransformDirty) or may be moved at any time (@see AreInstancesMovable).
+	// Note: Indexed locations are as of SpawnEntities, so this relies on instances being stationary unless reported moved.
+	// @see AArsInstancedActorsManager::ForEachCandidateInstance
+	const UE::ArsInstancedActors::FInstanceSpatialIndex* GetOrBuildSpatialIndex() const;
+
 	FMassEntityHandle GetEntityHandleForIndex(const FArsInstancedActorsInstanceIndex Index) const
 	{
 		return Entities.IsValidIndex(Index.GetIndex()) ? Entities[Index.GetIndex()] : FMassEntityHandle();
@@ -420,6 +596,7 @@ protected:
 	//~ Begin UObject Overrides
 	virtual void PostDuplicate(EDuplicateMode::Type DuplicateMode) override;
 	virtual void PostLoad() override;
+	virtual void Serialize(FArchive& Ar) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 #if UE_WITH_IRIS
 	virtual void RegisterReplicationFragments(UE::Net::FFragmentRegistrationContext& Context, UE::Net::EFragmentRegistrationFlags RegistrationFlags) override;
@@ -427,13 +604,43 @@ protected:
 	virtual bool IsNameStableForNetworking() const override { return true; }
 	//~ End UObject Overrides
 
-	// Called on BeginPlay to create default entity template
-	void CreateEntityTemplate(const AActor& ExemplarActor);
+	// Called on BeginPlay to get or create the default entity template, shared with other IADs where possible 
+	// @see UArsInstancedActorsSubsystem::GetOrCreateSharedEntityTemplate
+	// Note: Only requires an exemplar actor if a new template needs building, which is spawned on demand if Initialize didn't already.
+	void CreateEntityTemplate();
+
+	// Builds a new entity template from InOutEntityConfig, called by UArsInstancedActorsSubsystem::GetOrCreateSharedEntityTemplate
+	// for the first IAD requesting a given FSharedEntityTemplateKey.
+	// Note: As the resulting template is shared, this and ModifyEntityTemplate must not add per-IAD data. Per-IAD entity data is 
+	// instead set by UArsInstancedActorsInitializerProcessor.
+	FMassEntityTemplateID BuildEntityTemplate(const AActor& ExemplarActor, FMassEntityConfig& InOutEntityConfig);
 	virtual void ModifyEntityTemplate(FMassEntityTemplateData& ModifiedTemplate, const AActor& ExemplarActor);
 
-	// Called from Deinitialize to destroy the owned FMassEntityTemplate  
+	// Returns the exemplar actor if held, or ActorClass's default object when using IA.ExemplarActors.UseClassDefaults, for 
+	// UArsInstancedActorsSubsystem::ModifyVisualDescriptionForActor
+	AActor* GetExemplarOrClassDefaultActor() const;
+
+	// Returns the key identifying IADs which can share this IAD's entity template
+	virtual UE::ArsInstancedActors::FSharedEntityTemplateKey MakeSharedEntityTemplateKey() const;
+
+	// Gets or creates the FArsInstancedActorsDataSharedFragment pointing back to this IAD, used for bulk LOD
+	void CreateSharedInstancedActorDataStruct();
+
+	// Called from Deinitialize to release this IAD's reference to SharedEntityTemplate
 	void ReleaseEntityTemplate();
 
+	// Instantiates runtime added instances at manager-relative LocalTransforms: prior to entity spawning by extending
+	// InstanceTransforms, after by batch spawning their entities. Instances already instantiated are skipped.
+	// Called by AddRuntimeInstances on authority, ApplyInstanceDeltas for replicated additions on clients and when restoring
+	// persisted additions. @see FArsInstancedActorsDelta::IsAdded
+	void InstantiateAddedInstances(TConstArrayView<FArsInstancedActorsInstanceIndex> InstanceIndices, TConstArrayView<FTransform> LocalTransforms);
+
+	// Returns the instance index the next runtime added instance will be assigned
+	int32 GetNextRuntimeInstanceIndex() const;
+
+	// Gathers added instance deltas from Deltas and passes them to InstantiateAddedInstances
+	void InstantiateAddedInstanceDeltas(TConstArrayView<FArsInstancedActorsDelta> Deltas);
+
 	// Helper function used in ApplyInstanceDeltas to apply a single delta
 	// @see ApplyInstanceDeltas
 	virtual void ApplyInstanceDelta(FMassEntityManager& EntityManager, const FArsInstancedActorsDelta& InstanceDelta, TArray<FArsInstancedActorsInstanceIndex>& OutEntitiesToRemove);
@@ -477,16 +684,49 @@ protected:
 	// Note: TSparseArray can't be used directly here as it's not a UPROPERTY type.
 	TBitArray<> InstanceVisualizationAllocationFlags;
 
-	// Adds or reuses a previously removed entry in InstanceVisualizations
+	// Adds or reuses a previously removed entry in InstanceVisualizations. Pooled entries are skipped unless InstanceVisualizations
+	// is full, in which case the longest pooled entry is released for reuse.
 	// @return The 'visualization index` of the new or reused entry in InstanceVisualizations
 	// @see AddVisualization, AddVisualizationAsync
 	uint8 AllocateVisualization();
 
+	// Returns the index of a pooled visualization matching VisualizationDesc, or INDEX_NONE if none
+	int32 FindPooledVisualization(const FArsInstancedActorsVisualizationDesc& VisualizationDesc) const;
+
+	// Deregisters VisualizationIndex's ISMCs from Mass and destroys them, freeing the entry for reuse
+	void ReleaseVisualization(uint8 VisualizationIndex);
+
+	// Visualizations removed via RemoveVisualization, pending release at the paired world time, in removal order
+	TArray<TPair<uint8, double>> PooledVisualizations;
+
 	// Creates ISMCs for VisualizationDesc.InstancedMeshes, registers them with Mass and sets
 	// FArsInstancedActorsVisualizationInfo::MassStaticMeshDescIndex with the newly registed ISMC decription index
 	// @see AddVisualization, AddVisualizationAsync
 	void InitializeVisualization(uint8 AllocatedVisualizationIndex, const FArsInstancedActorsVisualizationDesc& VisualizationDesc);
 
+	// Swaps VisualizationIndex's placeholder ISMC meshes and materials for VisualizationDesc's in place, enabling their collision,
+	// and re-registers the ISMCs with Mass under VisualizationDesc. @see AddVisualizationAsync, OnVisualizationAssetsLoaded
+	void ApplyLoadedVisualization(uint8 VisualizationIndex, const FArsInstancedActorsVisualizationDesc& VisualizationDesc);
+
+	// Returns true if the default visualization's ISMCs are collision-only, i.e: created on a headless server, where they aren't
+	// registered with Mass representation and instead hold one instance per instance index, maintained directly.
+	// @see AArsInstancedActorsManager::IsHeadlessServer
+	bool HasCollisionOnlyISMComponents() const;
+
+	// Seeds collision-only ISMC instances from LocalTransforms, indexed by instance index. Empty ISMCs are filled with a single
+	// AddInstances call, whilst ISMCs already holding instances only update those whose transform differs. Invalid (zero scaled)
+	// transforms are kept as placeholders to preserve indexing, without instance bodies, and trailing ones are skipped entirely.
+	void SeedCollisionOnlyInstances(TConstArrayView<FTransform> LocalTransforms);
+
+	// Removes all collision-only ISMC instances
+	void ClearCollisionOnlyInstances();
+
+	// Updates collision-only ISMC instances at InstanceIndices to LocalTransforms, growing the ISMCs as required
+	void UpdateCollisionOnlyInstances(TConstArrayView<FArsInstancedActorsInstanceIndex> InstanceIndices, TConstArrayView<FTransform> LocalTransforms);
+
+	// Zero scales collision-only ISMC instances at InstanceIndices, removing their instance bodies
+	void RemoveCollisionOnlyInstances(TConstArrayView<FArsInstancedActorsInstanceIndex> InstanceIndices);
+
 #if WITH_EDITORONLY_DATA
 	// ISMCs created in GetOrCreateActorInstanceData to match default visualizations ISMComponents for editor only preview of instances
 	UPROPERTY()
@@ -506,8 +746,34 @@ private:
 	UPROPERTY(Replicated, SaveGame, Transient)
 	FArsInstancedActorsDeltaList InstanceDeltas;
 
-	UPROPERTY(Transient)
-	FMassEntityConfig EntityConfig;
+	// Set by AArsInstancedActorsManager::CreateRuntimeInstanceData on IADs created at runtime, replicating their identity for
+	// OnRep_RuntimeCreationDesc to register them with the client's manager. Left unset for cooked IADs, so never sent for them.
+	UPROPERTY(ReplicatedUsing=OnRep_RuntimeCreationDesc, Transient)
+	FArsInstancedActorsRuntimeInstanceDataDesc RuntimeCreationDesc;
+
+	UFUNCTION()
+	void OnRep_RuntimeCreationDesc();
+
+	// InstanceTransforms retained by SpawnEntities with IA.RetainInstanceTransforms, unless AreInstancesMovable, left unmodified
+	// whilst entities are spawned.
+	// DespawnEntities restores InstanceTransforms from this, only applying runtime changes: removed entities and 
+	// DirtyInstanceTransforms.
+	TArray<FTransform> RetainedInstanceTransforms;
+
+	// One past the largest runtime added instance index instantiated since the last DespawnEntities. Runtime added
+	// instances aren't part of the cooked NumInstances, and may not be present in InstanceTransforms or Entities if 
+	// destroyed before entity spawning. @see GetNextRuntimeInstanceIndex
+	int32 NumAddedInstanceSlots = 0;
+
+	// Sparse set of instance indices whose entity transforms have changed since SpawnEntities
+	// @see MarkInstanceTransformDirty
+	TSet<int32> DirtyInstanceTransforms;
+
+	// Set by MarkInstanceTransformDirty once any instance has moved since SpawnEntities, invalidating SpatialIndex locations
+	bool bHasMovedInstances = false;
+
+	// Entity template shared with other IADs with matching FSharedEntityTemplateKey. @see CreateEntityTemplate
+	TSharedPtr<UE::ArsInstancedActors::FSharedEntityTemplate> SharedEntityTemplate;
 
 	// Result of combining AdditionalTags with class-based FArsInstancedActorsSettings::GameplayTags
 	UPROPERTY(Transient)
@@ -528,6 +794,38 @@ private:
 		TWeakObjectPtr<AActor> Actor;
 	};
 	TArray<FSetReplicatedActorRequests> CachedSetReplicatedActorRequests;
+
+	// Quantized InstanceTransforms, present only for data cooked with IA.CookCompressedInstances. InstanceTransforms is
+	// left empty in this case until decompressed in Initialize.
+	// @see Serialize, DecompressInstanceTransforms
+	UE::ArsInstancedActors::FCompressedInstanceTransforms CompressedInstanceTransforms;
+
+	// Decompresses CompressedInstanceTransforms (if any) into InstanceTransforms, freeing CompressedInstanceTransforms
+	void DecompressInstanceTransforms();
+
+	// ActorClass settings compiled at cook time, present only for data cooked with IA.CookBakedSettings. Used in Initialize to seed
+	// UArsInstancedActorsSubsystem's per-class settings cache instead of compiling them from the settings Data Registries, then freed.
+	// @see Serialize, UArsInstancedActorsSubsystem::GetOrAddCookedSettingsForActorClass
+	FInstancedStruct CookedSettings;
+
+#if WITH_EDITOR
+	// Compresses InstanceTransforms into CompressedInstanceTransforms for cooking, using IA.Compressed*Error tolerances
+	// @return false if InstanceTransforms can't be compressed within tolerances, in which case they'll be cooked as-is
+	bool CompressInstanceTransformsForCook();
+#endif
+
+	// Waits for and discards any in-flight or completed spawn preparation
+	void CancelSpawnEntitiesPreparation();
+
+	// Spawn data prepared by SpawnPreparationTask, or inline in SpawnEntities
+	UE::ArsInstancedActors::FSpawnEntitiesPreparation SpawnPreparation;
+
+	// Task populating SpawnPreparation, launched in BeginPrepareSpawnEntities
+	UE::Tasks::FTask SpawnPreparationTask;
+
+	// Spatial index of instances for bounded queries. Built lazily in GetOrBuildSpatialIndex or latest in SpawnEntities,
+	// before InstanceTransforms are released, and reset in DespawnEntities.
+	mutable UE::ArsInstancedActors::FInstanceSpatialIndex SpatialIndex;
 };
 
 //-----------------------------------------------------------------------------
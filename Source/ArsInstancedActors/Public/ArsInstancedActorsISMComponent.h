@@ -0,0 +1,61 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#pragma once
+
+#include "ArsMechanicaAPI.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "ArsInstancedActorsISMComponent.generated.h"
+
+
+/**
+ * Instanced static mesh component created by AArsInstancedActorsManager::CreateISMComponents, supporting physics state
+ * creation with instance bodies created incrementally, so large components can be time-sliced across frames.
+ * @see UArsInstancedActorsSubsystem::ExecutePendingPhysicsStateCreations
+ */
+UCLASS(MinimalAPI, ClassGroup=Rendering, NotBlueprintable)
+class ARSMECHANICA_API UArsInstancedActorsISMComponent : public UInstancedStaticMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Creates physics state without any instance bodies, leaving them pending creation by CreatePendingInstanceBodies.
+	 * Does nothing if physics state is already created.
+	 */
+	void CreatePhysicsStateWithPendingInstanceBodies();
+
+	/**
+	 * Creates up to MaxBodies pending instance bodies, in instance order. For non-movable components, the created bodies are
+	 * added to the physics scene together in a single batch.
+	 * @return the number of instance bodies created
+	 */
+	int32 CreatePendingInstanceBodies(int32 MaxBodies = MAX_int32);
+
+	/** @return true if physics state has been created but some instance bodies are still pending CreatePendingInstanceBodies */
+	bool HasPendingInstanceBodies() const { return bHasPendingInstanceBodies; }
+
+	//~ Begin UPrimitiveComponent Overrides
+	virtual UBodySetup* GetBodySetup() override;
+	//~ End UPrimitiveComponent Overrides
+
+protected:
+
+	//~ Begin UActorComponent Overrides
+	virtual void OnDestroyPhysicsState() override;
+	//~ End UActorComponent Overrides
+
+	/** @return the first instance index >= StartIndex which should have, but is missing, an instance body. INDEX_NONE if none */
+	int32 FindMissingInstanceBody(int32 StartIndex) const;
+
+private:
+
+	// Next instance index to consider in CreatePendingInstanceBodies
+	int32 NextPendingInstanceBodyIndex = 0;
+
+	bool bHasPendingInstanceBodies = false;
+
+	// Set whilst creating physics state in CreatePhysicsStateWithPendingInstanceBodies, so no instance bodies are created
+	bool bSuppressBodySetup = false;
+};
@@ -14,28 +14,53 @@ class UArsInstancedActorsData;
 class AArsInstancedActorsManager;
 struct FArsInstancedActorsIterationContext;
 
-/** This type is only valid to be used with the instance of UArsInstancedActorsData it applies to. */
+/** 
+ * This type is only valid to be used with the instance of UArsInstancedActorsData it applies to. 
+ *
+ * Indices are stored as 32-bit values. UArsInstancedActorsData with bWideInstanceIndices = false are limited to MaxNarrowIndex 
+ * instances, allowing their indices to be persisted as 16-bit values. @see UArsInstancedActorsData::bWideInstanceIndices
+ */
 USTRUCT()
 struct FArsInstancedActorsInstanceIndex
 {
 	GENERATED_BODY()
 	
+	// Largest index addressable by 16-bit 'narrow' instance indices (MAX_uint16 is reserved for INDEX_NONE)
+	static constexpr int32 MaxNarrowIndex = MAX_uint16 - 1;
+
+	// Largest index addressable by 32-bit 'wide' instance indices, leaving room for instance data IDs in composite indices
+	static constexpr int32 MaxWideIndex = (1 << 24) - 1;
+
+	// Instance index bit count for composite indices, for managers whose instance datas are all within MaxNarrowIndex
+	static constexpr int32 DefaultCompositeInstanceIndexBits = 16;
+
+	// Number of instance data IDs addressable by composite indices alongside MaxWideIndex instance indices
+	static constexpr int32 MaxWideInstanceDataIDs = int32((uint64(1) << 32) / (uint64(MaxWideIndex) + 1));
+
 	FArsInstancedActorsInstanceIndex() = default;
-	explicit FArsInstancedActorsInstanceIndex(const int32 InIndex) : Index((uint16)InIndex) 
+	explicit FArsInstancedActorsInstanceIndex(const int32 InIndex) : Index(InIndex) 
 	{ 
-		check((InIndex >= INDEX_NONE) && (InIndex < (MAX_uint16 - 1))); // -1 for INDEX_NONE
+		check((InIndex >= INDEX_NONE) && (InIndex <= MaxWideIndex));
 	}
 
-	friend FArchive& operator<<(FArchive& Ar, FArsInstancedActorsInstanceIndex& InstanceIndex)
-	{
-		Ar << InstanceIndex.Index;
-		return Ar;
-	}
+	friend ARSMECHANICA_API FArchive& operator<<(FArchive& Ar, FArsInstancedActorsInstanceIndex& InstanceIndex);
+	friend ARSMECHANICA_API void operator<<(FStructuredArchive::FSlot Slot, FArsInstancedActorsInstanceIndex& InstanceIndex);
 
-	friend void operator<<(FStructuredArchive::FSlot Slot, FArsInstancedActorsInstanceIndex& InstanceIndex)
-	{
-		Slot << InstanceIndex.Index;
-	}
+	/** 
+	 * Serializes InstanceIndex as a 16-bit value if bWide = false, else as a 32-bit value. 
+	 * Used for persistence where the width is known up-front. @see AArsInstancedActorsManager::SerializeInstancePersistenceData
+	 */
+	static ARSMECHANICA_API void SerializeWithWidth(FStructuredArchive::FSlot Slot, FArsInstancedActorsInstanceIndex& InstanceIndex, const bool bWide);
+
+	/** 
+	 * Replicates Index as a packed integer, costing no more than the previous fixed 16-bit representation for typical instance counts.
+	 * Note: There's no Iris NetSerializer for this type, so Iris falls back to it's last resort serializer wrapping NetSerialize.
+	 *		 Wide instance indices are unsupported under Iris. @see UArsInstancedActorsData::RegisterReplicationFragments
+	 */
+	ARSMECHANICA_API bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	/** Maps the 16-bit INDEX_NONE sentinel of tagged property data saved prior to 32-bit indices back to INDEX_NONE */
+	ARSMECHANICA_API void PostSerialize(const FArchive& Ar);
 
 	friend uint32 GetTypeHash(const FArsInstancedActorsInstanceIndex& InstanceIndex)
 	{
@@ -51,31 +76,33 @@ struct FArsInstancedActorsInstanceIndex
 
 	int32 GetIndex() const { return Index; }
 
-	static constexpr FORCEINLINE int32 BuildCompositeIndex(const uint16 InstanceDataID, const int32 InstanceIndex)
+	/** 
+	 * Composite indices pack an instance data ID in the high bits and an instance index in the low InstanceIndexBits bits, 
+	 * for use as FActorInstanceHandle instance indices. @see AArsInstancedActorsManager::GetCompositeInstanceIndexBits
+	 */
+	static constexpr FORCEINLINE int32 BuildCompositeIndex(const int32 InstanceDataID, const int32 InstanceIndex, const int32 InstanceIndexBits = DefaultCompositeInstanceIndexBits)
 	{
-		const uint32 HighBits = InstanceDataID;
-		const uint32 LowBits = InstanceIndex;
-		check(LowBits <= MAX_uint16);
+		const uint32 HighBits = static_cast<uint32>(InstanceDataID);
+		const uint32 LowBits = static_cast<uint32>(InstanceIndex);
+		check(LowBits < (1u << InstanceIndexBits));
+		check(HighBits < (1u << (32 - InstanceIndexBits)));
 		return static_cast<int32>((HighBits << InstanceIndexBits) | LowBits);
 	}
 
-	static constexpr FORCEINLINE int32 ExtractInstanceDataID(const int32 CompositeIndex)
+	static constexpr FORCEINLINE int32 ExtractInstanceDataID(const int32 CompositeIndex, const int32 InstanceIndexBits = DefaultCompositeInstanceIndexBits)
 	{
-		return CompositeIndex >> InstanceIndexBits;
+		return static_cast<int32>(static_cast<uint32>(CompositeIndex) >> InstanceIndexBits);
 	}
 
-	static constexpr FORCEINLINE int32 ExtractInternalInstanceIndex(const int32 CompositeIndex)
+	static constexpr FORCEINLINE int32 ExtractInternalInstanceIndex(const int32 CompositeIndex, const int32 InstanceIndexBits = DefaultCompositeInstanceIndexBits)
 	{
-		return (CompositeIndex & InstanceIndexMask);
+		return static_cast<int32>(static_cast<uint32>(CompositeIndex) & ((1u << InstanceIndexBits) - 1));
 	}
 
 private:
 	/** Stable(consistent between client and server) instance index into UArsInstancedActorsData */
 	UPROPERTY()
-	uint16 Index = INDEX_NONE;
-
-	static constexpr int32 InstanceIndexBits = 16;
-	static constexpr int32 InstanceIndexMask = (1 << InstanceIndexBits) - 1;
+	int32 Index = INDEX_NONE;
 };
 
 template<>
@@ -86,6 +113,8 @@ struct TStructOpsTypeTraits<FArsInstancedActorsInstanceIndex> : public TStructOp
 		WithZeroConstructor = true,
 		WithCopy = true,
 		WithIdenticalViaEquality = true,
+		WithNetSerializer = true,
+		WithPostSerialize = true,
 	};
 };
 
@@ -9,6 +9,10 @@
 
 
 class UArsInstancedActorsData;
+namespace UE::ArsInstancedActors
+{
+	struct FSpawnEntitiesPreparation;
+}
 
 USTRUCT()
 struct FArsInstancedActorsMassSpawnData
@@ -16,6 +20,9 @@ struct FArsInstancedActorsMassSpawnData
 	GENERATED_BODY()
 
 	TWeakObjectPtr<UArsInstancedActorsData> InstanceData;
+
+	// Prepared per-entity spawn data, owned by InstanceData. @see UArsInstancedActorsData::BeginPrepareSpawnEntities
+	const UE::ArsInstancedActors::FSpawnEntitiesPreparation* Preparation = nullptr;
 };
 
 /** Initializes the fragments of all entities that fit the query specified in ConfigureQueries, which are all considered Instanced Actors. */
@@ -48,6 +48,24 @@ namespace UE::ArsInstancedActors
 		extern bool bEnablePersistence;
 	}
 
+	/** Persistence state of an IAD changed since its manager's last persistence save, written out by incremental saves */
+	struct FInstanceDataPersistenceDirtyState
+	{
+		/** Instances whose destroyed state or Persisted instance fragments have changed */
+		TSet<int32> InstanceIndices;
+
+		/** UArsInstancedActorsComponent::GetInstancePersistenceDataID's of IACs whose persistence data has changed */
+		TSet<uint32> IACPersistenceIDs;
+
+		/** True if all IAC persistence data should be re-saved, e.g: if what changed is unknown */
+		bool bAllIACPersistenceData = false;
+	};
+
+	namespace BoundsTests
+	{
+		struct FLocationsSoA;
+	}
+
 	template <typename TBoundsType>
 	bool PassesBoundsTest(const TBoundsType& QueryBounds, EBoundsTestType BoundsTestType, const FArsInstancedActorsInstanceHandle& InstanceHandle, const FTransform& InstanceTransform);
 
@@ -99,6 +117,28 @@ public:
 	 */
 	void InitializeModifyAndSpawnEntities();
 
+	/**
+	 * First half of a two phase InitializeModifyAndSpawnEntities: initializes all PerActorClassInstanceData, applies pre-spawn
+	 * modifiers then launches tasks to prepare entity spawn data off the game thread. CommitPreparedSpawnEntities must be called
+	 * later to complete spawning.
+	 * 
+	 * Called by UArsInstancedActorsSubsystem::ExecutePendingDeferredSpawnEntitiesRequests if IA.DeferSpawnEntities.AsyncPreparation
+	 * is enabled.
+	 */
+	void InitializeModifyAndPrepareSpawnEntities();
+
+	/** @return true if all spawn preparation tasks launched in InitializeModifyAndPrepareSpawnEntities have completed */
+	bool IsSpawnEntitiesPreparationComplete() const;
+
+	/**
+	 * Second half of a two phase InitializeModifyAndSpawnEntities: spawns entities from prepared data (waiting on any incomplete
+	 * preparation) then applies post-spawn modifiers and persistence deltas.
+	 */
+	void CommitPreparedSpawnEntities();
+
+	/** @return true if InitializeModifyAndPrepareSpawnEntities has been called, pending CommitPreparedSpawnEntities */
+	bool IsPreparingSpawnEntities() const { return bIsPreparingSpawnEntities; }
+
 	/** @return true if InstanceTransforms have been consumed to spawn Mass entities in InitializeModifyAndSpawnEntities */
 	bool HasSpawnedEntities() const;
 
@@ -120,12 +160,59 @@ public:
 	bool RemoveActorInstance(const FArsInstancedActorsInstanceHandle& InstanceToRemove);
 #endif
 
+	/**
+	 * Creates a new IAD at runtime for instances of ActorClass, for UArsInstancedActorsSubsystem::AddInstances to add instances to when 
+	 * none of this manager's IADs match. Authority only. The IAD replicates to clients as a dynamic subobject, registering itself with
+	 * their manager via OnRuntimeInstanceDataReplicated, and is recreated from persistence data when loading.
+	 * @param InstanceDataID	The ID to recreate a persisted IAD with. Otherwise the next NextInstanceDataID is assigned.
+	 * @return the new IAD, or nullptr if its ID can't be addressed by this manager's composite instance indices
+	 * @see UArsInstancedActorsData::AddRuntimeInstances
+	 */
+	UArsInstancedActorsData* CreateRuntimeInstanceData(TSubclassOf<AActor> ActorClass, const FArsInstancedActorsTagSet& AdditionalInstanceTags, TOptional<uint16> InstanceDataID = TOptional<uint16>());
+
+	/** Called on clients once a runtime created IAD has replicated, to register it with this manager. Safe to call repeatedly. */
+	void OnRuntimeInstanceDataReplicated(UArsInstancedActorsData& InstanceData);
+
 	/** Searches PerActorClassInstanceData, returning the IAD with matching UArsInstancedActorsData::ID, if any(nullptr otherwise) */
 	UArsInstancedActorsData* FindInstanceDataByID(uint16 InstanceDataID) const;
 
 	/** @return the full set of instance data for this manager */
 	TConstArrayView<TObjectPtr<UArsInstancedActorsData>> GetAllInstanceData() const;
 
+	/** 
+	 * @return the number of low bits used for instance indices in this manager's composite indices (e.g: FActorInstanceHandle 
+	 * instance indices), sized to fit the largest IAD's instance count. Frozen at first entity spawn and persisted, so composite
+	 * indices remain stable across respawns and runtime instance additions. Clients adopt the server's frozen width once replicated.
+	 * @see FArsInstancedActorsInstanceIndex::BuildCompositeIndex
+	 */
+	int32 GetCompositeInstanceIndexBits() const { return CompositeInstanceIndexBits; }
+
+	/** @return true once GetCompositeInstanceIndexBits is fixed, limiting further runtime instance and IAD additions to fit it */
+	bool IsCompositeInstanceIndexBitsFrozen() const { return bCompositeInstanceIndexBitsFrozen; }
+
+	/**
+	 * @return true if InstanceIndex can be addressed by composite instance indices. On the authority, a frozen width never grows.
+	 * Clients that froze their own width before receiving the server's widen it to fit replicated instance additions, as the
+	 * server has already limited them to its own width.
+	 */
+	bool FitCompositeInstanceIndexBits(int32 InstanceIndex);
+
+	/**
+	 * @return true if this manager is running in headless dedicated server mode (IA.HeadlessServer), where ISMCs are only
+	 * created as collision carriers, stripped of render-only setup, or not created at all if IA.InstanceCollisionsOnServer 
+	 * is disabled.
+	 */
+	bool IsHeadlessServer() const;
+
+	/** @return false if CreateISMComponents shouldn't create any ISMCs, i.e: in headless server mode without instance collision */
+	bool ShouldCreateISMComponents() const;
+
+	/** @return true if ISMCs created by CreateISMComponents have instance collision, as per IA.InstanceCollisionsOnServer / Client */
+	bool ShouldEnableInstanceCollision() const;
+
+	/** Enables / disables ISMComponent's instance collision the way CreateISMComponents does */
+	static void SetInstanceCollisionEnabled(UInstancedStaticMeshComponent& ISMComponent, bool bEnable);
+
 	/**
 	 * Removes all instances as if they were never present i.e: these removals are not persisted as
 	 * if made by a player.
@@ -150,6 +237,12 @@ public:
 	/** @return world space cumulative instance bounds. Only valid after BeginPlay. */
 	FBox GetInstanceBounds() const;
 
+	/**
+	 * Called by UArsInstancedActorsData::InstantiateAddedInstances to grow InstanceBounds by runtime added instances' world space
+	 * bounds, updating this manager's registration in the subsystem's spatial hash grid as required.
+	 */
+	void OnRuntimeInstancesAdded(const FBox& AddedInstancesBounds);
+
 	/**
 	 * Iteration callback for ForEachInstance
 	 * @param InstanceHandle	Handle to the current instance in the iteration
@@ -164,6 +257,18 @@ public:
 	 */
 	using FInstancedActorDataPredicateFunc = TFunctionRef<bool(const UArsInstancedActorsData& InstancedActorData)>;
 
+	/**
+	 * Returns the bounds test type to use for a UArsInstancedActorsData's instances, or an unset optional to skip the IAD entirely.
+	 * @see ForEachInstanceInBounds
+	 */
+	using FInstancedActorDataBoundsTestTypeFunc = TFunctionRef<TOptional<UE::ArsInstancedActors::EBoundsTestType>(const UArsInstancedActorsData& InstancedActorData)>;
+
+	/**
+	 * Batch location test appending the indices of Locations which may pass a bounds test to OutCandidates.
+	 * @see UE::ArsInstancedActors::BoundsTests::TInstanceLocationFilter
+	 */
+	using FInstanceLocationFilterFunc = TFunctionRef<int32(const UE::ArsInstancedActors::BoundsTests::FLocationsSoA& Locations, TArray<int32>& OutCandidates)>;
+
 	/**
 	 * Call InOperation for each valid instance in this manager. Prior to entity spawning in BeginPlay, this iterates valid UArsInstancedActorsData::InstanceTransforms.
 	 * Once entities have been spawned, UArsInstancedActorsData::Entities are iterated.
@@ -176,7 +281,7 @@ public:
 	/**
 	 * Call InOperation for each valid instance in this manager whose location falls within QueryBounds. Prior to entity spawning in BeginPlay, this iterates valid
 	 * UArsInstancedActorsData::InstanceTransforms. Once entities have been spawned, UArsInstancedActorsData::Entities are iterated.
-	 * @param QueryBounds A world space FBox or FSphere to test instance locations against using QueryBounds.IsInside(InstanceLocation)
+	 * @param QueryBounds A world space FBox, FSphere or FOrientedBox to test instances against using PassesBoundsTest with EBoundsTestType::Intersect
 	 * @param InOperation Function to call for each instance found within QueryBounds
 	 * @return false if InOperation ever returned false to break iteration, true otherwise.
 	 */
@@ -186,12 +291,45 @@ public:
 	bool ForEachInstance(const TBoundsType& QueryBounds, FInstanceOperationFunc InOperation, FArsInstancedActorsIterationContext& IterationContext
 		, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate = TOptional<FInstancedActorDataPredicateFunc>()) const;
 
+	/**
+	 * Call InOperation for each valid instance in this manager that may overlap QueryBounds. Uses each UArsInstancedActorsData's spatial
+	 * index (where available) to skip instances that can't overlap QueryBounds, falling back to iterating all instances otherwise.
+	 * Note: InOperation may still be called for instances that don't overlap QueryBounds and is expected to perform it's own exact test
+	 *       e.g: PassesBoundsTest or IsInstanceInsideBounds.
+	 * Note: Spatial indices hold instance locations as of entity spawning, so instances moved at runtime are only found if reported
+	 *       via UArsInstancedActorsData::MarkInstanceTransformDirty or their settings set bMovableInstances.
+	 * @param QueryBounds A world space FBox or FSphere
+	 * @param InOperation Function to call for each candidate instance
+	 * @return false if InOperation ever returned false to break iteration, true otherwise.
+	 * @see UArsInstancedActorsData::GetOrBuildSpatialIndex
+	 */
+	template <typename TBoundsType>
+	bool ForEachCandidateInstance(const TBoundsType& QueryBounds, FInstanceOperationFunc InOperation, FArsInstancedActorsIterationContext& IterationContext
+		, TOptional<FInstancedActorDataPredicateFunc> InstancedActorDataPredicate = TOptional<FInstancedActorDataPredicateFunc>()) const;
+
+	/**
+	 * Call InOperation for each valid instance in this manager passing PassesBoundsTest against QueryBounds, with the test type returned
+	 * by BoundsTestTypeFunc for each UArsInstancedActorsData. Candidates are narrowed by each IAD's spatial index (where available), then
+	 * batch tested by location so precise per-instance tests only run for instances which may pass them.
+	 * @param QueryBounds A world space FBox, FSphere or FOrientedBox
+	 * @param InOperation Function to call for each instance passing the bounds test
+	 * @param BoundsTestTypeFunc Returns the test type for each IAD, or an unset optional to skip it
+	 * @return false if InOperation ever returned false to break iteration, true otherwise.
+	 * @see UE::ArsInstancedActors::BoundsTests::TInstanceLocationFilter
+	 */
+	template <typename TBoundsType>
+	bool ForEachInstanceInBounds(const TBoundsType& QueryBounds, FInstanceOperationFunc InOperation, FArsInstancedActorsIterationContext& IterationContext
+		, FInstancedActorDataBoundsTestTypeFunc BoundsTestTypeFunc) const;
+
 	/**
 	 * Checks whether there are any instanced actors within this manager, representing ActorClass or its subclasses inside QueryBounds.
 	 * The check doesn't differentiate between hydrated and dehydrated actors (i.e. whether there's an actor instance
 	 * associated with the instance or not).
+	 * Instance datas are filtered by a cached class mask and, where spatially indexed, answered from indexed instance locations,
+	 * only running precise tests for instances whose bounds overlap QueryBounds without their location being inside it.
 	 * @param bTestActorsIfSpawned if true then when an instance is found to overlap given bounds, and it has an actor 
 	 *	spawned associated with it, then the actor itself will be tested against the bounds for more precise test.
+	 * @see UE::ArsInstancedActors::FInstanceSpatialIndex::TestOccupancy
 	 */
 	bool HasInstancesOfClass(const FBox& QueryBounds, TSubclassOf<AActor> ActorClass, const bool bTestActorsIfSpawned = false
 		, const EArsInstancedActorsBulkLODMask AllowedLODs = EArsInstancedActorsBulkLODMask::All) const;
@@ -214,9 +352,28 @@ public:
 	void RemoveModifierVolume(UArsInstancedActorsModifierVolumeComponent& ModifierVolume);
 	void RemoveAllModifierVolumes();
 
-	/** Request the persistent data system to re-save this managers persistent data */
+	/**
+	 * Marks all instance delta lists dirty and flushes net dormancy, so deltas deferred by per-connection relevancy are re-evaluated
+	 * for each connection. @see IA.DeltaRelevancy.Distance, UArsInstancedActorsSubsystem::FlushDeferredInstanceDeltas
+	 */
+	void MarkInstanceDeltasForRelevancyUpdate();
+
+	/** 
+	 * Request the persistent data system to re-save this managers persistent data.
+	 * All IAC persistence data is considered changed, prefer RequestInstancePersistentDataSave / RequestComponentPersistentDataSave
+	 * where the change is known so incremental saves only write what changed.
+	 */
 	void RequestPersistentDataSave();
 
+	/** Request a persistent data re-save after InstanceIndex's destroyed state or Persisted instance fragments have changed */
+	void RequestInstancePersistentDataSave(const UArsInstancedActorsData& InstanceData, FArsInstancedActorsInstanceIndex InstanceIndex);
+
+	/** 
+	 * Request a persistent data re-save after InstanceData's persistence data for the IAC with IACPersistenceID has changed
+	 * @see UArsInstancedActorsComponent::GetInstancePersistenceDataID
+	 */
+	void RequestComponentPersistentDataSave(const UArsInstancedActorsData& InstanceData, uint32 IACPersistenceID);
+
 	/** Helper function to deduce appropriate instanced static mesh bounds for ActorClass */
 	static FBox CalculateBounds(TSubclassOf<AActor> ActorClass);
 
@@ -266,6 +423,7 @@ protected:
 #endif
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual bool IsHLODRelevant() const override;
 	virtual void PostLoad() override;
 #if WITH_EDITOR
@@ -289,8 +447,30 @@ protected:
 	 * @param InstanceData	The InstanceData to serialize from / to. May be nullptr when loading if Record's IAD has been removed since saving.
 	 * 						In this case, we still need to read Record to seek the archive past this IAD record consistently.
 	 * @param TimeDelta		Real time in seconds since serialization (0 when saving)
+	 * @param bDeltaRecord	If true, Record is an incremental delta record containing only InstanceData's PersistenceDirtyStates when
+	 * 						saving, which are applied on top of previously loaded records when loading
+	 */
+	void SerializeInstancePersistenceData(FStructuredArchive::FRecord Record, UArsInstancedActorsData* InstanceData, int64 TimeDelta, bool bDeltaRecord = false) const;
+
+	/** 
+	 * Called by Serialize for SaveGame archives to save / load a persistence record: a time stamp followed by per-IAD persistence data.
+	 * @param bDeltaRecord	If true, only IADs with PersistenceDirtyStates are written. @see SerializeInstancePersistenceData
+	 */
+	void SerializePersistenceRecord(FStructuredArchive::FRecord Record, bool bDeltaRecord);
+
+	/**
+	 * Called by SerializePersistenceRecord to save / load the identity of runtime created IADs, for recreation on load.
+	 * @see CreateRuntimeInstanceData
+	 * @return true if the record's IAD was created at runtime, with InOutActorClassPath and InOutAdditionalTagNames serialized
+	 */
+	bool SerializeRuntimeCreatedInstanceData(FStructuredArchive::FRecord Record, const UArsInstancedActorsData* InstanceData
+		, FSoftClassPath& InOutActorClassPath, TArray<FName>& InOutAdditionalTagNames) const;
+
+	/** 
+	 * Loads NumRecords persistence records from Bytes, or appends NumRecords to Bytes, using a binary archive with the versions of OuterArchive
+	 * @return false if an archive error occurred
 	 */
-	void SerializeInstancePersistenceData(FStructuredArchive::FRecord Record, UArsInstancedActorsData* InstanceData, int64 TimeDelta) const;
+	bool SerializePersistenceRecords(TArray<uint8>& Bytes, int32 NumRecords, bool bDeltaRecords, const FArchive& OuterArchive);
 
 	/** Despawns all entities spawned by individual UArsInstancedActorsData instances. */
 	virtual void DespawnAllEntities();
@@ -307,14 +487,18 @@ protected:
 	/** Calculate cumulative local space instance bounds for all PerActorClassInstanceData */
 	FBox CalculateLocalInstanceBounds() const;
 
+	/** Creates a new IAD for ActorClass instances with the next NextInstanceDataID, without adding it to PerActorClassInstanceData */
+	virtual UArsInstancedActorsData* CreateNextInstanceActorData(TSubclassOf<AActor> ActorClass, const FArsInstancedActorsTagSet& AdditionalInstanceTags);
+
+	/** Adds runtime created InstanceData to PerActorClassInstanceData, initializing it if the other IADs already have been */
+	void RegisterRuntimeInstanceData(UArsInstancedActorsData& InstanceData);
+
 #if WITH_EDITOR
 public:
 	/** Helper function to create and initialize per-actor-class UArsInstancedActorsData's, optionally further partitioned by AdditionalInstanceTags */
 	UArsInstancedActorsData& GetOrCreateActorInstanceData(TSubclassOf<AActor> ActorClass, const FArsInstancedActorsTagSet& AdditionalInstanceTags, bool bCreateEditorPreviewISMCs = true);
 
 protected:
-	virtual UArsInstancedActorsData* CreateNextInstanceActorData(TSubclassOf<AActor> ActorClass, const FArsInstancedActorsTagSet& AdditionalInstanceTags);
-
 	/** Used to set the right properties on the editor ISMCs so we can do per-instance selection. */
 	virtual void PreRegisterAllComponents() override;
 #endif
@@ -341,6 +525,40 @@ protected:
 	/** True if SetupLoadedInstances has ever been called */
 	bool bHasSetupLoadedInstances : 1 = false;
 
+	/** True between InitializeModifyAndPrepareSpawnEntities and CommitPreparedSpawnEntities */
+	bool bIsPreparingSpawnEntities : 1 = false;
+
+	/** True if PersistenceSnapshot holds a full persistence record that incremental saves can append delta records to */
+	bool bHasPersistenceSnapshot : 1 = false;
+
+	/** Number of delta records in PersistenceDeltaRecords */
+	int32 NumPersistenceDeltaRecords = 0;
+
+	/** The last full persistence record saved, re-used by incremental saves until compaction. @see IA.Persistence.Incremental */
+	TArray<uint8> PersistenceSnapshot;
+
+	/** Delta records saved since PersistenceSnapshot, applied in order on top of it when loading */
+	TArray<uint8> PersistenceDeltaRecords;
+
+	/** Persistence changes per IAD ID since the last save, written out as the next delta record */
+	TMap<uint16, UE::ArsInstancedActors::FInstanceDataPersistenceDirtyState> PersistenceDirtyStates;
+
+	/** @see GetCompositeInstanceIndexBits, UpdateCompositeInstanceIndexBits */
+	uint8 CompositeInstanceIndexBits = FArsInstancedActorsInstanceIndex::DefaultCompositeInstanceIndexBits;
+
+	/** Set once CompositeInstanceIndexBits is fixed, at first entity spawn or when restored from persistence data */
+	bool bCompositeInstanceIndexBitsFrozen = false;
+
+	/** 
+	 * The authority's CompositeInstanceIndexBits once frozen, 0 before. Replicated so clients, which may spawn entities before receiving
+	 * it, decode composite indices exchanged with the server identically. @see OnRep_AuthorityCompositeInstanceIndexBits
+	 */
+	UPROPERTY(ReplicatedUsing=OnRep_AuthorityCompositeInstanceIndexBits, Transient)
+	uint8 AuthorityCompositeInstanceIndexBits = 0;
+
+	UFUNCTION()
+	void OnRep_AuthorityCompositeInstanceIndexBits();
+
 	/** 
 	 * Incremented in GetOrCreateActorInstanceData to provide IAD's with a stable, unique identifier
 	 * within this IAM.
@@ -353,10 +571,16 @@ protected:
 	UPROPERTY(Instanced, VisibleAnywhere, Category=ArsInstancedActors)
 	TArray<TObjectPtr<UArsInstancedActorsData>> PerActorClassInstanceData;
 
-	/** World space cumulative instance bounds, calculated in BeginPlay */
+	/** Cached PerActorClassInstanceData masks by queried actor class. @see GetInstanceDataClassMask */
+	mutable TMap<TObjectKey<const UClass>, TBitArray<>> InstanceDataClassMasks;
+
+	/** World space cumulative instance bounds, calculated in BeginPlay and grown by OnRuntimeInstancesAdded */
 	UPROPERTY(Transient)
 	FBox InstanceBounds = FBox(ForceInit);
 
+	/** World space bounds of runtime added instances, included in InstanceBounds. Reset in DespawnAllEntities */
+	FBox RuntimeAddedInstanceBounds = FBox(ForceInit);
+
 	/** Modifier volumes added via AddModifierVolume */
 	TArray<TWeakObjectPtr<UArsInstancedActorsModifierVolumeComponent>> ModifierVolumes;
 
@@ -419,7 +643,45 @@ private:
 
 	AActor* GetActorForInstance(const UArsInstancedActorsData& InstanceData, const int32 InstancedActorIndex) const;
 
+	/**
+	 * Calls Operation for each valid instance in InstanceData, optionally limited to InstanceIndices.
+	 * If LocationFilter is provided, instance locations are gathered per Mass chunk (or per batch of InstanceTransforms prior to entity
+	 * spawning) and Operation is only called for those LocationFilter returns.
+	 * @return false if Operation ever returned false to break iteration, true otherwise.
+	 * @see ForEachInstance, ForEachCandidateInstance, ForEachInstanceInBounds
+	 */
+	bool ForEachInstanceInInstanceData(UArsInstancedActorsData& InstanceData, FInstanceOperationFunc Operation, FArsInstancedActorsIterationContext& IterationContext
+		, TOptional<TConstArrayView<FArsInstancedActorsInstanceIndex>> InstanceIndices = TOptional<TConstArrayView<FArsInstancedActorsInstanceIndex>>()
+		, TOptional<FInstanceLocationFilterFunc> LocationFilter = TOptional<FInstanceLocationFilterFunc>()) const;
+
 	FArsInstancedActorsInstanceHandle ActorInstanceHandleFromFSMInstanceId(const FSMInstanceId& InstanceId) const;
+
+	/** Shared first step of InitializeModifyAndSpawnEntities & InitializeModifyAndPrepareSpawnEntities */
+	void InitializeAndRunPreSpawnModifiers();
+
+	/**
+	 * Returns a bit per PerActorClassInstanceData entry, set for those of ActorClass or it's subclasses. Computed once per queried class.
+	 * @see HasInstancesOfClass
+	 */
+	const TBitArray<>& GetInstanceDataClassMask(const UClass* ActorClass) const;
+
+	/** @return the composite instance index bit count required to fit the largest of PerActorClassInstanceData */
+	int32 CalculateCompositeInstanceIndexBits() const;
+
+	/** Sizes CompositeInstanceIndexBits to fit the largest of PerActorClassInstanceData, unless bCompositeInstanceIndexBitsFrozen */
+	void UpdateCompositeInstanceIndexBits();
+
+	/** Fixes CompositeInstanceIndexBits at InstanceIndexBits, replicating it to clients if we're the authority */
+	void FreezeCompositeInstanceIndexBits(int32 InstanceIndexBits);
+
+	/** Sets CompositeInstanceIndexBits, re-encoding spawned entities' dehydrated actor handles if it changed */
+	void SetCompositeInstanceIndexBits(int32 InstanceIndexBits);
+
+	/** Saves / restores CompositeInstanceIndexBits in persistence records, freezing it on load if spawning hasn't already */
+	void SerializeCompositeInstanceIndexBits(FStructuredArchive::FRecord Record);
+
+	/** Shared last step of InitializeModifyAndSpawnEntities & CommitPreparedSpawnEntities */
+	void SpawnEntitiesAndRunPostSpawnModifiers();
 };
 
 
@@ -109,6 +109,12 @@ public:
 	 */
 	bool TryRunPendingModifiers(AArsInstancedActorsManager& Manager, TBitArray<>& InOutPendingModifiers);
 
+	/** @return true if Manager's instances are skipped by this volume, per bIgnoreOwnLevelsInstances and LevelsToIgnore */
+	bool IsIgnoringManager(const AArsInstancedActorsManager& Manager) const;
+
+	/** @return true if Location is within this volume's Shape */
+	bool IsInside(const FVector& Location) const;
+
 	//~ Begin UObject overrides
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	//~ End UObject overrides
@@ -128,6 +134,9 @@ public:
 
 protected:
 
+	/** @return the world space box volume, for Shape == Box. @see IA.ModifierVolumes.OrientedBoxes */
+	FOrientedBox GetOrientedBox() const;
+
 	UPROPERTY(Transient)
 	FArsInstancedActorsModifierVolumeHandle ModifierVolumeHandle;
 		
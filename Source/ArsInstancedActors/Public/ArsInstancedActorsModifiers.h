@@ -75,48 +75,41 @@ public:
 	 * Prior to entity spawning in BeginPlay, this iterates valid UArsInstancedActorsData::InstanceTransforms. Once entities have 
 	 * spawned, UArsInstancedActorsData::Entities are iterated.
 	 * 
-	 * By default this simply calls ModifyInstance for all instances.
+	 * By default this simply calls ModifyInstance for all instances passing the bounds test, using the instance datas' spatial
+	 * indices to skip instances that can't overlap Bounds.
 	 * 
-	 * @param Bounds 			A world space FBox or FSphere to test instance locations against using Bounds.IsInside(InstanceLocation)
+	 * @param Bounds 			A world space FBox, FSphere or FOrientedBox to test instances against using PassesBoundsTest, per IAD settings' bModifierVolumeCheckFullyEnclosed
 	 * @param Manager			The whole manager to modify. If bRequiresSpawnedEntities = false, this Manager may or may not have spawned entities yet. @see bRequiresSpawnedEntities
 	 * @param InterationContext Provides useful functionality while iterating instances like safe instance deletion
-	 * @see AArsInstancedActorsManager::ForEachInstance
+	 * @see AArsInstancedActorsManager::ForEachInstanceInBounds
 	 */
 	template<typename TBoundsType>
 	void ModifyAllInstancesInBounds(const TBoundsType& Bounds, AArsInstancedActorsManager& Manager, FArsInstancedActorsIterationContext& IterationContext)
 	{
-		UE::ArsInstancedActors::EBoundsTestType ArsInstancedActorsDataBoundsTestType{UE::ArsInstancedActors::EBoundsTestType::Default};
-		
-		Manager.ForEachInstance([this, &Bounds, &ArsInstancedActorsDataBoundsTestType](const FArsInstancedActorsInstanceHandle& InstanceHandle, const FTransform& InstanceTransform, FArsInstancedActorsIterationContext& IterationContext)
+		Manager.ForEachInstanceInBounds(Bounds, [this](const FArsInstancedActorsInstanceHandle& InstanceHandle, const FTransform& InstanceTransform, FArsInstancedActorsIterationContext& IterationContext)
 		{
-			if (UE::ArsInstancedActors::PassesBoundsTest(Bounds, ArsInstancedActorsDataBoundsTestType, InstanceHandle, InstanceTransform))
-			{
-				return ModifyInstance(InstanceHandle, InstanceTransform, IterationContext);
-			}
-			return true;
+			return ModifyInstance(InstanceHandle, InstanceTransform, IterationContext);
 		}, 
 		IterationContext,
-		/*Predicate*/TOptional<AArsInstancedActorsManager::FInstancedActorDataPredicateFunc>([this, &ArsInstancedActorsDataBoundsTestType](const UArsInstancedActorsData& InstancedActorData)
+		/*BoundsTestType*/[this](const UArsInstancedActorsData& InstancedActorData) -> TOptional<UE::ArsInstancedActors::EBoundsTestType>
 		{			
 			// Allow settings to stop modifiers affect this instance type.
 			const FArsInstancedActorsSettings* Settings = InstancedActorData.GetSettingsPtr<const FArsInstancedActorsSettings>();
 			if (Settings && Settings->bOverride_bIgnoreModifierVolumes && Settings->bIgnoreModifierVolumes)
 			{
-				return false;
+				return TOptional<UE::ArsInstancedActors::EBoundsTestType>();
 			}
 
 			if (InstanceTagsQuery.IsEmpty() || InstancedActorData.GetCombinedTags().MatchesQuery(InstanceTagsQuery))
 			{
-				// modify the EBoundsTestType for this set of Entities that are associated with this IAD, if the settings require it
-				ArsInstancedActorsDataBoundsTestType = (Settings != nullptr && Settings->bModifierVolumeCheckFullyEnclosed)
+				// Test this IAD's instances for full enclosure, if the settings require it
+				return (Settings != nullptr && Settings->bModifierVolumeCheckFullyEnclosed)
 					? UE::ArsInstancedActors::EBoundsTestType::Enclosed
 					: UE::ArsInstancedActors::EBoundsTestType::Intersect;
-
-				return true;
 			}
 
-			return false;
-		}));
+			return TOptional<UE::ArsInstancedActors::EBoundsTestType>();
+		});
 	}
 
 protected:
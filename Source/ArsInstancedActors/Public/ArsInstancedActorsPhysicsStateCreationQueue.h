@@ -0,0 +1,91 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#pragma once
+
+#include "ArsMechanicaAPI.h"
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+
+class UInstancedStaticMeshComponent;
+
+namespace UE::ArsInstancedActors
+{
+/** An ISMComponent pending physics state creation, prioritized by distance to the closest viewer */
+struct FPhysicsStateCreationRequest
+{
+	TWeakObjectPtr<UInstancedStaticMeshComponent> ISMComponent;
+
+	// Key of ISMComponent, set by FPhysicsStateCreationQueue::Push. Remains valid for lookups once ISMComponent has been destroyed.
+	TObjectKey<const UInstancedStaticMeshComponent> ISMComponentKey;
+
+	// Squared distance from the closest viewer to the component's instances when requested
+	double DistanceSquared = TNumericLimits<double>::Max();
+
+	// Incrementing request order, keeping equally prioritized requests FIFO
+	uint32 RequestOrder = 0;
+
+	bool operator<(const FPhysicsStateCreationRequest& Other) const
+	{
+		return DistanceSquared < Other.DistanceSquared || (DistanceSquared == Other.DistanceSquared && RequestOrder < Other.RequestOrder);
+	}
+};
+
+/**
+ * Indexed binary min-heap of FPhysicsStateCreationRequest's, closest to viewers first. Each queued ISMComponent's heap slot
+ * is tracked in a map, so requests can be found and removed in O(1) / O(log n) without searching the queue.
+ * @see UArsInstancedActorsSubsystem::RequestDeferredPhysicsStateCreation
+ */
+struct ARSMECHANICA_API FPhysicsStateCreationQueue
+{
+	int32 Num() const { return Heap.Num(); }
+	bool IsEmpty() const { return Heap.IsEmpty(); }
+
+	/** @return the request closest to viewers. Queue must not be empty */
+	const FPhysicsStateCreationRequest& Top() const
+	{
+		check(Heap.Num() > 0);
+		return Heap[0];
+	}
+
+	/** @return true if ISMComponent is queued */
+	bool Contains(const UInstancedStaticMeshComponent& ISMComponent) const
+	{
+		return QueueIndices.Contains(TObjectKey<const UInstancedStaticMeshComponent>(&ISMComponent));
+	}
+
+	/** Adds Request to the queue. Request.ISMComponent must not already be queued */
+	void Push(FPhysicsStateCreationRequest&& Request);
+
+	/** Removes the request closest to viewers. Queue must not be empty */
+	void Pop();
+
+	/**
+	 * Removes ISMComponent's request, if queued.
+	 * @return true if ISMComponent was queued
+	 */
+	bool Remove(const UInstancedStaticMeshComponent& ISMComponent);
+
+	/** Removes all requests from the queue */
+	void Reset();
+
+	/** @return all queued requests, in heap order */
+	TConstArrayView<FPhysicsStateCreationRequest> GetRequests() const { return Heap; }
+
+private:
+	/** Moves Request into Heap[Index], updating its QueueIndices entry */
+	void Place(int32 Index, FPhysicsStateCreationRequest&& Request);
+	void SiftUp(int32 Index);
+	void SiftDown(int32 Index);
+	void RemoveAt(int32 Index);
+
+	TArray<FPhysicsStateCreationRequest> Heap;
+
+	// Heap index of each queued request, by ISMComponentKey
+	TMap<TObjectKey<const UInstancedStaticMeshComponent>, int32> QueueIndices;
+};
+} // UE::ArsInstancedActors
@@ -6,13 +6,46 @@
 
 #include "ArsInstancedActorsIndex.h"
 #include "Net/Serialization/FastArraySerializer.h"
+#include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
 #include "ArsInstancedActorsReplication.generated.h"
 
 
 
 struct FArsInstancedActorsDeltaList;
+struct FArsInstancedActorsDeltaRelevancyContext;
 class UArsInstancedActorsData;
 
+namespace UE::ArsInstancedActors
+{
+namespace CVars
+{
+	extern float DeltaRelevancyDistance;
+}
+
+/**
+ * Server-side instance delta relevancy state for a single connection, across all delta lists. Owned by UArsInstancedActorsSubsystem,
+ * which flushes deferred deltas once the connection's view target approaches them.
+ * @see IA.DeltaRelevancy.Distance, UArsInstancedActorsSubsystem::FlushDeferredInstanceDeltas
+ */
+struct FConnectionDeltaRelevancy
+{
+	// GFrameCounter NumNewDeltasWritten was counted in
+	uint64 BudgetFrame = 0;
+
+	// Number of deltas new to the connection written in BudgetFrame. @see IA.DeltaRelevancy.MaxNewDeltasPerConnectionPerFrame
+	int32 NumNewDeltasWritten = 0;
+
+	// Bounds of the deltas deferred for being out of the connection's range, by manager ID
+	TMap<int32, FBox> OutOfRangeDeferredBounds;
+
+	// IDs of managers with deltas deferred by the connection's per-frame budget, retried regardless of distance
+	TSet<int32> BudgetDeferredManagerIDs;
+
+	bool HasDeferredDeltas() const { return !OutOfRangeDeferredBounds.IsEmpty() || !BudgetDeferredManagerIDs.IsEmpty(); }
+};
+} // UE::ArsInstancedActors
+
 /** Per-instance delta's against the cooked instance data, for persistence and replication */
 USTRUCT() 
 struct FArsInstancedActorsDelta : public FFastArraySerializerItem
@@ -32,7 +65,9 @@ struct FArsInstancedActorsDelta : public FFastArraySerializerItem
 	FORCEINLINE bool HasAnyDeltas() const
 	{
 		return IsDestroyed() 
+			|| IsAdded()
 			|| HasCurrentLifecyclePhase()
+			|| HasFragments()
 #if WITH_SERVER_CODE
 			|| HasCurrentLifecyclePhaseTimeElapsed()
 #endif
@@ -43,9 +78,31 @@ struct FArsInstancedActorsDelta : public FFastArraySerializerItem
 
 	bool IsDestroyed() const { return bDestroyed; }
 
+	// Returns true if this delta's instance was added at runtime rather than cooked @see UArsInstancedActorsData::AddRuntimeInstances
+	bool IsAdded() const { return bAdded; }
+
+	// Manager-relative transform of a runtime added instance. Only meaningful if IsAdded()
+	const FTransform& GetAddedTransform() const { return AddedTransform; }
+
 	const bool HasCurrentLifecyclePhase() const { return CurrentLifecyclePhaseIndex != (uint8)INDEX_NONE; }
 	uint8 GetCurrentLifecyclePhaseIndex() const { return CurrentLifecyclePhaseIndex; }
 
+	// Returns true if this delta has any registered instance fragment values @see UE::ArsInstancedActors::RegisterInstanceFragmentType
+	bool HasFragments() const
+	{
+		return !ReplicatedFragments.IsEmpty()
+#if WITH_SERVER_CODE
+			|| !ServerFragments.IsEmpty()
+#endif
+			;
+	}
+
+	// Returns this delta's value for FragmentType, if any
+	const FInstancedStruct* FindFragment(const UScriptStruct* FragmentType) const;
+
+	// Calls Function for each of this delta's instance fragment values. Non-replicated values are only present on the server.
+	void ForEachFragment(TFunctionRef<void(FConstStructView /*Fragment*/)> Function) const;
+
 #if WITH_SERVER_CODE
 
 	// mz@todo IA: move this section back
@@ -59,18 +116,36 @@ private:
 	friend FArsInstancedActorsDeltaList;
 
 	bool SetDestroyed(bool bInDestroyed) { return bDestroyed = bInDestroyed; }
+	void SetAdded(const FTransform& InAddedTransform) { bAdded = true; AddedTransform = InAddedTransform; }
 	void SetCurrentLifecyclePhaseIndex(uint8 InCurrentLifecyclePhaseIndex) { CurrentLifecyclePhaseIndex = InCurrentLifecyclePhaseIndex; }
 	void ResetLifecyclePhaseIndex() { CurrentLifecyclePhaseIndex = (uint8)INDEX_NONE; }
 
+	// @return true if the fragment value was added or changed
+	bool SetFragment(FConstStructView Fragment, bool bReplicated);
+
+	// @return true if a FragmentType value was present and removed
+	bool RemoveFragment(const UScriptStruct* FragmentType);
+
 	UPROPERTY()
 	FArsInstancedActorsInstanceIndex InstanceIndex;
 
 	UPROPERTY()
 	uint8 bDestroyed : 1 = false;
 
+	UPROPERTY()
+	uint8 bAdded : 1 = false;
+
 	UPROPERTY()
 	uint8 CurrentLifecyclePhaseIndex = (uint8)INDEX_NONE;
 
+	// Values for instance fragment types registered with EArsInstancedActorsFragmentFlags::Replicated
+	UPROPERTY()
+	TArray<FInstancedStruct> ReplicatedFragments;
+
+	// Manager-relative transform for runtime added instances (bAdded), which have no cooked InstanceTransforms entry to spawn from
+	UPROPERTY()
+	FTransform AddedTransform = FTransform::Identity;
+
 #if WITH_SERVER_CODE
 	void SetCurrentLifecyclePhaseTimeElapsed(FFloat16 InCurrentLifecyclePhaseTimeElapsed) { CurrentLifecyclePhaseTimeElapsed = InCurrentLifecyclePhaseTimeElapsed; }
 	void ResetLifecyclePhaseTimeElapsed() { CurrentLifecyclePhaseTimeElapsed = -1.0f; }
@@ -78,6 +153,14 @@ private:
 	// Server-only (not replicated) time elapsed in current phase, saved & restored via persistence.
 	// Unrequired by client code which only needs to know about discrete phase changes for visual updates.
 	FFloat16 CurrentLifecyclePhaseTimeElapsed = -1.0f;
+
+	// Server-only (not replicated) values for instance fragment types registered with EArsInstancedActorsFragmentFlags::Persisted only
+	TArray<FInstancedStruct> ServerFragments;
+
+	// Server-only (not replicated) world location of the instance, cached when the delta is added for per-connection
+	// relevancy. Unset if the location couldn't be determined, in which case the delta is always relevant.
+	// @see IA.DeltaRelevancy.Distance
+	TOptional<FVector> RelevancyLocation;
 #endif // WITH_SERVER_CODE
 };
 
@@ -90,6 +173,9 @@ struct FArsInstancedActorsDeltaList : public FFastArraySerializer
 
 	const TArray<FArsInstancedActorsDelta>& GetInstanceDeltas() const { return InstanceDeltas; }
 
+	// Returns the FArsInstancedActorsDelta for InstanceIndex, if any. Server only.
+	const FArsInstancedActorsDelta* FindInstanceDelta(FArsInstancedActorsInstanceIndex InstanceIndex) const;
+
 	// Clear the InstanceDeltas list and resets InstancedActorData 
 	// @param bMarkDirty If true, marks InstanceDeltas dirty for fast array replication
 	void Reset(bool bMarkDirty = true);
@@ -102,6 +188,13 @@ struct FArsInstancedActorsDeltaList : public FFastArraySerializer
 
 	void RemoveDestroyedInstanceDelta(FArsInstancedActorsInstanceIndex InstanceIndex);
 
+	// Adds a FArsInstancedActorsDelta for runtime added InstanceIndex, recording its manager-relative LocalTransform and marks the 
+	// delta as dirty for replication, so clients can spawn the instance too.
+	// This delta will also be persisted @see AArsInstancedActorsManager::SerializeInstancePersistenceData
+	// Note: Added deltas are never removed, as the instance index remains allocated even once destroyed
+	// Note: This does not request a persistence re-save
+	void SetInstanceAdded(FArsInstancedActorsInstanceIndex InstanceIndex, const FTransform& LocalTransform);
+
 	// Adds or modifies a FArsInstancedActorsDelta for InstanceIndex, specifying a new lifecycle phase to switch the instance
 	// to, and marks the delta as dirty for replication and application on clients
 	// Note: This does not request a persistence re-save
@@ -109,6 +202,14 @@ struct FArsInstancedActorsDeltaList : public FFastArraySerializer
 
 	void RemoveLifecyclePhaseDelta(FArsInstancedActorsInstanceIndex InstanceIndex);
 
+	// Adds or modifies a FArsInstancedActorsDelta for InstanceIndex, storing Fragment's value for its registered instance fragment type.
+	// Replicated fragment types are marked dirty for replication and application on clients. Persisted fragment types will be saved
+	// @see AArsInstancedActorsManager::SerializeInstancePersistenceData
+	// Note: This does not request a persistence re-save
+	void SetInstanceFragment(FArsInstancedActorsInstanceIndex InstanceIndex, FConstStructView Fragment);
+
+	void RemoveInstanceFragment(FArsInstancedActorsInstanceIndex InstanceIndex, const UScriptStruct& FragmentType);
+
 #if WITH_SERVER_CODE
 	// Adds or modifies a FArsInstancedActorsDelta for InstanceIndex, specifying a new elapse time for the current lifecycle phase.
 	// Note: This is a server-only delta and is NOT replicated to clients. It's simply stored in the delta list alongside the lifecycle 
@@ -118,9 +219,10 @@ struct FArsInstancedActorsDeltaList : public FFastArraySerializer
 	void RemoveLifecyclePhaseTimeElapsedDelta(FArsInstancedActorsInstanceIndex InstanceIndex);
 #endif // WITH_SERVER_CODE
 
-	const uint16 GetNumDestroyedInstanceDeltas() const { return NumDestroyedInstanceDeltas; }
-	const uint16 GetNumLifecyclePhaseDeltas() const { return NumLifecyclePhaseDeltas; }
-	const uint16 GetNumLifecyclePhaseTimeElapsedDeltas() const { return NumLifecyclePhaseTimeElapsedDeltas; }
+	int32 GetNumDestroyedInstanceDeltas() const { return NumDestroyedInstanceDeltas; }
+	int32 GetNumAddedInstanceDeltas() const { return NumAddedInstanceDeltas; }
+	int32 GetNumLifecyclePhaseDeltas() const { return NumLifecyclePhaseDeltas; }
+	int32 GetNumLifecyclePhaseTimeElapsedDeltas() const { return NumLifecyclePhaseTimeElapsedDeltas; }
 
 	// UStruct overrides
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
@@ -130,25 +232,44 @@ struct FArsInstancedActorsDeltaList : public FFastArraySerializer
 	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize);
 	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize);
 
+	// Filters deltas per connection whilst NetDeltaSerialize is writing with IA.DeltaRelevancy.Distance, deferring deltas
+	// the connection hasn't yet received which are out of range or over the connection's per-frame budget.
+	template<typename Type, typename SerializerType>
+	bool ShouldWriteFastArrayItem(const Type& Item, const bool bIsWritingOnClient)
+	{
+		if (RelevancyContext != nullptr && !ShouldWriteInstanceDelta(Item))
+		{
+			return false;
+		}
+		return FFastArraySerializer::ShouldWriteFastArrayItem<Type, SerializerType>(Item, bIsWritingOnClient);
+	}
+
 private:
 
 	FArsInstancedActorsDelta& FindOrAddInstanceDelta(FArsInstancedActorsInstanceIndex InstanceIndex);
-	void RemoveInstanceDelta(uint16 DeltaIndex);
+	void RemoveInstanceDelta(int32 DeltaIndex);
+
+	// Returns true if InstanceDelta should be written to RelevancyContext's connection now, or false to defer it
+	bool ShouldWriteInstanceDelta(const FArsInstancedActorsDelta& InstanceDelta);
 
 	// Lookup the InstanceDeltas index from a FArsInstancedActorsInstanceIndex. 
 	// Note: This is server only data, initialized in Initialize
-	TMap<FArsInstancedActorsInstanceIndex, uint16> InstanceIndexToDeltaIndex;
+	TMap<FArsInstancedActorsInstanceIndex, int32> InstanceIndexToDeltaIndex;
 
 	// Cached counts for persistence serialization
-	uint16 NumDestroyedInstanceDeltas = 0;
-	uint16 NumLifecyclePhaseDeltas = 0;
-	uint16 NumLifecyclePhaseTimeElapsedDeltas = 0;
+	int32 NumDestroyedInstanceDeltas = 0;
+	int32 NumAddedInstanceDeltas = 0;
+	int32 NumLifecyclePhaseDeltas = 0;
+	int32 NumLifecyclePhaseTimeElapsedDeltas = 0;
 
 	UPROPERTY(Transient)
 	TArray<FArsInstancedActorsDelta> InstanceDeltas; // FastArray of Instance replication data.
 
 	// Raw pointer to the UArsInstancedActorsData this FArsInstancedActorsDeltaList instance is a member of
 	UArsInstancedActorsData* InstancedActorData = nullptr;
+
+	// Connection being written to by NetDeltaSerialize, only set with per-connection relevancy enabled
+	FArsInstancedActorsDeltaRelevancyContext* RelevancyContext = nullptr;
 };
 
 template<>
@@ -13,6 +13,27 @@ class ARSMECHANICA_API UArsInstancedActorsRepresentationSubsystem : public UMass
 {
 	GENERATED_BODY()
 
+public:
+	/**
+	 * Queues EntityHandles to switch to NewStaticMeshDescHandle, applied in bulk by the next UArsInstancedActorsVisualizationSwitcherProcessor
+	 * execution. Repeated requests for the same entity before then are coalesced, with the latest request winning.
+	 * @see UArsInstancedActorsData::SwitchInstanceVisualization
+	 */
+	void RequestVisualizationSwitches(TConstArrayView<FMassEntityHandle> EntityHandles, FStaticMeshInstanceVisualizationDescHandle NewStaticMeshDescHandle);
+
+	bool HasPendingVisualizationSwitches() const { return !PendingVisualizationSwitches.IsEmpty(); }
+
+	/** Moves all pending visualization switches into OutSwitches, sorted by new static mesh desc handle */
+	void ConsumePendingVisualizationSwitches(TArray<TPair<FMassEntityHandle, FStaticMeshInstanceVisualizationDescHandle>>& OutSwitches);
+
+	/**
+	 * Immediately moves EntityHandles using OldStaticMeshDescHandle, and any switches pending to it, over to NewStaticMeshDescHandle,
+	 * so OldStaticMeshDescHandle can be removed straight after. Moved entities' ISMC instances are re-added by the next
+	 * UMassStationaryISMSwitcherProcessor execution. @see UArsInstancedActorsData::ApplyLoadedVisualization
+	 */
+	void RetargetStaticMeshDesc(FMassEntityManager& EntityManager, TConstArrayView<FMassEntityHandle> EntityHandles
+		, FStaticMeshInstanceVisualizationDescHandle OldStaticMeshDescHandle, FStaticMeshInstanceVisualizationDescHandle NewStaticMeshDescHandle);
+
 protected:
 	//~ Begin USubsystem Overrides
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
@@ -22,4 +43,7 @@ protected:
 	void OnSettingsChanged();
 
 	FDelegateHandle OnSettingsChangedHandle;
+
+	/** Pending switch per entity, queued by RequestVisualizationSwitches */
+	TMap<FMassEntityHandle, FStaticMeshInstanceVisualizationDescHandle> PendingVisualizationSwitches;
 };
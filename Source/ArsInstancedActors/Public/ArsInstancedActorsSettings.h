@@ -104,6 +104,21 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = ActorClassSettings)
 	FArsInstancedActorsConfig DefaultConfig;
 
+	/** 
+	 * Default for UArsInstancedActorsData::bWideInstanceIndices on newly created instance datas. Wide indices allow far larger
+	 * instance counts per instance data (e.g: for dense procedurally placed foliage) rather than splitting them across many.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Instances)
+	bool bWideInstanceIndicesByDefault = false;
+
+	/**
+	 * If specified, visualizations added with UArsInstancedActorsData::AddVisualizationAsync render instances with this (ideally cheap
+	 * and always loaded) mesh until their assets have streamed in, rather than nothing.
+	 * @see UArsInstancedActorsSubsystem::RequestVisualizationLoad
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Visualization)
+	TSoftObjectPtr<UStaticMesh> VisualizationLoadPlaceholderMesh;
+
 protected:
 	FOnSettingsChanged OnSettingsUpdated;
 
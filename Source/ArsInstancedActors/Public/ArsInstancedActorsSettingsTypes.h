@@ -102,6 +102,21 @@ struct FArsInstancedActorsSettings : public FTableRowBase
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (InlineEditConditionToggle), Category=ArsInstancedActors)
 	uint8 bOverride_WorldPositionOffsetDisableDistance : 1 = false;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta=(InlineEditConditionToggle), Category=ArsInstancedActors)
+	uint8 bOverride_MediumLODDistance : 1 = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta=(InlineEditConditionToggle), Category=ArsInstancedActors)
+	uint8 bOverride_MediumLODTickInterval : 1 = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta=(InlineEditConditionToggle), Category=ArsInstancedActors)
+	uint8 bOverride_MediumLODForcedLodModel : 1 = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta=(InlineEditConditionToggle), Category=ArsInstancedActors)
+	uint8 bOverride_bMediumLODCastShadows : 1 = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta=(InlineEditConditionToggle), Category=ArsInstancedActors)
+	uint8 bOverride_bMediumLODEvaluateWorldPositionOffset : 1 = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta=(InlineEditConditionToggle), Category=ArsInstancedActors)
 	uint8 bOverride_bEjectOnActorMoved : 1 = false;
 
@@ -135,6 +150,9 @@ struct FArsInstancedActorsSettings : public FTableRowBase
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta=(InlineEditConditionToggle), Category=ArsInstancedActors)
 	uint8 bOverride_GameplayTags : 1 = false;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta=(InlineEditConditionToggle), Category=ArsInstancedActors)
+	uint8 bOverride_bMovableInstances : 1 = false;
+
 	// Settings 
 
 	/** Optional shadow casting override applied to instance ISMC's if set (shadow casting settings from ActorClass will be used for ISMC's if unset) */
@@ -153,6 +171,16 @@ struct FArsInstancedActorsSettings : public FTableRowBase
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (EditCondition = "bOverride_bControlPhysicsState"), Category=ArsInstancedActors)
 	bool bControlPhysicsState = true;	
 
+	/**
+	 * Set if code moves these instances at runtime by writing their Mass entities' FTransformFragment. Instances are otherwise assumed
+	 * stationary, as per their stationary Mass representation, with spatial queries answered from locations indexed at spawn.
+	 * Movable instances skip the spatial index, testing every instance's current transform instead.
+	 * Note: Occasional moves of stationary instances can instead be reported via UArsInstancedActorsData::MarkInstanceTransformDirty.
+	 * @see UArsInstancedActorsData::GetOrBuildSpatialIndex
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (EditCondition = "bOverride_bMovableInstances"), Category=ArsInstancedActors)
+	bool bMovableInstances = false;
+
 	static constexpr double DefaultMaxInstanceDistance = 100000.0;
 
 	/** Final draw distance for ISMC instances */
@@ -183,6 +211,32 @@ struct FArsInstancedActorsSettings : public FTableRowBase
 	UPROPERTY(EditAnywhere, Meta = (EditCondition = "bOverride_WorldPositionOffsetDisableDistance"), Category=ArsInstancedActors)
 	int32 WorldPositionOffsetDisableDistance = 5000;
 
+	/** 
+	 * Instance datas are at Medium bulk LOD from DetailedRepresentationLODDistance up to this distance from a viewer, beyond which they're at Low bulk LOD.
+	 * 0 = Use the instance data's low LOD draw distance, computed from mesh screen sizes and ForceLowRepresentationLODDistance.
+	 */
+	UPROPERTY(EditAnywhere, Meta = (EditCondition = "bOverride_MediumLODDistance"), Category=ArsInstancedActors)
+	double MediumLODDistance = 0.0;
+
+	/** Interval in seconds at which bulk LOD is re-evaluated for instance datas at Medium bulk LOD, overriding UArsInstancedActorsStationaryLODBatchProcessor::DelayPerBulkLOD */
+	UPROPERTY(EditAnywhere, Meta = (EditCondition = "bOverride_MediumLODTickInterval", ClampMin = "0.0"), Category=ArsInstancedActors)
+	float MediumLODTickInterval = 1.0f;
+
+	/** 
+	 * Static mesh LOD forced on instance ISMC's at Medium bulk LOD, biasing towards cheaper mesh LODs and materials. 
+	 * 1-based as per UStaticMeshComponent::ForcedLodModel, 0 = not forced. Low bulk LOD always forces the lowest LOD.
+	 */
+	UPROPERTY(EditAnywhere, Meta = (EditCondition = "bOverride_MediumLODForcedLodModel", ClampMin = "0", ClampMax = "8"), Category=ArsInstancedActors)
+	int32 MediumLODForcedLodModel = 0;
+
+	/** If false, instance ISMC's don't cast shadows at Medium bulk LOD */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (EditCondition = "bOverride_bMediumLODCastShadows"), Category=ArsInstancedActors)
+	bool bMediumLODCastShadows = true;
+
+	/** If false, instance ISMC's don't evaluate world position offset at Medium bulk LOD */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (EditCondition = "bOverride_bMediumLODEvaluateWorldPositionOffset"), Category=ArsInstancedActors)
+	bool bMediumLODEvaluateWorldPositionOffset = true;
+
 	/**
 	 * If bEjectOnActorMoved = true, spawned Actors will have their locations monitored and if moved further than 
 	 * ActorEjectionMovementThreshold from their spawn location, they will be 'ejected' from their manager / marked 
@@ -0,0 +1,135 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#pragma once
+
+#include "ArsMechanicaAPI.h"
+
+#include "ArsInstancedActorsIndex.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/BitArray.h"
+#include "Math/Box.h"
+#include "Math/Interval.h"
+#include "Math/OrientedBox.h"
+#include "Math/Sphere.h"
+
+
+namespace UE::ArsInstancedActors
+{
+/**
+ * Compact uniform 2D grid of instance indices for a single UArsInstancedActorsData, used to narrow bounded instance
+ * queries down to a conservative set of candidate instances.
+ *
+ * Built once from world space instance transforms and stored CSR-style: CellStarts holds per-cell offsets into a single
+ * packed CellInstances array. Instances are expected to be stationary once indexed; runtime removals simply clear the
+ * instance's bit in ValidInstances rather than touching the packed arrays, and runtime additions are appended to an unbinned
+ * list that's tested linearly.
+ *
+ * Candidates are gathered by expanding the query bounds by the largest instance bounds extent found while building, so
+ * any instance whose bounds could intersect the query is returned. Callers are still expected to perform exact tests
+ * (e.g. PassesBoundsTest) on each candidate.
+ *
+ * @see UArsInstancedActorsData::GetOrBuildSpatialIndex, AArsInstancedActorsManager::ForEachCandidateInstance
+ */
+struct ARSMECHANICA_API FInstanceSpatialIndex
+{
+	/**
+	 * (Re)builds the index from InstanceTransforms. Invalid (zero scale) transforms are skipped.
+	 * @param InstanceTransforms		Per-instance transforms, indexed by FArsInstancedActorsInstanceIndex
+	 * @param InstanceToWorld			Transform applied to InstanceTransforms to get world space (i.e: the manager transform
+	 *									for local space InstanceTransforms, identity for world space ones)
+	 * @param LocalInstanceBounds		Per-instance local bounds, used to pad queries. May be invalid, in which case only instance
+	 *									locations are considered.
+	 * @param TargetInstancesPerCell	Cell size is chosen to hold roughly this many instances per cell on average
+	 */
+	void Build(TConstArrayView<FTransform> InstanceTransforms, const FTransform& InstanceToWorld, const FBox& LocalInstanceBounds, int32 TargetInstancesPerCell);
+
+	/** Frees all index memory. IsBuilt() will return false afterwards */
+	void Reset();
+
+	bool IsBuilt() const { return CellStarts.Num() > 0; }
+
+	/**
+	 * Adds runtime added instances to an already built index. As the packed cell arrays can't be grown in place, these are kept
+	 * in a separate unbinned list, tested individually by candidate queries.
+	 * @param InstanceIndices		Indices of instances to add, matching WorldTransforms
+	 * @param WorldTransforms		World space transforms of instances to add
+	 * @param LocalInstanceBounds	Per-instance local bounds, used to pad queries. May be invalid, as in Build.
+	 */
+	void AddInstances(TConstArrayView<FArsInstancedActorsInstanceIndex> InstanceIndices, TConstArrayView<FTransform> WorldTransforms, const FBox& LocalInstanceBounds);
+
+	/** Flags InstanceIndex as removed, excluding it from subsequent candidate queries */
+	void RemoveInstance(FArsInstancedActorsInstanceIndex InstanceIndex);
+
+	/** Flags all indexed instances as removed */
+	void RemoveAllInstances();
+
+	/**
+	 * Appends all non-removed instances whose bounds may intersect QueryBounds to OutCandidates.
+	 * @return the number of candidates appended
+	 */
+	int32 GatherCandidates(const FBox& QueryBounds, TArray<FArsInstancedActorsInstanceIndex>& OutCandidates) const;
+	int32 GatherCandidates(const FSphere& QueryBounds, TArray<FArsInstancedActorsInstanceIndex>& OutCandidates) const;
+	int32 GatherCandidates(const FOrientedBox& QueryBounds, TArray<FArsInstancedActorsInstanceIndex>& OutCandidates) const;
+
+	/**
+	 * Coarse presence test for QueryBounds using indexed instance locations alone, skipping cells whose instance bounds lie entirely
+	 * above or below QueryBounds.
+	 * @return true as soon as any non-removed instance location is found inside QueryBounds. Otherwise, instances whose bounds may
+	 *         still overlap QueryBounds are appended to OutOverlapCandidates, for callers to test precisely.
+	 * @see AArsInstancedActorsManager::HasInstancesOfClass
+	 */
+	bool TestOccupancy(const FBox& QueryBounds, TArray<FArsInstancedActorsInstanceIndex>& OutOverlapCandidates) const;
+
+	/** @return world space bounds of all indexed instance locations, padded by the largest instance extent */
+	const FBox& GetIndexedBounds() const { return IndexedBounds; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	FORCEINLINE int32 GetCellIndex(const int32 CellX, const int32 CellY) const
+	{
+		return CellY * GridSize.X + CellX;
+	}
+
+	FIntPoint GetClampedCellCoord(const FVector& Location) const;
+
+	// World space XY origin of cell (0,0)
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+
+	// World space size of a single (square) cell
+	double CellSize = 1.0;
+
+	// Number of cells along X and Y
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+
+	// Largest XY distance from any instance location to the edge of it's world space bounds. Queries are expanded by this
+	// to ensure instances whose locations lie outside the query, but whose bounds may overlap it, are still returned.
+	double QueryPadding = 0.0;
+
+	// As QueryPadding, along Z. Only used by TestOccupancy, as cells aren't divided along Z.
+	double QueryPaddingZ = 0.0;
+
+	// World space bounds of all indexed instances, including QueryPadding. Used for early out of non-overlapping queries.
+	FBox IndexedBounds = FBox(ForceInit);
+
+	// CellStarts[CellIndex] .. CellStarts[CellIndex + 1] is the range of CellInstances within cell CellIndex. Sized to NumCells + 1.
+	TArray<int32> CellStarts;
+
+	// Instance indices, packed by cell
+	TArray<FArsInstancedActorsInstanceIndex> CellInstances;
+
+	// World space instance locations, parallel to CellInstances
+	TArray<FVector> CellInstanceLocations;
+
+	// Per-cell world space Z range covered by it's instances bounds. Invalid for empty cells.
+	TArray<FDoubleInterval> CellZRanges;
+
+	// Bit per instance, set for indexed instances that haven't since been removed
+	TBitArray<> ValidInstances;
+
+	// Instances added via AddInstances after Build, with their world space locations
+	TArray<FArsInstancedActorsInstanceIndex> AddedInstances;
+	TArray<FVector> AddedInstanceLocations;
+};
+} // namespace UE::ArsInstancedActors
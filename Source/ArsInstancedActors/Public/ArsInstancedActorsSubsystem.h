@@ -6,9 +6,13 @@
 
 #include "ArsInstancedActorsDebug.h"
 #include "ArsInstancedActorsManager.h"
+#include "ArsInstancedActorsPhysicsStateCreationQueue.h"
+#include "ArsInstancedActorsReplication.h"
+#include "ArsInstancedActorsTickQueue.h"
 #include "GameplayTagContainer.h"
 #include "HierarchicalHashGrid2D.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "StructUtils/InstancedStruct.h"
 #include "StructUtils/SharedStruct.h"
 #include "UObject/ObjectKey.h"
 #include "ArsInstancedActorsSubsystem.generated.h"
@@ -19,6 +23,9 @@ class UActorPartitionSubsystem;
 class UDataRegistrySubsystem;
 class UArsInstancedActorsModifierVolumeComponent;
 class ULevel;
+class UNetConnection;
+class UStaticMesh;
+struct FStreamableHandle;
 struct FArsInstancedActorsInstanceHandle;
 struct FArsInstancedActorsManagerHandle;
 struct FArsInstancedActorsModifierVolumeHandle;
@@ -27,6 +34,7 @@ class UArsInstancedActorsProjectSettings;
 namespace UE::ArsInstancedActors
 {
 struct FExemplarActorData;
+struct FSharedEntityTemplate;
 } // UE::ArsInstancedActors
 
 /**
@@ -99,6 +107,24 @@ public:
 	FArsInstancedActorsManagerHandle AddManager(AArsInstancedActorsManager& Manager);
 	void RemoveManager(FArsInstancedActorsManagerHandle ManagerHandle);
 
+	/** Re-registers ManagerHandle in ManagersHashGrid after its instance bounds have grown from PreviousManagerBounds, e.g: by runtime instance additions */
+	void UpdateManagerBounds(FArsInstancedActorsManagerHandle ManagerHandle, const FBox& PreviousManagerBounds);
+
+	/**
+	 * Adds runtime instances of ActorClass at WorldTransforms to managers' instance data for ActorClass and AdditionalInstanceTags,
+	 * preferring the closest manager in each transform's ManagersHashGrid cell with matching instance data (with room for more instances).
+	 * Failing that, a new instance data is created in the closest manager in the cell. Additions are replicated and persisted via 
+	 * instance deltas. Authority only.
+	 *
+	 * Note: No new managers are created at runtime, transforms without any manager in their cell are skipped.
+	 * Note: Modifier volumes aren't re-run for added instances, so transforms inside modifier volumes affecting the target manager
+	 *       are skipped, rather than adding instances the volumes would've modified.
+	 * @param OutInstanceHandles	If provided, receives handles for all added instances
+	 * @return the number of instances added
+	 */
+	int32 AddInstances(TSubclassOf<AActor> ActorClass, TConstArrayView<FTransform> WorldTransforms
+		, const FGameplayTagContainer& AdditionalInstanceTags = FGameplayTagContainer(), TArray<FArsInstancedActorsInstanceHandle>* OutInstanceHandles = nullptr);
+
 	FArsInstancedActorsModifierVolumeHandle AddModifierVolume(UArsInstancedActorsModifierVolumeComponent& ModifierVolume);
 	void RemoveModifierVolume(FArsInstancedActorsModifierVolumeHandle ModifierVolumeHandle);
 
@@ -106,7 +132,7 @@ public:
 	void RequestDeferredSpawnEntities(FArsInstancedActorsManagerHandle ManagerHandle);
 
 	/**
-	 * Removes ManagerHandle from PendingManagersToSpawnEntities if present 
+	 * Removes ManagerHandle from PendingManagersToSpawnEntities or ManagersPreparingSpawnEntities if present 
 	 * @return	true if ManagerHandle was present in PendingManagersToSpawnEntities and subsequently removed. False otherwise (list is empty
 	 *			or didn't contain ManagerHandle)
 	 */
@@ -114,7 +140,9 @@ public:
 
 	/**
 	 * Calls AArsInstancedActorsManager::InitializeModifyAndSpawnEntities for all pending managers in PendingManagersToSpawnEntities
-	 * added via RequestDeferredSpawnEntities.
+	 * added via RequestDeferredSpawnEntities, in order of distance to the closest MassLOD viewer.
+	 * With IA.DeferSpawnEntities.AsyncPreparation, managers first prepare spawn data in tasks and are committed in a subsequent call
+	 * once preparation completes. Unbounded calls (StopAfterSeconds = INFINITY) always complete all pending requests.
 	 * @param	StopAfterSeconds	If < INFINITY, requests processing will stop after this time, leaving remaining requests for the next 
 	 *								ExecutePendingDeferredSpawnEntitiesRequests to continue.
 	 */
@@ -123,6 +151,85 @@ public:
 	/** Return true if any deferred spawn entities requests are pending execution by the next ExecutePendingDeferredSpawnEntitiesRequests */
 	bool HasPendingDeferredSpawnEntitiesRequests() const;
 
+	/**
+	 * @return Connection's instance delta relevancy state, with its per-frame budget reset on the first call each frame. Used by
+	 * FArsInstancedActorsDeltaList to record deltas deferred for Connection, which are re-replicated by FlushDeferredInstanceDeltas
+	 * once Connection's view target approaches them.
+	 */
+	UE::ArsInstancedActors::FConnectionDeltaRelevancy& GetConnectionDeltaRelevancy(const UNetConnection& Connection);
+
+	/**
+	 * Queues physics state creation for ISMComponent, executed in Tick -> ExecutePendingPhysicsStateCreations under
+	 * IA.PhysicsStateCreation.MaxTimePerTick and IA.PhysicsStateCreation.MaxBodiesPerTick budgets, closest to viewers first.
+	 * UArsInstancedActorsISMComponent's have their instance bodies created incrementally, spreading large components across frames.
+	 * Called by UArsInstancedActorsStationaryLODBatchProcessor when an instance data switches to Detailed bulk LOD.
+	 * @param DistanceSquared	Squared distance from the closest viewer to ISMComponent's instances, used to prioritize creation
+	 */
+	void RequestDeferredPhysicsStateCreation(UInstancedStaticMeshComponent& ISMComponent, double DistanceSquared);
+
+	/** 
+	 * Removes ISMComponent's pending physics state creation, if any, e.g: prior to destroying it's physics state.
+	 * Note: Instance bodies already created for a partially created UArsInstancedActorsISMComponent are left as is.
+	 * @return	true if ISMComponent had pending physics state creation which was subsequently removed
+	 */
+	bool CancelDeferredPhysicsStateCreation(const UInstancedStaticMeshComponent& ISMComponent);
+
+	/**
+	 * Immediately creates physics state for any of InstanceData's ISMComponents still pending deferred creation. Should be called 
+	 * before relying on instance bodies being present, e.g: before physics queries expected to hit InstanceData's instances.
+	 * Called on actor hydration by UArsInstancedActorsRepresentationActorManagement.
+	 */
+	void FlushDeferredPhysicsStateCreation(const UArsInstancedActorsData& InstanceData);
+
+	/**
+	 * Immediately creates physics state for any ISMComponents still pending deferred creation whose bounds intersect QueryBounds.
+	 * Game code performing overlaps, traces or sweeps expected to hit instances should call this for the query's bounds first.
+	 */
+	void FlushDeferredPhysicsStateCreation(const FBox& QueryBounds);
+
+	/**
+	 * Creates physics state for pending ISMComponents added via RequestDeferredPhysicsStateCreation, in order of distance to the closest viewer.
+	 * UArsInstancedActorsISMComponent's are sliced by body count, remaining at the front of the queue until all their bodies are created.
+	 * At least one instance body is created per call, so processing always makes progress.
+	 * @param	StopAfterSeconds	Processing stops after this time, leaving remaining requests for the next call
+	 * @param	MaxBodies			Processing stops once this many instance bodies have been created, leaving remaining bodies for the next call
+	 * @return	true if all pending requests were executed
+	 */
+	bool ExecutePendingPhysicsStateCreations(double StopAfterSeconds = INFINITY, int32 MaxBodies = MAX_int32);
+
+	/** Return true if ISMComponent has physics state creation pending execution by ExecutePendingPhysicsStateCreations */
+	bool HasPendingPhysicsStateCreation(const UInstancedStaticMeshComponent& ISMComponent) const;
+
+	/**
+	 * Adds InstanceData to InstanceDatasWithPooledVisualizations, for Tick to release its pooled visualizations once expired.
+	 * Called by UArsInstancedActorsData::RemoveVisualization when pooling it's first visualization.
+	 */
+	void RequestPooledVisualizationsRelease(UArsInstancedActorsData& InstanceData);
+
+	/**
+	 * Queues an async load of SoftVisualizationDesc's assets for InstanceData's reserved VisualizationIndex, calling
+	 * UArsInstancedActorsData::OnVisualizationAssetsLoaded once complete. Requests for equal descriptors share a single streaming request.
+	 * Requests start immediately while fewer than IA.VisualizationLoads.MaxConcurrent loads are in flight, which may complete immediately
+	 * for already resident assets. Requests beyond that are queued and started closest to viewers first, as earlier loads complete.
+	 * @see UArsInstancedActorsData::AddVisualizationAsync
+	 */
+	void RequestVisualizationLoad(UArsInstancedActorsData& InstanceData, uint8 VisualizationIndex, const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc);
+
+	/**
+	 * Removes InstanceData's VisualizationIndex from it's pending visualization load, cancelling streaming once no other requesters remain.
+	 * @see RequestVisualizationLoad
+	 */
+	void CancelVisualizationLoad(const UArsInstancedActorsData& InstanceData, uint8 VisualizationIndex);
+
+	/**
+	 * Returns the mesh shown in place of visualizations still loading, or nullptr if no placeholder should be shown.
+	 * @see UArsInstancedActorsProjectSettings::VisualizationLoadPlaceholderMesh
+	 */
+	UStaticMesh* GetVisualizationLoadPlaceholderMesh() const { return VisualizationLoadPlaceholderMesh; }
+
+	/** Returns the number of distinct visualization loads queued or in flight */
+	int32 GetNumPendingVisualizationLoads() const { return VisualizationLoadRequests.Num(); }
+
 	/**
 	 * Retrieves existing or spawns a new ActorClass for introspecting exemplary instance data.
 	 *
@@ -138,6 +245,44 @@ public:
 	 */
 	void UnregisterExemplarActorClass(TSubclassOf<AActor> ActorClass);
 
+	/**
+	 * Called once the last reference to ExemplarActor's FExemplarActorData is released. Retains ExemplarActor for reuse by subsequent
+	 * GetOrCreateExemplarActor calls within IA.ExemplarActorCache.MemoryBudgetMB, evicting the least recently released exemplars once 
+	 * over budget, or destroys it immediately if the cache is disabled.
+	 */
+	void ReleaseExemplarActor(AActor& ExemplarActor);
+
+	/**
+	 * Retrieves existing or builds a new default visualization for ActorClass from its class default object and component templates via
+	 * CreateVisualDescriptionFromActorClassDefaults, without spawning an exemplar actor.
+	 * @return nullptr if no visualization could be deduced from ActorClass's defaults, in which case an exemplar actor should be used instead.
+	 * @see IA.ExemplarActors.UseClassDefaults
+	 */
+	const FArsInstancedActorsVisualizationDesc* GetOrCreateClassDefaultVisualization(TSubclassOf<AActor> ActorClass);
+
+	/**
+	 * Retrieves an existing or builds a new entity template for InstanceData, shared by all instance datas with a matching 
+	 * UArsInstancedActorsData::MakeSharedEntityTemplateKey. The template is destroyed once all returned references are released.
+	 * @see IA.ShareEntityTemplates
+	 */
+	TSharedRef<UE::ArsInstancedActors::FSharedEntityTemplate> GetOrCreateSharedEntityTemplate(UArsInstancedActorsData& InstanceData, const AActor& ExemplarActor);
+
+	/** Retrieves an existing entity template shared with InstanceData's key, if any. @see GetOrCreateSharedEntityTemplate */
+	TSharedPtr<UE::ArsInstancedActors::FSharedEntityTemplate> FindSharedEntityTemplate(const UArsInstancedActorsData& InstanceData) const;
+
+	/**
+	 * @return false if ActorClass has components opting out of entity template sharing, as found building its first template.
+	 * @see UArsInstancedActorsComponent::CanShareEntityTemplate
+	 */
+	bool CanShareEntityTemplates(TSubclassOf<AActor> ActorClass) const;
+
+	/**
+	 * Removes Key's shared entity template from the map
+	 */
+	void UnregisterSharedEntityTemplate(const UE::ArsInstancedActors::FSharedEntityTemplateKey& Key);
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
 	/** 
 	 * Compiles and caches finalized settings for ActorClass based off FArsInstancedActorsClassSettingsBase found in 
 	 * UArsInstancedActorsProjectSettings::ActorClassSettingsRegistryType data registry, for ActorClass and it's 
@@ -149,6 +294,21 @@ public:
 	 */
 	FSharedStruct GetOrCompileSettingsForActorClass(TSubclassOf<AActor> ActorClass);
 
+	/**
+	 * As per GetOrCompileSettingsForActorClass but uses CookedSettings, previously compiled at cook time via CompileSettingsForCook, 
+	 * rather than compiling settings if ActorClass settings aren't cached yet. Falls back to runtime compilation if CookedSettings
+	 * is invalid or of a different type to this subsystem's SettingsType.
+	 */
+	FSharedStruct GetOrAddCookedSettingsForActorClass(TSubclassOf<AActor> ActorClass, const FInstancedStruct& CookedSettings);
+
+#if WITH_EDITOR
+	/**
+	 * Compiles settings for ActorClass to be cooked into instance data, @see IA.CookBakedSettings
+	 * Note: This relies on the settings registries being loaded, i.e: set to preload in editor. Returns an empty struct if they aren't.
+	 */
+	FInstancedStruct CompileSettingsForCook(TSubclassOf<AActor> ActorClass);
+#endif
+
 	/**
 	 * Returns true if ActorClass has a matching FArsInstancedActorsClassSettingsBase entry in 
 	 * UArsInstancedActorsProjectSettings::ActorClassSettingsRegistryType data registry.
@@ -176,6 +336,7 @@ public:
 	void PopAllDirtyRepresentationInstances(TArray<FArsInstancedActorsInstanceHandle>& OutInstances);
 
 	virtual FArsInstancedActorsVisualizationDesc CreateVisualDescriptionFromActor(const AActor& ExemplarActor) const;
+	virtual FArsInstancedActorsVisualizationDesc CreateVisualDescriptionFromActorClassDefaults(TSubclassOf<AActor> ActorClass) const;
 	/*
 	* Called when an additional/alternate VisualizationDesc is registered. Override to make custom modifications to the visual representation
 	*/
@@ -192,20 +353,23 @@ public:
 	virtual void Deinitialize() override;
 	//~ End USubsystem Overrides
 
-	struct FNextTickSharedFragment
-	{
-		FSharedStruct SharedStruct;
-		double NextTickTime = 0;
+	using FNextTickSharedFragment = UE::ArsInstancedActors::FNextTickSharedFragment;
 
-		bool operator<(const FNextTickSharedFragment& Other) const
-		{
-			return NextTickTime < Other.NextTickTime;
-		}
-	};
+	/** @return the queue of all FArsInstancedActorsDataSharedFragment's ordered by next bulk LOD tick time, registering any new ones first */
+	UE::ArsInstancedActors::FSharedFragmentTickQueue& GetTickableSharedFragments();
 
-	TArray<UArsInstancedActorsSubsystem::FNextTickSharedFragment>& GetTickableSharedFragments();
+	/** Reschedules ArsInstancedActorsDataSharedFragment to be ticked by the next bulk LOD update */
 	void UpdateAndResetTickTime(TConstStructView<FArsInstancedActorsDataSharedFragment> ArsInstancedActorsDataSharedFragment);
 
+	/** 
+	 * Schedules SharedFragment for immediate bulk LOD evaluation, whether newly created or previously removed by UnregisterSharedFragment,
+	 * e.g: for an instance data streaming back in and reusing its previous shared fragment.
+	 */
+	void RegisterSharedFragment(const FSharedStruct& SharedFragment);
+
+	/** Removes SharedFragment from bulk LOD evaluation until re-registered with RegisterSharedFragment */
+	void UnregisterSharedFragment(TConstStructView<FArsInstancedActorsDataSharedFragment> SharedFragment);
+
 	TSubclassOf<AArsInstancedActorsManager> GetArsInstancedActorsManagerClass() const 
 	{ 
 		return ArsInstancedActorsManagerClass; 
@@ -213,15 +377,18 @@ public:
 
 protected:
 	/** 
-	 * Fetches all registered FArsInstancedActorsDataSharedFragment from the EntityManager and adds the missing ones to SortedSharedFragments
+	 * Fetches all registered FArsInstancedActorsDataSharedFragment from the EntityManager and bulk adds the new ones to SortedSharedFragments
 	 * @param ArsInstancedActorsDataSharedFragment optionally the function can check if given shared fragment is amongst 
 	 *	the newly added fragments
 	 * @param returns whether ArsInstancedActorsDataSharedFragment has been found, or `true` if that param is not provided. 
 	 */
 	bool RegisterNewSharedFragmentsInternal(TConstStructView<FArsInstancedActorsDataSharedFragment> ArsInstancedActorsDataSharedFragment = TConstStructView<FArsInstancedActorsDataSharedFragment>());
 
-	/** The container storing a sorted queue of FSharedStruct instances, ordered by the NextTickTime */
-	TArray<FNextTickSharedFragment> SortedSharedFragments;
+	/** Indexed priority queue of FSharedStruct instances, ordered by the NextTickTime */
+	UE::ArsInstancedActors::FSharedFragmentTickQueue SortedSharedFragments;
+
+	/** Number of EntityManager's FArsInstancedActorsDataSharedFragment's already added to SortedSharedFragments */
+	int32 NumRegisteredSharedFragments = 0;
 
 	TSharedPtr<FMassEntityManager> EntityManager;
 
@@ -249,8 +416,114 @@ protected:
 	using FModifierVolumesHashGridType = THierarchicalHashGrid2D</*Levels*/3, /*LevelRatio*/4, /*ItemIDType*/FArsInstancedActorsModifierVolumeHandle>;
 	FModifierVolumesHashGridType ModifierVolumesHashGrid;
 
-	// FIFO queue of Managers pending deferred entity spawning in Tick. Enqueued in RequestDeferredSpawnEntities
-	TArray<FArsInstancedActorsManagerHandle> PendingManagersToSpawnEntities;
+	struct FPendingSpawnEntitiesRequest
+	{
+		FArsInstancedActorsManagerHandle ManagerHandle;
+
+		// Squared distance from the closest viewer to the manager's instance bounds. Max if there are no viewers.
+		double DistanceSquared = TNumericLimits<double>::Max();
+
+		// Incrementing request order, keeping equally prioritized requests FIFO
+		uint32 RequestOrder = 0;
+
+		bool operator<(const FPendingSpawnEntitiesRequest& Other) const
+		{
+			return DistanceSquared < Other.DistanceSquared || (DistanceSquared == Other.DistanceSquared && RequestOrder < Other.RequestOrder);
+		}
+	};
+
+	// Gathers MassLOD viewer locations relevant to deferred spawn prioritization, skipping streaming sources and uninitialized viewers
+	void GatherDeferredSpawnViewerLocations(TArray<FVector>& OutViewerLocations) const;
+
+	// @return Squared distance from the closest of ViewerLocations to ManagerHandle's instance bounds
+	double ComputeDeferredSpawnDistanceSquared(FArsInstancedActorsManagerHandle ManagerHandle, TConstArrayView<FVector> ViewerLocations) const;
+
+	// Recomputes PendingManagersToSpawnEntities priorities if viewers have moved more than IA.DeferSpawnEntities.ReprioritizeDistance
+	// since priorities were last computed
+	void UpdateDeferredSpawnEntitiesPriorities();
+
+	// Heap of Managers pending deferred entity spawning in Tick, ordered by distance to the closest viewer.
+	// Enqueued in RequestDeferredSpawnEntities and re-prioritized in UpdateDeferredSpawnEntitiesPriorities.
+	TArray<FPendingSpawnEntitiesRequest> PendingManagersToSpawnEntities;
+
+	// Managers popped from PendingManagersToSpawnEntities which are preparing entity spawn data in tasks, awaiting
+	// AArsInstancedActorsManager::CommitPreparedSpawnEntities once complete. @see IA.DeferSpawnEntities.AsyncPreparation
+	TArray<FArsInstancedActorsManagerHandle> ManagersPreparingSpawnEntities;
+
+	// Every IA.DeltaRelevancy.FlushInterval, re-replicates managers with deltas deferred for connections whose view target has since
+	// come within range of them, or which were deferred by the per-frame budget. Prunes closed connections.
+	void FlushDeferredInstanceDeltas();
+
+	// Per-connection instance delta relevancy state @see GetConnectionDeltaRelevancy
+	TMap<TObjectKey<UNetConnection>, UE::ArsInstancedActors::FConnectionDeltaRelevancy> ConnectionDeltaRelevancies;
+
+	// World time after which FlushDeferredInstanceDeltas will next evaluate ConnectionDeltaRelevancies
+	double NextDeferredInstanceDeltasFlushTime = 0.0;
+
+	// ISMComponents pending physics state creation in Tick, ordered by distance to the closest viewer when requested.
+	// @see RequestDeferredPhysicsStateCreation
+	UE::ArsInstancedActors::FPhysicsStateCreationQueue PendingPhysicsStateCreations;
+
+	uint32 NextPhysicsStateCreationRequestOrder = 0;
+
+	// Instance datas with visualizations pooled by UArsInstancedActorsData::RemoveVisualization, pending release in Tick
+	// @see RequestPooledVisualizationsRelease
+	TArray<TWeakObjectPtr<UArsInstancedActorsData>> InstanceDatasWithPooledVisualizations;
+
+	struct FVisualizationLoadRequester
+	{
+		TWeakObjectPtr<UArsInstancedActorsData> InstanceData;
+		uint8 VisualizationIndex = 0;
+	};
+
+	struct FVisualizationLoadRequest
+	{
+		TArray<FSoftObjectPath> AssetsToLoad;
+
+		// Instance data visualizations waiting on this load, sharing a single streaming request
+		TArray<FVisualizationLoadRequester> Requesters;
+
+		// Valid once started by StartVisualizationLoad
+		TSharedPtr<FStreamableHandle> LoadHandle;
+
+		// Incrementing request order, keeping equally prioritized requests FIFO
+		uint32 RequestOrder = 0;
+	};
+
+	// Starts the closest pending VisualizationLoadRequests to viewers, up to IA.VisualizationLoads.MaxConcurrent in flight
+	void StartPendingVisualizationLoads();
+
+	// Starts streaming SoftVisualizationDesc's pending VisualizationLoadRequests entry, which may complete (and be removed) immediately
+	void StartVisualizationLoad(const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc);
+
+	// IA.VisualizationLoads.MaxConcurrent, with <= 0 meaning unlimited
+	static int32 GetMaxConcurrentVisualizationLoads();
+
+	// Squared distance from the closest of ViewerLocations to any requester of Request
+	double ComputeVisualizationLoadDistanceSquared(const FVisualizationLoadRequest& Request, TConstArrayView<FVector> ViewerLocations) const;
+
+	// Completes SoftVisualizationDesc's load request for all it's requesters
+	void OnVisualizationLoadCompleted(const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc);
+
+	// Visualization loads by descriptor, deduplicating requests across instance datas. @see RequestVisualizationLoad
+	TMap<FArsInstancedActorsSoftVisualizationDesc, FVisualizationLoadRequest> VisualizationLoadRequests;
+
+	// Number of VisualizationLoadRequests with a LoadHandle in flight
+	int32 NumActiveVisualizationLoads = 0;
+
+	// Set whilst in StartPendingVisualizationLoads, so loads completing immediately don't start further loads re-entrantly
+	bool bStartingVisualizationLoads = false;
+
+	uint32 NextVisualizationLoadRequestOrder = 0;
+
+	// Loaded from UArsInstancedActorsProjectSettings::VisualizationLoadPlaceholderMesh on Initialize
+	UPROPERTY(Transient)
+	TObjectPtr<UStaticMesh> VisualizationLoadPlaceholderMesh;
+
+	// Viewer locations PendingManagersToSpawnEntities priorities were last computed against
+	TArray<FVector> DeferredSpawnViewerLocations;
+
+	uint32 NextDeferredSpawnRequestOrder = 0;
 
 	// Instances whose representation is explicitly dirty, e.g: due to actor spawn / despawn replication, requiring immediate representation 
 	// processing even out of 'detailed' representation processing range.
@@ -283,6 +556,35 @@ protected:
 	// @see GetOrCreateExemplarActor
 	TMap<TObjectKey<const UClass>, TWeakPtr<UE::ArsInstancedActors::FExemplarActorData>> ExemplarActors;
 
+	struct FRetainedExemplarActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		SIZE_T ResourceSize = 0;
+	};
+
+	// Released exemplar actors retained for reuse, least recently released first
+	// @see ReleaseExemplarActor
+	TArray<FRetainedExemplarActor> RetainedExemplarActors;
+	SIZE_T RetainedExemplarActorsResourceSize = 0;
+
+	// Takes ActorClass's retained exemplar actor out of RetainedExemplarActors, if any
+	AActor* TakeRetainedExemplarActor(const UClass* ActorClass);
+
+	// Destroys the least recently released exemplar actors until RetainedExemplarActors is within MemoryBudget and MaxActors
+	void EvictRetainedExemplarActors(SIZE_T MemoryBudget, int32 MaxActors);
+
+	// Default visualizations deduced from actor class defaults. Empty visualizations are cached for classes requiring exemplar actors.
+	// @see GetOrCreateClassDefaultVisualization
+	TMap<TObjectKey<const UClass>, FArsInstancedActorsVisualizationDesc> ClassDefaultVisualizations;
+
+	// Entity templates shared between instance datas
+	// @see GetOrCreateSharedEntityTemplate
+	TMap<UE::ArsInstancedActors::FSharedEntityTemplateKey, TWeakPtr<UE::ArsInstancedActors::FSharedEntityTemplate>> SharedEntityTemplates;
+
+	// Actor classes with components opting out of entity template sharing
+	// @see CanShareEntityTemplates
+	TSet<TObjectKey<const UClass>> UnsharedEntityTemplateActorClasses;
+
 	UPROPERTY(Transient)
 	TObjectPtr<const UScriptStruct> SettingsType;
 };
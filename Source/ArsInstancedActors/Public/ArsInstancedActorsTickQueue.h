@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#pragma once
+
+#include "ArsMechanicaAPI.h"
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "StructUtils/SharedStruct.h"
+
+
+namespace UE::ArsInstancedActors
+{
+/** A FArsInstancedActorsDataSharedFragment scheduled for bulk LOD evaluation at NextTickTime */
+struct FNextTickSharedFragment
+{
+	FSharedStruct SharedStruct;
+	double NextTickTime = 0;
+
+	bool operator<(const FNextTickSharedFragment& Other) const
+	{
+		return NextTickTime < Other.NextTickTime;
+	}
+};
+
+/**
+ * Indexed binary min-heap of FArsInstancedActorsDataSharedFragment's ordered by NextTickTime, used to schedule bulk LOD evaluation.
+ *
+ * Each queued FArsInstancedActorsDataSharedFragment stores its current heap slot in TickQueueIndex (INDEX_NONE when not queued),
+ * so shared fragments can be rescheduled or removed in O(log n) without searching the queue.
+ *
+ * @see UArsInstancedActorsSubsystem::GetTickableSharedFragments, UArsInstancedActorsStationaryLODBatchProcessor
+ */
+struct ARSMECHANICA_API FSharedFragmentTickQueue
+{
+	int32 Num() const { return Heap.Num(); }
+	bool IsEmpty() const { return Heap.IsEmpty(); }
+
+	/** @return the shared fragment due to tick soonest. Queue must not be empty */
+	const FNextTickSharedFragment& Top() const
+	{
+		check(Heap.Num() > 0);
+		return Heap[0];
+	}
+
+	/** Adds Item to the queue. Item.SharedStruct must not already be queued */
+	void Push(FNextTickSharedFragment&& Item);
+
+	/** Removes the shared fragment due to tick soonest into OutItem. Queue must not be empty */
+	void Pop(FNextTickSharedFragment& OutItem);
+
+	/**
+	 * Adds all SharedStructs, scheduled at NextTickTime, e.g: for all instance datas of a newly streamed in cell. Rebuilds the
+	 * heap in O(n) when that's cheaper than pushing items individually.
+	 */
+	void PushBulk(TConstArrayView<FSharedStruct> SharedStructs, double NextTickTime);
+
+	/** Reschedules the shared fragment at QueueIndex (i.e: its TickQueueIndex) to tick at NextTickTime */
+	void Reschedule(int32 QueueIndex, double NextTickTime);
+
+	/** Removes the shared fragment at QueueIndex (i.e: its TickQueueIndex) from the queue */
+	void RemoveAt(int32 QueueIndex);
+
+	/** Removes all shared fragments from the queue */
+	void Reset();
+
+private:
+	/** Moves Item into Heap[Index], updating its back-pointer */
+	void Place(int32 Index, FNextTickSharedFragment&& Item);
+	void SiftUp(int32 Index);
+	void SiftDown(int32 Index);
+
+	static int32& GetQueueIndex(const FNextTickSharedFragment& Item);
+
+	TArray<FNextTickSharedFragment> Heap;
+};
+} // UE::ArsInstancedActors
@@ -9,7 +9,9 @@
 #include "ISMPartition/ISMComponentDescriptor.h"
 #include "MassEntityTypes.h"
 #include "MassRepresentationTypes.h"
+#include "StructUtils/SharedStruct.h"
 #include "ArsInstancedActorsIndex.h"
+#include "UObject/ObjectKey.h"
 #include "ArsInstancedActorsTypes.generated.h"
 
 
@@ -17,7 +19,6 @@
 DECLARE_LOG_CATEGORY_EXTERN(LogArsInstancedActors, Log, All)
 
 struct FStaticMeshInstanceVisualizationDesc;
-struct FStreamableHandle;
 struct FMassISMCSharedData;
 class UArsInstancedActorsData;
 class UWorld;
@@ -72,6 +73,29 @@ namespace UE::ArsInstancedActors::Utils
 	UArsInstancedActorsSubsystem* GetArsInstancedActorsSubsystem(const UWorld& World);
 }
 
+namespace UE::ArsInstancedActors
+{
+/**
+ * Registers FragmentType, a FMassFragment, as an instance fragment. Per-instance values set via UArsInstancedActorsData::SetInstanceFragment
+ * are stored in the instance delta list and applied to the instance's entity, replicated to clients with EArsInstancedActorsFragmentFlags::Replicated
+ * and saved with instance persistence data with EArsInstancedActorsFragmentFlags::Persisted, serialized by type.
+ * Typically called on module startup, prior to any instance data loading.
+ */
+ARSMECHANICA_API void RegisterInstanceFragmentType(const UScriptStruct& FragmentType, EArsInstancedActorsFragmentFlags Flags);
+
+template<typename T>
+void RegisterInstanceFragmentType(EArsInstancedActorsFragmentFlags Flags)
+{
+	static_assert(TIsDerivedFrom<T, FMassFragment>::Value, "Only FMassFragment types can be registered as instance fragments");
+	RegisterInstanceFragmentType(*T::StaticStruct(), Flags);
+}
+
+ARSMECHANICA_API void UnregisterInstanceFragmentType(const UScriptStruct& FragmentType);
+
+/** @return The flags FragmentType was registered with via RegisterInstanceFragmentType, or None if it wasn't */
+ARSMECHANICA_API EArsInstancedActorsFragmentFlags GetInstanceFragmentTypeFlags(const UScriptStruct* FragmentType);
+} // namespace UE::ArsInstancedActors
+
 // FArsInstancedActorsTagSet -> FArsInstancedActorsTagSet
 /** An immutable hashed tag container used to categorize / partition instances */
 USTRUCT(BlueprintType)
@@ -134,6 +158,11 @@ struct FArsInstancedActorsVisualizationDesc
 	FArsInstancedActorsVisualizationDesc() = default;
 	explicit FArsInstancedActorsVisualizationDesc(const FArsInstancedActorsSoftVisualizationDesc& SoftVisualizationDesc);
 
+	bool operator==(const FArsInstancedActorsVisualizationDesc& Other) const
+	{
+		return ISMComponentDescriptors == Other.ISMComponentDescriptors && CustomDataFloats == Other.CustomDataFloats;
+	}
+
 	/**
 	 * Array of Instanced Static Mesh Component descriptors. An ISMC will be created for each of these, using the specified mesh, material,
 	 * collision settings etc. Instanced Actors using this visualization will add an instance to each of these, allowing for composite mesh
@@ -161,6 +190,14 @@ struct FArsInstancedActorsVisualizationDesc
 	 */	
 	static FArsInstancedActorsVisualizationDesc FromActor(const AActor& ExemplarActor, const FVisualizationDescSetupFunction& AdditionalSetupFunction = [](const AActor& /*ExemplarActor*/, FArsInstancedActorsVisualizationDesc& /*OutVisualization*/){});
 
+	/**
+	 * As per FromActor but deduces the instanced static mesh representation from ActorClass's class default object and its native and
+	 * blueprint (SCS) component templates, without spawning an exemplar actor.
+	 * Note: Construction scripts are not run, so any meshes, visibility or transforms set up there are not reflected.
+	 * @see IA.ExemplarActors.UseClassDefaults
+	 */
+	static FArsInstancedActorsVisualizationDesc FromActorClassDefaults(TSubclassOf<AActor> ActorClass);
+
 	FStaticMeshInstanceVisualizationDesc ToMassVisualizationDesc() const;
 
 	friend inline uint32 GetTypeHash(const FArsInstancedActorsVisualizationDesc& InDesc)
@@ -186,6 +223,11 @@ struct FArsInstancedActorsSoftVisualizationDesc
 	FArsInstancedActorsSoftVisualizationDesc() = default;
 	explicit FArsInstancedActorsSoftVisualizationDesc(const FArsInstancedActorsVisualizationDesc& VisualizationDesc);
 
+	bool operator==(const FArsInstancedActorsSoftVisualizationDesc& Other) const
+	{
+		return ISMComponentDescriptors == Other.ISMComponentDescriptors;
+	}
+
 	/**
 	 * Array of Instanced Static Mesh Component descriptors. An ISMC will be created for each of these, using the specified mesh, material,
 	 * collision settings etc. Instanced Actors using this visualization will add an instance to each of these, allowing for composite mesh
@@ -195,7 +237,67 @@ struct FArsInstancedActorsSoftVisualizationDesc
 	TArray<FSoftISMComponentDescriptor> ISMComponentDescriptors;
 
 	void GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssetsToLoad) const;
+
+	/**
+	 * Builds a visualization with an ISMC per ISMComponentDescriptors entry, keeping their settings but rendering PlaceholderMesh without
+	 * material overrides. Shown by UArsInstancedActorsData::AddVisualizationAsync until the descriptor's assets are loaded.
+	 */
+	FArsInstancedActorsVisualizationDesc ToPlaceholderVisualizationDesc(UStaticMesh& PlaceholderMesh) const;
+
+	friend inline uint32 GetTypeHash(const FArsInstancedActorsSoftVisualizationDesc& InDesc)
+	{
+		uint32 Hash = 0;
+		for (const FSoftISMComponentDescriptor& InstancedMesh : InDesc.ISMComponentDescriptors)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(InstancedMesh));
+		}
+		return Hash;
+	}
+};
+
+
+namespace UE::ArsInstancedActors
+{
+/**
+ * Identifies UArsInstancedActorsData which can share a single entity template: those of the same class spawning the same 
+ * actor class, with matching combined tags, compiled settings and default visualization.
+ * Settings and visualization are hashed for lookup, then compared in full on hash matches.
+ * @see UArsInstancedActorsData::MakeSharedEntityTemplateKey
+ */
+struct FSharedEntityTemplateKey
+{
+	TObjectKey<const UClass> InstanceDataClass;
+	TObjectKey<const UClass> ActorClass;
+	FGameplayTagContainer CombinedTags;
+	FConstSharedStruct Settings;
+	FArsInstancedActorsVisualizationDesc VisualizationDesc;
+	uint32 SettingsHash = 0;
+	uint32 VisualizationHash = 0;
+
+	// Non-zero to opt out of sharing, set to the requesting IAD's unique ID when IA.ShareEntityTemplates is disabled or
+	// ActorClass has components opting out via UArsInstancedActorsComponent::CanShareEntityTemplate
+	uint32 UnsharedID = 0;
+
+	ARSMECHANICA_API bool operator==(const FSharedEntityTemplateKey& Other) const;
+
+	friend uint32 GetTypeHash(const FSharedEntityTemplateKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.InstanceDataClass), GetTypeHash(Key.ActorClass));
+		Hash = HashCombine(Hash, Key.SettingsHash);
+		Hash = HashCombine(Hash, Key.VisualizationHash);
+
+		// CombinedTags order depends on how AdditionalTags and settings tags were appended, so hash order-independently
+		uint32 TagsHash = 0;
+		for (const FGameplayTag& Tag : Key.CombinedTags)
+		{
+			TagsHash ^= GetTypeHash(Tag);
+		}
+		Hash = HashCombine(Hash, TagsHash);
+
+		return HashCombine(Hash, Key.UnsharedID);
+	}
 };
+} // namespace UE::ArsInstancedActors
 
 
 /** Runtime ISMC tracking for a given 'visualization' (alternate ISMC set) for instances */
@@ -207,9 +309,10 @@ struct FArsInstancedActorsVisualizationInfo
 	/**
 	 * Returns true if this visualization was added view UArsInstancedActorsData::AddVisualizationAsync and streaming is still in-progress.
 	 * Once streaming completes, Desc, ISMComponents and MassStaticMeshDescIndex will be valid and this returns false.
-	 * Note: Until streaming completes, Desc, ISMComponents & MassStaticMeshDescIndex will all be defayult values / unset.
+	 * Note: Until streaming completes, Desc, ISMComponents & MassStaticMeshDescIndex will all be defayult values / unset, or describe
+	 *       placeholder ISMCs if UArsInstancedActorsProjectSettings::VisualizationLoadPlaceholderMesh is set.
 	 */
-	FORCEINLINE bool IsAsyncLoading() const { return AssetLoadHandle.IsValid(); }
+	FORCEINLINE bool IsAsyncLoading() const { return bAsyncLoading; }
 
 	/**
 	 * Cached specification for this visualization, defining ISMCs to create.
@@ -237,9 +340,9 @@ struct FArsInstancedActorsVisualizationInfo
 	UPROPERTY(VisibleAnywhere, Category = ArsInstancedActors)
 	FStaticMeshInstanceVisualizationDescHandle MassStaticMeshDescHandle;
 
-	// If this visualization was added with UArsInstancedActorsData::AddVisualizationAsync, this will be set to the async streaming request 
-	// until streaming is complete, whereupon this handle is cleared.
-	TSharedPtr<FStreamableHandle> AssetLoadHandle;
+	// If this visualization was added with UArsInstancedActorsData::AddVisualizationAsync, this will be set until streaming (scheduled by
+	// UArsInstancedActorsSubsystem::RequestVisualizationLoad) is complete, whereupon this is cleared.
+	bool bAsyncLoading = false;
 
 	/** Used to track version of data used to create CollisionIndexToEntityIndexMap */
 	mutable uint16 CachedTouchCounter = 0;
@@ -325,7 +428,7 @@ private:
  * @todo This will be addressed in the future by refactoring where this data is stored and how it's used.
  */
 USTRUCT()
-struct FArsInstancedActorsDataSharedFragment : public FMassSharedFragment
+struct ARSMECHANICA_API FArsInstancedActorsDataSharedFragment : public FMassSharedFragment
 {
 	GENERATED_BODY()
 
@@ -335,6 +438,12 @@ struct FArsInstancedActorsDataSharedFragment : public FMassSharedFragment
 	EArsInstancedActorsBulkLOD BulkLOD = EArsInstancedActorsBulkLOD::MAX;
 
 	double LastTickTime = 0.0;
+
+	// World time at which BulkLOD last changed, used to enforce IA.BulkLOD.MinDwellTime
+	double BulkLODChangeTime = 0.0;
+
+	// Slot in UArsInstancedActorsSubsystem's tick queue, or INDEX_NONE if not currently queued. @see UE::ArsInstancedActors::FSharedFragmentTickQueue
+	int32 TickQueueIndex = INDEX_NONE;
 };
 
 USTRUCT()
@@ -13,7 +13,9 @@ struct FMassRepresentationFragment;
 
 /**
  * Executes on entities with FArsInstancedActorsMeshSwitchFragment's, processing them as `pending requests` to switch to
- * the specified NewStaticMeshDescHandle, then removing the fragments once complete
+ * the specified NewStaticMeshDescHandle, then removing the fragments once complete.
+ * Also applies switches queued via UArsInstancedActorsRepresentationSubsystem::RequestVisualizationSwitches in bulk, per
+ * new static mesh desc, without the archetype changes of adding and removing switch fragments.
  */
 UCLASS(MinimalAPI)
 class ARSMECHANICA_API UArsInstancedActorsVisualizationSwitcherProcessor : public UMassProcessor
@@ -32,5 +34,11 @@ protected:
 	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
 	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
 
+	// Applies all switches queued in UArsInstancedActorsRepresentationSubsystem
+	void ExecutePendingSwitches(FMassEntityManager& EntityManager, FMassExecutionContext& Context);
+
 	FMassEntityQuery EntityQuery;
+
+	// Query for entities with queued switches, executed over entity collections built from the queued entities
+	FMassEntityQuery PendingSwitchQuery;
 };
@@ -6,6 +6,8 @@
 
 #include "ArsInstancedActorsIndex.h"
 #include "MassActorSpawnerSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/ObjectKey.h"
 #include "ServerArsInstancedActorsSpawnerSubsystem.generated.h"
 
 
@@ -14,6 +16,7 @@ struct FMassEntityManager;
 class UArsInstancedActorsComponent;
 struct FArsInstancedActorsInstanceHandle;
 struct FActorSpawnParameters;
+struct FMassActorSpawnRequest;
 
 /**
  * Dedicated UMassActorSpawnerSubsystem subclass handling server-side Actor spawning for InstancedActor.
@@ -58,5 +61,35 @@ protected:
 
 	UPROPERTY(Transient)
 	mutable FArsInstancedActorsInstanceHandle TransientActorSpawningInstance;
+
+	// Reuses a parked actor of SpawnRequest's class, if any, re-initializing it for InstanceHandle
+	AActor* RetrieveActorFromPool(const FMassActorSpawnRequest& SpawnRequest, const FArsInstancedActorsInstanceHandle& InstanceHandle) const;
+
+	// Destroys all parked actors
+	void EmptyActorPool();
+
+	// Component state disabled by ReleaseActorToPool while parked, restored by RetrieveActorFromPool
+	struct FPooledComponentState
+	{
+		TWeakObjectPtr<UActorComponent> Component;
+		ECollisionEnabled::Type CollisionEnabled = ECollisionEnabled::NoCollision;
+		bool bTickEnabled = false;
+		bool bVisible = false;
+	};
+
+	// A parked actor along with the actor and component state ReleaseActorToPool disabled
+	struct FPooledActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TArray<FPooledComponentState> ComponentStates;
+		bool bActorTickEnabled = false;
+		bool bActorEnableCollision = false;
+		bool bActorHiddenInGame = false;
+	};
+
+	// Hydrated actors released by ReleaseActorToPool, parked hidden and without collision, replication or ticking for reuse in SpawnActor.
+	// Mutable as SpawnActor is const.
+	// @see IA.ActorPooling
+	mutable TMap<TObjectKey<const UClass>, TArray<FPooledActor>> ActorPool;
 };
 
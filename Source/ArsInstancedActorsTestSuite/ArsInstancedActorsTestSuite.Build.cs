@@ -15,6 +15,8 @@ namespace UnrealBuildTool.Rules
 					"Core",
 					"CoreUObject",
 					"Engine",
+					"MassEntity",
+					"NetCore",
 					"ArsInstancedActors",
 					"AITestSuite",
 				}
@@ -0,0 +1,19 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#include "ArsInstancedActorsBenchmarkActor.h"
+#include "ArsInstancedActorsComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "UObject/ConstructorHelpers.h"
+
+
+AArsInstancedActorsBenchmarkActor::AArsInstancedActorsBenchmarkActor()
+{
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMesh(TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+	StaticMeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("StaticMesh"));
+	StaticMeshComponent->SetStaticMesh(CubeMesh.Object);
+	RootComponent = StaticMeshComponent;
+
+	InstancedActorsComponent = CreateDefaultSubobject<UArsInstancedActorsComponent>(TEXT("InstancedActors"));
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "ArsInstancedActorsManager.h"
+#include "ArsInstancedActorsBenchmarkActor.generated.h"
+
+
+class UArsInstancedActorsComponent;
+class UStaticMeshComponent;
+
+/** 
+ * Minimal instanced actor class used by the Instanced Actors benchmarks: a single engine cube static mesh plus a 
+ * UArsInstancedActorsComponent, so entity templates, visualization and persistence take their usual paths.
+ */
+UCLASS(NotPlaceable, NotBlueprintable, HideDropdown)
+class AArsInstancedActorsBenchmarkActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AArsInstancedActorsBenchmarkActor();
+
+	UPROPERTY(VisibleAnywhere, Category=ArsInstancedActors)
+	TObjectPtr<UStaticMeshComponent> StaticMeshComponent;
+
+	UPROPERTY(VisibleAnywhere, Category=ArsInstancedActors)
+	TObjectPtr<UArsInstancedActorsComponent> InstancedActorsComponent;
+};
+
+/** Manager exposing the persistence and entity lifetime hooks the Instanced Actors benchmarks drive directly */
+UCLASS(NotPlaceable, NotBlueprintable, HideDropdown)
+class AArsInstancedActorsBenchmarkManager : public AArsInstancedActorsManager
+{
+	GENERATED_BODY()
+
+public:
+	using AArsInstancedActorsManager::SerializePersistenceRecords;
+	using AArsInstancedActorsManager::DespawnAllEntities;
+	using AArsInstancedActorsManager::OnPersistentDataRestored;
+};
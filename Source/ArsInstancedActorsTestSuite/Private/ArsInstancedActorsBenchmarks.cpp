@@ -0,0 +1,552 @@
+// Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
+
+#include "AITestsCommon.h"
+#include "ArsInstancedActorsBenchmarkActor.h"
+#include "ArsInstancedActorsCustomVersion.h"
+#include "ArsInstancedActorsData.h"
+#include "ArsInstancedActorsIteration.h"
+#include "ArsInstancedActorsManager.h"
+#include "ArsInstancedActorsStationaryLODBatchProcessor.h"
+#include "ArsInstancedActorsSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "MassEntitySubsystem.h"
+#include "MassExecutionContext.h"
+#include "MassExecutor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/CoreNet.h"
+
+#define LOCTEXT_NAMESPACE "ArsInstancedActorsBenchmarks"
+
+/**
+ * Instanced Actors benchmarks and stress tests.
+ *
+ * Builds synthetic managers of AArsInstancedActorsBenchmarkActor instances in a headless game world (no scenes, physics,
+ * navigation or audio) and times the runtime hot paths: entity spawning & despawning, bounded ForEachInstance queries, the
+ * bulk LOD batch processor, persistence save & load and delta list replication serialization.
+ *
+ * Runs under -nullrhi, e.g:
+ *   UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests System.ArsInstancedActors.Benchmark; Quit"
+ *
+ * Sizes are configured via IA.Benchmark.* CVars (e.g: -ini:Engine:[ConsoleVariables]:IA.Benchmark.NumInstances=500000). Each timing
+ * is logged, reported as automation telemetry and written as a JSON line to IA.Benchmark.OutputFile for CI to track.
+ */
+
+#if WITH_EDITOR
+
+DEFINE_LOG_CATEGORY_STATIC(LogArsInstancedActorsBenchmark, Log, All);
+
+namespace UE::ArsInstancedActors::Benchmark
+{
+	namespace CVars
+	{
+		int32 NumInstances = 100000;
+		FAutoConsoleVariableRef CVarNumInstances(
+			TEXT("IA.Benchmark.NumInstances"),
+			NumInstances,
+			TEXT("Total number of instances to create for Instanced Actors benchmarks, spread evenly across IA.Benchmark.NumInstanceDatas."),
+			ECVF_Default);
+
+		int32 NumInstanceDatas = 16;
+		FAutoConsoleVariableRef CVarNumInstanceDatas(
+			TEXT("IA.Benchmark.NumInstanceDatas"),
+			NumInstanceDatas,
+			TEXT("Number of instance datas to create for Instanced Actors benchmarks. Each is created in its own manager, laid out in a grid."),
+			ECVF_Default);
+
+		int32 NumIterations = 3;
+		FAutoConsoleVariableRef CVarNumIterations(
+			TEXT("IA.Benchmark.NumIterations"),
+			NumIterations,
+			TEXT("Number of times to rebuild managers and repeat each Instanced Actors benchmark measurement."),
+			ECVF_Default);
+
+		int32 NumQueries = 256;
+		FAutoConsoleVariableRef CVarNumQueries(
+			TEXT("IA.Benchmark.NumQueries"),
+			NumQueries,
+			TEXT("Number of bounded ForEachInstance queries per Instanced Actors benchmark iteration."),
+			ECVF_Default);
+
+		float QueryExtent = 2500.0f;
+		FAutoConsoleVariableRef CVarQueryExtent(
+			TEXT("IA.Benchmark.QueryExtent"),
+			QueryExtent,
+			TEXT("Half extent of the boxes used for bounded ForEachInstance queries in Instanced Actors benchmarks."),
+			ECVF_Default);
+
+		float DestroyedInstanceRatio = 0.1f;
+		FAutoConsoleVariableRef CVarDestroyedInstanceRatio(
+			TEXT("IA.Benchmark.DestroyedInstanceRatio"),
+			DestroyedInstanceRatio,
+			TEXT("Ratio of instances destroyed (as if by players) before persistence and replication benchmarks, populating instance delta lists."),
+			ECVF_Default);
+
+		FString OutputFile;
+		FAutoConsoleVariableRef CVarOutputFile(
+			TEXT("IA.Benchmark.OutputFile"),
+			OutputFile,
+			TEXT("File to append Instanced Actors benchmark timings to as JSON lines. Defaults to <Saved>/Automation/ArsInstancedActorsBenchmarks.jsonl"),
+			ECVF_Default);
+	} // CVars
+
+	// Size of each manager's grid cell instances are scattered in
+	static constexpr double ManagerCellSize = 25600.0;
+
+	/**
+	 * Stand in for a net driver's replication layouts, so delta lists can be NetDeltaSerialize'd without net connections. Items
+	 * use their native NetSerialize where present, otherwise binary property serialization, approximating replicated bandwidth and cost.
+	 */
+	class FBenchmarkNetSerializeCB : public INetSerializeCB
+	{
+	public:
+		virtual void NetSerializeStruct(FNetDeltaSerializeInfo& Params) override
+		{
+			FBitArchive& Archive = Params.Reader ? static_cast<FBitArchive&>(*Params.Reader) : static_cast<FBitArchive&>(*Params.Writer);
+			UScriptStruct* Struct = CastChecked<UScriptStruct>(Params.Struct);
+			if (EnumHasAnyFlags(Struct->StructFlags, STRUCT_NetSerializeNative))
+			{
+				Struct->GetCppStructOps()->NetSerialize(Archive, Params.Map, Params.bOutSuccessful, Params.Data);
+			}
+			else
+			{
+				Struct->SerializeBin(Archive, Params.Data);
+			}
+		}
+
+		virtual void GatherGuidReferencesForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool MoveGuidToUnmappedForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+		virtual void UpdateUnmappedGuidsForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool NetDeltaSerializeForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+	};
+
+	/** Headless test world with synthetic managers, timing and reporting */
+	struct FBenchmarkTestBase : public FAITestBase
+	{
+		virtual bool SetUp() override
+		{
+			// Always defer entity spawning so it can be timed separately from manager registration
+			DeferSpawnEntitiesCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("IA.DeferSpawnEntities"));
+			if (DeferSpawnEntitiesCVar)
+			{
+				bPreviousDeferSpawnEntities = DeferSpawnEntitiesCVar->GetBool();
+				DeferSpawnEntitiesCVar->Set(true, ECVF_SetByCode);
+			}
+
+			UWorld::InitializationValues IVS;
+			IVS.InitializeScenes(false);
+			IVS.AllowAudioPlayback(false);
+			IVS.RequiresHitProxies(false);
+			IVS.CreatePhysicsScene(false);
+			IVS.CreateNavigation(false);
+			IVS.CreateAISystem(false);
+			IVS.ShouldSimulatePhysics(false);
+			IVS.EnableTraceCollision(false);
+			IVS.SetTransactional(false);
+			IVS.CreateFXSystem(false);
+
+			BenchmarkWorld = UWorld::CreateWorld(EWorldType::Game,
+				/*bInformEngineOfWorld*/false,
+				/*WorldName*/TEXT("ArsInstancedActorsBenchmarkWorld"),
+				/*Package*/nullptr,
+				/*bAddToRoot*/true,
+				ERHIFeatureLevel::Num,
+				&IVS);
+			AITEST_NOT_NULL(TEXT("Benchmark world"), BenchmarkWorld);
+
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(BenchmarkWorld);
+
+			BenchmarkWorld->InitializeActorsForPlay(FURL());
+			BenchmarkWorld->BeginPlay();
+
+			InstancedActorSubsystem = BenchmarkWorld->GetSubsystem<UArsInstancedActorsSubsystem>();
+			AITEST_NOT_NULL(TEXT("UArsInstancedActorsSubsystem"), InstancedActorSubsystem);
+
+			UMassEntitySubsystem* EntitySubsystem = BenchmarkWorld->GetSubsystem<UMassEntitySubsystem>();
+			AITEST_NOT_NULL(TEXT("UMassEntitySubsystem"), EntitySubsystem);
+			EntityManager = EntitySubsystem->GetMutableEntityManager().AsShared();
+
+			return true;
+		}
+
+		virtual void TearDown() override
+		{
+			DestroyManagers();
+			WriteResults();
+
+			InstancedActorSubsystem = nullptr;
+			EntityManager.Reset();
+
+			if (BenchmarkWorld)
+			{
+				GEngine->DestroyWorldContext(BenchmarkWorld);
+				BenchmarkWorld->DestroyWorld(/*bInformEngineOfWorld*/false);
+				BenchmarkWorld->RemoveFromRoot();
+				BenchmarkWorld = nullptr;
+			}
+
+			if (DeferSpawnEntitiesCVar)
+			{
+				DeferSpawnEntitiesCVar->Set(bPreviousDeferSpawnEntities, ECVF_SetByCode);
+			}
+
+			FAITestBase::TearDown();
+		}
+
+		/**
+		 * Spawns NumInstanceDatas managers in a grid, each with one instance data of NumInstances / NumInstanceDatas randomly
+		 * placed AArsInstancedActorsBenchmarkActor instances. Managers register with the subsystem in BeginPlay, pending deferred
+		 * entity spawning.
+		 */
+		void BuildManagers(const int32 NumInstances, const int32 NumInstanceDatas)
+		{
+			check(BenchmarkWorld);
+			const int32 NumManagers = FMath::Max(NumInstanceDatas, 1);
+			const int32 NumInstancesPerManager = FMath::DivideAndRoundUp(FMath::Max(NumInstances, 0), NumManagers);
+			const int32 GridWidth = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumManagers)));
+
+			for (int32 ManagerIndex = 0; ManagerIndex < NumManagers; ++ManagerIndex)
+			{
+				const FVector ManagerLocation((ManagerIndex % GridWidth) * ManagerCellSize, (ManagerIndex / GridWidth) * ManagerCellSize, 0.0);
+
+				FActorSpawnParameters SpawnParameters;
+				SpawnParameters.bDeferConstruction = true;
+				AArsInstancedActorsBenchmarkManager* Manager = BenchmarkWorld->SpawnActor<AArsInstancedActorsBenchmarkManager>(FTransform(ManagerLocation), SpawnParameters);
+				check(Manager);
+
+				UArsInstancedActorsData& InstanceData = Manager->GetOrCreateActorInstanceData(AArsInstancedActorsBenchmarkActor::StaticClass()
+					, FArsInstancedActorsTagSet(), /*bCreateEditorPreviewISMCs*/false);
+
+				// Deterministic placement so iterations and runs are comparable
+				FRandomStream RandomStream(ManagerIndex);
+				for (int32 InstanceIndex = 0; InstanceIndex < NumInstancesPerManager && InstanceData.CanAddInstance(); ++InstanceIndex)
+				{
+					const FVector InstanceLocation = ManagerLocation + FVector(RandomStream.FRandRange(0.0, ManagerCellSize), RandomStream.FRandRange(0.0, ManagerCellSize), 0.0);
+					const FRotator InstanceRotation(0.0, RandomStream.FRandRange(0.0, 360.0), 0.0);
+					InstanceData.AddInstance(FTransform(InstanceRotation, InstanceLocation), /*bWorldSpace*/true);
+				}
+
+				Manager->SetupLoadedInstances();
+				Manager->FinishSpawning(FTransform(ManagerLocation));
+
+				Managers.Add(Manager);
+			}
+
+			WorldBounds = FBox(FVector::ZeroVector, FVector(GridWidth * ManagerCellSize, FMath::DivideAndRoundUp(NumManagers, GridWidth) * ManagerCellSize, 0.0));
+		}
+
+		void DestroyManagers()
+		{
+			for (AArsInstancedActorsBenchmarkManager* Manager : Managers)
+			{
+				if (IsValid(Manager))
+				{
+					Manager->Destroy();
+				}
+			}
+			Managers.Reset();
+		}
+
+		int32 GetNumValidInstances() const
+		{
+			int32 NumValidInstances = 0;
+			for (const AArsInstancedActorsBenchmarkManager* Manager : Managers)
+			{
+				NumValidInstances += Manager->GetNumValidInstances();
+			}
+			return NumValidInstances;
+		}
+
+		int32 GetNumInstanceDatas() const
+		{
+			int32 NumInstanceDatas = 0;
+			for (const AArsInstancedActorsBenchmarkManager* Manager : Managers)
+			{
+				NumInstanceDatas += Manager->GetAllInstanceData().Num();
+			}
+			return NumInstanceDatas;
+		}
+
+		/** Destroys Ratio of each instance data's instances as if by players, generating persisted and replicated instance deltas */
+		void DestroyInstances(const float Ratio, const int32 Seed)
+		{
+			FRandomStream RandomStream(Seed);
+			for (AArsInstancedActorsBenchmarkManager* Manager : Managers)
+			{
+				for (UArsInstancedActorsData* InstanceData : Manager->GetAllInstanceData())
+				{
+					for (int32 InstanceIndex = 0; InstanceIndex < InstanceData->GetNumInstances(); ++InstanceIndex)
+					{
+						const FArsInstancedActorsInstanceHandle InstanceHandle(*InstanceData, FArsInstancedActorsInstanceIndex(InstanceIndex));
+						if (RandomStream.FRand() < Ratio && Manager->IsValidInstance(InstanceHandle))
+						{
+							InstanceData->DestroyInstance(FArsInstancedActorsInstanceIndex(InstanceIndex));
+						}
+					}
+				}
+			}
+		}
+
+		/** Times Function as Name, recording the result for Iteration */
+		template<typename FunctionType>
+		double Measure(const TCHAR* Name, const int32 Iteration, FunctionType&& Function)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Function();
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+			FTimingResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Name;
+			Result.Iteration = Iteration;
+			Result.Seconds = Seconds;
+			Result.NumInstances = GetNumValidInstances();
+			Result.NumInstanceDatas = GetNumInstanceDatas();
+
+			UE_LOG(LogArsInstancedActorsBenchmark, Display, TEXT("%s"), *Result.ToJson(GetTestName()));
+			GetTestRunner().AddTelemetryData(Name, Seconds * 1000.0, FString::Printf(TEXT("%d instances, %d instance datas"), Result.NumInstances, Result.NumInstanceDatas));
+
+			return Seconds;
+		}
+
+		/** Appends all results to IA.Benchmark.OutputFile as JSON lines */
+		void WriteResults() const
+		{
+			if (Results.IsEmpty())
+			{
+				return;
+			}
+
+			const FString OutputFile = CVars::OutputFile.IsEmpty()
+				? FPaths::Combine(FPaths::AutomationDir(), TEXT("ArsInstancedActorsBenchmarks.jsonl")) : CVars::OutputFile;
+
+			FString Lines;
+			for (const FTimingResult& Result : Results)
+			{
+				Lines += Result.ToJson(GetTestName());
+				Lines += LINE_TERMINATOR;
+			}
+
+			if (!FFileHelper::SaveStringToFile(Lines, *OutputFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+			{
+				UE_LOG(LogArsInstancedActorsBenchmark, Warning, TEXT("Failed to write benchmark results to %s"), *OutputFile);
+			}
+		}
+
+		FString GetTestName() const
+		{
+			return GetTestRunner().GetTestFullName();
+		}
+
+		struct FTimingResult
+		{
+			FString Name;
+			int32 Iteration = 0;
+			double Seconds = 0.0;
+			int32 NumInstances = 0;
+			int32 NumInstanceDatas = 0;
+
+			FString ToJson(const FString& TestName) const
+			{
+				return FString::Printf(TEXT("{\"test\":\"%s\",\"measurement\":\"%s\",\"iteration\":%d,\"ms\":%.4f,\"instances\":%d,\"instance_datas\":%d,\"platform\":\"%s\"}")
+					, *TestName, *Name, Iteration, Seconds * 1000.0, NumInstances, NumInstanceDatas, ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()));
+			}
+		};
+
+		UWorld* BenchmarkWorld = nullptr;
+		UArsInstancedActorsSubsystem* InstancedActorSubsystem = nullptr;
+		TSharedPtr<FMassEntityManager> EntityManager;
+		TArray<AArsInstancedActorsBenchmarkManager*> Managers;
+		FBox WorldBounds = FBox(ForceInit);
+		TArray<FTimingResult> Results;
+
+		IConsoleVariable* DeferSpawnEntitiesCVar = nullptr;
+		bool bPreviousDeferSpawnEntities = true;
+	};
+} // UE::ArsInstancedActors::Benchmark
+
+namespace FArsInstancedActorsBenchmarkTest
+{
+	using namespace UE::ArsInstancedActors::Benchmark;
+
+	/** Times each runtime hot path in turn, rebuilding the managers every iteration */
+	struct FHotPaths : FBenchmarkTestBase
+	{
+		virtual bool InstantTest() override
+		{
+			UArsInstancedActorsStationaryLODBatchProcessor* LODBatchProcessor = NewObject<UArsInstancedActorsStationaryLODBatchProcessor>(BenchmarkWorld);
+			LODBatchProcessor->CallInitialize(BenchmarkWorld, EntityManager.ToSharedRef());
+
+			FBenchmarkNetSerializeCB NetSerializeCB;
+
+			for (int32 Iteration = 0; Iteration < FMath::Max(CVars::NumIterations, 1); ++Iteration)
+			{
+				Measure(TEXT("RegisterManagers"), Iteration, [this]()
+				{
+					BuildManagers(CVars::NumInstances, CVars::NumInstanceDatas);
+				});
+
+				Measure(TEXT("SpawnEntities"), Iteration, [this]()
+				{
+					InstancedActorSubsystem->ExecutePendingDeferredSpawnEntitiesRequests();
+				});
+				AITEST_FALSE(TEXT("All deferred entity spawning completed"), InstancedActorSubsystem->HasPendingDeferredSpawnEntitiesRequests());
+				for (const AArsInstancedActorsBenchmarkManager* Manager : Managers)
+				{
+					AITEST_TRUE(TEXT("Manager spawned entities"), Manager->HasSpawnedEntities());
+				}
+
+				int32 NumQueriedInstances = 0;
+				Measure(TEXT("ForEachInstanceBounded"), Iteration, [this, Iteration, &NumQueriedInstances]()
+				{
+					FRandomStream RandomStream(Iteration);
+					for (int32 QueryIndex = 0; QueryIndex < CVars::NumQueries; ++QueryIndex)
+					{
+						const FVector QueryCenter(RandomStream.FRandRange(WorldBounds.Min.X, WorldBounds.Max.X), RandomStream.FRandRange(WorldBounds.Min.Y, WorldBounds.Max.Y), 0.0);
+						const FBox QueryBounds = FBox::BuildAABB(QueryCenter, FVector(CVars::QueryExtent));
+						InstancedActorSubsystem->ForEachInstance(QueryBounds, [&NumQueriedInstances](const FArsInstancedActorsInstanceHandle&, const FTransform&, FArsInstancedActorsIterationContext&)
+						{
+							++NumQueriedInstances;
+							return true;
+						});
+					}
+				});
+				UE_LOG(LogArsInstancedActorsBenchmark, Verbose, TEXT("%d bounded queries visited %d instances"), CVars::NumQueries, NumQueriedInstances);
+
+				Measure(TEXT("BulkLODBatchProcessorTick"), Iteration, [this, LODBatchProcessor]()
+				{
+					FMassProcessingContext ProcessingContext(EntityManager.ToSharedRef(), /*DeltaSeconds*/0.0f);
+					UE::Mass::Executor::Run(*LODBatchProcessor, ProcessingContext);
+				});
+
+				DestroyInstances(CVars::DestroyedInstanceRatio, Iteration);
+
+				// Persistence
+				FMemoryWriter SaveArchive(PersistenceOuterBytes, /*bIsPersistent*/true);
+				SaveArchive.ArIsSaveGame = true;
+				SaveArchive.UsingCustomVersion(FArsInstancedActorsCustomVersion::GUID);
+
+				TArray<TArray<uint8>> PersistenceRecords;
+				PersistenceRecords.SetNum(Managers.Num());
+				Measure(TEXT("PersistenceSave"), Iteration, [this, &PersistenceRecords, &SaveArchive]()
+				{
+					for (int32 ManagerIndex = 0; ManagerIndex < Managers.Num(); ++ManagerIndex)
+					{
+						Managers[ManagerIndex]->SerializePersistenceRecords(PersistenceRecords[ManagerIndex], 1, /*bDeltaRecords*/false, SaveArchive);
+					}
+				});
+
+				FMemoryReader LoadArchive(PersistenceOuterBytes, /*bIsPersistent*/true);
+				LoadArchive.ArIsSaveGame = true;
+				LoadArchive.SetCustomVersions(SaveArchive.GetCustomVersions());
+
+				bool bLoadedAllRecords = true;
+				Measure(TEXT("PersistenceLoad"), Iteration, [this, &PersistenceRecords, &LoadArchive, &bLoadedAllRecords]()
+				{
+					for (int32 ManagerIndex = 0; ManagerIndex < Managers.Num(); ++ManagerIndex)
+					{
+						bLoadedAllRecords &= Managers[ManagerIndex]->SerializePersistenceRecords(PersistenceRecords[ManagerIndex], 1, /*bDeltaRecords*/false, LoadArchive);
+						Managers[ManagerIndex]->OnPersistentDataRestored();
+					}
+				});
+				AITEST_TRUE(TEXT("Loaded all persistence records"), bLoadedAllRecords);
+
+				// Delta list replication: a full initial serialization, then incremental serialization of further destroyed instances
+				TArray<TSharedPtr<INetDeltaBaseState>> ReplicationStates;
+				auto SerializeDeltaLists = [this, &ReplicationStates, &NetSerializeCB]()
+				{
+					ReplicationStates.SetNum(GetNumInstanceDatas());
+					int32 StateIndex = 0;
+					for (AArsInstancedActorsBenchmarkManager* Manager : Managers)
+					{
+						for (UArsInstancedActorsData* InstanceData : Manager->GetAllInstanceData())
+						{
+							FNetBitWriter Writer(/*PackageMap*/nullptr, /*MaxBits*/0);
+							TSharedPtr<INetDeltaBaseState>& State = ReplicationStates[StateIndex++];
+							TSharedPtr<INetDeltaBaseState> NewState;
+
+							FNetDeltaSerializeInfo Params;
+							Params.Writer = &Writer;
+							Params.NetSerializeCB = &NetSerializeCB;
+							Params.Object = InstanceData;
+							Params.OldState = State.Get();
+							Params.NewState = &NewState;
+							InstanceData->GetMutableInstanceDeltaList().NetDeltaSerialize(Params);
+
+							if (NewState.IsValid())
+							{
+								State = NewState;
+							}
+						}
+					}
+				};
+
+				Measure(TEXT("DeltaListReplicationInitial"), Iteration, SerializeDeltaLists);
+				DestroyInstances(CVars::DestroyedInstanceRatio * 0.1f, Iteration + 1);
+				Measure(TEXT("DeltaListReplicationIncremental"), Iteration, SerializeDeltaLists);
+
+				Measure(TEXT("DespawnEntities"), Iteration, [this]()
+				{
+					for (AArsInstancedActorsBenchmarkManager* Manager : Managers)
+					{
+						Manager->DespawnAllEntities();
+					}
+				});
+
+				DestroyManagers();
+			}
+
+			return true;
+		}
+
+		TArray<uint8> PersistenceOuterBytes;
+	};
+	IMPLEMENT_AI_INSTANT_TEST(FHotPaths, "System.ArsInstancedActors.Benchmark.HotPaths");
+
+	/**
+	 * Streams managers in and out repeatedly, as with players moving through a partitioned world, timing each cycle and checking
+	 * entities are fully released each time.
+	 */
+	struct FStreamingChurn : FBenchmarkTestBase
+	{
+		virtual bool InstantTest() override
+		{
+#if WITH_MASSENTITY_DEBUG
+			const int32 BaselineEntityCount = EntityManager->DebugGetEntityCount();
+#endif
+
+			for (int32 Iteration = 0; Iteration < FMath::Max(CVars::NumIterations, 1) * 4; ++Iteration)
+			{
+				Measure(TEXT("StreamIn"), Iteration, [this]()
+				{
+					BuildManagers(CVars::NumInstances / 4, CVars::NumInstanceDatas);
+					InstancedActorSubsystem->ExecutePendingDeferredSpawnEntitiesRequests();
+				});
+
+				const int32 NumValidInstances = GetNumValidInstances();
+				AITEST_TRUE(TEXT("Streamed in instances"), NumValidInstances > 0);
+
+				Measure(TEXT("StreamOut"), Iteration, [this]()
+				{
+					DestroyManagers();
+				});
+
+#if WITH_MASSENTITY_DEBUG
+				AITEST_EQUAL(TEXT("Entities released on stream out"), EntityManager->DebugGetEntityCount(), BaselineEntityCount);
+#endif
+			}
+
+			return true;
+		}
+	};
+	IMPLEMENT_AI_INSTANT_TEST(FStreamingChurn, "System.ArsInstancedActors.Stress.StreamingChurn");
+} // FArsInstancedActorsBenchmarkTest
+
+#endif // WITH_EDITOR
+
+#undef LOCTEXT_NAMESPACE
@@ -1,11 +1,253 @@
 // Copyright (c) 2024 Lorenzo Santa Cruz. All rights reserved.
 
 #include "AITestsCommon.h"
+#include "ArsInstancedActorsBoundsTests.h"
+#include "ArsInstancedActorsTickQueue.h"
+#include "ArsInstancedActorsTypes.h"
+#include "Math/RandomStream.h"
 
 #define LOCTEXT_NAMESPACE "ArsInstancedActorsTest"
 
 UE_DISABLE_OPTIMIZATION_SHIP
 
+namespace FArsInstancedActorsTest
+{
+	using namespace UE::ArsInstancedActors;
+
+	/**
+	 * Compares the batched (SIMD) BoundsTests::GatherInside against plain scalar tests, for FBox, FSphere and FOrientedBox queries.
+	 * Location counts cover empty, sub-batch, exact batch multiple and remainder lane cases. Each query is also run with padding.
+	 */
+	struct FBoundsTestsGatherInside : FAITestBase
+	{
+		template <typename TBoundsType, typename TScalarTestFunc>
+		bool TestGatherInside(const TCHAR* ShapeName, const BoundsTests::FLocationsSoA& Locations, const TBoundsType& Bounds, const double Padding, TScalarTestFunc&& ScalarTest)
+		{
+			TArray<int32> ExpectedIndices;
+			ExpectedIndices.Add(INDEX_NONE);
+			for (int32 LocationIndex = 0; LocationIndex < Locations.Num(); ++LocationIndex)
+			{
+				if (ScalarTest(FVector(Locations.X[LocationIndex], Locations.Y[LocationIndex], Locations.Z[LocationIndex]), Padding))
+				{
+					ExpectedIndices.Add(LocationIndex);
+				}
+			}
+
+			// Pre-seed the output to ensure GatherInside appends, rather than overwrites
+			TArray<int32> GatheredIndices;
+			GatheredIndices.Add(INDEX_NONE);
+			const int32 NumGathered = BoundsTests::GatherInside(Locations, Bounds, Padding, GatheredIndices);
+
+			AITEST_EQUAL(*FString::Printf(TEXT("%s gathered count for %d locations with %.0f padding"), ShapeName, Locations.Num(), Padding), NumGathered, ExpectedIndices.Num() - 1);
+			AITEST_TRUE(*FString::Printf(TEXT("%s gathered indices match scalar tests for %d locations with %.0f padding"), ShapeName, Locations.Num(), Padding), GatheredIndices == ExpectedIndices);
+
+			return true;
+		}
+
+		virtual bool InstantTest() override
+		{
+			const FVector Center(1000.0, -2000.0, 300.0);
+			const FVector Extent(200.0, 100.0, 50.0);
+
+			const FBox Box(Center - Extent, Center + Extent);
+			const FSphere Sphere(Center, 150.0);
+
+			const FQuat Rotation(FRotator(20.0, 35.0, -10.0));
+			FOrientedBox OrientedBox;
+			OrientedBox.Center = Center;
+			OrientedBox.AxisX = Rotation.GetAxisX();
+			OrientedBox.AxisY = Rotation.GetAxisY();
+			OrientedBox.AxisZ = Rotation.GetAxisZ();
+			OrientedBox.ExtentX = Extent.X;
+			OrientedBox.ExtentY = Extent.Y;
+			OrientedBox.ExtentZ = Extent.Z;
+
+			auto IsInsideBox = [&Box](const FVector& Location, const double Padding)
+			{
+				return Box.ExpandBy(Padding).IsInsideOrOn(Location);
+			};
+			auto IsInsideSphere = [&Sphere](const FVector& Location, const double Padding)
+			{
+				return FVector::DistSquared(Sphere.Center, Location) <= FMath::Square(Sphere.W + Padding);
+			};
+			auto IsInsideOrientedBox = [&OrientedBox](const FVector& Location, const double Padding)
+			{
+				const FVector Delta = Location - OrientedBox.Center;
+				return FMath::Abs(Delta | OrientedBox.AxisX) <= OrientedBox.ExtentX + Padding
+					&& FMath::Abs(Delta | OrientedBox.AxisY) <= OrientedBox.ExtentY + Padding
+					&& FMath::Abs(Delta | OrientedBox.AxisZ) <= OrientedBox.ExtentZ + Padding;
+			};
+
+			FRandomStream RandomStream(0x1A5);
+			const int32 LocationCounts[] = { 0, 1, 3, 4, 5, 7, 8, 9, 259 };
+			const double Paddings[] = { 0.0, 40.0 };
+			for (const int32 NumLocations : LocationCounts)
+			{
+				// Scatter locations over roughly twice the query bounds, so all shapes see a mix of passing and failing lanes
+				BoundsTests::FLocationsSoA Locations;
+				Locations.Reserve(NumLocations);
+				for (int32 LocationIndex = 0; LocationIndex < NumLocations; ++LocationIndex)
+				{
+					Locations.Add(Center + FVector(RandomStream.FRandRange(-400.0, 400.0), RandomStream.FRandRange(-250.0, 250.0), RandomStream.FRandRange(-200.0, 200.0)));
+				}
+
+				for (const double Padding : Paddings)
+				{
+					if (!TestGatherInside(TEXT("Box"), Locations, Box, Padding, IsInsideBox)
+						|| !TestGatherInside(TEXT("Sphere"), Locations, Sphere, Padding, IsInsideSphere)
+						|| !TestGatherInside(TEXT("OrientedBox"), Locations, OrientedBox, Padding, IsInsideOrientedBox))
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+	};
+	IMPLEMENT_AI_INSTANT_TEST(FBoundsTestsGatherInside, "System.ArsInstancedActors.BoundsTests.GatherInside");
+
+	/**
+	 * Exercises FSharedFragmentTickQueue's Push, PushBulk (both sift up and heap rebuild paths), Reschedule and RemoveAt, checking the queue
+	 * back-pointers stay consistent and that draining the queue yields shared fragments in NextTickTime order.
+	 */
+	struct FSharedFragmentTickQueueHeap : FAITestBase
+	{
+		static int32 GetTickQueueIndex(const FSharedStruct& SharedStruct)
+		{
+			return SharedStruct.Get<FArsInstancedActorsDataSharedFragment>().TickQueueIndex;
+		}
+
+		bool TestQueueIndices(const TCHAR* Step, const FSharedFragmentTickQueue& Queue, TConstArrayView<FSharedStruct> SharedStructs)
+		{
+			TBitArray<> UsedQueueIndices(false, Queue.Num());
+			for (const FSharedStruct& SharedStruct : SharedStructs)
+			{
+				const int32 TickQueueIndex = GetTickQueueIndex(SharedStruct);
+				AITEST_TRUE(*FString::Printf(TEXT("%s: TickQueueIndex %d is a valid queue slot"), Step, TickQueueIndex), TickQueueIndex >= 0 && TickQueueIndex < Queue.Num());
+				AITEST_FALSE(*FString::Printf(TEXT("%s: TickQueueIndex %d is unique"), Step, TickQueueIndex), UsedQueueIndices[TickQueueIndex]);
+				UsedQueueIndices[TickQueueIndex] = true;
+			}
+			return true;
+		}
+
+		bool TestDrain(const TCHAR* Step, FSharedFragmentTickQueue& Queue, const int32 ExpectedNum, const TMap<const void*, double>& ExpectedTickTimes)
+		{
+			AITEST_EQUAL(*FString::Printf(TEXT("%s: queue size"), Step), Queue.Num(), ExpectedNum);
+
+			double PreviousTickTime = -UE_BIG_NUMBER;
+			while (!Queue.IsEmpty())
+			{
+				const double TopTickTime = Queue.Top().NextTickTime;
+
+				FNextTickSharedFragment Item;
+				Queue.Pop(Item);
+				AITEST_EQUAL(*FString::Printf(TEXT("%s: Top matches Pop"), Step), Item.NextTickTime, TopTickTime);
+				AITEST_TRUE(*FString::Printf(TEXT("%s: popped in NextTickTime order"), Step), Item.NextTickTime >= PreviousTickTime);
+				AITEST_EQUAL(*FString::Printf(TEXT("%s: popped shared fragment is no longer queued"), Step), GetTickQueueIndex(Item.SharedStruct), int32(INDEX_NONE));
+
+				const double* ExpectedTickTime = ExpectedTickTimes.Find(Item.SharedStruct.GetMemory());
+				AITEST_NOT_NULL(*FString::Printf(TEXT("%s: popped shared fragment was queued"), Step), ExpectedTickTime);
+				AITEST_EQUAL(*FString::Printf(TEXT("%s: popped shared fragment kept its NextTickTime"), Step), Item.NextTickTime, *ExpectedTickTime);
+
+				PreviousTickTime = Item.NextTickTime;
+			}
+			return true;
+		}
+
+		virtual bool InstantTest() override
+		{
+			FRandomStream RandomStream(0x7C);
+			FSharedFragmentTickQueue Queue;
+			TArray<FSharedStruct> SharedStructs;
+			TMap<const void*, double> ExpectedTickTimes;
+
+			auto MakeSharedStructs = [](const int32 Num)
+			{
+				TArray<FSharedStruct> NewSharedStructs;
+				for (int32 Index = 0; Index < Num; ++Index)
+				{
+					NewSharedStructs.Add(FSharedStruct::Make<FArsInstancedActorsDataSharedFragment>());
+				}
+				return NewSharedStructs;
+			};
+
+			// Individual pushes
+			for (const FSharedStruct& SharedStruct : MakeSharedStructs(37))
+			{
+				const double NextTickTime = RandomStream.FRandRange(0.0, 100.0);
+				Queue.Push(FNextTickSharedFragment{ SharedStruct, NextTickTime });
+				ExpectedTickTimes.Add(SharedStruct.GetMemory(), NextTickTime);
+				SharedStructs.Add(SharedStruct);
+			}
+			if (!TestQueueIndices(TEXT("Push"), Queue, SharedStructs))
+			{
+				return false;
+			}
+
+			// A small bulk push into a larger queue sifts each item up, a large one rebuilds the heap
+			const int32 BulkCounts[] = { 2, 200 };
+			for (const int32 BulkCount : BulkCounts)
+			{
+				const TArray<FSharedStruct> BulkSharedStructs = MakeSharedStructs(BulkCount);
+				const double NextTickTime = RandomStream.FRandRange(0.0, 100.0);
+				Queue.PushBulk(BulkSharedStructs, NextTickTime);
+				for (const FSharedStruct& SharedStruct : BulkSharedStructs)
+				{
+					ExpectedTickTimes.Add(SharedStruct.GetMemory(), NextTickTime);
+				}
+				SharedStructs.Append(BulkSharedStructs);
+				if (!TestQueueIndices(*FString::Printf(TEXT("PushBulk %d"), BulkCount), Queue, SharedStructs))
+				{
+					return false;
+				}
+			}
+
+			// Reschedule both earlier and later, via each shared fragment's queue back-pointer
+			for (int32 Iteration = 0; Iteration < 500; ++Iteration)
+			{
+				const FSharedStruct& SharedStruct = SharedStructs[RandomStream.RandHelper(SharedStructs.Num())];
+				const double NextTickTime = RandomStream.FRandRange(-10.0, 110.0);
+				Queue.Reschedule(GetTickQueueIndex(SharedStruct), NextTickTime);
+				ExpectedTickTimes.Add(SharedStruct.GetMemory(), NextTickTime);
+			}
+			if (!TestQueueIndices(TEXT("Reschedule"), Queue, SharedStructs))
+			{
+				return false;
+			}
+
+			// Remove from arbitrary heap slots, as unregistering shared fragments does, including the last slot
+			TArray<FSharedStruct> RemainingSharedStructs = SharedStructs;
+			for (int32 Iteration = 0; Iteration < 100; ++Iteration)
+			{
+				const int32 RemoveIndex = (Iteration == 0) ? RemainingSharedStructs.Num() - 1 : RandomStream.RandHelper(RemainingSharedStructs.Num());
+				const FSharedStruct SharedStruct = RemainingSharedStructs[RemoveIndex];
+				Queue.RemoveAt(GetTickQueueIndex(SharedStruct));
+				AITEST_EQUAL(TEXT("RemoveAt: removed shared fragment is no longer queued"), GetTickQueueIndex(SharedStruct), int32(INDEX_NONE));
+				ExpectedTickTimes.Remove(SharedStruct.GetMemory());
+				RemainingSharedStructs.RemoveAtSwap(RemoveIndex);
+			}
+			if (!TestQueueIndices(TEXT("RemoveAt"), Queue, RemainingSharedStructs)
+				|| !TestDrain(TEXT("Drain"), Queue, RemainingSharedStructs.Num(), ExpectedTickTimes))
+			{
+				return false;
+			}
+
+			// Reset clears all back-pointers
+			Queue.PushBulk(SharedStructs, 0.0);
+			Queue.Reset();
+			AITEST_TRUE(TEXT("Reset empties the queue"), Queue.IsEmpty());
+			for (const FSharedStruct& SharedStruct : SharedStructs)
+			{
+				AITEST_EQUAL(TEXT("Reset shared fragments are no longer queued"), GetTickQueueIndex(SharedStruct), int32(INDEX_NONE));
+			}
+
+			return true;
+		}
+	};
+	IMPLEMENT_AI_INSTANT_TEST(FSharedFragmentTickQueueHeap, "System.ArsInstancedActors.TickQueue.Heap");
+} // namespace FArsInstancedActorsTest
+
 UE_ENABLE_OPTIMIZATION_SHIP
 
 #undef LOCTEXT_NAMESPACE